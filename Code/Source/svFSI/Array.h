@@ -729,7 +729,7 @@ class Array
 
     /// @brief Compound add assignment. 
     //
-    Array<T> operator+=(const Array<T>& array) const
+    Array<T>& operator+=(const Array<T>& array)
     {
       for (int j = 0; j < ncols_; j++) {
         for (int i = 0; i < nrows_; i++) {
@@ -741,7 +741,7 @@ class Array
 
     /// @brief Compound subtract assignment. 
     //
-    Array<T> operator-=(const Array<T>& array) const
+    Array<T>& operator-=(const Array<T>& array)
     {
       for (int j = 0; j < ncols_; j++) {
         for (int i = 0; i < nrows_; i++) {
@@ -753,7 +753,7 @@ class Array
 
     /// @brief Compound multiply assignment. 
     //
-    Array<T> operator*=(const Array<T>& array) const
+    Array<T>& operator*=(const Array<T>& array)
     {
       for (int j = 0; j < ncols_; j++) {
         for (int i = 0; i < nrows_; i++) {
@@ -834,7 +834,7 @@ class Array
 
     /// @brief Compound add assignment. 
     //
-    Array<T> operator+=(const T value) const
+    Array<T>& operator+=(const T value)
     {
       for (int j = 0; j < ncols_; j++) {
         for (int i = 0; i < nrows_; i++) {
@@ -859,7 +859,7 @@ class Array
 
     /// @brief Compound subtract assignment. 
     //
-    Array<T> operator-=(const T value) const
+    Array<T>& operator-=(const T value)
     {
       for (int j = 0; j < ncols_; j++) {
         for (int i = 0; i < nrows_; i++) {
@@ -869,6 +869,18 @@ class Array
       return *this;
     }
 
+    /// @brief Compound multiply assignment.
+    //
+    Array<T>& operator*=(const T value)
+    {
+      for (int j = 0; j < ncols_; j++) {
+        for (int i = 0; i < nrows_; i++) {
+          data_[i + j*nrows_] *= value;
+        }
+      }
+      return *this;
+    }
+
     /// @brief Subtract a scalar.
     /// s - A
     //
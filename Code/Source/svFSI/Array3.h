@@ -90,6 +90,18 @@ class Array3
       active += 1;
     }
 
+    /// @brief Create an Array3 using data owned by another object.
+    Array3(const int num_rows, const int num_cols, const int num_slices, T* data)
+    {
+      data_reference_ = true;
+      nrows_ = num_rows;
+      ncols_ = num_cols;
+      nslices_ = num_slices;
+      slice_size_ = ncols_ * nrows_;
+      size_ = nrows_ * ncols_ * nslices_;
+      data_ = data;
+    }
+
     /// @brief Array copy
     Array3(const Array3 &rhs)
     {
@@ -106,10 +118,12 @@ class Array3
     ~Array3() 
     {
       if (data_ != nullptr) {
-        memory_in_use -= sizeof(T) * size_;;
-        memory_returned += sizeof(T) * size_;;
-        active -= 1;
-        delete [] data_;
+        if (!data_reference_) {
+          memory_in_use -= sizeof(T) * size_;;
+          memory_returned += sizeof(T) * size_;;
+          active -= 1;
+          delete [] data_;
+        }
         data_ = nullptr;
        }
      }
@@ -174,6 +188,9 @@ class Array3
     void clear()
     {
       if (data_ != nullptr) {
+        if (data_reference_) {
+          throw std::runtime_error("[Array3] Can't clear an Array3 with reference data.");
+        }
         delete [] data_;
         memory_in_use -= sizeof(T) * size_;;
         memory_returned += sizeof(T) * size_;;
@@ -289,6 +306,9 @@ class Array3
       }
 
       if (data_ != nullptr) {
+        if (data_reference_) {
+          throw std::runtime_error("[Array3] Can't resize an Array3 with reference data.");
+        }
         delete [] data_;
         memory_in_use -= sizeof(T) * size_;;
         memory_returned += sizeof(T) * size_;;
@@ -458,6 +478,7 @@ class Array3
     int slice_size_ = 0;
     int size_ = 0;
     T *data_ = nullptr;
+    bool data_reference_ = false;
 
 };
 
@@ -55,7 +55,13 @@ const std::map<std::string,TimeIntegratioType> cep_time_int_to_type
 
   {"rk", TimeIntegratioType::RK4},
   {"rk4", TimeIntegratioType::RK4},
-  {"runge", TimeIntegratioType::RK4}
+  {"runge", TimeIntegratioType::RK4},
+
+  {"rl", TimeIntegratioType::RL},
+  {"rush-larsen", TimeIntegratioType::RL},
+
+  {"rl2", TimeIntegratioType::RL2},
+  {"grl2", TimeIntegratioType::RL2}
 
 };
 
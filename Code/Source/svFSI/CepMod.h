@@ -48,6 +48,7 @@
 #include "Array.h"
 #include "Vector.h"
 #include <map>
+#include <vector>
 
 /// @brief Type of cardiac electrophysiology models.
 enum class ElectrophysiologyModelType {
@@ -78,7 +79,9 @@ enum class TimeIntegratioType {
   NA = 200, 
   FE = 201,
   RK4 = 202, 
-  CN2 = 203
+  CN2 = 203,
+  RL = 204,
+  RL2 = 205
 };
 
 extern const std::map<std::string,TimeIntegratioType> cep_time_int_to_type;
@@ -90,6 +93,8 @@ static std::ostream &operator << ( std::ostream& strm, TimeIntegratioType type)
     {TimeIntegratioType::FE, "FE"}, 
     {TimeIntegratioType::RK4, "RK4"}, 
     {TimeIntegratioType::CN2, "CN2"}, 
+    {TimeIntegratioType::RL, "RL"}, 
+    {TimeIntegratioType::RL2, "RL2"}, 
   };
   return strm << names.at(type);
 }
@@ -216,6 +221,24 @@ class cemModelType
     Vector<double> Ya;
 };
 
+/// @brief Nodes integrated by each electrophysiology domain. 
+///
+/// The lists are set once by cep_ion::set_dmn_nodes() so the domain of each 
+/// node is not tested every time step.
+//
+class cepDmnNodesType
+{
+  public:
+    /// @brief Number of nodes (tnNo) when the lists were set
+    int tnNo = -1;
+
+    /// @brief Index into eq.dmn[] of the domain of each list
+    std::vector<int> iDmn;
+
+    /// @brief Nodes integrated with the model of each domain
+    std::vector<std::vector<int>> nodes;
+};
+
 class CepMod 
 {
   public:
@@ -229,6 +252,9 @@ class CepMod
     /// @brief Unknowns stored at all nodes
     Array<double> Xion;
 
+    /// @brief Nodes integrated by each domain
+    cepDmnNodesType dmnNodes;
+
     /// @brief Cardiac electromechanics type
     cemModelType cem;
 
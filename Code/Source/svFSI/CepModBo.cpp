@@ -32,6 +32,7 @@
 
 #include "mat_fun.h"
 #include "utils.h"
+#include <algorithm>
 #include <math.h>
 
 CepModBo::CepModBo()
@@ -319,6 +320,108 @@ void CepModBo::integ_rk(const int imyo, const int nX, Vector<double>& X, const d
 
 }
 
+/// @brief Return the factor (exp(b*dt) - 1) / b used by the Rush-Larsen 
+/// update x + factor*f, which is exact when f = a + b*x.
+//
+static double rush_larsen_factor(const double b, const double dt)
+{
+  if (fabs(b*dt) < 1.0e-10) {
+    return dt;
+  }
+  return (exp(b*dt) - 1.0) / b;
+}
+
+/// @brief Compute the Rush-Larsen rates b = df/dX(i) of the gating 
+/// variables v, w and s, whose equations are linear in the variable. 
+///
+/// The rate of u is the derivative of the fast inward and slow outward 
+/// currents away from their thresholds. It is limited to b <= 0 so that 
+/// only the stiff, decaying part of the u equation is integrated 
+/// exponentially; the upstroke (b > 0) uses forward Euler.
+///
+/// The 'zone_id' parameter is the myocardium zone id: 1, 2 or 3.
+//
+void CepModBo::rl_rates(const int zone_id, const Vector<double>& X, Vector<double>& b)
+{
+  double u = X(0);
+  int i = zone_id - 1;
+
+  double H_uv = step(u - theta_v[i]);
+  double H_uw = step(u - theta_w[i]);
+  double H_umv = step(u - thetam_v[i]);
+  double H_uo = step(u - theta_o[i]);
+
+  double taum_v = (1.0-H_umv)*taum_v1[i] + H_umv*taum_v2[i];
+  double taum_w = taum_w1[i] + 0.5*(taum_w2[i]-taum_w1[i])* (1.0 + tanh(km_w[i]*(u-um_w[i])));
+  double tau_s  = (1.0-H_uw)*tau_s1[i] + H_uw*tau_s2[i];
+  double tau_o  = (1.0-H_uo)*tau_o1[i] + H_uo*tau_o2[i];
+
+  double dI_fi = -X(1)*H_uv*(u_u[i] - 2.0*u + theta_v[i])/tau_fi[i];
+  double dI_so = (1.0-H_uw)/tau_o;
+
+  b(0) = std::min(-(dI_fi + dI_so), 0.0);
+  b(1) = -(1.0-H_uv)/taum_v - H_uv/taup_v[i];
+  b(2) = -(1.0-H_uw)/taum_w - H_uw/taup_w[i];
+  b(3) = -1.0/tau_s;
+}
+
+/// @brief First-order Rush-Larsen integration: each variable is integrated 
+/// exactly over dt with its equation linearized about the start of the step 
+/// using the rates of rl_rates().
+//
+void CepModBo::integ_rl(const int imyo, const int nX, Vector<double>& X, const double Ti, const double Istim, 
+    const double Ksac, Vector<double>& RPAR)
+{
+  double dt = Ti / Tscale;
+
+  double Isac = Ksac * (Vrest - X(0));
+  double fext = (Istim + Isac) * Tscale / Vscale;
+  X(0) = (X(0) - Voffset) / Vscale;
+
+  Vector<double> f(nX), b(nX);
+  getf(imyo, nX, X, f, fext, RPAR);
+  rl_rates(imyo, X, b);
+
+  for (int i = 0; i < nX; i++) {
+    X(i) = X(i) + rush_larsen_factor(b(i), dt) * f(i);
+  }
+
+  X(0) = X(0)*Vscale + Voffset;
+}
+
+/// @brief Second-order generalized Rush-Larsen integration.
+///
+/// A first-order half step gives the midpoint state Xm, then each variable 
+/// is integrated over dt with its equation linearized about Xm. 
+//
+void CepModBo::integ_rl2(const int imyo, const int nX, Vector<double>& X, const double Ti, const double Istim, 
+    const double Ksac, Vector<double>& RPAR)
+{
+  double dt = Ti / Tscale;
+
+  double Isac = Ksac * (Vrest - X(0));
+  double fext = (Istim + Isac) * Tscale / Vscale;
+  X(0) = (X(0) - Voffset) / Vscale;
+
+  Vector<double> f(nX), b(nX);
+  getf(imyo, nX, X, f, fext, RPAR);
+  rl_rates(imyo, X, b);
+
+  Vector<double> Xm(nX);
+  for (int i = 0; i < nX; i++) {
+    Xm(i) = X(i) + rush_larsen_factor(b(i), 0.5*dt) * f(i);
+  }
+
+  getf(imyo, nX, Xm, f, fext, RPAR);
+  rl_rates(imyo, Xm, b);
+
+  for (int i = 0; i < nX; i++) {
+    X(i) = X(i) + rush_larsen_factor(b(i), dt) * (f(i) + b(i)*(X(i) - Xm(i)));
+  }
+
+  X(0) = X(0)*Vscale + Voffset;
+}
+
 double CepModBo::step(const double r)
 {
   double result;
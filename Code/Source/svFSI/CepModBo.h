@@ -154,6 +154,14 @@ class CepModBo
     void integ_rk(const int imyo, const int nX, Vector<double>& X, const double Ts, const double Ti,
         const double Istim, const double Ksac, Vector<double>& RPAR);
 
+    void integ_rl(const int imyo, const int nX, Vector<double>& X, const double Ti, const double Istim,
+        const double Ksac, Vector<double>& RPAR);
+
+    void integ_rl2(const int imyo, const int nX, Vector<double>& X, const double Ti, const double Istim,
+        const double Ksac, Vector<double>& RPAR);
+
+    void rl_rates(const int zone_id, const Vector<double>& X, Vector<double>& b);
+
     double step(const double r);
 
 };
@@ -31,6 +31,7 @@
 #include "CepModTtp.h"
 
 #include "mat_fun.h"
+#include <algorithm>
 #include <math.h>
 
 CepModTtp::CepModTtp()
@@ -686,6 +687,103 @@ void CepModTtp::integ_rk(const int imyo, const int nX, const int nG, Vector<doub
   Xg = Xgr;
 }
 
+/// @brief Return (exp(b*dt) - 1) / b, the factor multiplying f in the exact 
+/// update of x' = f = a + b*x over dt. 
+//
+static double rush_larsen_factor(const double b, const double dt)
+{
+  if (fabs(b*dt) < 1.0e-10) {
+    return dt;
+  }
+  return (exp(b*dt) - 1.0) / b;
+}
+
+/// @brief Return the rate b = df/dV of the transmembrane potential equation.
+///
+/// The rate is computed with a forward difference of getf() and limited to 
+/// b <= 0 so that only the stiff, decaying part of the V equation is 
+/// integrated exponentially; the upstroke (b > 0) uses forward Euler.
+//
+double CepModTtp::v_rate(const int imyo, const int nX, const int nG, const Vector<double>& X, 
+    const Vector<double>& Xg, const Vector<double>& f, const double Istim, const double Ksac, 
+    const Vector<double>& RPAR)
+{
+  const double dV = 1.0e-4;
+  auto Xp = X;
+  auto RPARp = RPAR;
+  Vector<double> fp(nX);
+
+  Xp(0) = Xp(0) + dV;
+  getf(imyo, nX, nG, Xp, Xg, fp, Istim, Ksac, RPARp);
+
+  return std::min((fp(0) - f(0)) / dV, 0.0);
+}
+
+/// @brief First-order Rush-Larsen integration.
+///
+/// The gating variables are integrated exactly over dt for the rates at the 
+/// start of the step (update_g) and so are V, using the rate of v_rate(), and 
+/// the linear ryanodine receptor equation for R_bar. The concentrations use 
+/// forward Euler. 
+//
+void CepModTtp::integ_rl(const int imyo, const int nX, const int nG, Vector<double>& X, Vector<double>& Xg, 
+    const double dt, const double Istim, const double Ksac, Vector<double>& RPAR)
+{
+  Vector<double> f(nX);
+
+  getf(imyo, nX, nG, X, Xg, f, Istim, Ksac, RPAR);
+
+  // dR_bar/dt = k4 - (k2*Ca_ss + k4)*R_bar, k2 was set by getf().
+  double bR = -(k2*X(4) + k4);
+  double bV = v_rate(imyo, nX, nG, X, Xg, f, Istim, Ksac, RPAR);
+
+  update_g(imyo, dt, nX, nG, X, Xg);
+
+  for (int i = 0; i < nX; i++) {
+    if (i == 0) {
+      X(i) = X(i) + rush_larsen_factor(bV, dt) * f(i);
+    } else if (i == 6) {
+      X(i) = X(i) + rush_larsen_factor(bR, dt) * f(i);
+    } else {
+      X(i) = X(i) + dt*f(i);
+    }
+  }
+}
+
+/// @brief Second-order generalized Rush-Larsen integration.
+///
+/// A first-order Rush-Larsen half step gives the midpoint state. The full 
+/// step then integrates each variable exactly using the midpoint rates, 
+/// with the equation linearized about the midpoint value for V and R_bar.
+//
+void CepModTtp::integ_rl2(const int imyo, const int nX, const int nG, Vector<double>& X, Vector<double>& Xg, 
+    const double dt, const double Istim, const double Ksac, Vector<double>& RPAR)
+{
+  // Midpoint state.
+  auto Xm = X;
+  auto Xgm = Xg;
+  integ_rl(imyo, nX, nG, Xm, Xgm, 0.5*dt, Istim, Ksac, RPAR);
+
+  Vector<double> fm(nX);
+  getf(imyo, nX, nG, Xm, Xgm, fm, Istim, Ksac, RPAR);
+  double bR = -(k2*Xm(4) + k4);
+  double bV = v_rate(imyo, nX, nG, Xm, Xgm, fm, Istim, Ksac, RPAR);
+
+  // Gating variables from their values at the start of the step with the 
+  // midpoint rates.
+  update_g(imyo, dt, nX, nG, Xm, Xg);
+
+  for (int i = 0; i < nX; i++) {
+    if (i == 0) {
+      X(i) = X(i) + rush_larsen_factor(bV, dt) * (fm(i) + bV*(X(i) - Xm(i)));
+    } else if (i == 6) {
+      X(i) = X(i) + rush_larsen_factor(bR, dt) * (fm(i) + bR*(X(i) - Xm(i)));
+    } else {
+      X(i) = X(i) + dt*fm(i);
+    }
+  }
+}
+
 /// @brief Update all the gating variables
 void CepModTtp::update_g(const int i, const double dt, const int n, const int nG, const Vector<double>& X, Vector<double>& Xg)
 {
@@ -418,9 +418,18 @@ class CepModTtp
     void integ_rk(const int imyo, const int nX, const int nG, Vector<double>& X, Vector<double>& Xg, 
         const double Ts, const double dt, const double Istim, const double Ksac, Vector<double>& RPAR);
 
+    void integ_rl(const int imyo, const int nX, const int nG, Vector<double>& X, Vector<double>& Xg, 
+        const double dt, const double Istim, const double Ksac, Vector<double>& RPAR);
+
+    void integ_rl2(const int imyo, const int nX, const int nG, Vector<double>& X, Vector<double>& Xg, 
+        const double dt, const double Istim, const double Ksac, Vector<double>& RPAR);
+
     void update_g(const int i, const double dt, const int n, const int nG, const Vector<double>& X, 
         Vector<double>& Xg);
 
+    double v_rate(const int imyo, const int nX, const int nG, const Vector<double>& X, const Vector<double>& Xg,
+        const Vector<double>& f, const double Istim, const double Ksac, const Vector<double>& RPAR);
+
 };
 
 #endif
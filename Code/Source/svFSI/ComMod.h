@@ -42,6 +42,7 @@
 #include "CepMod.h"
 #include "ChnlMod.h"
 #include "CmMod.h"
+#include "ElementWorkspace.h"
 #include "Timer.h"
 #include "Vector.h"
 
@@ -954,9 +955,42 @@ class mshType
     /// @brief Mesh element adjacency
     adjType eAdj;
 
+    /// @brief Number of element colors used for threaded assembly
+    int nColors = 0;
+
+    /// @brief Element color offsets into colorElems (nColors+1)
+    Vector<int> colorPtr;
+
+    /// @brief Elements sorted by color; the elements of a color share no 
+    /// nodes and have the same domain ID
+    Vector<int> colorElems;
+
+    /// @brief Column of com_mod.Val holding entry (a,b) of the local matrix
+    /// of element e, stored at (a*eNoN+b, e) (see lhsa_ns::set_elem_val_ptr)
+    Array<int> valPtr;
+
+    /// @brief Whether geoNx, geoJac and geoKsix hold valid element 
+    /// geometric factors (see nn::init_geo_cache)
+    bool geoCache = false;
+
+    /// @brief Cached physical shape function gradients (nsd,eNoN,nEl)
+    Array3<double> geoNx;
+
+    /// @brief Cached element Jacobians (nEl)
+    Vector<double> geoJac;
+
+    /// @brief Cached ksix metric (nsd,nsd,nEl)
+    Array3<double> geoKsix;
+
     /// @brief Function spaces (basis)
     std::vector<fsType> fs;
 
+    /// @brief Velocity/pressure function space pairs used for assembly,
+    /// built once by fs::init_thood_fs_msh(): [0] stabilized (equal order),
+    /// [1] Taylor-Hood at velocity Gauss points, [2] Taylor-Hood at pressure
+    /// Gauss points
+    std::array<std::array<fsType,2>,3> thood_fs;
+
     /// @brief BSpline in different directions (NURBS)
     std::vector<bsType> bs;
 
@@ -1084,6 +1118,18 @@ class eqType
     /// @brief The type of preconditioner used by the interface to a numerical linear algebra library.
     consts::PreconditionerType linear_algebra_preconditioner = consts::PreconditionerType::PREC_FSILS;
 
+    /// @brief Number of linear solves between preconditioner rebuilds, 0 only rebuilds 
+    /// when triggered by 'linear_algebra_rebuild_iterations'.
+    int linear_algebra_rebuild_interval = 1;
+
+    /// @brief Rebuild the preconditioner when a linear solve takes more than this 
+    /// number of iterations, 0 disables the check.
+    int linear_algebra_rebuild_iterations = 0;
+
+    /// @brief Recompute the preconditioner values on its existing structure 
+    /// between rebuilds instead of reusing it unchanged.
+    bool linear_algebra_refresh_values = false;
+
     /// @brief Interface to a numerical linear algebra library.
     LinearAlgebra* linear_algebra = nullptr;
 
@@ -1324,12 +1370,20 @@ class ComMod {
     /// @brief Whether mesh is moving
     bool mvMsh = false;
 
+    /// @brief Whether to cache element geometric factors of linear elements
+    /// on a fixed mesh
+    bool geoCache = false;
+
     /// @brief Whether to averaged results
     bool saveAve = false;
 
     /// @brief Whether to save to VTK files
     bool saveVTK = false;
 
+    /// @brief Whether each processor saves its own VTK file piece, 
+    /// indexed by a .pvtu file
+    bool savePVTU = false;
+
     /// @brief Whether any file being saved
     bool savedOnce = false;
 
@@ -1473,6 +1527,13 @@ class ComMod {
     /// @brief Stop_trigger file name
     std::string stopTrigName;
 
+    /// @brief Folder of the partition cache
+    std::string partCacheDir;
+
+    /// @brief Folder of the partition cache files of this run, empty if the
+    /// cache is not used (see partition_cache.h)
+    std::string partCachePath;
+
     /// @brief Precomputed state-variable file name
     std::string precompFileName;
 
@@ -1596,6 +1657,10 @@ class ComMod {
     /// @brief IB: Immersed boundary data structure
     ibType ib;
 
+    /// @brief Workspaces for the local arrays used in element assembly, 
+    /// one for each assembly thread
+    std::vector<ElementWorkspace> elem_workspace;
+
     bool debug_active = false;
 
     Timer timer;
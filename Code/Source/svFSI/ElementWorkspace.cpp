@@ -0,0 +1,127 @@
+/* Copyright (c) Stanford University, The Regents of the University of California, and others.
+ *
+ * All Rights Reserved.
+ *
+ * See Copyright-SimVascular.txt for additional details.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "ElementWorkspace.h"
+
+#include <algorithm>
+
+/// @brief Return a pointer to 'size' zeroed values. 
+///
+/// The values are taken from the current block or the next block 
+/// with enough space, a new block is added if there is none.
+//
+template<typename T>
+T* ElementWorkspace::Pool<T>::get(const int size)
+{
+  const size_t num_values = static_cast<size_t>(size);
+
+  while (block < blocks.size()) {
+    auto& data = blocks[block];
+    if (offset + num_values <= data.size()) {
+      T* values = data.data() + offset;
+      std::fill(values, values+num_values, T(0));
+      offset += num_values;
+      return values;
+    }
+    block += 1;
+    offset = 0;
+  }
+
+  blocks.emplace_back(std::max(size, block_size), T(0));
+  offset = num_values;
+  return blocks.back().data();
+}
+
+/// @brief Allocate the workspace memory, 'size' is the number of double
+/// values needed to assemble an element.
+//
+void ElementWorkspace::allocate(const int size)
+{
+  double_pool_.block_size = std::max(size, double_pool_.block_size);
+  double_pool_.blocks.clear();
+  double_pool_.blocks.emplace_back(double_pool_.block_size, 0.0);
+  double_pool_.reset();
+
+  int_pool_.blocks.clear();
+  int_pool_.blocks.emplace_back(int_pool_.block_size, 0);
+  int_pool_.reset();
+}
+
+/// @brief Make all of the workspace memory available. 
+///
+/// Arrays obtained before calling reset() must no longer be used.
+//
+void ElementWorkspace::reset()
+{
+  double_pool_.reset();
+  int_pool_.reset();
+}
+
+ElementWorkspace::Scope::Scope(ElementWorkspace& ws) : ws_(ws)
+{
+  double_block_ = ws.double_pool_.block;
+  double_offset_ = ws.double_pool_.offset;
+  int_block_ = ws.int_pool_.block;
+  int_offset_ = ws.int_pool_.offset;
+}
+
+ElementWorkspace::Scope::~Scope()
+{
+  ws_.double_pool_.block = double_block_;
+  ws_.double_pool_.offset = double_offset_;
+  ws_.int_pool_.block = int_block_;
+  ws_.int_pool_.offset = int_offset_;
+}
+
+Array<double> ElementWorkspace::array(const int num_rows, const int num_cols)
+{
+  return Array<double>(num_rows, num_cols, double_pool_.get(num_rows*num_cols));
+}
+
+Array3<double> ElementWorkspace::array3(const int num_rows, const int num_cols, const int num_slices)
+{
+  return Array3<double>(num_rows, num_cols, num_slices, double_pool_.get(num_rows*num_cols*num_slices));
+}
+
+Tensor4<double> ElementWorkspace::tensor4(const int num_i, const int num_j, const int num_k, const int num_l)
+{
+  return Tensor4<double>(num_i, num_j, num_k, num_l, double_pool_.get(num_i*num_j*num_k*num_l));
+}
+
+Vector<double> ElementWorkspace::vector(const int size)
+{
+  return Vector<double>(size, double_pool_.get(size));
+}
+
+Vector<int> ElementWorkspace::ivector(const int size)
+{
+  return Vector<int>(size, int_pool_.get(size));
+}
+
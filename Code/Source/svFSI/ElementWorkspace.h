@@ -0,0 +1,102 @@
+/* Copyright (c) Stanford University, The Regents of the University of California, and others.
+ *
+ * All Rights Reserved.
+ *
+ * See Copyright-SimVascular.txt for additional details.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef ELEMENT_WORKSPACE_H 
+#define ELEMENT_WORKSPACE_H 
+
+#include "Array.h"
+#include "Array3.h"
+#include "Tensor4.h"
+#include "Vector.h"
+
+#include <vector>
+
+/// @brief The ElementWorkspace class provides the storage for the local arrays 
+/// (element coordinates, solution values, residual, tangent, ...) used to 
+/// assemble the contribution of an element. 
+///
+/// Arrays are returned as views into blocks of memory owned by the workspace.
+/// Calling reset() makes all of the memory available again for the next 
+/// element. Blocks are only allocated when the existing blocks are too small so 
+/// after the first few elements no more heap allocations are made.
+///
+/// Each assembly thread uses its own workspace.
+///
+/// The temporaries used for a Gauss point (deformation gradient, stresses, 
+/// the material model tensors of mat_models::get_pk2cc, ...) are also taken 
+/// from the workspace, within a Scope that releases them at the end of the 
+/// Gauss point.
+//
+class ElementWorkspace 
+{
+  public:
+    ElementWorkspace() {};
+
+    void allocate(const int size);
+    void reset();
+
+    Array<double> array(const int num_rows, const int num_cols);
+    Array3<double> array3(const int num_rows, const int num_cols, const int num_slices);
+    Tensor4<double> tensor4(const int num_i, const int num_j, const int num_k, const int num_l);
+    Vector<double> vector(const int size);
+    Vector<int> ivector(const int size);
+
+    /// @brief Make the memory obtained from the workspace during the lifetime
+    /// of a Scope available again when it is destroyed, e.g. the temporaries
+    /// used for a Gauss point.
+    class Scope {
+      public:
+        explicit Scope(ElementWorkspace& ws);
+        ~Scope();
+
+      private:
+        ElementWorkspace& ws_;
+        size_t double_block_, double_offset_;
+        size_t int_block_, int_offset_;
+    };
+
+  private:
+    template<typename T>
+    class Pool {
+      public:
+        T* get(const int size);
+        void reset() { block = 0; offset = 0; };
+        std::vector<std::vector<T>> blocks;
+        size_t block = 0;
+        size_t offset = 0;
+        int block_size = 1024;
+    };
+
+    Pool<double> double_pool_;
+    Pool<int> int_pool_;
+};
+
+#endif
+
@@ -49,14 +49,37 @@ class LinearAlgebra {
     virtual void alloc(ComMod& com_mod, eqType& lEq) = 0;
     virtual void assemble(ComMod& com_mod, const int num_elem_nodes, const Vector<int>& eqN, 
         const Array3<double>& lK, const Array<double>& lR) = 0;
+
+    /// @brief Assemble the local arrays of element 'e' of mesh 'lM', where 
+    /// 'eqN' is lM.IEN(:,e). Implementations may use the element index to 
+    /// locate the sparse matrix entries directly.
+    virtual void assemble_element(ComMod& com_mod, const mshType&, const int, const int num_elem_nodes, 
+        const Vector<int>& eqN, const Array3<double>& lK, const Array<double>& lR)
+    {
+      assemble(com_mod, num_elem_nodes, eqN, lK, lR);
+    }
+
     virtual void check_options(const consts::PreconditionerType prec_cond_type, const consts::LinearAlgebraType assembly_type) = 0;
     virtual void initialize(ComMod& com_mod, eqType& lEq) = 0;
     virtual void set_assembly(consts::LinearAlgebraType assembly_type) = 0;
     virtual void set_preconditioner(consts::PreconditionerType prec_type) = 0;
+
+    /// @brief Set the policy used to decide when the preconditioner is rebuilt. 
+    /// Implementations that build a new preconditioner for every solve ignore it.
+    virtual void set_preconditioner_reuse(const int, const int, const bool) { }
+
+    /// @brief Return how the preconditioner was updated for the last solve, or an 
+    /// empty string if it is rebuilt for every solve.
+    virtual std::string preconditioner_status() { return ""; }
+
     virtual void solve(ComMod& com_mod, eqType& lEq, const Vector<int>& incL, const Vector<double>& res) = 0;
 
     virtual consts::LinearAlgebraType get_interface_type() { return interface_type; }
 
+    /// @brief Return true if assemble() can be called concurrently for elements 
+    /// that do not share nodes.
+    virtual bool thread_safe_assembly() { return false; }
+
     consts::LinearAlgebraType interface_type = consts::LinearAlgebraType::none;
     consts::LinearAlgebraType assembly_type = consts::LinearAlgebraType::none;
     consts::PreconditionerType preconditioner_type = consts::PreconditionerType::PREC_NONE;
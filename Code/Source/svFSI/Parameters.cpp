@@ -1825,6 +1825,7 @@ GeneralSimulationParameters::GeneralSimulationParameters()
   // A parameter that must be defined.
   bool required = true;
 
+  set_parameter("Cache_geometric_factors", false, !required, cache_geometric_factors);
   set_parameter("Check_IEN_order", true, !required, check_ien_order);
   set_parameter("Continue_previous_simulation", false, required, continue_previous_simulation);
   set_parameter("Convert_BIN_to_VTK_format", false, !required, convert_bin_to_vtk_format);
@@ -1838,14 +1839,18 @@ GeneralSimulationParameters::GeneralSimulationParameters()
   set_parameter("Number_of_initialization_time_steps", 0, !required, number_of_initialization_time_steps, {0,int_inf});
   set_parameter("Number_of_spatial_dimensions", 3, !required, number_of_spatial_dimensions);
   set_parameter("Number_of_time_steps", 0, required, number_of_time_steps, {0,int_inf});
+  set_parameter("Number_of_threads", 1, !required, number_of_threads, {1,int_inf});
 
   set_parameter("Overwrite_restart_file", false, !required, overwrite_restart_file);
 
+  set_parameter("Partition_cache_folder", "", !required, partition_cache_folder);
+
   set_parameter("Restart_file_name", "stFile", !required, restart_file_name);
 
   set_parameter("Save_averaged_results", false, !required, save_averaged_results);
   set_parameter("Save_results_in_folder", "", !required, save_results_in_folder);
   set_parameter("Save_results_to_VTK_format", false, required, save_results_to_vtk_format);
+  set_parameter("Save_results_to_parallel_VTK_format", false, !required, save_results_to_parallel_vtk_format);
   set_parameter("Searched_file_name_to_trigger_stop", "", !required, searched_file_name_to_trigger_stop);
   set_parameter("Simulation_initialization_file_path", "", !required, simulation_initialization_file_path);
   set_parameter("Simulation_requires_remeshing", false, !required, simulation_requires_remeshing);
@@ -2220,6 +2225,11 @@ LinearAlgebraParameters::LinearAlgebraParameters()
 
   auto assemble_type = LinearAlgebra::type_to_name.at(consts::LinearAlgebraType::none);
   set_parameter("Assembly", assemble_type, !required, assembly);
+
+  // Preconditioner reuse policy, the default rebuilds the preconditioner for every solve.
+  set_parameter("Preconditioner_rebuild_interval", 1, !required, preconditioner_rebuild_interval);
+  set_parameter("Preconditioner_rebuild_iterations", 0, !required, preconditioner_rebuild_iterations);
+  set_parameter("Preconditioner_refresh_values", false, !required, preconditioner_refresh_values);
 }
 
 void LinearAlgebraParameters::print_parameters()
@@ -2280,6 +2290,14 @@ void LinearAlgebraParameters::set_values(tinyxml2::XMLElement* xml_elem)
         "' given in the XML <Linear_algebra> <Preconditioner> element.\nValid types are: " + valid_types);
   }     
 
+  if (preconditioner_rebuild_interval() < 0) {
+    throw std::runtime_error("The XML <Linear_algebra> <Preconditioner_rebuild_interval> value must be >= 0.");
+  }
+
+  if (preconditioner_rebuild_iterations() < 0) {
+    throw std::runtime_error("The XML <Linear_algebra> <Preconditioner_rebuild_iterations> value must be >= 0.");
+  }
+
   check_input_parameters();
 
   values_set_ = true;
@@ -2323,6 +2341,7 @@ LinearSolverParameters::LinearSolverParameters()
   set_parameter("NS_CG_max_iterations", 1000, !required, ns_cg_max_iterations);
   set_parameter("NS_CG_tolerance", 1.0e-2, !required, ns_cg_tolerance);
   set_parameter("NS_GM_max_iterations", 1000, !required, ns_gm_max_iterations);
+  set_parameter("NS_GM_pipelined", false, !required, ns_gm_pipelined);
   set_parameter("NS_GM_tolerance", 1.0e-2, !required, ns_gm_tolerance);
 
   //set_parameter("Preconditioner", "", !required, preconditioner);
@@ -578,6 +578,9 @@ class CoupleGenBCParameters : public ParameterLists
     Parameter<std::string> type;
 
     // String parameters.
+
+    // The genBC executable, or a genBC shared library (.so or .dylib) 
+    // called in-process (see GenBCInterface).
     Parameter<std::string> zerod_code_file_path;
 
     bool value_set = false;
@@ -855,6 +858,19 @@ class ViscosityParameters : public ParameterLists
 
 /// @brief The LinearAlgebraParameters class stores parameters for
 /// the 'Linear_algebra' XML element.
+///
+/// The Preconditioner_rebuild_* and Preconditioner_refresh_values elements
+/// set when a Trilinos ML or IFPACK preconditioner is rebuilt. By default it is
+/// rebuilt for every linear solve.
+///
+/// \code {.xml}
+/// <Linear_algebra type="trilinos" >
+///   <Preconditioner> trilinos-ml </Preconditioner>
+///   <Preconditioner_rebuild_interval> 10 </Preconditioner_rebuild_interval>
+///   <Preconditioner_rebuild_iterations> 100 </Preconditioner_rebuild_iterations>
+///   <Preconditioner_refresh_values> true </Preconditioner_refresh_values>
+/// </Linear_algebra>
+/// \endcode
 class LinearAlgebraParameters : public ParameterLists
 {
   public:
@@ -871,6 +887,10 @@ class LinearAlgebraParameters : public ParameterLists
     Parameter<std::string> assembly;
     Parameter<std::string> configuration_file;
     Parameter<std::string> preconditioner;
+
+    Parameter<int> preconditioner_rebuild_interval;
+    Parameter<int> preconditioner_rebuild_iterations;
+    Parameter<bool> preconditioner_refresh_values;
 };
 
 /// @brief The LinearSolverParameters class stores parameters for
@@ -894,6 +914,7 @@ class LinearSolverParameters : public ParameterLists
     Parameter<int> ns_cg_max_iterations;
     Parameter<double> ns_cg_tolerance;
     Parameter<int> ns_gm_max_iterations; 
+    Parameter<bool> ns_gm_pipelined;
     Parameter<double> ns_gm_tolerance;
 
     //Parameter<std::string> preconditioner;
@@ -1216,6 +1237,7 @@ class EquationParameters : public ParameterLists
 ///   <Spectral_radius_of_infinite_time_step> 0.50 </Spectral_radius_of_infinite_time_step>
 ///   <Searched_file_name_to_trigger_stop> STOP_SIM </Searched_file_name_to_trigger_stop>
 ///   <Save_results_to_VTK_format> true </Save_results_to_VTK_format>
+///   <Save_results_to_parallel_VTK_format> false </Save_results_to_parallel_VTK_format>
 ///   <Name_prefix_of_saved_VTK_files> result </Name_prefix_of_saved_VTK_files>
 ///   <Increment_in_saving_VTK_files> 1 </Increment_in_saving_VTK_files>
 ///   <Start_saving_after_time_step> 1 </Start_saving_after_time_step>
@@ -1225,6 +1247,7 @@ class EquationParameters : public ParameterLists
 ///   <Warning> 0 </Warning>
 ///   <Debug> 0 </Debug>
 ///   <Simulation_requires_remeshing> true </Simulation_requires_remeshing>
+///   <Partition_cache_folder> partitions </Partition_cache_folder>
 /// </GeneralSimulationParameters>
 /// \endcode
 class GeneralSimulationParameters : public ParameterLists 
@@ -1237,6 +1260,7 @@ class GeneralSimulationParameters : public ParameterLists
 
     std::string xml_element_name;
 
+    Parameter<bool> cache_geometric_factors;
     Parameter<bool> check_ien_order;
     Parameter<bool> continue_previous_simulation;
     Parameter<bool> convert_bin_to_vtk_format;
@@ -1244,6 +1268,7 @@ class GeneralSimulationParameters : public ParameterLists
     Parameter<bool> overwrite_restart_file;
     Parameter<bool> save_averaged_results;
     Parameter<bool> save_results_to_vtk_format;
+    Parameter<bool> save_results_to_parallel_vtk_format;
     Parameter<bool> simulation_requires_remeshing;
     Parameter<bool> start_averaging_from_zero;
     Parameter<bool> verbose;
@@ -1261,8 +1286,10 @@ class GeneralSimulationParameters : public ParameterLists
     Parameter<int> start_saving_after_time_step;
     Parameter<int> starting_time_step;
     Parameter<int> number_of_time_steps;
+    Parameter<int> number_of_threads;
 
     Parameter<std::string> name_prefix_of_saved_vtk_files;
+    Parameter<std::string> partition_cache_folder; 
     Parameter<std::string> restart_file_name; 
     Parameter<std::string> searched_file_name_to_trigger_stop; 
     Parameter<std::string> save_results_in_folder; 
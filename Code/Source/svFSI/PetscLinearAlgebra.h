@@ -44,11 +44,14 @@ class PetscLinearAlgebra : public virtual LinearAlgebra {
     virtual void alloc(ComMod& com_mod, eqType& lEq);
     virtual void assemble(ComMod& com_mod, const int num_elem_nodes, const Vector<int>& eqN, 
         const Array3<double>& lK, const Array<double>& lR);
+    virtual void assemble_element(ComMod& com_mod, const mshType& lM, const int e, const int num_elem_nodes, 
+        const Vector<int>& eqN, const Array3<double>& lK, const Array<double>& lR);
     virtual void check_options(const consts::PreconditionerType prec_cond_type, const consts::LinearAlgebraType assembly_type);
     virtual void initialize(ComMod& com_mod, eqType& lEq);
     virtual void solve(ComMod& com_mod, eqType& lEq, const Vector<int>& incL, const Vector<double>& res);
     virtual void set_assembly(consts::LinearAlgebraType assembly_type);
     virtual void set_preconditioner(consts::PreconditionerType prec_type);
+    virtual bool thread_safe_assembly() { return true; }
 
   private:
     static std::set<consts::LinearAlgebraType> valid_assemblers;
@@ -86,9 +86,14 @@ void Simulation::set_module_parameters()
   com_mod.startTS = general.starting_time_step.value();
   com_mod.dt = general.time_step_size.value();
 
+  // Number of OpenMP threads used for element assembly.
+  com_mod.cm.nThreads = std::max(1, general.number_of_threads.value());
+
   com_mod.stopTrigName = general.searched_file_name_to_trigger_stop.value();
   com_mod.ichckIEN = general.check_ien_order.value();
+  com_mod.geoCache = general.cache_geometric_factors.value();
   com_mod.saveVTK = general.save_results_to_vtk_format.value();
+  com_mod.savePVTU = general.save_results_to_parallel_vtk_format.value();
   com_mod.saveName = general.name_prefix_of_saved_vtk_files.value();
   com_mod.saveName = chnl_mod.appPath + com_mod.saveName;
   com_mod.saveIncr = general.increment_in_saving_vtk_files.value();
@@ -99,6 +104,7 @@ void Simulation::set_module_parameters()
   com_mod.stFileName = chnl_mod.appPath + general.restart_file_name.value();
   com_mod.stFileIncr = general.increment_in_saving_restart_files.value();
   com_mod.rmsh.isReqd = general.simulation_requires_remeshing.value();
+  com_mod.partCacheDir = general.partition_cache_folder.value();
 
   com_mod.usePrecomp = general.use_precomputed_solution.value();
   com_mod.precompFileName = general.precomputed_solution_file_path.value();
@@ -0,0 +1,383 @@
+/* Copyright (c) Stanford University, The Regents of the University of California, and others.
+ *
+ * All Rights Reserved.
+ *
+ * See Copyright-SimVascular.txt for additional details.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "SpatialIndex.h"
+
+#include "mat_fun.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+/// @brief Build the tree for the points stored in the columns of 'points'.
+//
+void PointTree::build(const Array<double>& points)
+{
+  nsd_ = points.nrows();
+  points_ = points;
+
+  int num_points = points.ncols();
+  index_.resize(num_points);
+  split_dir_.assign(num_points, 0);
+
+  for (int i = 0; i < num_points; i++) {
+    index_[i] = i;
+  }
+
+  build_node(0, num_points);
+}
+
+/// @brief Split the index range [lo,hi) at its median along the direction
+/// of largest extent and recursively build the two halves.
+//
+void PointTree::build_node(const int lo, const int hi)
+{
+  if (hi - lo <= 1) {
+    return;
+  }
+
+  int dir = 0;
+  double max_extent = -1.0;
+
+  for (int i = 0; i < nsd_; i++) {
+    double xmin = points_(i,index_[lo]);
+    double xmax = xmin;
+    for (int n = lo+1; n < hi; n++) {
+      double x = points_(i,index_[n]);
+      xmin = std::min(xmin, x);
+      xmax = std::max(xmax, x);
+    }
+    if (xmax - xmin > max_extent) {
+      max_extent = xmax - xmin;
+      dir = i;
+    }
+  }
+
+  int mid = (lo + hi) / 2;
+  std::nth_element(index_.begin()+lo, index_.begin()+mid, index_.begin()+hi, 
+      [&](const int a, const int b) { return points_(dir,a) < points_(dir,b); });
+  split_dir_[mid] = dir;
+
+  build_node(lo, mid);
+  build_node(mid+1, hi);
+}
+
+/// @brief Append to 'found' the points whose distance to 'x' is less than or 
+/// equal to 'radius'.
+///
+/// Points are appended in tree order, not sorted.
+//
+void PointTree::find_in_radius(const double* x, const double radius, std::vector<int>& found) const
+{
+  if (index_.size() == 0) {
+    return;
+  }
+
+  search_node(0, index_.size(), x, radius, found);
+}
+
+void PointTree::search_node(const int lo, const int hi, const double* x, const double radius, 
+    std::vector<int>& found) const
+{
+  if (lo >= hi) {
+    return;
+  }
+
+  int mid = (lo + hi) / 2;
+  int n = index_[mid];
+
+  double dist = 0.0;
+  for (int i = 0; i < nsd_; i++) {
+    double dx = points_(i,n) - x[i];
+    dist += dx*dx;
+  }
+
+  if (dist <= radius*radius) {
+    found.push_back(n);
+  }
+
+  // Only visit the halves that overlap the interval [x-radius,x+radius] 
+  // along the split direction.
+  //
+  int dir = split_dir_[mid];
+  double dx = x[dir] - points_(dir,n);
+
+  if (dx <= radius) {
+    search_node(lo, mid, x, radius, found);
+  }
+
+  if (dx >= -radius) {
+    search_node(mid+1, hi, x, radius, found);
+  }
+}
+
+/// @brief Return the point nearest to 'x', or -1 if the tree is empty.
+///
+/// 'dist' is set to the distance to the nearest point. The point 'skip' is 
+/// not considered, this is used to find the nearest neighbor of a point 
+/// stored in the tree.
+//
+int PointTree::find_nearest(const double* x, double& dist, const int skip) const
+{
+  int nearest = -1;
+  double dist2 = std::numeric_limits<double>::max();
+
+  nearest_node(0, index_.size(), x, skip, nearest, dist2);
+
+  dist = (nearest == -1) ? std::numeric_limits<double>::max() : sqrt(dist2);
+  return nearest;
+}
+
+void PointTree::nearest_node(const int lo, const int hi, const double* x, const int skip, 
+    int& nearest, double& dist2) const
+{
+  if (lo >= hi) {
+    return;
+  }
+
+  int mid = (lo + hi) / 2;
+  int n = index_[mid];
+
+  if (n != skip) {
+    double d2 = 0.0;
+    for (int i = 0; i < nsd_; i++) {
+      double dx = points_(i,n) - x[i];
+      d2 += dx*dx;
+    }
+
+    if (d2 < dist2 || (d2 == dist2 && n < nearest)) {
+      nearest = n;
+      dist2 = d2;
+    }
+  }
+
+  // Search the half containing 'x' first, the other half is only searched 
+  // if it can contain a closer point.
+  //
+  int dir = split_dir_[mid];
+  double dx = x[dir] - points_(dir,n);
+
+  if (dx <= 0.0) {
+    nearest_node(lo, mid, x, skip, nearest, dist2);
+    if (dx*dx <= dist2) {
+      nearest_node(mid+1, hi, x, skip, nearest, dist2);
+    }
+  } else {
+    nearest_node(mid+1, hi, x, skip, nearest, dist2);
+    if (dx*dx <= dist2) {
+      nearest_node(lo, mid, x, skip, nearest, dist2);
+    }
+  }
+}
+
+/// @brief Build the tree for the simplex elements 'ien' with node 
+/// coordinates 'x'.
+//
+void ElementTree::build(const Array<double>& x, const Array<int>& ien)
+{
+  nsd_ = x.nrows();
+  int eNoN = ien.nrows();
+  int num_elems = ien.ncols();
+
+  if (eNoN != nsd_+1) {
+    throw std::runtime_error("[ElementTree] Only linear triangle or tetrahedral elements are supported.");
+  }
+
+  xmin_.resize(nsd_, num_elems);
+  xmax_.resize(nsd_, num_elems);
+  Ainv_.resize(eNoN*eNoN, num_elems);
+  Array<double> xc(nsd_, num_elems);
+  Array<double> A(eNoN, eNoN);
+
+  for (int e = 0; e < num_elems; e++) {
+    A = 1.0;
+
+    for (int a = 0; a < eNoN; a++) {
+      int Ac = ien(a,e);
+      for (int i = 0; i < nsd_; i++) {
+        A(i,a) = x(i,Ac);
+      }
+    }
+
+    for (int i = 0; i < nsd_; i++) {
+      xmin_(i,e) = A(i,0);
+      xmax_(i,e) = A(i,0);
+      xc(i,e) = 0.0;
+      for (int a = 0; a < eNoN; a++) {
+        xmin_(i,e) = std::min(xmin_(i,e), A(i,a));
+        xmax_(i,e) = std::max(xmax_(i,e), A(i,a));
+        xc(i,e) += A(i,a) / eNoN;
+      }
+    }
+
+    auto Ainv = mat_fun::mat_inv(A, eNoN);
+
+    for (int j = 0; j < eNoN; j++) {
+      for (int i = 0; i < eNoN; i++) {
+        Ainv_(i+j*eNoN,e) = Ainv(i,j);
+      }
+    }
+  }
+
+  index_.resize(num_elems);
+  for (int e = 0; e < num_elems; e++) {
+    index_[e] = e;
+  }
+
+  nodes_.clear();
+  nodes_.reserve(2*(num_elems/leaf_size+1));
+
+  if (num_elems > 0) {
+    build_node(0, num_elems, xc);
+  }
+}
+
+/// @brief Create the node for the elements in the index range [lo,hi) and 
+/// return its position in 'nodes_'.
+//
+int ElementTree::build_node(const int lo, const int hi, const Array<double>& xc)
+{
+  int id = nodes_.size();
+  nodes_.emplace_back();
+
+  Node node;
+  node.lo = lo;
+  node.hi = hi;
+  node.xmin.fill(0.0);
+  node.xmax.fill(0.0);
+
+  for (int i = 0; i < nsd_; i++) {
+    node.xmin[i] = xmin_(i,index_[lo]);
+    node.xmax[i] = xmax_(i,index_[lo]);
+    for (int n = lo+1; n < hi; n++) {
+      node.xmin[i] = std::min(node.xmin[i], xmin_(i,index_[n]));
+      node.xmax[i] = std::max(node.xmax[i], xmax_(i,index_[n]));
+    }
+  }
+
+  if (hi - lo > leaf_size) {
+    int dir = 0;
+    for (int i = 1; i < nsd_; i++) {
+      if (node.xmax[i] - node.xmin[i] > node.xmax[dir] - node.xmin[dir]) {
+        dir = i;
+      }
+    }
+
+    int mid = (lo + hi) / 2;
+    std::nth_element(index_.begin()+lo, index_.begin()+mid, index_.begin()+hi, 
+        [&](const int a, const int b) { return xc(dir,a) < xc(dir,b); });
+
+    node.left = build_node(lo, mid, xc);
+    node.right = build_node(mid, hi, xc);
+  }
+
+  nodes_[id] = node;
+  return id;
+}
+
+/// @brief Return the element containing the point 'x', or -1 if there is 
+/// none. 
+///
+/// 'N' is set to the shape function values (barycentric coordinates) of 'x' 
+/// in the element. A point is in an element if all of its shape functions 
+/// are in (-tol,1+tol). If several elements contain the point the one with 
+/// the smallest ID is returned.
+//
+int ElementTree::find_element(const double* x, const double tol, double* N) const
+{
+  if (nodes_.size() == 0) {
+    return -1;
+  }
+
+  int eNoN = nsd_ + 1;
+  int found = -1;
+  std::vector<double> Ne(eNoN);
+  std::vector<int> stack = {0};
+
+  while (stack.size() != 0) {
+    const auto& node = nodes_[stack.back()];
+    stack.pop_back();
+
+    bool inside = true;
+    for (int i = 0; i < nsd_; i++) {
+      double dx = tol * (1.0 + node.xmax[i] - node.xmin[i]);
+      if (x[i] < node.xmin[i] - dx || x[i] > node.xmax[i] + dx) {
+        inside = false;
+        break;
+      }
+    }
+
+    if (!inside) {
+      continue;
+    }
+
+    if (node.left != -1) {
+      stack.push_back(node.right);
+      stack.push_back(node.left);
+      continue;
+    }
+
+    for (int n = node.lo; n < node.hi; n++) {
+      int e = index_[n];
+      if ((found != -1) && (e > found)) {
+        continue;
+      }
+      if (shape_functions(e, x, tol, Ne.data())) {
+        found = e;
+        std::copy(Ne.begin(), Ne.end(), N);
+      }
+    }
+  }
+
+  return found;
+}
+
+/// @brief Compute the shape functions of element 'e' at 'x' using the cached 
+/// inverse and check if 'x' is inside the element.
+//
+bool ElementTree::shape_functions(const int e, const double* x, const double tol, double* N) const
+{
+  int eNoN = nsd_ + 1;
+  bool inside = true;
+
+  for (int i = 0; i < eNoN; i++) {
+    N[i] = Ainv_(i+nsd_*eNoN,e);
+    for (int j = 0; j < nsd_; j++) {
+      N[i] += Ainv_(i+j*eNoN,e) * x[j];
+    }
+    if ((N[i] <= -tol) || (N[i] >= 1.0+tol)) {
+      inside = false;
+    }
+  }
+
+  return inside;
+}
+
@@ -0,0 +1,126 @@
+/* Copyright (c) Stanford University, The Regents of the University of California, and others.
+ *
+ * All Rights Reserved.
+ *
+ * See Copyright-SimVascular.txt for additional details.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SPATIAL_INDEX_H 
+#define SPATIAL_INDEX_H 
+
+#include "Array.h"
+
+#include <array>
+#include <vector>
+
+/// @brief The PointTree class is a k-d tree over a set of points used to 
+/// find all of the points lying within a given distance of a query point.
+///
+/// The tree is stored implicitly in a permutation of the point indexes: 
+/// the range [lo,hi) is split at its median point mid = (lo+hi)/2 along the 
+/// coordinate direction with the largest extent. Building the tree takes 
+/// O(N log N) operations and a radius query visits O(log N + k) nodes 
+/// for k points found.
+///
+/// Points are identified by their column in the 'points' array passed to 
+/// build(). 
+//
+class PointTree 
+{
+  public:
+    PointTree() {};
+
+    void build(const Array<double>& points);
+    void find_in_radius(const double* x, const double radius, std::vector<int>& found) const;
+    int find_nearest(const double* x, double& dist, const int skip = -1) const;
+    int size() const { return index_.size(); };
+
+  private:
+    void build_node(const int lo, const int hi);
+    void search_node(const int lo, const int hi, const double* x, const double radius, 
+        std::vector<int>& found) const;
+    void nearest_node(const int lo, const int hi, const double* x, const int skip, 
+        int& nearest, double& dist2) const;
+
+    int nsd_ = 0;
+    Array<double> points_;
+    std::vector<int> index_;
+    std::vector<int> split_dir_;
+};
+
+/// @brief The ElementTree class is a bounding volume hierarchy over the 
+/// linear simplex elements (triangles in 2D, tetrahedra in 3D) of a mesh used 
+/// to find the element containing a given point.
+///
+/// Each tree node stores the bounding box of its elements, the elements are
+/// split at the median of their centroids along the direction of largest
+/// extent. The inverse of the matrix 
+///
+///   | x_1 ... x_nsd+1 |
+///   |  1  ...    1    |
+///
+/// is computed once for each element when the tree is built so locating a 
+/// point only requires a matrix-vector product per candidate element.
+///
+/// Elements are identified by their column in the 'ien' array passed to 
+/// build(). 
+//
+class ElementTree 
+{
+  public:
+    ElementTree() {};
+
+    void build(const Array<double>& x, const Array<int>& ien);
+    int find_element(const double* x, const double tol, double* N) const;
+    int size() const { return index_.size(); };
+
+  private:
+    class Node {
+      public:
+        std::array<double,3> xmin;
+        std::array<double,3> xmax;
+        int lo;
+        int hi;
+        int left = -1;
+        int right = -1;
+    };
+
+    int build_node(const int lo, const int hi, const Array<double>& xc);
+    bool shape_functions(const int e, const double* x, const double tol, double* N) const;
+
+    // Number of elements stored in a leaf node.
+    static const int leaf_size = 4;
+
+    int nsd_ = 0;
+    std::vector<int> index_;
+    std::vector<Node> nodes_;
+    Array<double> xmin_;
+    Array<double> xmax_;
+    Array<double> Ainv_;
+};
+
+#endif
+
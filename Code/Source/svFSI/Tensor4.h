@@ -55,6 +55,7 @@ class Tensor4
     int p2_ = 0;
     int size_ = 0;
     T *data_ = nullptr;
+    bool data_reference_ = false;
 
     Tensor4() 
     {
@@ -74,12 +75,28 @@ class Tensor4
       allocate(num_i, num_j, num_k, num_l);
     }
 
+    /// @brief Create a Tensor4 using data owned by another object.
+    Tensor4(const int num_i, const int num_j, const int num_k, const int num_l, T* data)
+    {
+      data_reference_ = true;
+      ni_ = num_i;
+      nj_ = num_j;
+      nk_ = num_k;
+      nl_ = num_l;
+      p1_ = num_i * num_j;
+      p2_ = p1_ * num_l;
+      size_ =  ni_ * nj_ * nk_ * nl_;
+      data_ = data;
+    }
+
     ~Tensor4() 
     {
       //std::cout << "- - - - - Tensor4 dtor - - - - - " << std::endl;
       if (data_ != nullptr) {
         //std::cout << "[Tensor4 dtor] delete[] data: " << data_ << std::endl;
-        delete [] data_;
+        if (!data_reference_) {
+          delete [] data_;
+        }
         data_ = nullptr;
        }
      }
@@ -234,6 +251,9 @@ class Tensor4
     {
       //std::cout << "----- Tensor4::erase -----" << std::endl;
       if (data_ != nullptr) {
+        if (data_reference_) {
+          throw std::runtime_error("[Tensor4] Can't clear a Tensor4 with reference data.");
+        }
         //std::cout << "[Tensor4::erase] data_: " << data_ << std::endl;
         delete [] data_;
       }
@@ -256,6 +276,9 @@ class Tensor4
     void resize(const int num_i, const int num_j, const int num_k, const int num_l)
     {
       if (data_ != nullptr) {
+        if (data_reference_) {
+          throw std::runtime_error("[Tensor4] Can't resize a Tensor4 with reference data.");
+        }
         //std::cout << "[Tensor4::resize] data_: " << data_ << std::endl;
         delete [] data_;
         data_ = nullptr;
@@ -313,7 +336,7 @@ class Tensor4
 
     // Compound add assignment. 
     //
-    Tensor4<T> operator+=(const Tensor4<T>& rhs) const
+    Tensor4<T>& operator+=(const Tensor4<T>& rhs)
     {
       for (int i = 0; i < size_; i++) {
         data_[i] += rhs.data_[i];
@@ -323,7 +346,7 @@ class Tensor4
 
     // Compound subtract assignment. 
     //
-    Tensor4<T> operator-=(const Tensor4<T>& rhs) const
+    Tensor4<T>& operator-=(const Tensor4<T>& rhs)
     { 
       for (int i = 0; i < size_; i++) {
         data_[i] -= rhs.data_[i];
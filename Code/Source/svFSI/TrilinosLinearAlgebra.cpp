@@ -47,6 +47,8 @@ class TrilinosLinearAlgebra::TrilinosImpl {
         const Array3<double>& lK, const Array<double>& lR){};
     void initialize(ComMod& com_mod) {};
     void set_preconditioner(consts::PreconditionerType prec_type) {};
+    void set_preconditioner_reuse(const int, const int, const bool) {};
+    std::string preconditioner_status() { return ""; };
     void solve(ComMod& com_mod, eqType& lEq, const Vector<int>& incL, const Vector<double>& res) {};
     void solve_assembled(ComMod& com_mod, eqType& lEq, const Vector<int>& incL, const Vector<double>& res) {};
 };
@@ -108,6 +110,20 @@ void TrilinosLinearAlgebra::assemble(ComMod& com_mod, const int num_elem_nodes,
   }
 }
 
+/// @brief Assemble the local arrays of element 'e' of mesh 'lM'.
+///
+/// Only fsils assembly uses the element index.
+///
+void TrilinosLinearAlgebra::assemble_element(ComMod& com_mod, const mshType& lM, const int e, const int num_elem_nodes, 
+    const Vector<int>& eqN, const Array3<double>& lK, const Array<double>& lR)
+{
+  if (use_fsils_assembly) {
+    fsils_solver->assemble_element(com_mod, lM, e, num_elem_nodes, eqN, lK, lR);
+  } else {
+    impl->assemble(com_mod, num_elem_nodes, eqN, lK, lR);
+  }
+}
+
 /// @brief Check the validity of the precondition and assembly options. 
 /// 
 /// Trilinos can use fsils or trilinos for assembly.
@@ -192,6 +208,24 @@ void TrilinosLinearAlgebra::set_preconditioner(consts::PreconditionerType prec_t
   impl->set_preconditioner(prec_type);
 }
 
+/// @brief Set the preconditioner reuse policy.
+///
+/// The preconditioner is rebuilt every 'rebuild_interval' solves or after a solve 
+/// taking more than 'rebuild_iterations' iterations. Between rebuilds it is reused, 
+/// or its values are recomputed on the existing structure if 'refresh_values' is true.
+//
+void TrilinosLinearAlgebra::set_preconditioner_reuse(const int rebuild_interval, const int rebuild_iterations, 
+    const bool refresh_values)
+{
+  impl->set_preconditioner_reuse(rebuild_interval, rebuild_iterations, refresh_values);
+}
+
+/// @brief Return how the preconditioner was updated for the last solve.
+std::string TrilinosLinearAlgebra::preconditioner_status()
+{
+  return impl->preconditioner_status();
+}
+
 /// @brief Solve a system of linear equations.
 void TrilinosLinearAlgebra::solve(ComMod& com_mod, eqType& lEq, const Vector<int>& incL, const Vector<double>& res)
 {
@@ -45,10 +45,16 @@ class TrilinosLinearAlgebra : public virtual LinearAlgebra {
     virtual void alloc(ComMod& com_mod, eqType& lEq);
     virtual void assemble(ComMod& com_mod, const int num_elem_nodes, const Vector<int>& eqN,
         const Array3<double>& lK, const Array<double>& lR);
+    virtual void assemble_element(ComMod& com_mod, const mshType& lM, const int e, const int num_elem_nodes, 
+        const Vector<int>& eqN, const Array3<double>& lK, const Array<double>& lR);
     virtual void check_options(const consts::PreconditionerType prec_cond_type, const consts::LinearAlgebraType assembly_type);
     virtual void initialize(ComMod& com_mod, eqType& lEq);
     virtual void set_assembly(consts::LinearAlgebraType atype);
     virtual void set_preconditioner(consts::PreconditionerType prec_type);
+    virtual void set_preconditioner_reuse(const int rebuild_interval, const int rebuild_iterations, 
+        const bool refresh_values);
+    virtual std::string preconditioner_status();
+    virtual bool thread_safe_assembly() { return use_fsils_assembly; }
     virtual void solve(ComMod& com_mod, eqType& lEq, const Vector<int>& incL, const Vector<double>& res);
 
   private:
@@ -33,6 +33,7 @@
 
 #include <vtkDoubleArray.h>
 #include "vtkCellData.h"
+#include <vtkDataSetAttributes.h>
 #include <vtkGenericCell.h>
 #include <vtkIntArray.h>
 #include <vtkPointData.h>
@@ -251,6 +252,7 @@ class VtkVtuData::VtkVtuDataImpl {
     void set_point_data(const std::string& data_name, const Vector<int>& data);
 
     void set_points(const Array<double>& points);
+    void set_ghost_points(const Vector<int>& ghost);
     void write(const std::string& file_name);
 
     template<typename T1, typename T2>
@@ -496,6 +498,29 @@ void VtkVtuData::VtkVtuDataImpl::set_points(const Array<double>& points)
   vtk_ugrid->SetPoints(node_coords);
 }
 
+/// @brief Set the vtkGhostType point array, points with a non-zero 'ghost'
+/// value are marked as duplicate points owned by another piece.
+//
+void VtkVtuData::VtkVtuDataImpl::set_ghost_points(const Vector<int>& ghost)
+{
+  int num_vals = ghost.size();
+
+  auto ghost_array = vtkSmartPointer<vtkUnsignedCharArray>::New();
+  ghost_array->SetNumberOfComponents(1);
+  ghost_array->SetNumberOfTuples(num_vals);
+  ghost_array->SetName(vtkDataSetAttributes::GhostArrayName());
+
+  for (int i = 0; i < num_vals; i++) {
+    unsigned char value = 0;
+    if (ghost(i) != 0) {
+      value = vtkDataSetAttributes::DUPLICATEPOINT;
+    }
+    ghost_array->SetValue(i, value);
+  }
+
+  vtk_ugrid->GetPointData()->AddArray(ghost_array);
+}
+
 void VtkVtuData::VtkVtuDataImpl::write(const std::string& file_name)
 {
   auto writer = vtkSmartPointer<vtkXMLUnstructuredGridWriter>::New();
@@ -1045,6 +1070,11 @@ void VtkVtuData::set_points(const Array<double>& points)
   impl->set_points(points);
 }
 
+void VtkVtuData::set_ghost_points(const Vector<int>& ghost)
+{
+  impl->set_ghost_points(ghost);
+}
+
 void VtkVtuData::write()
 {
   impl->write(file_name);
@@ -139,6 +139,8 @@ class VtkVtuData : public VtkData {
     virtual void set_points(const Array<double>& points);
     virtual void write();
 
+    void set_ghost_points(const Vector<int>& ghost);
+
   private:
     class VtkVtuDataImpl;
     VtkVtuDataImpl* impl;
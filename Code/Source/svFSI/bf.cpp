@@ -68,10 +68,10 @@ void bf_construct(ComMod& com_mod, const mshType& lM, const int e, const int eNo
   auto& eq = com_mod.eq[cEq];
   auto& cDmn = com_mod.cDmn;
 
-  Vector<double> N(eNoN); 
-  Array<double> Nx(2,eNoN);
-  Array<double> lR(dof,eNoN);
-  Array3<double> lK(dof*dof,eNoN,eNoN);
+  auto& ws = com_mod.elem_workspace[0];
+  ElementWorkspace::Scope scope(ws);
+  auto lR = ws.array(dof,eNoN);
+  auto lK = ws.array3(dof*dof,eNoN,eNoN);
 
   cDmn = all_fun::domain(com_mod, lM, cEq, e);
   auto cPhys = eq.dmn[cDmn].phys;
@@ -88,19 +88,19 @@ void bf_construct(ComMod& com_mod, const mshType& lM, const int e, const int eNo
   //
   for (int g = 0; g < lM.nG; g++) {
     double w = lM.w(g);
-    Vector<double> N = lM.N.col(g);
-    Array<double> Nx = lM.Nx.slice(g);
+    auto N = lM.N.rcol(g);
+    auto Nx = lM.Nx.rslice(g);
 
     switch (cPhys) {
       case EquationType::phys_shell:
         // [NOTE] passing Array 'bfl' to Vector 'tfl' arg in shell_fp does not work.
-        shells::shell_fp(com_mod, eNoN, w, N, Nx, dl, xl, bfl, lR, lK);
+        shells::shell_fp(com_mod, eNoN, w, N, Nx, dl, xl, bfl, lR, lK, ws);
         //CALL SHELLFP(eNoN, w, N, Nx, dl, xl, bfl, lR, lK)
         //throw std::runtime_error("[bf_construct] Shell follower pressure loads not implemented.");
       break;
 
       case EquationType::phys_CMM:
-        cmm::bcmmi(com_mod, eNoN, idof, w, N, Nx, xl, bfl, lR);
+        cmm::bcmmi(com_mod, eNoN, idof, w, N, Nx, xl, bfl, lR, ws);
       break;
 
       default: 
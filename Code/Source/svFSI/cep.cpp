@@ -57,7 +57,7 @@ void b_cep(ComMod& com_mod, const int eNoN, const double w, const Vector<double>
 // 
 void cep_1d(ComMod& com_mod, CepMod& cep_mod, const int eNoN, const int nFn, const double w,
     const Vector<double>& N, const Array<double>& Nx, const Array<double>& al, const Array<double>& yl,
-    Array<double>& lR, Array3<double>& lK)
+    Array<double>& lR, Array3<double>& lK, ElementWorkspace& ws)
 {
   #define n_debug_cep_1d 
   #ifdef debug_cep_1d 
@@ -89,7 +89,8 @@ void cep_1d(ComMod& com_mod, CepMod& cep_mod, const int eNoN, const int nFn, con
 
   double Td = 0.0;
   double Tx = 0.0;
-  Vector<double> DNx(eNoN);
+  ElementWorkspace::Scope scope(ws);
+  auto DNx = ws.vector(eNoN);
 
   for (int a = 0; a < eNoN; a++) {
     Td = Td + N(a)*al(i,a);
@@ -113,7 +114,8 @@ void cep_1d(ComMod& com_mod, CepMod& cep_mod, const int eNoN, const int nFn, con
 // 
 void cep_2d(ComMod& com_mod, CepMod& cep_mod, const int eNoN, const int nFn, const double w,
     const Vector<double>& N, const Array<double>& Nx, const Array<double>& al, const Array<double>& yl,
-    const Array<double>& dl, const Array<double>& fN, Array<double>& lR, Array3<double>& lK)
+    const Array<double>& dl, const Array<double>& fN, Array<double>& lR, Array3<double>& lK,
+    ElementWorkspace& ws)
 {
   #define n_debug_cep_2d 
   #ifdef debug_cep_2d 
@@ -134,8 +136,19 @@ void cep_2d(ComMod& com_mod, CepMod& cep_mod, const int eNoN, const int nFn, con
   const double dt = com_mod.dt;
   const auto& cem = cep_mod.cem;
 
-  Vector<double> Dani(nFn), Vx(2), Ls(nFn), DVx(2);
-  Array<double> F(2,2), C(2,2), fl(2,nFn), D(2,2), DNx(2,eNoN);
+  ElementWorkspace::Scope scope(ws);
+  auto Dani = ws.vector(nFn);
+  auto Vx = ws.vector(2);
+  auto Ls = ws.vector(nFn);
+  auto DVx = ws.vector(2);
+  auto F = ws.array(2,2);
+  auto Ft = ws.array(2,2);
+  auto FtF = ws.array(2,2);
+  auto C = ws.array(2,2);
+  auto fl = ws.array(2,nFn);
+  auto D = ws.array(2,2);
+  auto DNx = ws.array(2,eNoN);
+  auto Cfi = ws.vector(2);
 
   if (nFn < dmn.cep.nFn) { 
     throw std::runtime_error("[cep_2d] No. of anisotropic conductivies exceed mesh fibers.");
@@ -189,12 +202,15 @@ void cep_2d(ComMod& com_mod, CepMod& cep_mod, const int eNoN, const int nFn, con
     double Jac = mat_fun::mat_det(F, 2);
 
     // Compute Cauchy-Green tensor and its inverse
-    C = mat_mul(transpose(F), F);
-    C = mat_inv(C, 2);
+    transpose(F, Ft);
+    mat_mul(Ft, F, FtF);
+    mat_inv(FtF, 2, C);
 
     // Compute fiber stretch
     for (int i = 0; i < nFn; i++) {
-      Ls(i) = sqrt(utils::norm(fN.col(i), mat_mul(C, fN.col(i))));
+      auto fNi = fN.rcol(i);
+      mat_mul(C, fNi, Cfi);
+      Ls(i) = sqrt(utils::norm(fNi, Cfi));
       for (int j = 0; j < 2; j++) {
         fl(j,i) = fN(j,i) / Ls(i);
       }
@@ -207,8 +223,14 @@ void cep_2d(ComMod& com_mod, CepMod& cep_mod, const int eNoN, const int nFn, con
     // Diffusion tensor - spatial isotropy
     //
     Diso = Diso * Jac;
-    Dani = Dani * Jac;
-    D = Diso * C;
+    for (int i = 0; i < nFn; i++) {
+      Dani(i) = Dani(i) * Jac;
+    }
+    for (int j = 0; j < D.ncols(); j++) {
+      for (int i = 0; i < D.nrows(); i++) {
+        D(i,j) = Diso * C(i,j);
+      }
+    }
 
   } else { 
     D  = 0.0;
@@ -258,7 +280,8 @@ void cep_2d(ComMod& com_mod, CepMod& cep_mod, const int eNoN, const int nFn, con
 // 
 void cep_3d(ComMod& com_mod, CepMod& cep_mod, const int eNoN, const int nFn, const double w,
     const Vector<double>& N, const Array<double>& Nx, const Array<double>& al, const Array<double>& yl,
-    const Array<double>& dl, const Array<double>& fN, Array<double>& lR, Array3<double>& lK)
+    const Array<double>& dl, const Array<double>& fN, Array<double>& lR, Array3<double>& lK,
+    ElementWorkspace& ws)
 {
   #define n_debug_cep_3d 
   #ifdef debug_cep_3d 
@@ -281,8 +304,19 @@ void cep_3d(ComMod& com_mod, CepMod& cep_mod, const int eNoN, const int nFn, con
   const double dt = com_mod.dt;
   const auto& cem = cep_mod.cem;
 
-  Vector<double> Dani(nFn), Vx(3), Ls(nFn), DVx(3);
-  Array<double> F(3,3), C(3,3), fl(3,nFn), D(3,3), DNx(3,eNoN);
+  ElementWorkspace::Scope scope(ws);
+  auto Dani = ws.vector(nFn);
+  auto Vx = ws.vector(3);
+  auto Ls = ws.vector(nFn);
+  auto DVx = ws.vector(3);
+  auto F = ws.array(3,3);
+  auto Ft = ws.array(3,3);
+  auto FtF = ws.array(3,3);
+  auto C = ws.array(3,3);
+  auto fl = ws.array(3,nFn);
+  auto D = ws.array(3,3);
+  auto DNx = ws.array(3,eNoN);
+  auto Cfi = ws.vector(3);
 
   double T1 = eq.af * eq.gam * dt;
   double amd = eq.am / T1;
@@ -342,12 +376,15 @@ void cep_3d(ComMod& com_mod, CepMod& cep_mod, const int eNoN, const int nFn, con
     double Jac = mat_fun::mat_det(F, 3);
 
     // Compute Cauchy-Green tensor and its inverse
-    C = mat_mul(transpose(F), F);
-    C = mat_inv(C, 3);
+    transpose(F, Ft);
+    mat_mul(Ft, F, FtF);
+    mat_inv(FtF, 3, C);
 
     // Compute fiber stretch
     for (int i = 0; i < nFn; i++) {
-      Ls(i) = sqrt(utils::norm(fN.col(i), mat_mul(C, fN.col(i))));
+      auto fNi = fN.rcol(i);
+      mat_mul(C, fNi, Cfi);
+      Ls(i) = sqrt(utils::norm(fNi, Cfi));
       for (int j = 0; j < 3; j++) {
         fl(j,i) = fN(j,i) / Ls(i);
       }
@@ -360,8 +397,14 @@ void cep_3d(ComMod& com_mod, CepMod& cep_mod, const int eNoN, const int nFn, con
     // Diffusion tensor - spatial isotropy
     //
     Diso = Diso * Jac;
-    Dani = Dani * Jac;
-    D = Diso * C;
+    for (int i = 0; i < nFn; i++) {
+      Dani(i) = Dani(i) * Jac;
+    }
+    for (int j = 0; j < D.ncols(); j++) {
+      for (int i = 0; i < D.nrows(); i++) {
+        D(i,j) = Diso * C(i,j);
+      }
+    }
 
   } else {
     D(0,0)  = Diso;
@@ -457,7 +500,7 @@ void construct_cep(ComMod& com_mod, CepMod& cep_mod, const mshType& lM, const Ar
   Array<double> xl(nsd,eNoN), al(tDof,eNoN), yl(tDof,eNoN), dl(tDof,eNoN), 
       fN(nsd,nFn), Nx(insd,eNoN), lR(dof,eNoN);
   Array3<double> lK(dof*dof,eNoN,eNoN);
-  Vector<double>  N(eNoN); 
+  auto& ws = com_mod.elem_workspace[0];
   
   // ECG computation
   Vector<double> pseudo_ECG_proc(cep_mod.ecgleads.num_leads);
@@ -476,6 +519,8 @@ void construct_cep(ComMod& com_mod, CepMod& cep_mod, const mshType& lM, const Ar
       continue;
     }
 
+    ws.reset();
+
     // Update shape functions for NURBS
     //if (lM.eType .EQ. eType_NRB) CALL NRBNNX(lM, e)
 
@@ -509,11 +554,11 @@ void construct_cep(ComMod& com_mod, CepMod& cep_mod, const mshType& lM, const Ar
     lR = 0.0;
     lK = 0.0;
     double Jac{0.0};
-    Array<double> ksix(nsd,nsd);
+    auto ksix = ws.array(nsd,nsd);
 
     for (int g = 0; g < lM.nG; g++) {
       if (g == 0 || !lM.lShpF) {
-        auto Nx_g = lM.Nx.slice(g);
+        auto Nx_g = lM.Nx.rslice(g);
         nn::gnn(eNoN, nsd, insd, Nx_g, xl, Nx, Jac, ksix);
         if (utils::is_zero(Jac)) {
           throw std::runtime_error("[construct_cep] Jacobian for element " + std::to_string(e) + " is < 0.");
@@ -521,7 +566,7 @@ void construct_cep(ComMod& com_mod, CepMod& cep_mod, const mshType& lM, const Ar
       }
 
       double w = lM.w(g) * Jac;
-      N = lM.N.col(g);
+      auto N = lM.N.rcol(g);
 
       #ifdef debug_construct_cep 
       dmsg << "   " << " ";
@@ -534,13 +579,13 @@ void construct_cep(ComMod& com_mod, CepMod& cep_mod, const mshType& lM, const Ar
       #endif
 
       if (insd == 3) {
-        cep_3d(com_mod, cep_mod, eNoN, nFn, w, N, Nx, al, yl, dl, fN, lR, lK);
+        cep_3d(com_mod, cep_mod, eNoN, nFn, w, N, Nx, al, yl, dl, fN, lR, lK, ws);
 
       } else if (insd == 2) {
-        cep_2d(com_mod, cep_mod, eNoN, nFn, w, N, Nx, al, yl, dl, fN, lR, lK);
+        cep_2d(com_mod, cep_mod, eNoN, nFn, w, N, Nx, al, yl, dl, fN, lR, lK, ws);
 
       } else if (insd == 1) {
-        cep_1d(com_mod, cep_mod, eNoN, nFn, w, N, Nx, al, yl, lR, lK);
+        cep_1d(com_mod, cep_mod, eNoN, nFn, w, N, Nx, al, yl, lR, lK, ws);
       }
 
       // ECG computation
@@ -582,7 +627,7 @@ void construct_cep(ComMod& com_mod, CepMod& cep_mod, const mshType& lM, const Ar
     } 
 
     // Assembly
-    eq.linear_algebra->assemble(com_mod, eNoN, ptr, lK, lR);
+    eq.linear_algebra->assemble_element(com_mod, lM, e, eNoN, ptr, lK, lR);
   }
 
   // Communications among processors for ECG leads computation
@@ -39,15 +39,17 @@ void b_cep(ComMod& com_mod, const int eNoN, const double w, const Vector<double>
 
 void cep_1d(ComMod& com_mod, CepMod& cep_mod, const int eNoN, const int nFn, const double w,
     const Vector<double>& N, const Array<double>& Nx, const Array<double>& al, const Array<double>& yl,
-    Array<double>& lR, Array3<double>& lK);
+    Array<double>& lR, Array3<double>& lK, ElementWorkspace& ws);
 
 void cep_2d(ComMod& com_mod, CepMod& cep_mod, const int eNoN, const int nFn, const double w,
     const Vector<double>& N, const Array<double>& Nx, const Array<double>& al, const Array<double>& yl,
-    const Array<double>& dl, const Array<double>& fN, Array<double>& lR, Array3<double>& lK);
+    const Array<double>& dl, const Array<double>& fN, Array<double>& lR, Array3<double>& lK,
+    ElementWorkspace& ws);
 
 void cep_3d(ComMod& com_mod, CepMod& cep_mod, const int eNoN, const int nFn, const double w,
     const Vector<double>& N, const Array<double>& Nx, const Array<double>& al, const Array<double>& yl,
-    const Array<double>& dl, const Array<double>& fN, Array<double>& lR, Array3<double>& lK);
+    const Array<double>& dl, const Array<double>& fN, Array<double>& lR, Array3<double>& lK,
+    ElementWorkspace& ws);
 
 void construct_cep(ComMod& com_mod, CepMod& cep_mod, const mshType& lM, const Array<double>& Ag, 
     const Array<double>& Yg, const Array<double>& Dg);
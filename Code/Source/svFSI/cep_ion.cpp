@@ -33,8 +33,15 @@
 #include "all_fun.h"
 #include "post.h"
 #include "utils.h"
+
+#include <algorithm>
+#include <exception>
 #include <math.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 namespace cep_ion {
 
 /// @brief Modifies:
@@ -55,6 +62,7 @@ void cep_init(Simulation* simulation)
 
   auto& cm = com_mod.cm;
   auto& cep_mod = simulation->cep_mod;
+  cep_mod.dmnNodes.tnNo = -1;
   const int nsd = com_mod.nsd;
   const int tnNo = com_mod.tnNo;
   const int nXion = cep_mod.nXion;
@@ -232,61 +240,44 @@ void cep_integ(Simulation* simulation, const int iEq, const int iDof, const Arra
 
   // Integrate electric potential based on cellular activation model
   //
+  auto& dmnNodes = cep_mod.dmnNodes;
+
+  if (dmnNodes.tnNo != tnNo) {
+    set_dmn_nodes(com_mod, eq, cep_mod);
+  }
+
+  Array<double> Xb;
+  Vector<double> Yb;
+
   if (com_mod.dmnId.size() != 0) {
     Vector<double> sA(tnNo); 
     Array<double> sF(nXion,tnNo); 
     Vector<double> sY(tnNo);
 
-    for (int Ac = 0; Ac < tnNo; Ac++) {
-      if (!all_fun::is_domain(com_mod, eq, Ac, Equation_CEP)) {
-        continue;
-      }
-
-      for (int iDmn = 0; iDmn < eq.nDmn; iDmn++) {
-        auto& dmn = eq.dmn[iDmn];
-        auto cPhys = dmn.phys;
-        int dID = dmn.Id;
-
-        if (cPhys != Equation_CEP || !utils::btest(com_mod.dmnId(Ac),dID)) {
-          continue;
-	}
-
-        int nX = dmn.cep.nX;
-        int nG = dmn.cep.nG;
-        #ifdef debug_cep_integ
-        dmsg << "nX: " << nX ;
-        dmsg << "nG: " << nG ;
-        #endif
-
-        auto Xl = Xion.rows(0,nX-1,Ac);
-
-        // [NOTE] nG can be 0.
-        Vector<double> Xgl;
-        if (nG != 0) {
-          Xgl.resize(nG);
-          for (int i = 0; i < nG; i++) {
-            Xgl(i) = Xion(i+nX,Ac);
-          }
-        }
+    int nDmnNodes = dmnNodes.nodes.size();
 
-        double yl = 0.0;
-        if (cem.cpld) {
-          yl = cem.Ya(Ac);
-        }
+    for (int n = 0; n < nDmnNodes; n++) {
+      auto& nodes = dmnNodes.nodes[n];
+      auto& cep = eq.dmn[dmnNodes.iDmn[n]].cep;
+      int nX = cep.nX;
+      int nG = cep.nG;
+      #ifdef debug_cep_integ
+      dmsg << "nX: " << nX ;
+      dmsg << "nG: " << nG ;
+      #endif
 
-        cep_integ_l(cep_mod, dmn.cep, nX, nG, Xl, Xgl, time-dt, yl, I4f(Ac), dt);
+      cep_integ_nodes(com_mod, cep_mod, cep, nodes, I4f, time-dt, dt, Xb, Yb);
+      int nNodes = nodes.size();
 
+      for (int k = 0; k < nNodes; k++) {
+        int Ac = nodes[k];
         sA(Ac) = sA(Ac) + 1.0;
-        for (int i = 0; i < nX; i++) {
-          sF(i,Ac) += Xl(i);
-        }
-
-        for (int i = 0; i < nG; i++) {
-          sF(nX+i,Ac) += Xgl(i);
+        for (int i = 0; i < nX+nG; i++) {
+          sF(i,Ac) += Xb(i,k);
         }
 
         if (cem.cpld) {
-          sY(Ac) = sY(Ac) + yl;
+          sY(Ac) = sY(Ac) + Yb(k);
         }
       }
     }
@@ -307,40 +298,171 @@ void cep_integ(Simulation* simulation, const int iEq, const int iDof, const Arra
       }
     }
 
-  } else {
+  } else if (dmnNodes.nodes.size() != 0) {
+    auto& nodes = dmnNodes.nodes[0];
+    auto& cep = eq.dmn[0].cep;
+    int nX = cep.nX;
+    int nG = cep.nG;
+
+    cep_integ_nodes(com_mod, cep_mod, cep, nodes, I4f, time-dt, dt, Xb, Yb);
+    int nNodes = nodes.size();
+
+    for (int k = 0; k < nNodes; k++) {
+      int Ac = nodes[k];
+      for (int i = 0; i < nX+nG; i++) {
+        Xion(i,Ac) = Xb(i,k);
+      }
+
+      if (cem.cpld) {
+        cem.Ya(Ac) = Yb(k);
+      }
+    }
+  }
+
+  for (int Ac = 0; Ac < tnNo; Ac++) {
+    Yo(iDof,Ac) = Xion(0,Ac);
+  }
+}
+
+/// @brief Set the lists of nodes integrated by each electrophysiology 
+/// domain of equation 'eq'.
+///
+/// If domain IDs are not defined then all of the nodes of the equation
+/// are integrated with the model of the first domain.
+//
+void set_dmn_nodes(const ComMod& com_mod, const eqType& eq, CepMod& cep_mod)
+{
+  using namespace consts;
+
+  const int tnNo = com_mod.tnNo;
+  auto& dmnNodes = cep_mod.dmnNodes;
+
+  dmnNodes.tnNo = tnNo;
+  dmnNodes.iDmn.clear();
+  dmnNodes.nodes.clear();
+
+  if (com_mod.dmnId.size() == 0) {
+    std::vector<int> nodes;
     for (int Ac = 0; Ac < tnNo; Ac++) {
-      if (!all_fun::is_domain(com_mod, eq, Ac, Equation_CEP)) {
-        continue;
+      if (all_fun::is_domain(com_mod, eq, Ac, EquationType::phys_CEP)) {
+        nodes.push_back(Ac);
       }
+    }
+    dmnNodes.iDmn.push_back(0);
+    dmnNodes.nodes.push_back(nodes);
+    return;
+  }
 
-      int nX = eq.dmn[0].cep.nX;
-      int nG = eq.dmn[0].cep.nG;
-      auto Xl = Xion.rows(0,nX-1,Ac);
-      auto Xgl = Xion.rows(nX,nX+nG-1,Ac);
+  for (int iDmn = 0; iDmn < eq.nDmn; iDmn++) {
+    auto& dmn = eq.dmn[iDmn];
+    if (dmn.phys != EquationType::phys_CEP) {
+      continue;
+    }
 
-      double yl = 0.0;
-      if (cem.cpld) {
-        yl = cem.Ya(Ac);
+    std::vector<int> nodes;
+    for (int Ac = 0; Ac < tnNo; Ac++) {
+      if (all_fun::is_domain(com_mod, eq, Ac, EquationType::phys_CEP) && 
+          utils::btest(com_mod.dmnId(Ac),dmn.Id)) {
+        nodes.push_back(Ac);
       }
+    }
+
+    dmnNodes.iDmn.push_back(iDmn);
+    dmnNodes.nodes.push_back(nodes);
+  }
+}
+
+/// @brief Integrate the state variables of a batch of nodes using the 
+/// model 'cep' from t1 to t1+dt.
+///
+/// The integrated state variables of nodes[k] are returned in column k of 
+/// 'Xb' and the excitation-activation variable in Yb(k). 
+///
+/// The nodes are split among com_mod.cm.nT() OpenMP threads. The cellular 
+/// activation models store intermediate currents in their data members so 
+/// each thread integrates with its own copy of the models.
+//
+void cep_integ_nodes(ComMod& com_mod, CepMod& cep_mod, cepModelType& cep, const std::vector<int>& nodes, 
+    const Vector<double>& I4f, const double t1, const double dt, Array<double>& Xb, Vector<double>& Yb)
+{
+  auto& cem = cep_mod.cem;
+  auto& Xion = cep_mod.Xion;
+  const int nX = cep.nX;
+  const int nG = cep.nG;
+  const int num_nodes = nodes.size();
 
-      cep_integ_l(cep_mod, eq.dmn[0].cep, nX, nG, Xl, Xgl, time-dt, yl, I4f(Ac), dt);
+  Xb.resize(nX+nG, num_nodes);
+  Yb.resize(num_nodes);
 
+  for (int k = 0; k < num_nodes; k++) {
+    int Ac = nodes[k];
+    for (int i = 0; i < nX+nG; i++) {
+      Xb(i,k) = Xion(i,Ac);
+    }
+    Yb(k) = cem.cpld ? cem.Ya(Ac) : 0.0;
+  }
+
+  int num_threads = 1;
+  #ifdef _OPENMP
+  num_threads = std::max(1, std::min(com_mod.cm.nT(), num_nodes));
+  #endif
+
+  std::vector<CepMod> thread_models(num_threads-1);
+
+  for (auto& models : thread_models) {
+    models.cem.cpld = cem.cpld;
+    models.cem.aStress = cem.aStress;
+    models.cem.aStrain = cem.aStrain;
+    models.ap = cep_mod.ap;
+    models.bo = cep_mod.bo;
+    models.fn = cep_mod.fn;
+    models.ttp = cep_mod.ttp;
+  }
+
+  // Exceptions can't propagate out of a parallel region so store the
+  // first one and rethrow it after the region. 
+  std::exception_ptr error = nullptr;
+
+  #pragma omp parallel for num_threads(num_threads) schedule(static)
+  for (int k = 0; k < num_nodes; k++) {
+    try {
+      int tid = 0;
+      #ifdef _OPENMP
+      tid = omp_get_thread_num();
+      #endif
+      auto& models = (tid == 0) ? cep_mod : thread_models[tid-1];
+
+      Vector<double> Xl(nX); 
+      Vector<double> Xgl(nG);
       for (int i = 0; i < nX; i++) {
-        Xion(i,Ac) = Xl(i);
+        Xl(i) = Xb(i,k);
+      }
+      for (int i = 0; i < nG; i++) {
+        Xgl(i) = Xb(nX+i,k);
       }
 
+      double yl = Yb(k);
+
+      cep_integ_l(models, cep, nX, nG, Xl, Xgl, t1, yl, I4f(nodes[k]), dt);
+
+      for (int i = 0; i < nX; i++) {
+        Xb(i,k) = Xl(i);
+      }
       for (int i = 0; i < nG; i++) {
-        Xion(nX+i,Ac) = Xgl(i);
+        Xb(nX+i,k) = Xgl(i);
       }
+      Yb(k) = yl;
 
-      if (cem.cpld) {
-        cem.Ya(Ac) = yl;
+    } catch (...) {
+      #pragma omp critical
+      if (error == nullptr) {
+        error = std::current_exception();
       }
     }
   }
 
-  for (int Ac = 0; Ac < tnNo; Ac++) {
-    Yo(iDof,Ac) = Xion(0,Ac);
+  if (error != nullptr) {
+    std::rethrow_exception(error);
   }
 }
 
@@ -458,6 +580,11 @@ void cep_integ_l(CepMod& cep_mod, cepModelType& cep, int nX, int nG, Vector<doub
             }
           }
         } break; 
+
+        // Rejected in read_cep_domain().
+        case TimeIntegratioType::RL:
+        case TimeIntegratioType::RL2:
+          throw std::runtime_error("[cep_integ_l] Rush-Larsen time integration is not supported for the Aliev-Panfilov model.");
       } 
     } break; 
 
@@ -535,6 +662,50 @@ void cep_integ_l(CepMod& cep_mod, cepModelType& cep, int nX, int nG, Vector<doub
             }
           }
         } break;
+
+        case TimeIntegratioType::RL: {
+          for (int i = 0; i < nt; i++) {
+            double t = t1 + static_cast<double>(i) * cep.dt;
+            double Istim;
+            if (t >= Ts-eps &&  t <= Te+eps) {
+              Istim = cep.Istim.A;
+            } else {
+              Istim = 0.0;
+            }
+
+            cep_mod.bo.integ_rl(cep.imyo, nX, X, cep.dt, Istim, Ksac, RPAR);
+
+            // Electromechanics excitation-activation
+            if (cem.aStress) {
+              double epsX;
+              cep_mod.bo.actv_strs(X(0), cep.dt, yl, epsX);
+            } else if (cem.aStrain) {
+              cep_mod.bo.actv_strn(X(3), I4f, cep.dt, yl);
+            }
+          }
+        } break;
+
+        case TimeIntegratioType::RL2: {
+          for (int i = 0; i < nt; i++) {
+            double t = t1 + static_cast<double>(i) * cep.dt;
+            double Istim;
+            if (t >= Ts-eps &&  t <= Te+eps) {
+              Istim = cep.Istim.A;
+            } else {
+              Istim = 0.0;
+            }
+
+            cep_mod.bo.integ_rl2(cep.imyo, nX, X, cep.dt, Istim, Ksac, RPAR);
+
+            // Electromechanics excitation-activation
+            if (cem.aStress) {
+              double epsX;
+              cep_mod.bo.actv_strs(X(0), cep.dt, yl, epsX);
+            } else if (cem.aStrain) {
+              cep_mod.bo.actv_strn(X(3), I4f, cep.dt, yl);
+            }
+          }
+        } break;
       } 
     } break; 
 
@@ -586,6 +757,11 @@ void cep_integ_l(CepMod& cep_mod, cepModelType& cep, int nX, int nG, Vector<doub
             cep_mod.fn.integ_cn2(nX, X, t, cep.dt, Istim, IPAR, RPAR);
            }
         } break;
+
+        // Rejected in read_cep_domain().
+        case TimeIntegratioType::RL:
+        case TimeIntegratioType::RL2:
+          throw std::runtime_error("[cep_integ_l] Rush-Larsen time integration is not supported for the Fitzhugh-Nagumo model.");
       }
     } break; 
 
@@ -662,6 +838,50 @@ void cep_integ_l(CepMod& cep_mod, cepModelType& cep, int nX, int nG, Vector<doub
             }
           }
         } break;
+
+        case TimeIntegratioType::RL: {
+          for (int i = 0; i < nt; i++) {
+            double t = t1 + static_cast<double>(i) * cep.dt;
+            double Istim;
+            if (t >= Ts-eps &&  t <= Te+eps) {
+              Istim = cep.Istim.A;
+            } else {
+              Istim = 0.0;
+            }
+
+            cep_mod.ttp.integ_rl(cep.imyo, nX, nG, X, Xg, cep.dt, Istim, Ksac, RPAR);
+
+            // Electromechanics excitation-activation
+            if (cem.aStress) {
+              double epsX;
+              cep_mod.ttp.actv_strs(X(3), cep.dt, yl, epsX);
+            } else if (cem.aStrain) {
+              cep_mod.ttp.actv_strn(X(3), I4f, cep.dt, yl);
+            }
+          }
+        } break;
+
+        case TimeIntegratioType::RL2: {
+          for (int i = 0; i < nt; i++) {
+            double t = t1 + static_cast<double>(i) * cep.dt;
+            double Istim;
+            if (t >= Ts-eps &&  t <= Te+eps) {
+              Istim = cep.Istim.A;
+            } else {
+              Istim = 0.0;
+            }
+
+            cep_mod.ttp.integ_rl2(cep.imyo, nX, nG, X, Xg, cep.dt, Istim, Ksac, RPAR);
+
+            // Electromechanics excitation-activation
+            if (cem.aStress) {
+              double epsX;
+              cep_mod.ttp.actv_strs(X(3), cep.dt, yl, epsX);
+            } else if (cem.aStrain) {
+              cep_mod.ttp.actv_strn(X(3), I4f, cep.dt, yl);
+            }
+          }
+        } break;
       }
     } break; 
   } 
@@ -39,6 +39,7 @@
 #include "consts.h"
 
 #include <string>
+#include <vector>
 
 namespace cep_ion {
 
@@ -51,6 +52,11 @@ void cep_integ(Simulation* simulation, const int iEq, const int iDof, const Arra
 void cep_integ_l(CepMod& cep_mod, cepModelType& cep, int nX, int nG, Vector<double>& X, Vector<double>& Xg,
     const double t1, double& yl, const double I4f, const double dt);
 
+void cep_integ_nodes(ComMod& com_mod, CepMod& cep_mod, cepModelType& cep, const std::vector<int>& nodes, 
+    const Vector<double>& I4f, const double t1, const double dt, Array<double>& Xb, Vector<double>& Yb);
+
+void set_dmn_nodes(const ComMod& com_mod, const eqType& eq, CepMod& cep_mod);
+
 };
 
 #endif
@@ -44,7 +44,7 @@ namespace cmm {
 
 void cmm_3d(ComMod& com_mod, const int eNoN, const double w, const Vector<double>& N, const Array<double>& Nx, 
     const Array<double>& al, const Array<double>& yl, const Array<double>& bfl, const Array<double>& Kxi, 
-    Array<double>& lR, Array3<double>& lK)
+    Array<double>& lR, Array3<double>& lK, ElementWorkspace& ws)
 {
   using namespace consts;
 
@@ -65,9 +65,9 @@ void cmm_3d(ComMod& com_mod, const int eNoN, const double w, const Vector<double
   const double ctC = 36.0;
 
   double rho = dmn.prop.at(PhysicalProperyType::fluid_density);
-  Vector<double> f({dmn.prop.at(PhysicalProperyType::f_x), 
-                    dmn.prop.at(PhysicalProperyType::f_y), 
-                    dmn.prop.at(PhysicalProperyType::f_z)});
+  double f[3] = {dmn.prop.at(PhysicalProperyType::f_x), 
+                 dmn.prop.at(PhysicalProperyType::f_y), 
+                 dmn.prop.at(PhysicalProperyType::f_z)};
 
   double T1 = eq.af * eq.gam * dt;
   double amd = eq.am/T1;
@@ -82,10 +82,16 @@ void cmm_3d(ComMod& com_mod, const int eNoN, const double w, const Vector<double
   // Indices are not selected based on the equation only
   // because fluid equation always come first
   //
+  ElementWorkspace::Scope scope(ws);
   double p = 0.0;
-  Vector<double> u(3), px(3);
-  Array<double> ux(3,3);
-  auto ud = -f;
+  auto u = ws.vector(3);
+  auto px = ws.vector(3);
+  auto ux = ws.array(3,3);
+  auto ud = ws.vector(3);
+
+  for (int i = 0; i < 3; i++) {
+    ud(i) = -f[i];
+  }
 
   for (int a = 0; a < eNoN; a++) {
     p = p + N(a)*yl(3,a);
@@ -127,7 +133,7 @@ void cmm_3d(ComMod& com_mod, const int eNoN, const double w, const Vector<double
 
   // Strain rate tensor 2*e_ij := (u_ij + u_ji)
   //
-  Array<double> es(3,3);
+  auto es = ws.array(3,3);
   es(0,0) = ux(0,0) + ux(0,0);
   es(1,0) = ux(1,0) + ux(0,1);
   es(2,0) = ux(2,0) + ux(0,2);
@@ -140,7 +146,7 @@ void cmm_3d(ComMod& com_mod, const int eNoN, const double w, const Vector<double
   es(1,2) = es(2,1);
   es(2,2) = ux(2,2) + ux(2,2);
 
-  Array<double> es_x(3,eNoN);
+  auto es_x = ws.array(3,eNoN);
   for (int a = 0; a < eNoN; a++) {
     es_x(0,a) = es(0,0)*Nx(0,a) + es(1,0)*Nx(1,a) + es(2,0)*Nx(2,a);
     es_x(1,a) = es(0,1)*Nx(0,a) + es(1,1)*Nx(1,a) + es(2,1)*Nx(2,a);
@@ -179,12 +185,12 @@ void cmm_3d(ComMod& com_mod, const int eNoN, const double w, const Vector<double
   double tauM = 1.0 / (rho * sqrt( kT + kU + kS ));
   double tauC = 1.0 / (tauM * (Kxi(0,0) + Kxi(1,1) + Kxi(2,2)));
 
-  Vector<double> rV(3);
+  auto rV = ws.vector(3);
   rV(0) = ud(0) + u(0)*ux(0,0) + u(1)*ux(1,0) + u(2)*ux(2,0);
   rV(1) = ud(1) + u(0)*ux(0,1) + u(1)*ux(1,1) + u(2)*ux(2,1);
   rV(2) = ud(2) + u(0)*ux(0,2) + u(1)*ux(1,2) + u(2)*ux(2,2);
 
-  Vector<double> up(3);
+  auto up = ws.vector(3);
   up(0) = -tauM*(rho*rV(0) + px(0));
   up(1) = -tauM*(rho*rV(1) + px(1));
   up(2) = -tauM*(rho*rV(2) + px(2));
@@ -200,7 +206,7 @@ void cmm_3d(ComMod& com_mod, const int eNoN, const double w, const Vector<double
   }
   tauB = rho / sqrt(tauB);
 
-  Vector<double> ua(3);
+  auto ua = ws.vector(3);
   ua(0) = u(0) + up(0);
   ua(1) = u(1) + up(1);
   ua(2) = u(2) + up(2);
@@ -210,7 +216,7 @@ void cmm_3d(ComMod& com_mod, const int eNoN, const double w, const Vector<double
   rV(1) = tauB*(up(0)*ux(0,1) + up(1)*ux(1,1) + up(2)*ux(2,1));
   rV(2) = tauB*(up(0)*ux(0,2) + up(1)*ux(1,2) + up(2)*ux(2,2));
 
-  Array<double> rM(3,3);
+  auto rM = ws.array(3,3);
   rM(0,0) = mu*es(0,0) - rho*up(0)*ua(0) + rV(0)*up(0) - pa;
   rM(1,0) = mu*es(1,0) - rho*up(0)*ua(1) + rV(0)*up(1);
   rM(2,0) = mu*es(2,0) - rho*up(0)*ua(2) + rV(0)*up(2);
@@ -227,7 +233,9 @@ void cmm_3d(ComMod& com_mod, const int eNoN, const double w, const Vector<double
   rV(1) = ud(1) + ua(0)*ux(0,1) + ua(1)*ux(1,1) + ua(2)*ux(2,1);
   rV(2) = ud(2) + ua(0)*ux(0,2) + ua(1)*ux(1,2) + ua(2)*ux(2,2);
 
-  Vector<double> uNx(eNoN), upNx(eNoN), uaNx(eNoN);
+  auto uNx = ws.vector(eNoN);
+  auto upNx = ws.vector(eNoN);
+  auto uaNx = ws.vector(eNoN);
 
   for (int a = 0; a < eNoN; a++) {
     uNx(a) = u(0)*Nx(0,a)  + u(1)*Nx(1,a)  + u(2)*Nx(2,a);
@@ -289,31 +297,35 @@ void cmm_3d(ComMod& com_mod, const int eNoN, const double w, const Vector<double
 
 void cmm_b(ComMod& com_mod, const faceType& lFa, const int e, const Array<double>& al, const Array<double>& dl, 
     const Array<double>& xl, const Array<double>& bfl, const Vector<double>& pS0l, const Vector<double>& vwp, 
-    const Vector<int>& ptr) 
+    const Vector<int>& ptr, ElementWorkspace& ws) 
 {
   const int nsd  = com_mod.nsd;
   const int dof = com_mod.dof;
   const int cEq = com_mod.cEq;
   const auto& eq = com_mod.eq[cEq];
 
-  Array<double> lR(dof,3);
-  Array3<double> lK(dof*dof,3,3);
+  ElementWorkspace::Scope scope(ws);
+  auto lR = ws.array(dof,3);
+  auto lK = ws.array3(dof*dof,3,3);
 
   // Internal stresses (stiffness) contribution
-  Vector<double> pSl(6);
-  auto Nx = lFa.Nx.slice(0);
-  cmm_stiffness(com_mod, Nx, xl, dl, pS0l, vwp, pSl, lR, lK);
+  auto pSl = ws.vector(6);
+  auto Nx = lFa.Nx.rslice(0);
+  cmm_stiffness(com_mod, Nx, xl, dl, pS0l, vwp, pSl, lR, lK, ws);
 
   // Inertia and body forces (mass) contribution
   //
+  auto nV = ws.vector(nsd);
+
   for (int g = 0; g < lFa.nG; g++) {
-    Vector<double> nV(nsd);
-    auto Nx = lFa.Nx.slice(g);
+    auto Nx = lFa.Nx.rslice(g);
     nn::gnnb(com_mod, lFa, e, g, nsd, nsd-1, 3, Nx, nV);
     double Jac = sqrt(utils::norm(nV));
-    nV = nV / Jac;
+    for (int i = 0; i < nsd; i++) {
+      nV(i) = nV(i) / Jac;
+    }
     double w = lFa.w(g)*Jac;
-    auto N = lFa.N.col(g);
+    auto N = lFa.N.rcol(g);
     cmm_mass(com_mod, w, N, al, bfl, vwp, lR, lK);
   }
 
@@ -321,7 +333,7 @@ void cmm_b(ComMod& com_mod, const faceType& lFa, const int e, const Array<double
 }
 
 void bcmmi(ComMod& com_mod, const int eNoN, const int idof, const double w, const Vector<double>& N, const Array<double>& Nxi, 
-    const Array<double>& xl, const Array<double>& tfl, Array<double>& lR)
+    const Array<double>& xl, const Array<double>& tfl, Array<double>& lR, ElementWorkspace& ws)
 {
   #define n_debug_bcmmi 
   #ifdef debug_bcmmi 
@@ -331,21 +343,27 @@ void bcmmi(ComMod& com_mod, const int eNoN, const int idof, const double w, cons
   #endif
 
   // Get traction vector
-  Vector<double> tfn(idof);
+  ElementWorkspace::Scope scope(ws);
+  auto tfn = ws.vector(idof);
 
   for (int a = 0; a < eNoN; a++) {
-    tfn = tfn + N(a)*tfl.col(a);
+    for (int i = 0; i < idof; i++) {
+      tfn(i) = tfn(i) + N(a)*tfl(i,a);
+    }
   }
 
   // Get surface normal vector (reference configuration)
   //
-  Array<double> xXi(3,2); 
+  auto xXi = ws.array(3,2); 
 
   for (int a = 0; a < eNoN; a++) {
-    xXi.set_col(0, xXi.col(0) + xl.col(a)*Nxi(0,a));
-    xXi.set_col(1, xXi.col(1) + xl.col(a)*Nxi(1,a));
+    for (int i = 0; i < 3; i++) {
+      xXi(i,0) = xXi(i,0) + xl(i,a)*Nxi(0,a);
+      xXi(i,1) = xXi(i,1) + xl(i,a)*Nxi(1,a);
+    }
   }
-  auto nV = utils::cross(xXi);
+  auto nV = ws.vector(3);
+  utils::cross(xXi, nV);
   #ifdef debug_bcmmi 
   dmsg << "nV: " << nV ;
   #endif
@@ -376,7 +394,8 @@ void bcmmi(ComMod& com_mod, const int eNoN, const int idof, const double w, cons
 /// Reproduces Fortran 'CMMI'.
 //
 void cmmi(ComMod& com_mod, const mshType& lM, const Array<double>& al, const Array<double>& dl, const Array<double>& xl,
-    const Array<double>& bfl, const Vector<double>& pS0l, const Vector<double>& vwp, const Vector<int>& ptr)
+    const Array<double>& bfl, const Vector<double>& pS0l, const Vector<double>& vwp, const Vector<int>& ptr,
+    ElementWorkspace& ws)
 {
   #define n_debug_cmmi 
   #ifdef debug_cmmi 
@@ -391,8 +410,9 @@ void cmmi(ComMod& com_mod, const mshType& lM, const Array<double>& al, const Arr
   auto& pSn = com_mod.pSn;
   auto& pSa = com_mod.pSa;
 
-  auto Nxi = lM.Nx.slice(0);
-  Array<double> xXi(3,2); 
+  ElementWorkspace::Scope scope(ws);
+  auto Nxi = lM.Nx.rslice(0);
+  auto xXi = ws.array(3,2); 
 
   for (int a = 0; a < 3; a++) {
     for (int i = 0; i < 3; i++) {
@@ -401,21 +421,24 @@ void cmmi(ComMod& com_mod, const mshType& lM, const Array<double>& al, const Arr
     }
   }
 
-  auto nV = utils::cross(xXi);
+  auto nV = ws.vector(3);
+  utils::cross(xXi, nV);
   auto Jac = sqrt(utils::norm(nV));
-  nV = nV / Jac;
+  for (int i = 0; i < 3; i++) {
+    nV(i) = nV(i) / Jac;
+  }
 
-  Array<double> lR(dof,3); 
-  Array3<double> lK(dof*dof,3,3);
-  Vector<double> pSl(6);
+  auto lR = ws.array(dof,3); 
+  auto lK = ws.array3(dof*dof,3,3);
+  auto pSl = ws.vector(6);
 
   // Internal stresses (stiffness) contribution
-  cmm_stiffness(com_mod, Nxi, xl, dl, pS0l, vwp, pSl, lR, lK);
+  cmm_stiffness(com_mod, Nxi, xl, dl, pS0l, vwp, pSl, lR, lK, ws);
 
   // Inertia and body forces (mass) contribution
   //
   for (int g = 0; g < lM.nG; g++) {
-    auto N = lM.N.col(g);
+    auto N = lM.N.rcol(g);
     double w = lM.w(g)*Jac;
     cmm_mass(com_mod, w, N, al, bfl, vwp, lR, lK);
 
@@ -456,14 +479,14 @@ void cmm_mass(ComMod& com_mod, const double w, const Vector<double>& N, const Ar
   dmsg << "dof: " << dof;
   #endif
 
-  Vector<double> f(3);
+  double f[3];
   double rho = eq.dmn[cDmn].prop.at(PhysicalProperyType::solid_density);
-  f(0) = eq.dmn[cDmn].prop.at(PhysicalProperyType::f_x);
-  f(1) = eq.dmn[cDmn].prop.at(PhysicalProperyType::f_y);
-  f(2) = eq.dmn[cDmn].prop.at(PhysicalProperyType::f_z);
+  f[0] = eq.dmn[cDmn].prop.at(PhysicalProperyType::f_x);
+  f[1] = eq.dmn[cDmn].prop.at(PhysicalProperyType::f_y);
+  f[2] = eq.dmn[cDmn].prop.at(PhysicalProperyType::f_z);
   #ifdef debug_cmm_mass
   dmsg << "rho: " << rho ;
-  dmsg << "f: " << f ;
+  dmsg << "f: " << f[0] << " " << f[1] << " " << f[2];
   dmsg << "cmmVarWall: " << com_mod.cmmVarWall ;
   #endif
 
@@ -480,18 +503,18 @@ void cmm_mass(ComMod& com_mod, const double w, const Vector<double>& N, const Ar
   int i = eq.s;
   int j = i + 1;
   int k = j + 1;
-  auto ud = -f;
+  double ud[3] = {-f[0], -f[1], -f[2]};
 
   for (int a = 0; a < 3; a++) {
-    ud(0) = ud(0) + N(a)*(al(i,a)-bfl(0,a));
-    ud(1) = ud(1) + N(a)*(al(j,a)-bfl(1,a));
-    ud(2) = ud(2) + N(a)*(al(k,a)-bfl(2,a));
+    ud[0] = ud[0] + N(a)*(al(i,a)-bfl(0,a));
+    ud[1] = ud[1] + N(a)*(al(j,a)-bfl(1,a));
+    ud[2] = ud[2] + N(a)*(al(k,a)-bfl(2,a));
   }
 
   for (int a = 0; a < 3; a++) {
-    lR(0,a) = lR(0,a) + wl*N(a)*ud(0);
-    lR(1,a) = lR(1,a) + wl*N(a)*ud(1);
-    lR(2,a) = lR(2,a) + wl*N(a)*ud(2);
+    lR(0,a) = lR(0,a) + wl*N(a)*ud[0];
+    lR(1,a) = lR(1,a) + wl*N(a)*ud[1];
+    lR(2,a) = lR(2,a) + wl*N(a)*ud[2];
   }
 
   for (int b = 0; b < 3; b++) {
@@ -506,7 +529,8 @@ void cmm_mass(ComMod& com_mod, const double w, const Vector<double>& N, const Ar
 
 
 void cmm_stiffness(ComMod& com_mod, const Array<double>& Nxi, const Array<double>& xl, const Array<double>& dl,
-    const Vector<double>& pS0l, const Vector<double>& vwp, Vector<double>& pSl, Array<double>& lR, Array3<double>& lK)
+    const Vector<double>& pS0l, const Vector<double>& vwp, Vector<double>& pSl, Array<double>& lR, Array3<double>& lK,
+    ElementWorkspace& ws)
 {
   static const double kT = 5.0 /6.0;
 
@@ -554,7 +578,8 @@ void cmm_stiffness(ComMod& com_mod, const Array<double>& Nxi, const Array<double
   dmsg << "i: " << i;
   #endif
 
-  Array<double> xXi(3,2);
+  ElementWorkspace::Scope scope(ws);
+  auto xXi = ws.array(3,2);
 
   for (int a = 0; a < 3; a++) { 
     for (int i = 0; i < 3; i++) { 
@@ -563,24 +588,32 @@ void cmm_stiffness(ComMod& com_mod, const Array<double>& Nxi, const Array<double
     }
   }
 
-  auto nV = utils::cross(xXi);
+  auto nV = ws.vector(3);
+  utils::cross(xXi, nV);
   double Jac = sqrt(utils::norm(nV));
-  nV = nV / Jac;
+  for (int i = 0; i < 3; i++) {
+    nV(i) = nV(i) / Jac;
+  }
 
   //  Rotation matrix
   //
-  Array<double> thet(3,3);
-  thet.set_row(0, xXi.col(0) / sqrt(utils::norm(xXi.col(0))));
+  auto thet = ws.array(3,3);
+  auto xXi_0 = xXi.rcol(0);
+  double xXi_0_nrm = sqrt(utils::norm(xXi_0));
+  for (int i = 0; i < 3; i++) {
+    thet(0,i) = xXi_0(i) / xXi_0_nrm;
+  }
   thet.set_row(2, nV);
 
   thet(1,0) = thet(2,1)*thet(0,2) - thet(2,2)*thet(0,1);
   thet(1,1) = thet(2,2)*thet(0,0) - thet(2,0)*thet(0,2);
   thet(1,2) = thet(2,0)*thet(0,1) - thet(2,1)*thet(0,0);
-  auto thetT = mat_fun::transpose(thet);
+  auto thetT = ws.array(3,3);
+  mat_fun::transpose(thet, thetT);
 
   // Define phi matrix
   //
-  Array<double> phi(9,9);
+  auto phi = ws.array(9,9);
 
   for (int i = 0; i < 3; i++) {
     for (int j = 0; j < 3; j++) {
@@ -593,8 +626,8 @@ void cmm_stiffness(ComMod& com_mod, const Array<double>& Nxi, const Array<double
   // Transform the global coordinates into local frame (planar). Copy
   // displacements into a vector.
   //
-  Array<double> xloc(2,3);
-  Vector<double> ul(9);
+  auto xloc = ws.array(2,3);
+  auto ul = ws.vector(9);
 
   for (int a = 0; a < 3; a++) {
     xloc(0,a) = thet(0,0)*xl(0,a) + thet(0,1)*xl(1,a) + thet(0,2)*xl(2,a);
@@ -608,7 +641,7 @@ void cmm_stiffness(ComMod& com_mod, const Array<double>& Nxi, const Array<double
 
   // Transformation Jacobian from local element to parent element
   //
-  Array<double> xlXi(2,2);
+  auto xlXi = ws.array(2,2);
 
   for (int a = 0; a < 3; a++) {
     for (int i = 0; i < 2; i++) {
@@ -619,7 +652,7 @@ void cmm_stiffness(ComMod& com_mod, const Array<double>& Nxi, const Array<double
 
   // Shape function derivatives in local coordinates
   //
-  Array<double> Nxl(2,3);
+  auto Nxl = ws.array(2,3);
 
   for (int a = 0; a < 3; a++) {
     Nxl(0,a) = (Nxi(0,a)*xlXi(1,1) - Nxi(1,a)*xlXi(1,0)) / Jac;
@@ -628,25 +661,27 @@ void cmm_stiffness(ComMod& com_mod, const Array<double>& Nxi, const Array<double
 
   // B matrix
   //
-  Array<double> Bm(5,9);
+  auto Bml = ws.array(5,9);
 
   for (int a = 0; a < 3; a++) {
     int b = a*3;
-    Bm(0,b+0) = Nxl(0,a);
-    Bm(1,b+1) = Nxl(1,a);
+    Bml(0,b+0) = Nxl(0,a);
+    Bml(1,b+1) = Nxl(1,a);
 
-    Bm(2,b+0) = Bm(1,b+1);
-    Bm(2,b+1) = Bm(0,b+0);
-    Bm(3,b+2) = Bm(0,b+0);
-    Bm(4,b+2) = Bm(1,b+1);
+    Bml(2,b+0) = Bml(1,b+1);
+    Bml(2,b+1) = Bml(0,b+0);
+    Bml(3,b+2) = Bml(0,b+0);
+    Bml(4,b+2) = Bml(1,b+1);
   }
 
   // Transform B using phi and compute its transpose
-  Bm  = mat_fun::mat_mul(Bm, phi);
-  auto BmT = mat_fun::transpose(Bm);
+  auto Bm = ws.array(5,9);
+  mat_fun::mat_mul(Bml, phi, Bm);
+  auto BmT = ws.array(9,5);
+  mat_fun::transpose(Bm, BmT);
 
   // Material tensor, D
-  Array<double> Dm(5,5);
+  auto Dm = ws.array(5,5);
   Dm(0,0) = lam;
   Dm(0,1) = lam*nu;
   Dm(2,2) = mu;
@@ -657,10 +692,11 @@ void cmm_stiffness(ComMod& com_mod, const Array<double>& Nxi, const Array<double
   Dm(4,4) = Dm(3,3);
 
   //  D*Bm
-  auto DBm = mat_fun::mat_mul(Dm, Bm);
+  auto DBm = ws.array(5,9);
+  mat_fun::mat_mul(Dm, Bm, DBm);
 
   // Stress tensor in local frame
-  Vector<double> Sl(5);
+  auto Sl = ws.vector(5);
 
   for (int a = 0; a < 9; a++) {
     Sl(0) = Sl(0) + DBm(0,a)*ul(a);
@@ -673,7 +709,8 @@ void cmm_stiffness(ComMod& com_mod, const Array<double>& Nxi, const Array<double
   // If prestress is present, convert into full matrix, and transform
   // into local coordinates, convert back into voigt notation
   //
-  Array<double> pSm(3,3);
+  auto pSm = ws.array(3,3);
+  auto pSt = ws.array(3,3);
   pSm(0,0) = pS0l(0);
   pSm(1,1) = pS0l(1);
   pSm(2,2) = pS0l(2);
@@ -685,10 +722,10 @@ void cmm_stiffness(ComMod& com_mod, const Array<double>& Nxi, const Array<double
   pSm(2,0) = pSm(0,2);
   pSm(2,1) = pSm(1,2);
 
-  pSm = mat_fun::mat_mul(pSm, thetT);
-  pSm = mat_fun::mat_mul(thet, pSm);
+  mat_fun::mat_mul(pSm, thetT, pSt);
+  mat_fun::mat_mul(thet, pSt, pSm);
 
-  Vector<double> S0l(5);
+  auto S0l = ws.vector(5);
   S0l(0) = pSm(0,0);
   S0l(1) = pSm(1,1);
   S0l(2) = pSm(0,1);
@@ -711,8 +748,8 @@ void cmm_stiffness(ComMod& com_mod, const Array<double>& Nxi, const Array<double
     pSm(2,0) = pSm(0,2);
     pSm(2,1) = pSm(1,2);
 
-    pSm = mat_fun::mat_mul(pSm,  thet);
-    pSm = mat_fun::mat_mul(thetT, pSm);
+    mat_fun::mat_mul(pSm,  thet, pSt);
+    mat_fun::mat_mul(thetT, pSt, pSm);
 
     pSl(0) = pSm(0,0);
     pSl(1) = pSm(1,1);
@@ -724,8 +761,10 @@ void cmm_stiffness(ComMod& com_mod, const Array<double>& Nxi, const Array<double
 
   // Internal stress contribution to residual together with prestress
   //
-  Sl = Sl + S0l;
-  Vector<double> BtS(9);
+  for (int i = 0; i < 5; i++) {
+    Sl(i) = Sl(i) + S0l(i);
+  }
+  auto BtS = ws.vector(9);
 
   for (int a = 0; a < 5; a++) {
     BtS(0) = BtS(0) + BmT(0,a)*Sl(a);
@@ -752,7 +791,8 @@ void cmm_stiffness(ComMod& com_mod, const Array<double>& Nxi, const Array<double
   }
 
   // Compute element level global stiffness matrix and remapping
-  auto Ke = mat_fun::mat_mul(BmT, DBm);
+  auto Ke = ws.array(9,9);
+  mat_fun::mat_mul(BmT, DBm, Ke);
   T1 = T1*afl;
 
   for (int a = 0; a < 3; a++) { 
@@ -817,10 +857,11 @@ void construct_cmm(ComMod& com_mod, const mshType& lM, const Array<double>& Ag,
   // CMM init: dof = nsd
   //
   Vector<int> ptr(eNoN);
-  Vector<double> pSl(nsymd), N(eNoN);
+  Vector<double> pSl(nsymd), vwp(2);
   Array<double> xl(nsd,eNoN), al(tDof,eNoN), yl(tDof,eNoN), dl(tDof,eNoN), vwpl(2,eNoN),
                 bfl(nsd,eNoN), pS0l(nsymd,eNoN), Nx(nsd,eNoN), lR(dof,eNoN);
   Array3<double> lK(dof*dof,eNoN,eNoN);
+  auto& ws = com_mod.elem_workspace[0];
 
 
   for (int e = 0; e < lM.nEl; e++) {
@@ -831,6 +872,8 @@ void construct_cmm(ComMod& com_mod, const mshType& lM, const Array<double>& Ag,
       continue;
     }
 
+    ws.reset();
+
     if (cmmInit) {
       if (lM.eType != ElementType::TRI3) {
         throw std::runtime_error("[construct_cmm] CMM initialization is allowed for triangular meshes only");
@@ -861,24 +904,30 @@ void construct_cmm(ComMod& com_mod, const mshType& lM, const Array<double>& Ag,
       }
 
       if (pS0.size() != 0) {
-        pS0l.set_col(a, pS0.col(Ac));
+        pS0l.set_col(a, pS0.rcol(Ac));
       }
 
       if (cmmVarWall) {
-        vwpl.set_col(a, varWallProps.col(Ac));
+        vwpl.set_col(a, varWallProps.rcol(Ac));
       }
     }
 
     if (cmmInit) {
       pSl = 0.0;
-      Vector<double> vwp(2);
+      vwp = 0.0;
       for (int a = 0; a < eNoN; a++) {
-        pSl = pSl + pS0l.col(a);
-        vwp = vwp + vwpl.col(a);
+        for (int i = 0; i < nsymd; i++) {
+          pSl(i) = pSl(i) + pS0l(i,a);
+        }
+        vwp(0) = vwp(0) + vwpl(0,a);
+        vwp(1) = vwp(1) + vwpl(1,a);
+      }
+      for (int i = 0; i < nsymd; i++) {
+        pSl(i) = pSl(i) / static_cast<double>(eNoN);
       }
-      pSl = pSl / static_cast<double>(eNoN);
-      vwp = vwp / static_cast<double>(eNoN);
-      cmmi(com_mod, lM, al, dl, xl, bfl, pSl, vwp, ptr);
+      vwp(0) = vwp(0) / static_cast<double>(eNoN);
+      vwp(1) = vwp(1) / static_cast<double>(eNoN);
+      cmmi(com_mod, lM, al, dl, xl, bfl, pSl, vwp, ptr, ws);
 
     // Gauss integration
     //
@@ -888,20 +937,20 @@ void construct_cmm(ComMod& com_mod, const mshType& lM, const Array<double>& Ag,
       lK = 0.0;
 
       double Jac{0.0};
-      Array<double> ksix(nsd,nsd);
+      auto ksix = ws.array(nsd,nsd);
 
       for (int g = 0; g < lM.nG; g++) {
         if (g == 0 || !lM.lShpF) {
-          auto Nx_g = lM.Nx.slice(g);
+          auto Nx_g = lM.Nx.rslice(g);
           nn::gnn(eNoN, nsd, nsd, Nx_g, xl, Nx, Jac, ksix);
           if (utils::is_zero(Jac)) {
             throw std::runtime_error("[construct_dsolid] Jacobian for element " + std::to_string(e) + " is < 0.");
           }
         }
         double w = lM.w(g) * Jac;
-        N = lM.N.col(g);
+        auto N = lM.N.rcol(g);
 
-        cmm_3d(com_mod, eNoN, w, N, Nx, al, yl, bfl, ksix, lR, lK);
+        cmm_3d(com_mod, eNoN, w, N, Nx, al, yl, bfl, ksix, lR, lK, ws);
       }
 
       eq.linear_algebra->assemble(com_mod, eNoN, ptr, lK, lR);
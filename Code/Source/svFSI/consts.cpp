@@ -217,7 +217,10 @@ const std::set<PreconditionerType> trilinos_preconditioners = {
 /// @brief The list of FSILS preconditioners. 
 const std::set<PreconditionerType> fsils_preconditioners = {
   PreconditionerType::PREC_FSILS,
-  PreconditionerType::PREC_RCS
+  PreconditionerType::PREC_RCS,
+  PreconditionerType::PREC_FSILS_AMG,
+  PreconditionerType::PREC_FSILS_BILU,
+  PreconditionerType::PREC_FSILS_BLOCK_JACOBI
 };
 
 /// @brief The list of PETSc preconditioners. 
@@ -233,6 +236,9 @@ const std::map<std::string,PreconditionerType> preconditioner_name_to_type =
   {"none", PreconditionerType::PREC_NONE},
 
   {"fsils", PreconditionerType::PREC_FSILS},
+  {"fsils-amg", PreconditionerType::PREC_FSILS_AMG},
+  {"fsils-ilu", PreconditionerType::PREC_FSILS_BILU},
+  {"fsils-blockjacobi", PreconditionerType::PREC_FSILS_BLOCK_JACOBI},
   {"rcs", PreconditionerType::PREC_RCS},
   {"row-column-scaling", PreconditionerType::PREC_RCS},
 
@@ -252,6 +258,9 @@ const std::map<std::string,PreconditionerType> preconditioner_name_to_type =
 //
 const std::map<PreconditionerType, std::string> preconditioner_type_to_name {
   {PreconditionerType::PREC_FSILS, "fsils"}, 
+  {PreconditionerType::PREC_FSILS_AMG, "fsils-amg"}, 
+  {PreconditionerType::PREC_FSILS_BILU, "fsils-ilu"}, 
+  {PreconditionerType::PREC_FSILS_BLOCK_JACOBI, "fsils-blockjacobi"}, 
   {PreconditionerType::PREC_NONE, "none"}, 
   {PreconditionerType::PREC_RCS, "row-column-scaling"}, 
   {PreconditionerType::PREC_TRILINOS_DIAGONAL, "trilinos-diagonal"}, 
@@ -276,6 +285,9 @@ const std::map<std::string,SolverType> solver_name_to_type
 
   {"gmres", SolverType::lSolver_GMRES},
 
+  {"pipelined-gmres", SolverType::lSolver_PGMRES},
+  {"pgmres", SolverType::lSolver_PGMRES},
+
   {"conjugate-gradient", SolverType::lSolver_CG},
   {"cg", SolverType::lSolver_CG},
 
@@ -35,6 +35,9 @@
 #include "lhsa.h"
 #include "nn.h"
 #include "utils.h"
+#include "SpatialIndex.h"
+
+#include <algorithm>
 #include <math.h>
 
 namespace contact {
@@ -142,82 +145,61 @@ void construct_contact_pnlty(ComMod& com_mod, CmMod& cm_mod, const Array<double>
     }
   }
 
-  // Create a bounding box around possible region of contact and bin
-  // the box with neighboring nodes
+  // Find the nodes of other shell meshes lying within the contact 
+  // distance of each shell node using a k-d tree over the deformed 
+  // shell nodes. 
   //
-  int maxNnb = 15;
-  label_101: maxNnb = maxNnb + 5;
+  int nShlNo = 0;
+
+  for (int iM = 0; iM < com_mod.nMsh; iM++) {
+    if (com_mod.msh[iM].lShl) {
+      nShlNo += com_mod.msh[iM].nNo;
+    }
+  }
 
-  Array<int> bBox(maxNnb,tnNo);
-  bBox = -1;
+  Array<double> xShl(nsd,nShlNo);
+  std::vector<int> shlNode(nShlNo), shlMesh(nShlNo);
+  int n = 0;
 
   for (int iM = 0; iM < com_mod.nMsh; iM++) {
     auto& msh = com_mod.msh[iM];
-
     if (!msh.lShl) {
       continue;
     }
 
-    Vector<double> x1(nsd), xmin(nsd), xmax(nsd);
-
-    for (int a = 0; a < msh.nNo; a++) {
+    for (int a = 0; a < msh.nNo; a++, n++) {
       int Ac = msh.gN(a);
-      x1(0) = com_mod.x(0,Ac) + Dg(i,Ac);
-      x1(1) = com_mod.x(1,Ac) + Dg(j,Ac);
-      x1(2) = com_mod.x(2,Ac) + Dg(k,Ac);
-
-      // Box limits for each node
-      xmin = x1 - cntctM.c;
-      xmax = x1 + cntctM.c;
-
-      // Load the box with neighboring nodes lying within it
-      //
-      for (int jM = 0; jM < com_mod.nMsh; jM++) {
-        auto& msh_jM = com_mod.msh[jM];
-        if (iM == jM || !msh_jM.lShl) {
-          continue;
-        }
+      xShl(0,n) = com_mod.x(0,Ac) + Dg(i,Ac);
+      xShl(1,n) = com_mod.x(1,Ac) + Dg(j,Ac);
+      xShl(2,n) = com_mod.x(2,Ac) + Dg(k,Ac);
+      shlNode[n] = Ac;
+      shlMesh[n] = iM;
+    }
+  }
 
-        Vector<double> x2(nsd); 
-
-        for (int b = 0; b < msh_jM.nNo; b++) {
-          int Bc = msh_jM.gN(b);
-          x2(0) = com_mod.x(0,Bc) + Dg(i,Bc);
-          x2(1) = com_mod.x(1,Bc) + Dg(j,Bc);
-          x2(2) = com_mod.x(2,Bc) + Dg(k,Bc);
-
-          if ((x2(0) >= xmin(0)) && (x2(0) <= xmax(0)) && (x2(1) >= xmin(1)) && (x2(1) <= xmax(1)) && 
-              (x2(2) >= xmin(2)) && (x2(2) <= xmax(2))) {
-
-            int l = 0;
-
-            for (int i = 0; i < maxNnb; i++, l++) {
-              if (bBox(l,Ac) == -1) {
-                bBox(l,Ac) = Bc;
-                break; 
-              }
-              if (Bc > bBox(l,Ac)) {
-                continue;
-              }
-
-              if (Bc == bBox(l,Ac)) {
-                break;
-              } 
-
-              if (bBox(maxNnb-1,Ac) != -1) goto label_101;
-
-              for (int m = maxNnb-1; m >= l; m--) {
-                bBox(m,Ac) = bBox(m-1,Ac);
-              }
-              bBox(l,Ac) = Bc;
-              break; 
-            }
-            if (l > maxNnb-1) goto label_101;
-          }
-        } // b
-      } // jM
-    } // a
-  } // iM
+  PointTree shlTree;
+  shlTree.build(xShl);
+
+  // Neighbors of each node, sorted by node ID.
+  std::vector<std::vector<int>> nbNodes(tnNo);
+  std::vector<int> found;
+
+  for (int a = 0; a < nShlNo; a++) {
+    found.clear();
+    shlTree.find_in_radius(xShl.col_data(a), cntctM.c, found);
+    auto& nb = nbNodes[shlNode[a]];
+
+    for (int b : found) {
+      if (shlMesh[b] != shlMesh[a]) {
+        nb.push_back(shlNode[b]);
+      }
+    }
+  }
+
+  for (auto& nb : nbNodes) {
+    std::sort(nb.begin(), nb.end());
+    nb.erase(std::unique(nb.begin(), nb.end()), nb.end());
+  }
 
   // Check if any node is strictly involved in contact and compute
   // corresponding penalty forces assembled to the residual
@@ -227,7 +209,7 @@ void construct_contact_pnlty(ComMod& com_mod, CmMod& cm_mod, const Array<double>
   Vector<double> x1(nsd), x2(nsd);
 
   for (int Ac = 0; Ac < tnNo; Ac++) {
-    if (bBox(0,Ac) == -1) {
+    if (nbNodes[Ac].size() == 0) {
       continue; 
     }
     x1(0) = com_mod.x(0,Ac) + Dg(i,Ac);
@@ -236,11 +218,7 @@ void construct_contact_pnlty(ComMod& com_mod, CmMod& cm_mod, const Array<double>
     auto nV1 = sF.rcol(Ac);
     int nNb = 0;
 
-    for (int a = 0; a < maxNnb; a++) {
-      int Bc = bBox(a,Ac);
-      if (Bc == -1) {
-        continue; 
-      }
+    for (int Bc : nbNodes[Ac]) {
       x2(0) = com_mod.x(0,Bc) + Dg(i,Bc);
       x2(1) = com_mod.x(1,Bc) + Dg(j,Bc);
       x2(2) = com_mod.x(2,Bc) + Dg(k,Bc);
@@ -49,7 +49,7 @@ extern "C" {
 int split_(int *nElptr, int *eNoNptr, int *eNoNbptr, int *IEN, int *nPartsPtr, int *iElmdist, float *iWgt, int *part);
 
 };
- 
+
 /// @brief Partition and distribute data across processors.
 ///
 /// This function replicates the Fortran 'SUBROUTINE DISTRIBUTE' in DISTRIBUTE.f.
@@ -84,6 +84,7 @@ void distribute(Simulation* simulation)
     cm.bcast(cm_mod, &com_mod.nMsh);
     cm.bcast(cm_mod, &com_mod.nsd);
     cm.bcast(cm_mod, &com_mod.rmsh.isReqd);
+    cm.bcast(cm_mod, com_mod.partCacheDir);
   } 
 
   cm.bcast(cm_mod, &com_mod.gtnNo);
@@ -172,6 +173,39 @@ void distribute(Simulation* simulation)
   dmsg << "wgt: " << wgt;
   #endif
 
+  // Check the partition cache for the distributed meshes and faces of 
+  // this processor saved by a previous run with the same meshes and 
+  // number of processors (see partition_cache.h). The cache is not used
+  // when remeshing.
+  //
+  partition_cache::CacheReader cacheReader;
+  partition_cache::CacheWriter cacheWriter;
+  com_mod.partCachePath.clear();
+
+  if (!cm.seq() && !com_mod.partCacheDir.empty() && !com_mod.resetSim && !com_mod.rmsh.isReqd) {
+    std::string hash;
+    if (cm.mas(cm_mod)) {
+      hash = partition_cache::mesh_hash(com_mod, wgt);
+    }
+    cm.bcast(cm_mod, hash);
+
+    if (!hash.empty()) {
+      com_mod.partCachePath = com_mod.partCacheDir + "/" + hash + "_" + std::to_string(num_proc) + "-procs";
+      int found = cacheReader.open(partition_cache::file_name(com_mod.partCachePath, "mesh", cm.idcm()));
+      if (cm.reduce(cm_mod, found, MPI_MIN) == 0) {
+        cacheReader.close();
+      }
+    }
+  }
+
+  bool cached = cacheReader.is_open();
+  auto reader = cached ? &cacheReader : nullptr;
+  auto writer = (!cached && !com_mod.partCachePath.empty()) ? &cacheWriter : nullptr;
+  #ifdef debug_distribute
+  dmsg << "partCachePath: " << com_mod.partCachePath;
+  dmsg << "cached: " << cached;
+  #endif
+
   for (int iM = 0; iM < nMsh; iM++) {
     #ifdef debug_distribute
     dmsg << "          " << " ";
@@ -184,7 +218,7 @@ void distribute(Simulation* simulation)
     #ifdef debug_distribute
     dmsg << "iWgt: " << iWgt;
     #endif
-    part_msh(simulation, iM, com_mod.msh[iM], gmtl, num_proc, iWgt);
+    part_msh(simulation, iM, com_mod.msh[iM], gmtl, num_proc, iWgt, reader, writer);
   }
 
   // Setting gtl pointer in case that it is needed and mapping IEN.
@@ -265,7 +299,10 @@ void distribute(Simulation* simulation)
 
   // Partitioning the faces
   //
-  // tMs is a temporary variable to keep fa%gN of the old meshes.
+  // tMs is a temporary variable to keep the global faces of the old 
+  // meshes. Only fa%nNo and fa%lN, the positions in the global face of 
+  // the face nodes on this processor, are set when the faces are read 
+  // from the partition cache.
   //
   #ifdef debug_distribute
   dmsg << " " << " ";
@@ -279,10 +316,15 @@ void distribute(Simulation* simulation)
 
     for (int iFa = 0; iFa < msh.nFa; iFa++) {
       auto& face = msh.fa[iFa];
-      part_face(simulation, msh, face, tMs[iM].fa[iFa], gmtl);
+      part_face(simulation, msh, face, tMs[iM].fa[iFa], gmtl, reader, writer);
     }
   }
 
+  if (writer != nullptr) {
+    cacheWriter.save(partition_cache::file_name(com_mod.partCachePath, "mesh", cm.idcm()));
+  }
+  cacheReader.close();
+
   #ifdef debug_distribute
   dmsg << " " << " ";
   dmsg << "Sending data read by master to slaves " << " ...";
@@ -301,6 +343,8 @@ void distribute(Simulation* simulation)
     cm.bcast(cm_mod, &com_mod.saveATS);
     cm.bcast(cm_mod, &com_mod.saveAve);
     cm.bcast(cm_mod, &com_mod.saveVTK);
+    cm.bcast(cm_mod, &com_mod.savePVTU);
+    cm.bcast(cm_mod, com_mod.saveName);
     cm.bcast(cm_mod, &com_mod.bin2VTK);
 
     cm.bcast(cm_mod, &com_mod.mvMsh);
@@ -687,23 +731,19 @@ void dist_bc(ComMod& com_mod, const CmMod& cm_mod, const cmType& cm, bcType& lBc
 
     cm.bcast(cm_mod, tmp);
 
-    // This is the new number of nodes
+    // This is the new number of nodes, a global face node position lN(b) 
+    // for each of them.
     a = com_mod.msh[lBc.iM].fa[lBc.iFa].nNo;
     lBc.gm.d.resize(iDof, a, nTp);
-    int b = 0;
-
-    for (int a = 0; a < nNo; a++) {
-      int Ac = tMs[lBc.iM].fa[lBc.iFa].gN[a];
-      Ac = gmtl[Ac];
-      if (Ac != -1) {
-        for (int i = 0; i < nTp; i++) {
-          int j = iDof * (i*nNo + a);
-          for (int k = 0; k < iDof; k++) {
-            lBc.gm.d(k,b,i) = tmp[k+j];
-          }
-        } 
-        b = b + 1;
-      }
+    auto& lN = tMs[lBc.iM].fa[lBc.iFa].lN;
+
+    for (int b = 0; b < a; b++) {
+      for (int i = 0; i < nTp; i++) {
+        int j = iDof * (i*nNo + lN[b]);
+        for (int k = 0; k < iDof; k++) {
+          lBc.gm.d(k,b,i) = tmp[k+j];
+        }
+      } 
     }
   }
 
@@ -725,14 +765,9 @@ void dist_bc(ComMod& com_mod, const CmMod& cm_mod, const cmType& cm, bcType& lBc
     // This is the new number of nodes
     int a = com_mod.msh[lBc.iM].fa[lBc.iFa].nNo;
     lBc.gx.resize(a);
-    int b = 0;
-    for (int a = 0; a < nNo; a++) {
-      int Ac = tMs[lBc.iM].fa[lBc.iFa].gN[a];
-      Ac = gmtl[Ac];
-      if (Ac != -1) {
-        lBc.gx[b] = tmp[a];
-        b = b + 1;
-      }
+    auto& lN = tMs[lBc.iM].fa[lBc.iFa].lN;
+    for (int b = 0; b < a; b++) {
+      lBc.gx[b] = tmp[lN[b]];
     }
   }
 
@@ -990,12 +1025,16 @@ void dist_eq(ComMod& com_mod, const CmMod& cm_mod, const cmType& cm, const std::
   cm.bcast(cm_mod, &lEq.FSILS.RI.sD);
   cm.bcast(cm_mod, &lEq.FSILS.GM.sD);
   cm.bcast(cm_mod, &lEq.FSILS.CG.sD);
+  cm.bcast(cm_mod, &lEq.FSILS.GM.pipelined);
 
   cm.bcast_enum(cm_mod, &lEq.ls.LS_type);
 
   cm.bcast_enum(cm_mod, &lEq.linear_algebra_type);
   cm.bcast_enum(cm_mod, &lEq.linear_algebra_preconditioner);
   cm.bcast_enum(cm_mod, &lEq.linear_algebra_assembly_type);
+  cm.bcast(cm_mod, &lEq.linear_algebra_rebuild_interval);
+  cm.bcast(cm_mod, &lEq.linear_algebra_rebuild_iterations);
+  cm.bcast(cm_mod, &lEq.linear_algebra_refresh_values);
 
   cm.bcast(cm_mod, &lEq.ls.relTol);
   cm.bcast(cm_mod, &lEq.ls.absTol);
@@ -1237,7 +1276,8 @@ void dist_visc_model(const ComMod& com_mod, const CmMod& cm_mod, const cmType& c
 }
 
 
-void part_face(Simulation* simulation, mshType& lM, faceType& lFa, faceType& gFa, Vector<int>& gmtl)
+void part_face(Simulation* simulation, mshType& lM, faceType& lFa, faceType& gFa, Vector<int>& gmtl,
+    partition_cache::CacheReader* cacheReader, partition_cache::CacheWriter* cacheWriter)
 {
   #ifdef debug_part_face
   DebugMsg dmsg(__func__, com_mod.cm.idcm());
@@ -1296,11 +1336,11 @@ void part_face(Simulation* simulation, mshType& lM, faceType& lFa, faceType& gFa
   int eNoNb = gFa.eNoN;
   int iM = gFa.iM;
 
-  gFa.IEN.resize(eNoNb, gFa.nEl);
-  gFa.gE.resize(gFa.nEl);
-  gFa.gN.resize(gFa.nNo);
-
-  Vector<int> ePtr(gFa.nEl);
+  if (cacheReader == nullptr) {
+    gFa.IEN.resize(eNoNb, gFa.nEl);
+    gFa.gE.resize(gFa.nEl);
+    gFa.gN.resize(gFa.nNo);
+  }
 
   // [NOTE Not sure about destroying the 'lFa' passed in parameter.
   //
@@ -1317,6 +1357,21 @@ void part_face(Simulation* simulation, mshType& lM, faceType& lFa, faceType& gFa
 
   nn::select_eleb(simulation, lM, lFa);
   lFa.iM = iM;
+  lFa.gnEl = gFa.gnEl;
+
+  // Reading the face of this processor from the partition cache.
+  //
+  if (cacheReader != nullptr) {
+    lFa.nEl = cacheReader->read<int>();
+    lFa.nNo = cacheReader->read<int>();
+    cacheReader->read(lFa.gE);
+    cacheReader->read(lFa.IEN);
+    cacheReader->read(lFa.gN);
+    cacheReader->read(gFa.lN);
+    return;
+  }
+
+  Vector<int> ePtr(gFa.nEl);
 
   // Be careful with 'i', it seems to be the number of something 
   // and not a counter.
@@ -1401,17 +1456,28 @@ void part_face(Simulation* simulation, mshType& lM, faceType& lFa, faceType& gFa
     }
   }
 
-  // Analogously copying the nodes which belong to this processor
+  // Analogously copying the nodes which belong to this processor, 
+  // gFa.lN keeps their positions in the global face for dist_bc().
+  //
+  gFa.lN.resize(lFa.nNo);
   j = 0;
   for (int a = 0; a < gFa.nNo; a++) {
     int Ac = gmtl(gFa.gN[a]);
     if (Ac != -1) {
       lFa.gN[j] = Ac;
+      gFa.lN[j] = a;
       j = j + 1;
     }
   }
 
-  lFa.gnEl = gFa.gnEl;
+  if (cacheWriter != nullptr) {
+    cacheWriter->write(lFa.nEl);
+    cacheWriter->write(lFa.nNo);
+    cacheWriter->write(lFa.gE);
+    cacheWriter->write(lFa.IEN);
+    cacheWriter->write(lFa.gN);
+    cacheWriter->write(gFa.lN);
+  }
 
   if (com_mod.rmsh.isReqd) {
     if (cm.mas(cm_mod)) {
@@ -1435,6 +1501,143 @@ void part_face(Simulation* simulation, mshType& lM, faceType& lFa, faceType& gFa
 }
 
 
+/// @brief Reorder the columns of lM.gIEN to the new element numbering 
+/// lM.otnIEN, following the cycles of the permutation in place.
+//
+static void reorder_gien(mshType& lM)
+{
+  std::vector<bool> moved(lM.gnEl, false);
+  Vector<int> col(lM.eNoN);
+  Vector<int> tmp(lM.eNoN);
+
+  for (int e = 0; e < lM.gnEl; e++) {
+    if (moved[e]) {
+      continue;
+    }
+    col = lM.gIEN.col(e);
+    int Ac = e;
+    do {
+      int Ec = lM.otnIEN[Ac];
+      tmp = lM.gIEN.col(Ec);
+      lM.gIEN.set_col(Ec, col);
+      moved[Ec] = true;
+      col = tmp;
+      Ac = Ec;
+    } while (Ac != e);
+  }
+}
+
+/// @brief Distribute the precomputed state-variable data lM.Ys, if any.
+//
+static void dist_ys(ComMod& com_mod, const CmMod& cm_mod, mshType& lM)
+{
+  auto& cm = com_mod.cm;
+  bool flag = (lM.Ys.size() != 0);
+  cm.bcast(cm_mod, &flag);
+
+  if (flag){
+    Array3<double> tmpYs;
+    int nsYs = lM.Ys.nslices();
+    if (cm.mas(cm_mod)) {
+      tmpYs.resize(lM.Ys.nrows(), lM.Ys.ncols(), nsYs);
+      tmpYs = lM.Ys;
+      lM.Ys.clear();
+    } else {
+      tmpYs.clear();
+    }
+    lM.Ys.resize(com_mod.nsd, com_mod.tnNo, nsYs);
+    lM.Ys = all_fun::local(com_mod, cm_mod, cm, tmpYs);
+    tmpYs.clear();
+  }
+}
+
+/// @brief Save the mesh of this processor set by part_msh() to the 
+/// partition cache: the element distribution, the local connectivity, 
+/// the node map lM.gN, the element IDs and fiber directions and the nodes 
+/// added by this mesh, ltg(com_mod.tnNo:tnNo-1). The master also saves lM.otnIEN used 
+/// to reorder lM.gIEN.
+//
+static void write_cached_msh(const ComMod& com_mod, const CmMod& cm_mod, const mshType& lM, const int tnNo, 
+    partition_cache::CacheWriter& writer)
+{
+  writer.write(lM.eDist);
+  writer.write(lM.nEl);
+  writer.write(lM.nNo);
+  writer.write(lM.IEN);
+  writer.write(lM.gN);
+
+  bool flag = (lM.eId.size() != 0);
+  writer.write(flag);
+  if (flag) {
+    writer.write(lM.eId);
+  }
+
+  flag = (lM.fN.size() != 0);
+  writer.write(flag);
+  if (flag) {
+    writer.write(lM.fN);
+  }
+
+  Vector<int> ltg(tnNo - com_mod.tnNo);
+  for (int a = 0; a < ltg.size(); a++) {
+    ltg[a] = com_mod.ltg[com_mod.tnNo + a];
+  }
+  writer.write(ltg);
+
+  if (com_mod.cm.mas(cm_mod)) {
+    writer.write(lM.otnIEN);
+  }
+}
+
+/// @brief Read the mesh of this processor saved by write_cached_msh() 
+/// and set the global to local map gmtl.
+//
+static void read_cached_msh(ComMod& com_mod, const CmMod& cm_mod, mshType& lM, Vector<int>& gmtl, 
+    partition_cache::CacheReader& reader)
+{
+  reader.read(lM.eDist);
+  lM.nEl = reader.read<int>();
+  lM.nNo = reader.read<int>();
+  reader.read(lM.IEN);
+  reader.read(lM.gN);
+
+  if (reader.read<bool>()) {
+    reader.read(lM.eId);
+  }
+
+  if (reader.read<bool>()) {
+    reader.read(lM.fN);
+  }
+
+  Vector<int> ltg;
+  reader.read(ltg);
+
+  int tnNo = com_mod.tnNo;
+  Vector<int> tmpI(com_mod.ltg);
+  com_mod.ltg.resize(tnNo + ltg.size());
+  for (int a = 0; a < tnNo; a++) {
+    com_mod.ltg[a] = tmpI[a];
+  }
+  for (int a = 0; a < ltg.size(); a++) {
+    com_mod.ltg[tnNo + a] = ltg[a];
+  }
+  com_mod.tnNo = tnNo + ltg.size();
+
+  gmtl = -1;
+  for (int a = 0; a < com_mod.tnNo; a++) {
+    gmtl[com_mod.ltg[a]] = a;
+  }
+
+  if (com_mod.cm.mas(cm_mod)) {
+    reader.read(lM.otnIEN);
+    reorder_gien(lM);
+  } else {
+    lM.otnIEN.clear();
+  }
+
+  lM.iGC.resize(lM.nEl);
+}
+
 /// @brief Reproduces the Fortran 'PARTMSH' subroutine.
 /// Parameters for the part_msh function:
 /// @param[in] simulation A pointer to the simulation object.
@@ -1443,8 +1646,11 @@ void part_face(Simulation* simulation, mshType& lM, faceType& lFa, faceType& gFa
 /// @param[in] gmtl The global to local map.
 /// @param[in] nP The number of processors.
 /// @param[in] wgt The weights.
+/// @param[in] cacheReader The partition cache to read the mesh from, or nullptr.
+/// @param[in] cacheWriter The partition cache to save the mesh to, or nullptr.
 //
-void part_msh(Simulation* simulation, int iM, mshType& lM, Vector<int>& gmtl, int nP, Vector<float>& wgt)
+void part_msh(Simulation* simulation, int iM, mshType& lM, Vector<int>& gmtl, int nP, Vector<float>& wgt,
+    partition_cache::CacheReader* cacheReader, partition_cache::CacheWriter* cacheWriter)
 {
   auto& cm_mod = simulation->cm_mod;
   auto& com_mod = simulation->com_mod;
@@ -1528,6 +1734,14 @@ void part_msh(Simulation* simulation, int iM, mshType& lM, Vector<int>& gmtl, in
     lM.fa.resize(lM.nFa);
   }
 
+  // Reading the mesh of this processor from the partition cache.
+  //
+  if (cacheReader != nullptr) {
+    read_cached_msh(com_mod, cm_mod, lM, gmtl, *cacheReader);
+    dist_ys(com_mod, cm_mod, lM);
+    return;
+  }
+
   Vector<int> sCount(num_proc); 
   Vector<int> disp(num_proc); 
 
@@ -1623,6 +1837,20 @@ void part_msh(Simulation* simulation, int iM, mshType& lM, Vector<int>& gmtl, in
   if (fp) fclose(fp);
   #endif
 
+  // Scattering the lM.gIEN array to all processors, each processor 
+  // gets the contiguous block of elements lM.eDist(i):lM.eDist(i+1). 
+  //
+  #ifdef dbg_part_msh
+  dmsg << " " << " ";
+  dmsg << "Scattering the lM%gIEN array to processors " << " ... ";
+  dmsg << "sCount: " << sCount;
+  dmsg << "disp: " << disp;
+  #endif
+  lM.IEN.resize(eNoN, nEl);
+
+  MPI_Scatterv(lM.gIEN.data(), sCount.data(), disp.data(), cm_mod::mpint, lM.IEN.data(), 
+      nEl*eNoN, cm_mod::mpint, cm_mod.master, cm.com());
+
   if (lM.eType == consts::ElementType::NRB) {
     part = cm.id();
 
@@ -1648,26 +1876,9 @@ void part_msh(Simulation* simulation, int iM, mshType& lM, Vector<int>& gmtl, in
     dmsg << "---------- " << "---------- ";
     #endif
 
-  // Scattering the lM.gIEN array to all processors.
+  // Partitioning the distributed element blocks.
   //
   } else { 
-    #ifdef dbg_part_msh
-    dmsg << " " << " ";
-    dmsg << " " << " ";
-    dmsg << "Scattering the lM%gIEN array to processors " << " ... ";
-    #endif
-    lM.IEN.resize(eNoN, nEl);
-
-    // Send lM.gIEN array to all processor's lM.IEN[] array of siize nEl*eNoN.
-    //
-    #ifdef dbg_part_msh
-    dmsg << "sCount: " << sCount;
-    dmsg << "disp: " << disp;
-    #endif
-
-    MPI_Scatterv(lM.gIEN.data(), sCount.data(), disp.data(), cm_mod::mpint, lM.IEN.data(), 
-        nEl*eNoN, cm_mod::mpint, cm_mod.master, cm.com());
-
     int eNoNb = consts::element_type_to_elem_nonb.at(lM.eType);
     #ifdef dbg_part_msh
     dmsg << "nEl: " << nEl;
@@ -1695,7 +1906,12 @@ void part_msh(Simulation* simulation, int iM, mshType& lM, Vector<int>& gmtl, in
       #endif
     } 
 
-    lM.IEN.clear();
+    // The fallback partition used when ParMETIS fails is not saved to the
+    // partition cache so later runs partition the mesh again.
+    //
+    if ((edgecut <= 0) && (cacheWriter != nullptr)) {
+      cacheWriter->discard();
+    }
 
     if (com_mod.rmsh.isReqd) {
       #ifdef dbg_part_msh
@@ -1717,182 +1933,162 @@ void part_msh(Simulation* simulation, int iM, mshType& lM, Vector<int>& gmtl, in
     }
   }
 
-  for (int i = 0; i < num_proc; i++) { 
-    disp[i] = lM.eDist[i];
-    sCount[i] = lM.eDist[i+1] - disp[i];
-  }
-
-  // Gathering the parts inside master, part(e) is equal to the
-  // cm%id() that the element e belong to.
+  // Migrating the elements directly from the processor holding their 
+  // block to the processor owning them, part(e) is equal to the cm%id() 
+  // that the element e belongs to.
   //
-  Vector<int> gPart;
-  if (cm.mas(cm_mod)) {
-    gPart.resize(lM.gnEl);
-  } else { 
-    gPart.clear();
-  } 
-
-  // gpart is a global version of part in which processor p = gpart(e)
-  // is the owner of element "e".
+  // Elements keep their original relative order so the new element 
+  // numbering is ordered by owner and then by original element number.
   //
-  MPI_Gatherv(part.data(), nEl, cm_mod::mpint, gPart.data(), sCount.data(), disp.data(), 
-      cm_mod::mpint, cm_mod.master, cm.com());
-
-  part.clear();
-
-  Array<int> tempIEN;
-  Array<double> tmpFn;
-  flag = false;
-  bool fnFlag = false;
-
   #ifdef dbg_part_msh
-  dmsg << "sCount: " << sCount;
-  dmsg << "disp: " << disp;
-  //dmsg << "gPart: " << gPart;
   dmsg << " " << " ";
-  dmsg << "Making the lM%IEN array " << " ...";
+  dmsg << "Migrating elements to their owners " << " ...";
   #endif
- 
-  if (cm.mas(cm_mod)) {
-    sCount = 0;
-    for (int e = 0; e < lM.gnEl; e++) {
-      sCount[gPart[e]] = sCount[gPart[e]] + 1;
-    }
+  Vector<int> bDist(lM.eDist);
+  int bnEl = nEl;
 
-    for (int i = 0; i < num_proc; i++) { 
-      lM.eDist[i+1] = lM.eDist[i] + sCount[i];
-    }
-
-    #ifdef dbg_part_msh
-    dmsg << "lM.eDist: " << lM.eDist;
-    dmsg << "sCount: " << sCount;
-    #endif
+  // Number of block elements sent to each processor and received
+  // from each processor.
+  //
+  Vector<int> eCount(num_proc); 
+  Vector<int> rCount(num_proc); 
+  eCount = 0;
+  for (int e = 0; e < bnEl; e++) {
+    eCount[part[e]] = eCount[part[e]] + 1;
+  }
 
-    tempIEN.resize(eNoN,lM.gnEl); 
-    lM.otnIEN.resize(lM.gnEl);
+  MPI_Alltoall(eCount.data(), 1, cm_mod::mpint, rCount.data(), 1, cm_mod::mpint, cm.com());
 
-    // Making the lM%IEN array in order, based on the cm%id() number in
-    // master. lM%otnIEN maps old IEN order to new IEN order.
-    //
-    disp = 0;
+  nEl = rCount.sum();
+  MPI_Allgather(&nEl, 1, cm_mod::mpint, sCount.data(), 1, cm_mod::mpint, cm.com());
 
-    for (int e = 0; e < lM.gnEl; e++) { 
-      int Ec = lM.eDist[gPart[e]];
-      lM.eDist[gPart[e]] = Ec + 1;
-      tempIEN.set_col(Ec, lM.gIEN.col(e));
-      lM.otnIEN[e] = Ec;
-    }
+  lM.eDist[0] = 0;
+  for (int i = 0; i < num_proc; i++) { 
+    lM.eDist[i+1] = lM.eDist[i] + sCount[i];
+  }
+  #ifdef dbg_part_msh
+  dmsg << "lM.eDist: " << lM.eDist;
+  #endif
 
-    lM.gIEN = tempIEN;
-    lM.eDist[0] = 0;
-    for (int i = 0; i < num_proc; i++) { 
-      lM.eDist[i+1] = lM.eDist[i] + sCount[i];
-    }
-    #ifdef dbg_part_msh
-    dmsg << "2 lM.eDist: " << lM.eDist;
-    #endif
+  // Number of elements sent to each processor by lower ID processors,
+  // used to set the new element numbers of the block.
+  //
+  Vector<int> eOffset(num_proc); 
+  MPI_Exscan(eCount.data(), eOffset.data(), num_proc, cm_mod::mpint, MPI_SUM, cm.com());
+  if (cm.id() == 0) {
+    eOffset = 0;
+  }
 
-    // This it to distribute eId, if allocated
-    //
-    if (lM.eId.size() != 0) {
-      flag = true;
-      part.resize(lM.gnEl);
-      for (int e = 0; e < lM.gnEl; e++) {
-        int Ec = lM.otnIEN[e];
-        part[Ec] = lM.eId[e];
-      }
-      lM.eId.clear();
-    }
+  // Order of the block elements sorted by destination processor and 
+  // their new element numbers.
+  //
+  Vector<int> sDisp(num_proc); 
+  Vector<int> rDisp(num_proc); 
+  for (int i = 1; i < num_proc; i++) { 
+    sDisp[i] = sDisp[i-1] + eCount[i-1];
+    rDisp[i] = rDisp[i-1] + rCount[i-1];
+  }
+
+  Vector<int> sOrder(bnEl);
+  Vector<int> bOtn(bnEl);
+  disp = sDisp;
+  for (int e = 0; e < bnEl; e++) {
+    int i = part[e];
+    sOrder[disp[i]] = e;
+    bOtn[e] = lM.eDist[i] + eOffset[i] + disp[i] - sDisp[i];
+    disp[i] = disp[i] + 1;
+  }
+  part.clear();
 
-    // This it to distribute fN, if allocated
-    if (lM.fN.size() != 0) {
-      fnFlag = true;
-      tmpFn.resize(nFn*nsd, lM.gnEl);
-      for (int e = 0; e < lM.gnEl; e++) {
-        int Ec = lM.otnIEN[e];
-        tmpFn.set_col(Ec, lM.fN.col(e));
+  // Send the columns of 'sData' in the order 'sOrder' to their owners.
+  //
+  auto migrate = [&](auto& sData, auto& rData, const int m, MPI_Datatype dtype) -> void {
+    using T = typename std::remove_reference<decltype(sData)>::type;
+    T sBuf(m, bnEl);
+    for (int j = 0; j < bnEl; j++) {
+      for (int i = 0; i < m; i++) {
+        sBuf(i,j) = sData(i,sOrder[j]);
       }
-      lM.fN.clear();
     }
+    auto sc = eCount * m;
+    auto sd = sDisp * m;
+    auto rc = rCount * m;
+    auto rd = rDisp * m;
+    rData.resize(m, nEl);
+    MPI_Alltoallv(sBuf.data(), sc.data(), sd.data(), dtype, rData.data(), rc.data(), rd.data(), dtype, cm.com());
+  };
 
-  } else { 
-    lM.otnIEN.clear();
-  }
-
-  gPart.clear();
-
+  // Element IDs and fiber directions are scattered in blocks and
+  // then migrated.
+  //
+  flag = (lM.eId.size() != 0);
+  bool fnFlag = (lM.fN.size() != 0);
   cm.bcast(cm_mod, &flag);
   cm.bcast(cm_mod, &fnFlag);
-  cm.bcast(cm_mod, lM.eDist);
-
-  nEl = lM.eDist[cm.id()+1] - lM.eDist[cm.id()];
   #ifdef dbg_part_msh
   dmsg << "flag: " << flag;
   dmsg << "fnFlag: " << fnFlag;
-  dmsg << "3 lM.eDist: " << lM.eDist;
   #endif
-  lM.nEl = nEl;
-  lM.IEN.resize(eNoN,nEl); 
-  lM.iGC.resize(nEl);
 
-  // Communicating eId, if neccessary.
-  //
   if (flag) {
-    lM.eId.resize(nEl);
-    // [NOTE] Not sure what's going on here.
-    if (part.size() == 0) {
-      part.clear();
-    }
+    Array<int> bId(1, bnEl);
+    Array<int> eId;
     for (int i = 0; i < num_proc; i++) { 
-      disp[i] = lM.eDist[i];
-      sCount[i] = lM.eDist[i+1] - disp[i];
+      disp[i] = bDist[i];
+      sCount[i] = bDist[i+1] - disp[i];
     }
-    MPI_Scatterv(part.data(), sCount.data(), disp.data(), cm_mod::mpint, lM.eId.data(), nEl, 
+    MPI_Scatterv(lM.eId.data(), sCount.data(), disp.data(), cm_mod::mpint, bId.data(), bnEl, 
         cm_mod::mpint, cm_mod.master, cm.com());
-    part.clear();
+    migrate(bId, eId, 1, cm_mod::mpint);
+    lM.eId.resize(nEl);
+    for (int e = 0; e < nEl; e++) {
+      lM.eId[e] = eId(0,e);
+    }
   }
 
-  // Communicating fN, if neccessary
-  //
   if (fnFlag) { 
     #ifdef dbg_part_msh
     dmsg << "Communicating fN " << " ...";
     dmsg << "nFn: " << nFn;
     dmsg << "nsd: " << nsd;
-    dmsg << "nEl: " << nEl;
-    dmsg << "tmpFn.size(): " << tmpFn.size();
     #endif
-    lM.fN.resize(nFn*nsd,nEl);
-    if (tmpFn.size() == 0) {
-      // ALLOCATE(tmpFn(0,0))
-    }
+    Array<double> bFn(nFn*nsd, bnEl);
     for (int i = 0; i < num_proc; i++) { 
-      disp[i] = lM.eDist[i] * nFn * nsd;
-      sCount[i] = lM.eDist[i+1] * nFn * nsd - disp[i];
+      disp[i] = bDist[i] * nFn * nsd;
+      sCount[i] = bDist[i+1] * nFn * nsd - disp[i];
     }
-    MPI_Scatterv(tmpFn.data(), sCount.data(), disp.data(), cm_mod::mpreal, lM.fN.data(), nEl*nFn*nsd, 
+    MPI_Scatterv(lM.fN.data(), sCount.data(), disp.data(), cm_mod::mpreal, bFn.data(), bnEl*nFn*nsd, 
         cm_mod::mpreal, cm_mod.master, cm.com());
-    tmpFn.clear();
+    migrate(bFn, lM.fN, nFn*nsd, cm_mod::mpreal);
   }
 
-  // Now scattering the sorted lM%IEN to all processors.
+  Array<int> bIEN(lM.IEN);
+  migrate(bIEN, lM.IEN, eNoN, cm_mod::mpint);
+  bIEN.clear();
+
+  lM.nEl = nEl;
+  lM.iGC.resize(nEl);
+
+  // Gathering the new element numbers inside master, lM%otnIEN maps 
+  // old IEN order to new IEN order, and reordering lM%gIEN with them.
   //
-  #ifdef dbg_part_msh
-  dmsg << " " << " ";
-  dmsg << "Now scattering the sorted lM%IEN to all processors " << " ...";
-  #endif
-  if (tempIEN.size() == 0) {
-    tempIEN.clear();
-  }
-  for (int i = 0; i < num_proc; i++) {
-    disp[i] = lM.eDist[i] * eNoN;
-    sCount[i] = lM.eDist[i+1]*eNoN - disp[i];
+  for (int i = 0; i < num_proc; i++) { 
+    disp[i] = bDist[i];
+    sCount[i] = bDist[i+1] - disp[i];
   }
 
-  MPI_Scatterv(tempIEN.data(), sCount.data(), disp.data(), cm_mod::mpint, lM.IEN.data(), 
-      nEl*eNoN, cm_mod::mpint, cm_mod.master, cm.com());
+  if (cm.mas(cm_mod)) {
+    lM.otnIEN.resize(lM.gnEl);
+  } else { 
+    lM.otnIEN.clear();
+  } 
+
+  MPI_Gatherv(bOtn.data(), bnEl, cm_mod::mpint, lM.otnIEN.data(), sCount.data(), disp.data(), 
+      cm_mod::mpint, cm_mod.master, cm.com());
 
-  tempIEN.clear();
+  if (cm.mas(cm_mod)) {
+    reorder_gien(lM);
+  }
 
   // Constructing the initial global to local pointer
   // lM%IEN: eNoN,nEl --> gnNo
@@ -1962,7 +2158,7 @@ void part_msh(Simulation* simulation, int iM, mshType& lM, Vector<int>& gmtl, in
   #endif
 
   lM.gN.clear();
-  gPart.resize(com_mod.tnNo + nNo); 
+  Vector<int> gPart(com_mod.tnNo + nNo); 
   lM.gN.resize(nNo);
   gmtl = -1;
 
@@ -1995,6 +2191,10 @@ void part_msh(Simulation* simulation, int iM, mshType& lM, Vector<int>& gmtl, in
   }
 
   gPart.clear();
+
+  if (cacheWriter != nullptr) {
+    write_cached_msh(com_mod, cm_mod, lM, tnNo, *cacheWriter);
+  }
   com_mod.tnNo = tnNo;
 
   // If neccessary communicate NURBS
@@ -2040,24 +2240,6 @@ void part_msh(Simulation* simulation, int iM, mshType& lM, Vector<int>& gmtl, in
   }
   // If necessary, distribute precomputed state-variable data.
   //
-  flag = (lM.Ys.size() != 0);
-  cm.bcast(cm_mod, &flag);
-  if (flag){
-    #ifdef dbg_part_msh
-    dmsg << "Distributing precomputed state-variable data " << " ...";
-    #endif
-    Array3<double> tmpYs;
-    int nsYs = lM.Ys.nslices();
-    if (cm.mas(cm_mod)) {
-      tmpYs.resize(lM.Ys.nrows(), lM.Ys.ncols(), nsYs);
-      tmpYs = lM.Ys;
-      lM.Ys.clear();
-    } else {
-      tmpYs.clear();
-    }
-    lM.Ys.resize(com_mod.nsd, com_mod.tnNo, nsYs);
-    lM.Ys = all_fun::local(com_mod, cm_mod, cm, tmpYs);
-    tmpYs.clear();
-  }
+  dist_ys(com_mod, cm_mod, lM);
 }
 
@@ -29,6 +29,7 @@
  */
 
 #include "Simulation.h"
+#include "partition_cache.h"
 
 #ifndef DISTRIBUTE_H
 #define DISTRIBUTE_H
@@ -47,9 +48,11 @@ void dist_mat_consts(const ComMod& com_mod, const CmMod& cm_mod, const cmType& c
 
 void dist_visc_model(const ComMod& com_mod, const CmMod& cm_mod, const cmType& cm, viscModelType& lVis);
 
-void part_face(Simulation* simulation, mshType& lM, faceType& lFa, faceType& gFa, Vector<int>& gmtl);
+void part_face(Simulation* simulation, mshType& lM, faceType& lFa, faceType& gFa, Vector<int>& gmtl,
+    partition_cache::CacheReader* cacheReader, partition_cache::CacheWriter* cacheWriter);
 
-void part_msh(Simulation* simulation, int iM, mshType& lM, Vector<int>& mtl, int nP, Vector<float>& wgt);
+void part_msh(Simulation* simulation, int iM, mshType& lM, Vector<int>& mtl, int nP, Vector<float>& wgt,
+    partition_cache::CacheReader* cacheReader, partition_cache::CacheWriter* cacheWriter);
 
 #endif
 
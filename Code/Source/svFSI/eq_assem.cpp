@@ -75,16 +75,21 @@ void b_assem_neu_bc(ComMod& com_mod, const faceType& lFa, const Vector<double>&
   const int eNoN = lFa.eNoN;
   const auto& msh = com_mod.msh[iM];
   auto& cDmn = com_mod.cDmn;
+  auto& ws = com_mod.elem_workspace[0];
 
   for (int e = 0; e < lFa.nEl; e++) {
     int Ec = lFa.gE(e);
     cDmn = all_fun::domain(com_mod, msh, cEq, Ec);
     auto cPhys = eq.dmn[cDmn].phys;
 
-    Vector<int> ptr(eNoN); 
-    Vector<double> N(eNoN), hl(eNoN); 
-    Array<double> yl(tDof,eNoN), lR(dof,eNoN); 
-    Array3<double> lK(dof*dof,eNoN,eNoN);
+    ws.reset();
+    auto ptr = ws.ivector(eNoN); 
+    auto hl = ws.vector(eNoN); 
+    auto yl = ws.array(tDof,eNoN);
+    auto lR = ws.array(dof,eNoN); 
+    auto lK = ws.array3(dof*dof,eNoN,eNoN);
+    auto nV = ws.vector(nsd);
+    auto y = ws.vector(tDof);
 
     for (int a = 0; a < eNoN; a++) {
       int Ac = lFa.IEN(a,e);
@@ -101,20 +106,24 @@ void b_assem_neu_bc(ComMod& com_mod, const faceType& lFa, const Vector<double>&
     }
 
     for (int g = 0; g < lFa.nG; g++) {
-      Vector<double> nV(nsd);
-      auto Nx = lFa.Nx.slice(g);
+      nV = 0.0;
+      auto Nx = lFa.Nx.rslice(g);
       nn::gnnb(com_mod, lFa, e, g, nsd, nsd-1, eNoN, Nx, nV);
       double Jac = sqrt(utils::norm(nV));
-      nV = nV / Jac;
+      for (int i = 0; i < nsd; i++) {
+        nV(i) = nV(i) / Jac;
+      }
       double w = lFa.w(g)*Jac;
-      N  = lFa.N.col(g);
+      auto N = lFa.N.rcol(g);
 
       double h = 0.0;
-      Vector<double> y(tDof);
+      y = 0.0;
 
       for (int a = 0; a < eNoN; a++) {
         h = h + N(a)*hl(a);
-        y = y + N(a)*yl.col(a);
+        for (int i = 0; i < tDof; i++) {
+          y(i) = y(i) + N(a)*yl(i,a);
+        }
       }
 
       switch ( cPhys) {
@@ -207,31 +216,42 @@ void b_neu_folw_p(ComMod& com_mod, const bcType& lBc, const faceType& lFa, const
 
   auto& eq = com_mod.eq[cEq];
   auto& cDmn = com_mod.cDmn;
+  auto& ws = com_mod.elem_workspace[0];
 
   #ifdef debug_b_neu_folw_p 
   dmsg << "nsd: " << nsd;
   dmsg << "eNoN: " << nsd;
   #endif
 
+  // Initialize parameteric coordinate for Newton's iterations
+  Vector<double> xi0(nsd);
+  for (int g = 0; g < msh.nG; g++) {
+    for (int i = 0; i < nsd; i++) {
+      xi0(i) = xi0(i) + msh.xi(i,g);
+    }
+  }
+  xi0 = xi0 / static_cast<double>(msh.nG);
+
   for (int e = 0; e < lFa.nEl; e++) {
     int Ec = lFa.gE(e);
     cDmn = all_fun::domain(com_mod, msh, cEq, Ec);  // Changes global
     auto cPhys = eq.dmn[cDmn].phys;
 
-    Vector<int> ptr(eNoN); 
-    Vector<double> hl(eNoN); 
-    Array<double> xl(nsd,eNoN); 
-    Array<double> dl(tDof,eNoN);
-    Vector<double> N(eNoN); 
-    Array<double> Nxi(nsd,eNoN); 
-    Array<double> Nx(nsd,eNoN); 
-    Array<double> lR(dof,eNoN);
-    Array3<double> lK(dof*dof,eNoN,eNoN);
-    Array3<double> lKd;
-
-    if (cPhys == EquationType::phys_ustruct) {
-      lKd.resize(dof*nsd,eNoN,eNoN);
-    }
+    ws.reset();
+    auto ptr = ws.ivector(eNoN); 
+    auto hl = ws.vector(eNoN); 
+    auto xl = ws.array(nsd,eNoN); 
+    auto dl = ws.array(tDof,eNoN);
+    auto N = ws.vector(eNoN); 
+    auto Nxi = ws.array(nsd,eNoN); 
+    auto Nx = ws.array(nsd,eNoN); 
+    auto lR = ws.array(dof,eNoN);
+    auto lK = ws.array3(dof*dof,eNoN,eNoN);
+    auto xp = ws.vector(nsd);
+    auto xi = ws.vector(nsd);
+    auto nV = ws.vector(nsd);
+    auto ksix = ws.array(nsd,nsd);
+    auto lKd = (cPhys == EquationType::phys_ustruct) ? ws.array3(dof*nsd,eNoN,eNoN) : Array3<double>();
 
     // Create local copies
     for (int a = 0; a < eNoN; a++) {
@@ -245,51 +265,47 @@ void b_neu_folw_p(ComMod& com_mod, const bcType& lBc, const faceType& lFa, const
       }
     }
 
-    // Initialize parameteric coordinate for Newton's iterations
-    Vector<double> xi0(nsd);
-    for (int g = 0; g < msh.nG; g++) {
-      xi0 = xi0 + msh.xi.col(g);
-    }
-    xi0 = xi0 / static_cast<double>(msh.nG);
-
     for (int g = 0; g < lFa.nG; g++) {
-      Vector<double> xp(nsd);
       double Jac;
+      xp = 0.0;
 
       for (int a = 0; a < eNoNb; a++) {
         int Ac = lFa.IEN(a,e);
-        xp = xp + com_mod.x.col(Ac) * lFa.N(a,g);
+        for (int i = 0; i < nsd; i++) {
+          xp(i) = xp(i) + com_mod.x(i,Ac) * lFa.N(a,g);
+        }
       }
 
-      auto xi = xi0;
+      xi = xi0;
       nn::get_nnx(nsd, msh.eType, eNoN, xl, msh.xib, msh.Nb, xp, xi, N, Nxi);
 
       if (g == 0 || !msh.lShpF) {
-        Array<double> ksix(nsd,nsd);
         nn::gnn(eNoN, nsd, nsd, Nxi, xl, Nx, Jac, ksix);
       }
 
       // Get surface normal vector
-      Vector<double> nV(nsd);
-      auto Nx_g = lFa.Nx.slice(g);
+      nV = 0.0;
+      auto Nx_g = lFa.Nx.rslice(g);
       nn::gnnb(com_mod, lFa, e, g, nsd, nsd-1, eNoNb, Nx_g, nV);
       Jac = sqrt(utils::norm(nV));
-      nV = nV / Jac;
+      for (int i = 0; i < nsd; i++) {
+        nV(i) = nV(i) / Jac;
+      }
       double w = lFa.w(g)*Jac;
 
       // Compute residual and tangent contributions
       if (cPhys == EquationType::phys_ustruct) {
         if (nsd == 3) {
-          ustruct::b_ustruct_3d(com_mod, eNoN, w, N, Nx, dl, hl, nV, lR, lK, lKd);
+          ustruct::b_ustruct_3d(com_mod, eNoN, w, N, Nx, dl, hl, nV, lR, lK, lKd, ws);
         } else {
-          ustruct::b_ustruct_2d(com_mod, eNoN, w, N, Nx, dl, hl, nV, lR, lK, lKd);
+          ustruct::b_ustruct_2d(com_mod, eNoN, w, N, Nx, dl, hl, nV, lR, lK, lKd, ws);
         }
 
       } else if (cPhys == EquationType::phys_struct) {
         if (nsd == 3) {
-          struct_ns::b_struct_3d(com_mod, eNoN, w, N, Nx, dl, hl, nV, lR, lK);
+          struct_ns::b_struct_3d(com_mod, eNoN, w, N, Nx, dl, hl, nV, lR, lK, ws);
         } else {
-          struct_ns::b_struct_2d(com_mod, eNoN, w, N, Nx, dl, hl, nV, lR, lK);
+          struct_ns::b_struct_2d(com_mod, eNoN, w, N, Nx, dl, hl, nV, lR, lK, ws);
         }
       }
     }
@@ -302,6 +318,63 @@ void b_neu_folw_p(ComMod& com_mod, const bcType& lBc, const faceType& lFa, const
   }
 }
 
+/// @brief Return the ID of the calling assembly thread.
+//
+int assembly_thread_id()
+{
+  #ifdef _OPENMP
+  return omp_get_thread_num();
+  #else
+  return 0;
+  #endif
+}
+
+/// @brief Return the number of threads used to assemble the current equation 
+/// on mesh lM. 
+///
+/// Threads are only used if OpenMP is enabled, the mesh elements have been 
+/// colored and the linear algebra assembly can be called concurrently.
+//
+int num_assembly_threads(ComMod& com_mod, const mshType& lM)
+{
+  #ifdef _OPENMP
+  const int num_threads = com_mod.cm.nT();
+  auto& eq = com_mod.eq[com_mod.cEq];
+
+  if ((num_threads > 1) && (lM.nColors > 0) && (eq.linear_algebra != nullptr) && 
+      eq.linear_algebra->thread_safe_assembly()) {
+    return num_threads;
+  }
+  #endif
+
+  return 1;
+}
+
+/// @brief Insert all physical properties into the property maps of the 
+/// current equation domains with physics 'phys'. 
+///
+/// Properties not set in the solver input file are read as zero using 
+/// 'prop[]' which inserts them into the std::map. Inserting them here means
+/// that the maps are not modified when they are read by assembly threads.
+//
+void init_dmn_props(ComMod& com_mod, const consts::EquationType phys)
+{
+  using namespace consts;
+
+  auto& eq = com_mod.eq[com_mod.cEq];
+
+  for (int iDmn = 0; iDmn < eq.nDmn; iDmn++) {
+    auto& dmn = eq.dmn[iDmn];
+    if (dmn.phys != phys) {
+      continue;
+    }
+    for (int i = static_cast<int>(PhysicalProperyType::fluid_density); 
+         i <= static_cast<int>(PhysicalProperyType::ctau_C); i++) {
+      dmn.prop.emplace(static_cast<PhysicalProperyType>(i), 0.0);
+    }
+  }
+}
+
 /// @brief This routine assembles the equation on a given mesh.
 ///
 /// Ag(tDof,tnNo), Yg(tDof,tnNo), Dg(tDof,tnNo)
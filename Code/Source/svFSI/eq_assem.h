@@ -34,8 +34,22 @@
 #include "ComMod.h"
 #include "Simulation.h"
 
+#include "all_fun.h"
+
+#include <exception>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 namespace eq_assem {
 
+int assembly_thread_id();
+
+int num_assembly_threads(ComMod& com_mod, const mshType& lM);
+
+void init_dmn_props(ComMod& com_mod, const consts::EquationType phys);
+
 void b_assem_neu_bc(ComMod& com_mod, const faceType& lFa, const Vector<double>& hg, const Array<double>& Yg);
 
 void b_neu_folw_p(ComMod& com_mod, const bcType& lBc, const faceType& lFa, const Vector<double>& hg, const Array<double>& Dg);
@@ -44,6 +58,79 @@ void fsi_ls_upd(ComMod& com_mod, const bcType& lBc, const faceType& lFa);
 
 void global_eq_assem(ComMod& com_mod, CepMod& cep_mod, const mshType& lM, const Array<double>& Ag, const Array<double>& Yg, const Array<double>& Dg);
 
+/// @brief Call 'elem_func(e, ws)' for each element 'e' of mesh 'lM' whose domain 
+/// physics is 'phys'. com_mod.cDmn is set to the domain of the element before the
+/// call. 'ws' is the (reset) workspace of the calling thread used to store the 
+/// element local arrays.
+///
+/// If num_assembly_threads() is larger than one then the elements of each color 
+/// (see lhsa_ns::set_elem_colors) are processed by OpenMP threads. The elements of 
+/// a color share no nodes and belong to the same domain so they can be assembled 
+/// into R and Val concurrently without locking. The domain property maps are
+/// filled in (see init_dmn_props) before the threads are started so that the
+/// element functions only read them.
+//
+template<typename ElemFunc>
+void loop_elements(ComMod& com_mod, const mshType& lM, const consts::EquationType phys, ElemFunc&& elem_func)
+{
+  const int cEq = com_mod.cEq;
+  const auto& eq = com_mod.eq[cEq];
+  auto& cDmn = com_mod.cDmn;
+  const int num_threads = num_assembly_threads(com_mod, lM);
+  auto& workspace = com_mod.elem_workspace;
+
+  if (workspace.size() < static_cast<size_t>(num_threads)) {
+    workspace.resize(num_threads);
+  }
+
+  if (num_threads == 1) {
+    auto& ws = workspace[0];
+    for (int e = 0; e < lM.nEl; e++) {
+      cDmn = all_fun::domain(com_mod, lM, cEq, e);
+      if (eq.dmn[cDmn].phys != phys) {
+        continue;
+      }
+      ws.reset();
+      elem_func(e, ws);
+    }
+    return;
+  }
+
+  init_dmn_props(com_mod, phys);
+
+  for (int c = 0; c < lM.nColors; c++) {
+    const int start = lM.colorPtr(c);
+    const int end = lM.colorPtr(c+1);
+
+    cDmn = all_fun::domain(com_mod, lM, cEq, lM.colorElems(start));
+    if (eq.dmn[cDmn].phys != phys) {
+      continue;
+    }
+
+    // Exceptions can't propagate out of a parallel region so store the
+    // first one and rethrow it after the region. 
+    std::exception_ptr error = nullptr;
+
+    #pragma omp parallel for num_threads(num_threads) schedule(static)
+    for (int k = start; k < end; k++) {
+      try {
+        auto& ws = workspace[assembly_thread_id()];
+        ws.reset();
+        elem_func(lM.colorElems(k), ws);
+      } catch (...) {
+        #pragma omp critical
+        if (error == nullptr) {
+          error = std::current_exception();
+        }
+      }
+    }
+
+    if (error != nullptr) {
+      std::rethrow_exception(error);
+    }
+  }
+}
+
 };
 
 #endif
@@ -32,6 +32,7 @@
 
 #include "all_fun.h"
 #include "consts.h"
+#include "eq_assem.h"
 #include "fs.h"
 #include "lhsa.h"
 #include "nn.h"
@@ -488,7 +489,6 @@ void construct_fluid(ComMod& com_mod, const mshType& lM, const Array<double>& Ag
   const int dof = com_mod.dof;
   const int cEq = com_mod.cEq;
   const auto& eq = com_mod.eq[cEq];
-  auto& cDmn = com_mod.cDmn;
 
   #ifdef debug_construct_fluid
   dmsg << "cEq: " << cEq;
@@ -503,26 +503,22 @@ void construct_fluid(ComMod& com_mod, const mshType& lM, const Array<double>& Ag
   dmsg << "nsd: " <<  nsd;
   #endif
 
-  // FLUID: dof = nsd+1
-  Vector<int> ptr(eNoN); 
-  Array<double> xl(nsd,eNoN); 
-  Array<double> al(tDof,eNoN); 
-  Array<double> yl(tDof,eNoN); 
-  Array<double> bfl(nsd,eNoN); 
-  Array<double> lR(dof,eNoN); 
-  Array3<double> lK(dof*dof,eNoN,eNoN);
-
-  // Loop over all elements of mesh
+  // Velocity and pressure function spaces, built once at initialization
   //
-  int num_c = lM.nEl / 10;
-
-  for (int e = 0; e < lM.nEl; e++) {
-    cDmn = all_fun::domain(com_mod, lM, cEq, e);
-    auto cPhys = eq.dmn[cDmn].phys;
+  const auto& fs_1 = fs::thood_fs(lM, vmsStab, 1);
+  const auto& fs_2 = fs::thood_fs(lM, vmsStab, 2);
 
-    if (cPhys != EquationType::phys_fluid) {
-      continue;
-    }
+  // Loop over all fluid elements of mesh
+  //
+  eq_assem::loop_elements(com_mod, lM, EquationType::phys_fluid, [&](const int e, ElementWorkspace& ws) {
+    // FLUID: dof = nsd+1
+    auto ptr = ws.ivector(eNoN); 
+    auto xl = ws.array(nsd,eNoN); 
+    auto al = ws.array(tDof,eNoN); 
+    auto yl = ws.array(tDof,eNoN); 
+    auto bfl = ws.array(nsd,eNoN); 
+    auto lR = ws.array(dof,eNoN); 
+    auto lK = ws.array3(dof*dof,eNoN,eNoN);
 
     //  Update shape functions for NURBS
     if (lM.eType == ElementType::NRB) {
@@ -547,30 +543,26 @@ void construct_fluid(ComMod& com_mod, const mshType& lM, const Array<double>& Ag
     // Initialize residual and tangents
     lR = 0.0;
     lK = 0.0;
-    std::array<fsType,2> fs;
-
-    // Set function spaces for velocity and pressure.
-    fs::get_thood_fs(com_mod, fs, lM, vmsStab, 1);
 
     // Define element coordinates appropriate for function spaces
-    Array<double> xwl(nsd,fs[0].eNoN); 
-    Array<double> Nwx(nsd,fs[0].eNoN); 
-    Array<double> Nwxx(l,fs[0].eNoN);
+    auto xwl = ws.array(nsd,fs_1[0].eNoN); 
+    auto Nwx = ws.array(nsd,fs_1[0].eNoN); 
+    auto Nwxx = ws.array(l,fs_1[0].eNoN);
 
-    Array<double> xql(nsd,fs[1].eNoN); 
-    Array<double> Nqx(nsd,fs[1].eNoN);
+    auto xql = ws.array(nsd,fs_1[1].eNoN); 
+    auto Nqx = ws.array(nsd,fs_1[1].eNoN);
 
     #ifdef debug_construct_fluid
     dmsg;
     dmsg << "l: " << l;
-    dmsg << "fs[0].eNoN: " << fs[0].eNoN;
-    dmsg << "fs[1].eNoN: " << fs[1].eNoN;
+    dmsg << "fs_1[0].eNoN: " << fs_1[0].eNoN;
+    dmsg << "fs_1[1].eNoN: " << fs_1[1].eNoN;
     #endif
 
     xwl = xl;
 
     for (int i = 0; i < xql.nrows(); i++) { 
-      for (int j = 0; j < fs[1].eNoN; j++) { 
+      for (int j = 0; j < fs_1[1].eNoN; j++) { 
         xql(i,j) = xl(i,j);
       }
     }
@@ -580,100 +572,104 @@ void construct_fluid(ComMod& com_mod, const mshType& lM, const Array<double>& Ag
     #ifdef debug_construct_fluid
     dmsg;
     dmsg << "Gauss integration 1 ... ";
-    dmsg << "fs[1].nG: " << fs[0].nG;
-    dmsg << "fs[1].lShpF: " << fs[0].lShpF;
-    dmsg << "fs[2].nG: " << fs[1].nG;
-    dmsg << "fs[2].lShpF: " << fs[1].lShpF;
+    dmsg << "fs_1[1].nG: " << fs_1[0].nG;
+    dmsg << "fs_1[1].lShpF: " << fs_1[0].lShpF;
+    dmsg << "fs_1[2].nG: " << fs_1[1].nG;
+    dmsg << "fs_1[2].lShpF: " << fs_1[1].lShpF;
     #endif
 
     double Jac{0.0};
-    Array<double> ksix(nsd,nsd);
+    auto ksix = ws.array(nsd,nsd);
 
-    for (int g = 0; g < fs[0].nG; g++) {
-      if (g == 0 || !fs[1].lShpF) {
-        auto Nx = fs[1].Nx.rslice(g);
-        nn::gnn(fs[1].eNoN, nsd, nsd, Nx, xql, Nqx, Jac, ksix);
+    for (int g = 0; g < fs_1[0].nG; g++) {
+      if (g == 0 || !fs_1[1].lShpF) {
+        if (!nn::get_geo_cache(lM, e, Nqx, Jac, ksix)) {
+          auto Nx = fs_1[1].Nx.rslice(g);
+          nn::gnn(fs_1[1].eNoN, nsd, nsd, Nx, xql, Nqx, Jac, ksix);
+        }
         if (utils::is_zero(Jac)) {
            throw std::runtime_error("[construct_fluid] Jacobian for element " + std::to_string(e) + " is < 0.");
         }
       }
 
-      if (g == 0 || !fs[0].lShpF) {
-        auto Nx = fs[0].Nx.rslice(g);
-        nn::gnn(fs[0].eNoN, nsd, nsd, Nx, xwl, Nwx, Jac, ksix);
+      if (g == 0 || !fs_1[0].lShpF) {
+        if (!nn::get_geo_cache(lM, e, Nwx, Jac, ksix)) {
+          auto Nx = fs_1[0].Nx.rslice(g);
+          nn::gnn(fs_1[0].eNoN, nsd, nsd, Nx, xwl, Nwx, Jac, ksix);
+        }
         if (utils::is_zero(Jac)) {
            throw std::runtime_error("[construct_fluid] Jacobian for element " + std::to_string(e) + " is < 0.");
         }
 
         if (!vmsStab) {
-          auto Nx = fs[0].Nx.rslice(g);
-          auto Nxx = fs[0].Nxx.rslice(g);
-          nn::gn_nxx(l, fs[0].eNoN, nsd, nsd, Nx, Nxx, xwl, Nwx, Nwxx); 
+          auto Nx = fs_1[0].Nx.rslice(g);
+          auto Nxx = fs_1[0].Nxx.rslice(g);
+          nn::gn_nxx(l, fs_1[0].eNoN, nsd, nsd, Nx, Nxx, xwl, Nwx, Nwxx); 
         }
       }
 
-      double w = fs[0].w(g) * Jac;
+      double w = fs_1[0].w(g) * Jac;
 
       // Compute momentum residual and tangent matrix.
       //
       if (nsd == 3) {
-        auto N0 = fs[0].N.rcol(g); 
-        auto N1 = fs[1].N.rcol(g); 
-        fluid_3d_m(com_mod, vmsStab, fs[0].eNoN, fs[1].eNoN, w, ksix, N0, N1, 
+        auto N0 = fs_1[0].N.rcol(g); 
+        auto N1 = fs_1[1].N.rcol(g); 
+        fluid_3d_m(com_mod, vmsStab, fs_1[0].eNoN, fs_1[1].eNoN, w, ksix, N0, N1, 
             Nwx, Nqx, Nwxx, al, yl, bfl, lR, lK);
 
       } else if (nsd == 2) {
-        auto N0 = fs[0].N.rcol(g); 
-        auto N1 = fs[1].N.rcol(g); 
-        fluid_2d_m(com_mod, vmsStab, fs[0].eNoN, fs[1].eNoN, w, ksix, N0, N1, 
+        auto N0 = fs_1[0].N.rcol(g); 
+        auto N1 = fs_1[1].N.rcol(g); 
+        fluid_2d_m(com_mod, vmsStab, fs_1[0].eNoN, fs_1[1].eNoN, w, ksix, N0, N1, 
             Nwx, Nqx, Nwxx, al, yl, bfl, lR, lK);
       }
     } // g: loop
 
-    // Set function spaces for velocity and pressure.
-    //
-    fs::get_thood_fs(com_mod, fs, lM, vmsStab, 2);
-
     // Gauss integration 2
     //
-    for (int g = 0; g < fs[1].nG; g++) {
-      if (g == 0 || !fs[0].lShpF) {
-        auto Nx = fs[0].Nx.rslice(g);
-        nn::gnn(fs[0].eNoN, nsd, nsd, Nx, xwl, Nwx, Jac, ksix);
+    for (int g = 0; g < fs_2[1].nG; g++) {
+      if (g == 0 || !fs_2[0].lShpF) {
+        if (!nn::get_geo_cache(lM, e, Nwx, Jac, ksix)) {
+          auto Nx = fs_2[0].Nx.rslice(g);
+          nn::gnn(fs_2[0].eNoN, nsd, nsd, Nx, xwl, Nwx, Jac, ksix);
+        }
 
         if (utils::is_zero(Jac)) {
            throw std::runtime_error("[construct_fluid] Jacobian for element " + std::to_string(e) + " is < 0.");
         }
       }
 
-      if (g == 0 || !fs[1].lShpF) {
-        auto Nx = fs[1].Nx.rslice(g);
-        nn::gnn(fs[1].eNoN, nsd, nsd, Nx, xql, Nqx, Jac, ksix);
+      if (g == 0 || !fs_2[1].lShpF) {
+        if (!nn::get_geo_cache(lM, e, Nqx, Jac, ksix)) {
+          auto Nx = fs_2[1].Nx.rslice(g);
+          nn::gnn(fs_2[1].eNoN, nsd, nsd, Nx, xql, Nqx, Jac, ksix);
+        }
 
         if (utils::is_zero(Jac)) {
            throw std::runtime_error("[construct_fluid] Jacobian for element " + std::to_string(e) + " is < 0.");
         }
       }
-      double w = fs[1].w(g) * Jac;
+      double w = fs_2[1].w(g) * Jac;
 
       // Compute continuity residual and tangent matrix.
       //
       if (nsd == 3) {
-        auto N0 = fs[0].N.rcol(g); 
-        auto N1 = fs[1].N.rcol(g); 
-        fluid_3d_c(com_mod, vmsStab, fs[0].eNoN, fs[1].eNoN, w, ksix, N0, N1, Nwx, Nqx, Nwxx, al, yl, bfl, lR, lK);
+        auto N0 = fs_2[0].N.rcol(g); 
+        auto N1 = fs_2[1].N.rcol(g); 
+        fluid_3d_c(com_mod, vmsStab, fs_2[0].eNoN, fs_2[1].eNoN, w, ksix, N0, N1, Nwx, Nqx, Nwxx, al, yl, bfl, lR, lK);
 
       } else if (nsd == 2) {
-        auto N0 = fs[0].N.rcol(g); 
-        auto N1 = fs[1].N.rcol(g); 
-        fluid_2d_c(com_mod, vmsStab, fs[0].eNoN, fs[1].eNoN, w, ksix, N0, N1, Nwx, Nqx, Nwxx, al, yl, bfl, lR, lK);
+        auto N0 = fs_2[0].N.rcol(g); 
+        auto N1 = fs_2[1].N.rcol(g); 
+        fluid_2d_c(com_mod, vmsStab, fs_2[0].eNoN, fs_2[1].eNoN, w, ksix, N0, N1, Nwx, Nqx, Nwxx, al, yl, bfl, lR, lK);
       }
 
     } // g: loop
 
-    eq.linear_algebra->assemble(com_mod, eNoN, ptr, lK, lR);
+    eq.linear_algebra->assemble_element(com_mod, lM, e, eNoN, ptr, lK, lR);
 
-  } // e: loop
+  }); // e: loop
 
   #ifdef debug_construct_fluid
   double end_time = utils::cput();
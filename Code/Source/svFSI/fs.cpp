@@ -329,6 +329,41 @@ void init_fs_msh(const ComMod& com_mod, mshType& lM)
 }
 
 
+/// @brief Build the velocity/pressure function space pairs of a mesh used
+/// during assembly so that they are not recomputed for every element.
+///
+/// The stabilized (equal order) pair is always built; the Taylor-Hood pairs
+/// are built only when the mesh has a second function space (nFs = 2).
+//
+void init_thood_fs_msh(ComMod& com_mod, mshType& lM)
+{
+  if (lM.lShl || lM.lFib) {
+    return;
+  }
+
+  get_thood_fs(com_mod, lM.thood_fs[0], lM, true, 1);
+
+  if (lM.nFs == 2) {
+    get_thood_fs(com_mod, lM.thood_fs[1], lM, false, 1);
+    get_thood_fs(com_mod, lM.thood_fs[2], lM, false, 2);
+  }
+}
+
+/// @brief Return the velocity/pressure function space pair built by 
+/// init_thood_fs_msh(); replaces calling get_thood_fs() for each element.
+//
+const std::array<fsType,2>& thood_fs(const mshType& lM, const bool lStab, const int iOpt)
+{
+  int k = lStab ? 0 : iOpt;
+
+  if ((k < 0) || (k > 2) || (lM.thood_fs[k][0].eNoN == 0)) {
+    throw std::runtime_error("Function spaces for mesh '" + lM.name + "' with lStab=" + std::to_string(lStab) + 
+        " and iOpt=" + std::to_string(iOpt) + " have not been initialized.");
+  }
+
+  return lM.thood_fs[k];
+}
+
 /// @brief Sets Tayloor-Hood basis for a parent element type
 ///
 /// Replicates 'SUBROUTINE SETTHOODFS(fs, eType)'.
@@ -48,8 +48,12 @@ void init_fs_face(const ComMod& com_mod, mshType& lM, faceType& lFa);
 
 void init_fs_msh(const ComMod& com_mod, mshType& mesh);
 
+void init_thood_fs_msh(ComMod& com_mod, mshType& lM);
+
 void set_thood_fs(fsType& fs, consts::ElementType eType);
 
+const std::array<fsType,2>& thood_fs(const mshType& lM, const bool lStab, const int iOpt);
+
 void thood_val_rc(ComMod& com_mod);
 
 };
@@ -93,16 +93,14 @@ void construct_fsi(ComMod& com_mod, CepMod& cep_mod, const mshType& lM, const Ar
       fN(nsd,nFn), pS0l(nsymd,eNoN), lR(dof,eNoN);
   Vector<double> pSl(nsymd), ya_l(eNoN);
 
-  std::array<fsType,2> fs_1;
-  fs::get_thood_fs(com_mod, fs_1, lM, vmsStab, 1);
-
-  std::array<fsType,2> fs_2;
-  fs::get_thood_fs(com_mod, fs_2, lM, vmsStab, 2);
+  const auto& fs_1 = fs::thood_fs(lM, vmsStab, 1);
+  const auto& fs_2 = fs::thood_fs(lM, vmsStab, 2);
 
   // Loop over all elements of mesh
   //
   double struct_3d_time = 0.0;
   double fluid_3d_time = 0.0;
+  auto& ws = com_mod.elem_workspace[0];
 
   for (int e = 0; e < lM.nEl; e++) {
     // setting globals
@@ -114,6 +112,8 @@ void construct_fsi(ComMod& com_mod, CepMod& cep_mod, const mshType& lM, const Ar
       continue;
     }
 
+    ws.reset();
+
     // Update shape functions for NURBS
     //if (lM.eType == eType_NRB) CALL NRBNNX(lM, e)
 
@@ -145,7 +145,7 @@ void construct_fsi(ComMod& com_mod, CepMod& cep_mod, const mshType& lM, const Ar
       }
 
       if (pS0.size() != 0) {
-        pS0l.set_col(a, pS0.col(Ac));
+        pS0l.set_col(a, pS0.rcol(Ac));
       }
 
       if (cem.cpld) {
@@ -169,11 +169,11 @@ void construct_fsi(ComMod& com_mod, CepMod& cep_mod, const mshType& lM, const Ar
     lKd = 0.0;
 
     //  Define element coordinates appropriate for function spaces
-    Array<double> xwl(nsd,fs_1[0].eNoN);
-    Array<double> Nwx(nsd,fs_1[0].eNoN);
-    Array<double> Nwxx(l,fs_1[0].eNoN);
-    Array<double> xql(nsd,fs_1[1].eNoN);
-    Array<double> Nqx(nsd,fs_1[1].eNoN);
+    auto xwl = ws.array(nsd,fs_1[0].eNoN);
+    auto Nwx = ws.array(nsd,fs_1[0].eNoN);
+    auto Nwxx = ws.array(l,fs_1[0].eNoN);
+    auto xql = ws.array(nsd,fs_1[1].eNoN);
+    auto Nqx = ws.array(nsd,fs_1[1].eNoN);
 
     xwl = xl;
 
@@ -186,7 +186,7 @@ void construct_fsi(ComMod& com_mod, CepMod& cep_mod, const mshType& lM, const Ar
     // Gauss integration 1
     //
     double Jac{0.0};
-    Array<double> ksix(nsd,nsd);
+    auto ksix = ws.array(nsd,nsd);
 
     for (int g = 0; g < fs_1[0].nG; g++) {
       if (g == 0 || !fs_1[1].lShpF) {
@@ -216,14 +216,14 @@ void construct_fsi(ComMod& com_mod, CepMod& cep_mod, const mshType& lM, const Ar
       if (nsd == 3) {
         switch (cPhys) {
           case Equation_fluid: {
-            auto N0 = fs_1[0].N.col(g);
-            auto N1 = fs_1[1].N.col(g);
+            auto N0 = fs_1[0].N.rcol(g);
+            auto N1 = fs_1[1].N.rcol(g);
             fluid::fluid_3d_m(com_mod, vmsStab, fs_1[0].eNoN, fs_1[1].eNoN, w, ksix, N0, N1, Nwx, Nqx, Nwxx, al, yl, bfl, lR, lK);
           } break;
 
           case Equation_struct: {
-            auto N0 = fs_1[0].N.col(g);
-            struct_ns::struct_3d(com_mod, cep_mod, fs_1[0].eNoN, nFn, w, N0, Nwx, al, yl, dl, bfl, fN, pS0l, pSl, ya_l, lR, lK);
+            auto N0 = fs_1[0].N.rcol(g);
+            struct_ns::struct_3d(com_mod, cep_mod, fs_1[0].eNoN, nFn, w, N0, Nwx, al, yl, dl, bfl, fN, pS0l, pSl, ya_l, lR, lK, ws);
           } break;
           case Equation_lElas:
             throw std::runtime_error("[construct_fsi] LELAS3D not implemented");
@@ -240,8 +240,8 @@ void construct_fsi(ComMod& com_mod, CepMod& cep_mod, const mshType& lM, const Ar
       } else if (nsd == 2) {
         switch (cPhys) {
           case Equation_fluid: {
-            auto N0 = fs_1[0].N.col(g);
-            auto N1 = fs_1[1].N.col(g);
+            auto N0 = fs_1[0].N.rcol(g);
+            auto N1 = fs_1[1].N.rcol(g);
             fluid::fluid_2d_m(com_mod, vmsStab, fs_1[0].eNoN, fs_1[1].eNoN, w, ksix, N0, N1, Nwx, Nqx, Nwxx, al, yl, bfl, lR, lK);
           } break;
 
@@ -251,8 +251,8 @@ void construct_fsi(ComMod& com_mod, CepMod& cep_mod, const mshType& lM, const Ar
           break;
 
           case Equation_struct: {
-            auto N0 = fs_1[0].N.col(g);
-            struct_ns::struct_2d(com_mod, cep_mod, fs_1[0].eNoN, nFn, w, N0, Nwx, al, yl, dl, bfl, fN, pS0l, pSl, ya_l, lR, lK);
+            auto N0 = fs_1[0].N.rcol(g);
+            struct_ns::struct_2d(com_mod, cep_mod, fs_1[0].eNoN, nFn, w, N0, Nwx, al, yl, dl, bfl, fN, pS0l, pSl, ya_l, lR, lK, ws);
           } break;
 
           case Equation_ustruct:
@@ -288,8 +288,8 @@ void construct_fsi(ComMod& com_mod, CepMod& cep_mod, const mshType& lM, const Ar
       if (nsd == 3) {
         switch (cPhys) {
           case Equation_fluid: {
-            auto N0 = fs_2[0].N.col(g);
-            auto N1 = fs_2[1].N.col(g);
+            auto N0 = fs_2[0].N.rcol(g);
+            auto N1 = fs_2[1].N.rcol(g);
             fluid::fluid_3d_c(com_mod, vmsStab, fs_2[0].eNoN, fs_2[1].eNoN, w, ksix, N0, N1, Nwx, Nqx, Nwxx, al, yl, bfl, lR, lK);
           } break;
 
@@ -302,8 +302,8 @@ void construct_fsi(ComMod& com_mod, CepMod& cep_mod, const mshType& lM, const Ar
       } else if (nsd == 2) {
         switch (cPhys) {
           case Equation_fluid: {
-            auto N0 = fs_2[0].N.col(g);
-            auto N1 = fs_2[1].N.col(g);
+            auto N0 = fs_2[0].N.rcol(g);
+            auto N1 = fs_2[1].N.rcol(g);
             fluid::fluid_2d_c(com_mod, vmsStab, fs_2[0].eNoN, fs_2[1].eNoN, w, ksix, N0, N1, Nwx, Nqx, Nwxx, al, yl, bfl, lR, lK);
           } break;
 
@@ -315,7 +315,7 @@ void construct_fsi(ComMod& com_mod, CepMod& cep_mod, const mshType& lM, const Ar
       }
     } // g: loop
 
-    eq.linear_algebra->assemble(com_mod, eNoN, ptr, lK, lR);
+    eq.linear_algebra->assemble_element(com_mod, lM, e, eNoN, ptr, lK, lR);
 
   } // e: loop
 
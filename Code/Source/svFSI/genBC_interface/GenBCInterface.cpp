@@ -0,0 +1,112 @@
+/* Copyright (c) Stanford University, The Regents of the University of California, and others.
+ *
+ * All Rights Reserved.
+ *
+ * See Copyright-SimVascular.txt for additional details.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "GenBCInterface.h"
+
+#include <dlfcn.h>
+#include <stdexcept>
+#include <string>
+
+//----------------
+// GenBCInterface
+//----------------
+//
+GenBCInterface::GenBCInterface()
+{
+  genbc_integ_name_ = "genbc_integ";
+}
+
+GenBCInterface::~GenBCInterface()
+{
+  if (library_handle_) {
+    dlclose(library_handle_);
+  }
+}
+
+//------------
+// is_library
+//------------
+// Check if a genBC file name is a shared library rather than an executable.
+//
+bool GenBCInterface::is_library(const std::string& file_name)
+{
+  for (const std::string ext : {".so", ".dylib"}) {
+    if ((file_name.size() > ext.size()) && 
+        (file_name.compare(file_name.size() - ext.size(), ext.size(), ext) == 0)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+//--------------
+// load_library
+//--------------
+// Load the genBC shared library and get a pointer to its interface function.
+//
+void GenBCInterface::load_library(const std::string& interface_lib)
+{
+  library_handle_ = dlopen(interface_lib.c_str(), RTLD_LAZY);
+
+  if (!library_handle_) {
+    throw std::runtime_error("Error loading the genBC shared library '" + interface_lib + "' with error: " + 
+        std::string(dlerror()));
+  }
+
+  *(void**)(&genbc_integ_) = dlsym(library_handle_, genbc_integ_name_.c_str());
+
+  if (!genbc_integ_) {
+    std::string error = dlerror();
+    dlclose(library_handle_);
+    library_handle_ = nullptr;
+    throw std::runtime_error("Error loading the function '" + genbc_integ_name_ + "' from the genBC shared library '" + 
+        interface_lib + "' with error: " + error);
+  }
+}
+
+//-------
+// integ
+//-------
+// Integrate the 0D model for the given 3D pressures and flow rates.
+//
+void GenBCInterface::integ(const std::string& flag, const double dt, const int nDir, const int nNeu, 
+    const std::vector<double>& P, const std::vector<double>& Q, std::vector<double>& y)
+{
+  int istat = 0;
+  y.resize(nDir + nNeu);
+
+  genbc_integ_(flag.c_str(), dt, nDir, nNeu, P.data(), Q.data(), y.data(), &istat);
+
+  if (istat != 0) {
+    throw std::runtime_error("genBC returned the error status " + std::to_string(istat) + " for the flag '" + flag + "'.");
+  }
+}
+
@@ -0,0 +1,80 @@
+/* Copyright (c) Stanford University, The Regents of the University of California, and others.
+ *
+ * All Rights Reserved.
+ *
+ * See Copyright-SimVascular.txt for additional details.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <string>
+#include <vector>
+
+#ifndef GenBCInterface_h
+#define GenBCInterface_h
+
+//----------------
+// GenBCInterface
+//----------------
+// Interface to a genBC built as a shared library, called in place of the
+// genBC executable and the GenBC.int communication file. 
+//
+// The library must export the C function
+//
+//   void genbc_integ(const char* flag, const double dt, const int nDir, const int nNeu, 
+//       const double* P, const double* Q, double* y, int* istat)
+//
+//   flag - I (initializing), T (iteration loop), L (last iteration) or D (derivative)
+//   dt - time step size
+//   P - (Po,Pn) of each of the nDir Dirichlet surfaces
+//   Q - (Qo,Qn) of each of the nNeu Neumann surfaces
+//   y - returns the flow rates of the Dirichlet surfaces followed by the 
+//       pressures of the Neumann surfaces
+//   istat - returns 0 on success
+//
+// which performs the same computation as genBC does for the data read from 
+// GenBC.int.
+//
+class GenBCInterface
+{
+  public:
+    GenBCInterface();
+    ~GenBCInterface();
+
+    static bool is_library(const std::string& file_name);
+
+    void load_library(const std::string& interface_lib);
+    void integ(const std::string& flag, const double dt, const int nDir, const int nNeu, 
+        const std::vector<double>& P, const std::vector<double>& Q, std::vector<double>& y);
+
+    // Interface functions.
+    std::string genbc_integ_name_;
+    void (*genbc_integ_)(const char*, const double, const int, const int, const double*, 
+        const double*, double*, int*) = nullptr;
+
+    void* library_handle_ = nullptr;
+};
+
+#endif
+
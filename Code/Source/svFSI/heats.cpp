@@ -31,6 +31,7 @@
 #include "heats.h"
 
 #include "all_fun.h"
+#include "eq_assem.h"
 #include "lhsa.h"
 #include "mat_fun.h"
 #include "nn.h"
@@ -61,27 +62,23 @@ void construct_heats(ComMod& com_mod, const mshType& lM, const Array<double>& Ag
   const int dof = com_mod.dof;
   const int cEq = com_mod.cEq;
   const auto& eq = com_mod.eq[cEq];
-  auto& cDmn = com_mod.cDmn;
 
  int eNoN = lM.eNoN;
   #ifdef debug_construct_heats
   dmsg << "cEq: " << cEq;
-  dmsg << "cDmn: " << cDmn;
   #endif
 
-  Vector<int> ptr(eNoN);
-  Vector<double> N(eNoN);
-  Array<double> xl(nsd,eNoN), al(tDof,eNoN), yl(tDof,eNoN), Nx(nsd,eNoN), lR(dof,eNoN);
-  Array3<double> lK(dof*dof,eNoN,eNoN);
-  Array<double> ksix(nsd,nsd); 
-
-  for (int e = 0; e < lM.nEl; e++) {
-    // Update domain and proceed if domain phys and eqn phys match
-    cDmn = all_fun::domain(com_mod, lM, cEq, e);
-    auto cPhys = eq.dmn[cDmn].phys;
-    if (cPhys != EquationType::phys_heatS) {
-      continue;
-    }
+  // Loop over the elements whose domain phys matches the eqn phys
+  //
+  eq_assem::loop_elements(com_mod, lM, EquationType::phys_heatS, [&](const int e, ElementWorkspace& ws) {
+    auto ptr = ws.ivector(eNoN);
+    auto xl = ws.array(nsd,eNoN);
+    auto al = ws.array(tDof,eNoN);
+    auto yl = ws.array(tDof,eNoN);
+    auto Nx = ws.array(nsd,eNoN);
+    auto lR = ws.array(dof,eNoN);
+    auto lK = ws.array3(dof*dof,eNoN,eNoN);
+    auto ksix = ws.array(nsd,nsd);
 
     // Update shape functions for NURBS
     if (lM.eType == ElementType::NRB) {
@@ -112,15 +109,17 @@ void construct_heats(ComMod& com_mod, const mshType& lM, const Array<double>& Ag
 
     for (int g = 0; g < lM.nG; g++) {
       if (g == 0 || !lM.lShpF) {
-        auto Nx_g = lM.Nx.slice(g);
-        nn::gnn(eNoN, nsd, nsd, Nx_g, xl, Nx, Jac, ksix);
+        if (!nn::get_geo_cache(lM, e, Nx, Jac, ksix)) {
+          auto Nx_g = lM.Nx.rslice(g);
+          nn::gnn(eNoN, nsd, nsd, Nx_g, xl, Nx, Jac, ksix);
+        }
         if (utils::is_zero(Jac)) {
           throw std::runtime_error("[construct_heats] Jacobian for element " + std::to_string(e) + " is < 0.");
         }
       }
 
       double w = lM.w(g) * Jac;
-      N = lM.N.col(g);
+      auto N = lM.N.rcol(g);
 
       if (nsd == 3) {
         heats_3d(com_mod, eNoN, w, N, Nx, al, yl, lR, lK);
@@ -129,8 +128,8 @@ void construct_heats(ComMod& com_mod, const mshType& lM, const Array<double>& Ag
       }
     }
 
-    eq.linear_algebra->assemble(com_mod, eNoN, ptr, lK, lR);
-  }
+    eq.linear_algebra->assemble_element(com_mod, lM, e, eNoN, ptr, lK, lR);
+  });
 }
 
 void heats_2d(ComMod& com_mod, const int eNoN, const double w, const Vector<double>& N, const Array<double>& Nx, 
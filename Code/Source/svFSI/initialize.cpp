@@ -43,6 +43,7 @@
 #include "mat_fun.h"
 #include "nn.h"
 #include "output.h"
+#include "partition_cache.h"
 #include "post.h"
 #include "set_bc.h"
 #include "txt.h"
@@ -85,7 +86,6 @@ void init_from_bin(Simulation* simulation, const std::string& fName, std::array<
   dmsg.banner();
   #endif
 
-  auto const recLn = com_mod.recLn;
   auto& cm_mod = simulation->cm_mod;
   auto& cep_mod = simulation->cep_mod;
   auto& cem = cep_mod.cem;
@@ -111,12 +111,31 @@ void init_from_bin(Simulation* simulation, const std::string& fName, std::array<
   // Open file and position at the location in the file
   // for the current process.
   //
+  // The record length is read from the file because it was computed for 
+  // the mesh used when the file was written, which may have been changed 
+  // by remeshing since then.
+  //
   std::ifstream bin_file(fName, std::ios::binary | std::ios::in);
+  int file_recLn = 0;
+  bool format_ok = output::read_restart_format(bin_file, file_recLn);
+
+  if (!cm.reduce(cm_mod, static_cast<int>(format_ok), MPI_MIN)) {
+    throw std::runtime_error("The restart file '" + fName + "' has an unsupported or old restart format.");
+  }
+
   int process_id = cm.tF(cm_mod);
-  std::streampos write_pos = (process_id  - 1) * recLn;
+  std::streampos write_pos = static_cast<std::streamoff>(process_id  - 1) * file_recLn;
   bin_file.seekg(write_pos);
   //OPEN(fid, FILE=fName, ACCESS='DIRECT', RECL=recLn)
 
+  // Check that the record of each process is complete.
+  //
+  bool valid = output::check_restart_record(bin_file, file_recLn);
+
+  if (!cm.reduce(cm_mod, static_cast<int>(valid), MPI_MIN)) {
+    throw std::runtime_error("The restart file '" + fName + "' is incomplete or corrupted (checksum mismatch).");
+  }
+
   std::array<int,7> tStamp;
   auto& cplBC = com_mod.cplBC;
   auto& Ad = com_mod.Ad;
@@ -508,12 +527,17 @@ void initialize(Simulation* simulation, Vector<double>& timeP)
     if (cep_mod.cem.cpld) i = i + 1;
   }
 
-  i = sizeof(int)*(1+com_mod.stamp.size()) + sizeof(double)*(2 + com_mod.nEq + com_mod.cplBC.nX + i*com_mod.tnNo);
+  // The header holds the format magic number and version, the stamp, the 
+  // record length and cTS.
+  i = sizeof(int)*(4+com_mod.stamp.size()) + sizeof(double)*(2 + com_mod.nEq + com_mod.cplBC.nX + i*com_mod.tnNo);
 
   if (com_mod.ibFlag) {
     i = i + sizeof(double)*(3*nsd + 1) * com_mod.ib.tnNo;
   }
 
+  // Checksum of the record.
+  i = i + sizeof(uint64_t);
+
   if (cm.seq()) {
     recLn = i;
   } else { 
@@ -551,6 +575,31 @@ void initialize(Simulation* simulation, Vector<double>& timeP)
   int nnz = 0;
   lhsa_ns::lhsa(simulation, nnz);
 
+  // Map element local matrix entries to the sparse matrix values.
+  //
+  lhsa_ns::set_elem_val_ptr(com_mod);
+
+  // Color mesh elements for threaded assembly.
+  //
+  if (cm.nT() > 1) {
+    lhsa_ns::set_elem_colors(com_mod);
+  }
+
+  // Allocate the workspaces used to store element local arrays, one for
+  // each assembly thread. The initial size covers the nodal copies and 
+  // the element residual and tangent.
+  //
+  int max_enon = 0;
+  for (auto& mesh : com_mod.msh) { 
+    max_enon = std::max(max_enon, 2*mesh.eNoN);
+  }
+  const int ws_size = max_enon*(8*tDof + 8*nsd) + tDof*tDof*max_enon*max_enon;
+  com_mod.elem_workspace.resize(cm.nT());
+
+  for (auto& ws : com_mod.elem_workspace) {
+    ws.allocate(ws_size);
+  }
+
   int gnnz = nnz;
   MPI_Allreduce(&nnz, &gnnz, 1, cm_mod::mpint, MPI_SUM, cm.com());
 
@@ -570,8 +619,15 @@ void initialize(Simulation* simulation, Vector<double>& timeP)
 
   fsi_linear_solver::fsils_commu_create(communicator, cm.com());
 
-  fsi_linear_solver::fsils_lhs_create(com_mod.lhs, communicator, com_mod.gtnNo, com_mod.tnNo, nnz, 
-      com_mod.ltg, com_mod.rowPtr, com_mod.colPtr, nFacesLS);
+  // The FSILS node ordering and communication structure are read from the
+  // partition cache if they were saved by a previous run.
+  //
+  if (!partition_cache::read_lhs(com_mod, cm_mod, communicator, nnz, nFacesLS)) {
+    fsi_linear_solver::fsils_lhs_create(com_mod.lhs, communicator, com_mod.gtnNo, com_mod.tnNo, nnz, 
+        com_mod.ltg, com_mod.rowPtr, com_mod.colPtr, nFacesLS);
+    partition_cache::write_lhs(com_mod, nnz);
+  }
+  com_mod.lhs.nThreads = cm.nT();
 
   // Variable allocation and initialization
   int tnNo = com_mod.tnNo; 
@@ -733,6 +789,8 @@ void initialize(Simulation* simulation, Vector<double>& timeP)
   for (int iM = 0; iM < nMsh; iM++) { 
     auto& mesh = com_mod.msh[iM];
     fs::init_fs_msh(com_mod, mesh);
+    fs::init_thood_fs_msh(com_mod, mesh);
+    nn::init_geo_cache(com_mod, mesh);
     for (int iFa = 0; iFa < com_mod.msh[iM].nFa; iFa++) { 
       fs::init_fs_face(com_mod, mesh, mesh.fa[iFa]);
     }
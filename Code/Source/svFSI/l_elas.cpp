@@ -85,10 +85,11 @@ void construct_l_elas(ComMod& com_mod, const mshType& lM, const Array<double>& A
   int eNoN = lM.eNoN;
 
   Vector<int> ptr(eNoN);
-  Vector<double> pSl(nsymd), N(eNoN);
+  Vector<double> pSl(nsymd);
   Array<double> xl(nsd,eNoN), al(tDof,eNoN), dl(tDof,eNoN), bfl(nsd,eNoN), 
       pS0l(nsymd,eNoN), Nx(nsd,eNoN), lR(dof,eNoN);
   Array3<double> lK(dof*dof,eNoN,eNoN);
+  auto& ws = com_mod.elem_workspace[0];
 
   for (int e = 0; e < lM.nEl; e++) {
     // Update domain and proceed if domain phys and eqn phys match
@@ -98,6 +99,8 @@ void construct_l_elas(ComMod& com_mod, const mshType& lM, const Array<double>& A
       continue;
     }
 
+    ws.reset();
+
     // Update shape functions for NURBS
     if (lM.eType == ElementType::NRB) {
       //CALL NRBNNX(lM, e)
@@ -121,7 +124,7 @@ void construct_l_elas(ComMod& com_mod, const mshType& lM, const Array<double>& A
       }
 
       if (pS0.size() != 0) {
-        pS0l.set_col(a, pS0.col(Ac));
+        pS0l.set_col(a, pS0.rcol(Ac));
       }
     }
 
@@ -131,11 +134,11 @@ void construct_l_elas(ComMod& com_mod, const mshType& lM, const Array<double>& A
     lK = 0.0;
 
     double Jac{0.0};
-    Array<double> ksix(nsd,nsd);
+    auto ksix = ws.array(nsd,nsd);
 
     for (int g = 0; g < lM.nG; g++) {
       if (g == 0 || !lM.lShpF) {
-        auto Nx_g = lM.Nx.slice(g);
+        auto Nx_g = lM.Nx.rslice(g);
         nn::gnn(eNoN, nsd, nsd, Nx_g, xl, Nx, Jac, ksix);
         if (utils::is_zero(Jac)) {
           throw std::runtime_error("[construct_dsolid] Jacobian for element " + std::to_string(e) + " is < 0.");
@@ -143,13 +146,13 @@ void construct_l_elas(ComMod& com_mod, const mshType& lM, const Array<double>& A
       }
 
       double w = lM.w(g) * Jac;
-      N = lM.N.col(g);
+      auto N = lM.N.rcol(g);
       pSl = 0.0;
 
       if (nsd == 3) {
-        l_elas_3d(com_mod, eNoN, w, N, Nx, al, dl, bfl, pS0l, pSl, lR, lK);
+        l_elas_3d(com_mod, eNoN, w, N, Nx, al, dl, bfl, pS0l, pSl, lR, lK, ws);
       } else if (nsd == 2) {
-        l_elas_2d(com_mod, eNoN, w, N, Nx, al, dl, bfl, pS0l, pSl, lR, lK);
+        l_elas_2d(com_mod, eNoN, w, N, Nx, al, dl, bfl, pS0l, pSl, lR, lK, ws);
       }
 
       // Prestress
@@ -164,7 +167,7 @@ void construct_l_elas(ComMod& com_mod, const mshType& lM, const Array<double>& A
       }
     }
 
-    eq.linear_algebra->assemble(com_mod, eNoN, ptr, lK, lR);
+    eq.linear_algebra->assemble_element(com_mod, lM, e, eNoN, ptr, lK, lR);
   }
 }
 
@@ -172,7 +175,8 @@ void construct_l_elas(ComMod& com_mod, const mshType& lM, const Array<double>& A
 //
 void l_elas_2d(ComMod& com_mod, const int eNoN, const double w, const Vector<double>& N,
     const Array<double>& Nx, const Array<double>& al, const Array<double>& dl, const Array<double>& bfl,
-    const Array<double>& pS0l, Vector<double>& pSl, Array<double>& lR, Array3<double>& lK)
+    const Array<double>& pS0l, Vector<double>& pSl, Array<double>& lR, Array3<double>& lK,
+    ElementWorkspace& ws)
 {
   using namespace consts;
 
@@ -197,8 +201,8 @@ void l_elas_2d(ComMod& com_mod, const int eNoN, const double w, const Vector<dou
   double elM = dmn.prop.at(PhysicalProperyType::elasticity_modulus);
   double nu = dmn.prop.at(PhysicalProperyType::poisson_ratio);
 
-  Vector<double> f({dmn.prop.at(PhysicalProperyType::f_x),
-                    dmn.prop.at(PhysicalProperyType::f_y),});
+  double f[2] = {dmn.prop.at(PhysicalProperyType::f_x),
+                 dmn.prop.at(PhysicalProperyType::f_y)};
 
   int i = eq.s;
   int j = i + 1;
@@ -216,13 +220,19 @@ void l_elas_2d(ComMod& com_mod, const int eNoN, const double w, const Vector<dou
   dmsg << "nu: " << nu;
   dmsg << "i: " << i;
   dmsg << "j: " << j;
-  dmsg << "f: " << f;
+  dmsg << "f: " << f[0] << " " << f[1];
   dmsg << "lambda: " << lambda;
   #endif
 
-  Vector<double> ed(3), ud(2), S0(3), S(3);
+  ElementWorkspace::Scope scope(ws);
+  auto ed = ws.vector(3);
+  auto ud = ws.vector(2);
+  auto S0 = ws.vector(3);
+  auto S = ws.vector(3);
 
-  ud = -f;
+  for (int i = 0; i < 2; i++) {
+    ud(i) = -f[i];
+  }
 
   for (int a = 0; a < eNoN; a++) {
     ud(0) = ud(0) + N(a)*(al(i,a)-bfl(0,a));
@@ -246,7 +256,9 @@ void l_elas_2d(ComMod& com_mod, const int eNoN, const double w, const Vector<dou
   pSl = S;
 
   // Add prestress contribution
-  S = pSl + S0;
+  for (int i = 0; i < S.size(); i++) {
+    S(i) = pSl(i) + S0(i);
+  }
 
   for (int a = 0; a < eNoN; a++) {
     lR(0,a) = lR(0,a) + w*(rho*N(a)*ud(0) + Nx(0,a)*S(0) + Nx(1,a)*S(2)); 
@@ -273,7 +285,8 @@ void l_elas_2d(ComMod& com_mod, const int eNoN, const double w, const Vector<dou
 //
 void l_elas_3d(ComMod& com_mod, const int eNoN, const double w, const Vector<double>& N, 
     const Array<double>& Nx, const Array<double>& al, const Array<double>& dl, const Array<double>& bfl, 
-    const Array<double>& pS0l, Vector<double>& pSl, Array<double>& lR, Array3<double>& lK)
+    const Array<double>& pS0l, Vector<double>& pSl, Array<double>& lR, Array3<double>& lK,
+    ElementWorkspace& ws)
 {
   using namespace consts;
 
@@ -298,9 +311,9 @@ void l_elas_3d(ComMod& com_mod, const int eNoN, const double w, const Vector<dou
   double elM = dmn.prop.at(PhysicalProperyType::elasticity_modulus);
   double nu = dmn.prop.at(PhysicalProperyType::poisson_ratio);
 
-  Vector<double> f({dmn.prop.at(PhysicalProperyType::f_x),
-                    dmn.prop.at(PhysicalProperyType::f_y),
-                    dmn.prop.at(PhysicalProperyType::f_z)});
+  double f[3] = {dmn.prop.at(PhysicalProperyType::f_x),
+                 dmn.prop.at(PhysicalProperyType::f_y),
+                 dmn.prop.at(PhysicalProperyType::f_z)};
 
   int i = eq.s;
   int j = i + 1;
@@ -320,13 +333,19 @@ void l_elas_3d(ComMod& com_mod, const int eNoN, const double w, const Vector<dou
   dmsg << "i: " << i;
   dmsg << "j: " << j;
   dmsg << "k: " << k;
-  dmsg << "f: " << f;
+  dmsg << "f: " << f[0] << " " << f[1] << " " << f[2];
   dmsg << "lambda: " << lambda;
   #endif
 
-  Vector<double> ed(6), ud(3), S0(6), S(6);
+  ElementWorkspace::Scope scope(ws);
+  auto ed = ws.vector(6);
+  auto ud = ws.vector(3);
+  auto S0 = ws.vector(6);
+  auto S = ws.vector(6);
 
-  ud = -f;
+  for (int i = 0; i < 3; i++) {
+    ud(i) = -f[i];
+  }
 
   for (int a = 0; a < eNoN; a++) {
     ud(0) = ud(0) + N(a)*(al(i,a)-bfl(0,a));
@@ -360,7 +379,9 @@ void l_elas_3d(ComMod& com_mod, const int eNoN, const double w, const Vector<dou
   pSl = S;
 
   // Add prestress contribution
-  S = pSl + S0;
+  for (int i = 0; i < S.size(); i++) {
+    S(i) = pSl(i) + S0(i);
+  }
 
   for (int a = 0; a < eNoN; a++) {
     lR(0,a) = lR(0,a) + w*(rho*N(a)*ud(0) + Nx(0,a)*S(0) + Nx(1,a)*S(3) + Nx(2,a)*S(5));
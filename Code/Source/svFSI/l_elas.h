@@ -42,11 +42,13 @@ void construct_l_elas(ComMod& com_mod, const mshType& lM, const Array<double>& A
 
 void l_elas_2d(ComMod& com_mod, const int eNoN, const double w, const Vector<double>& N, 
     const Array<double>& Nx, const Array<double>& al, const Array<double>& dl, const Array<double>& bfl, 
-    const Array<double>& pS0l, Vector<double>& pSl, Array<double>& lR, Array3<double>& lK);
+    const Array<double>& pS0l, Vector<double>& pSl, Array<double>& lR, Array3<double>& lK,
+    ElementWorkspace& ws);
 
 void l_elas_3d(ComMod& com_mod, const int eNoN, const double w, const Vector<double>& N, 
     const Array<double>& Nx, const Array<double>& al, const Array<double>& dl, const Array<double>& bfl, 
-    const Array<double>& pS0l, Vector<double>& pSl, Array<double>& lR, Array3<double>& lK);
+    const Array<double>& pS0l, Vector<double>& pSl, Array<double>& lR, Array3<double>& lK,
+    ElementWorkspace& ws);
 
 };
 
@@ -35,50 +35,11 @@
 #include "consts.h"
 #include "utils.h"
 
-namespace lhsa_ns {
-
-void add_col(const int tnNo, const int row, const int col, int& mnnzeic, Array<int>& uInd)
-{
-  int i = -1;
+#include <algorithm>
+#include <numeric>
+#include <unordered_map>
 
-  while (true) {
-    i = i + 1;
-    if (i == mnnzeic) {
-      resiz(tnNo, mnnzeic, uInd);
-    }
-
-    // If current entry is zero, then  fill it up
-    if (uInd(i,row) == -1) {
-       uInd(i,row) = col;
-       break;
-    }
-
-    // If current entry is still smaller, keep going
-    if (col > uInd(i,row)) { 
-      continue;
-    }
-
-    // If column entry already exists, exit
-    if (col == uInd(i,row)) { 
-      break;
-    }
-
-    // If we are this point, then then the current entry is bigger.
-    // Shift all the entries from here to the end of the list. If
-    // list is full, we request a larger list, otherwise we shift
-    // and add the item at the current entry position.
-    //
-    if (uInd(mnnzeic-1,row) != -1) {
-      resiz(tnNo, mnnzeic, uInd);
-    }
-
-    for (int j = mnnzeic - 1; j >= i+1; j--) {
-       uInd(j, row) = uInd(j-1, row);
-    }
-    uInd(i,row) = col;
-    break;
-  } 
-}
+namespace lhsa_ns {
 
 /// @brief This subroutine assembles the element stiffness matrix into the 
 /// global stiffness matrix (Val sparse matrix formatted as a vector). Also
@@ -140,11 +101,59 @@ void do_assem(ComMod& com_mod, const int d, const Vector<int>& eqN, const Array3
   }
 }
 
+/// @brief Assemble the local element arrays of element 'e' of mesh 'lM' 
+/// using the precomputed element to CSR map lM.valPtr, avoiding the column
+/// search of do_assem(). 
+///
+/// Falls back to do_assem() if the map has not been built for the mesh or
+/// does not match the number of element nodes. 'eqN' must be lM.IEN(:,e).
+//
+void do_assem(ComMod& com_mod, const mshType& lM, const int e, const int d, const Vector<int>& eqN, 
+    const Array3<double>& lK, const Array<double>& lR)
+{
+  const auto& valPtr = lM.valPtr;
+
+  if ((valPtr.ncols() != lM.nEl) || (valPtr.nrows() != d*d)) {
+    do_assem(com_mod, d, eqN, lK, lR);
+    return;
+  }
+
+  auto& R = com_mod.R;
+  auto& Val = com_mod.Val;
+  const int nr = R.nrows();
+  const int nv = Val.nrows();
+  double* val_data = Val.data();
+  const double* lK_data = lK.data();
+
+  for (int a = 0; a < d; a++) {
+    int rowN = eqN(a);
+
+    for (int i = 0; i < nr; i++) {
+      R(i,rowN) += lR(i,a);
+    }
+
+    for (int b = 0; b < d; b++) {
+      double* val = val_data + nv*valPtr(a*d+b,e);
+      const double* lk = lK_data + nv*(a + b*d);
+
+      #pragma omp simd
+      for (int i = 0; i < nv; i++) {
+        val[i] += lk[i];
+      }
+    }
+  }
+}
+
 //------
 // lhsa
 //------
 // Create data structure and assembling LHS sparse matrix.
 //
+// The columns of a row are the nodes of the elements containing the row 
+// node. They are collected from a node to element adjacency list, using a 
+// marker array to skip duplicates, and sorted. Rows are first counted and 
+// then filled so that colPtr is allocated only once.
+//
 // Modifies:
 //   com_mod.idMap
 //   com_mod.colPtr.resize(nnz); 
@@ -155,7 +164,13 @@ void lhsa(Simulation* simulation, int& nnz)
   using namespace consts;
 
   auto& com_mod = simulation->com_mod;
+  auto& cm_mod = simulation->cm_mod;
+  auto& cm = com_mod.cm;
+  double start_time = utils::cput();
+
   auto& idMap = com_mod.idMap;
+  auto& rowPtr = com_mod.rowPtr;
+  auto& colPtr = com_mod.colPtr;
   int tnNo = com_mod.tnNo;
   idMap.resize(tnNo);
 
@@ -163,86 +178,138 @@ void lhsa(Simulation* simulation, int& nnz)
     idMap[a] = a;
   }
 
-  int max_enon = std::numeric_limits<int>::min();
-  for (auto& mesh : com_mod.msh) { 
-    max_enon = std::max(mesh.eNoN, max_enon);
+  // Node lists of all elements. Shells with triangular elements also couple
+  // the nodes of their neighboring elements (eIEN).
+  //
+  int num_elems = 0;
+  int num_elem_nodes = 0;
+
+  for (auto& msh : com_mod.msh) {
+    bool shell_tri = com_mod.shlEq && (msh.eType == ElementType::TRI3);
+    if (shell_tri && !msh.lShl) {
+      continue;
+    }
+    num_elems += msh.nEl;
+    num_elem_nodes += (shell_tri ? 2 : 1) * msh.eNoN * msh.nEl;
   }
 
-  int mnnzeic = 10 * max_enon; 
+  std::vector<int> elemPtr(num_elems+1);
+  std::vector<int> elemNodes(num_elem_nodes);
+  int k = 0;
+  int n = 0;
+  elemPtr[0] = 0;
 
-  // First fill uInd array depending on mesh connectivity as is.
-  //
-  // Set uInd = -1 for checking end of rows/columns.
-  //
-  Array<int> uInd(mnnzeic, tnNo);
-  uInd = -1;
-  int nMsh = com_mod.nMsh;
-
-  for (int iM = 0; iM < nMsh; iM++) {
-    auto& msh = com_mod.msh[iM];
-    if (com_mod.shlEq && msh.eType == ElementType::TRI3) {
+  for (auto& msh : com_mod.msh) {
+    bool shell_tri = com_mod.shlEq && (msh.eType == ElementType::TRI3);
+    if (shell_tri && !msh.lShl) {
       continue;
     }
+
     for (int e = 0; e < msh.nEl; e++) {
       for (int a = 0; a < msh.eNoN; a++) { 
-        int rowN = msh.IEN(a,e);
-        for (int b = 0; b < msh.eNoN; b++) {
-          int colN = msh.IEN(b,e);
-          add_col(tnNo, rowN, colN, mnnzeic, uInd);
+        elemNodes[n++] = msh.IEN(a,e);
+      }
+
+      if (shell_tri) {
+        for (int a = 0; a < msh.eNoN; a++) { 
+          if (msh.eIEN(a,e) != -1) {
+            elemNodes[n++] = msh.eIEN(a,e);
+          }
         }
       }
+
+      elemPtr[++k] = n;
     }
   }
 
-  // Treat shells with triangular elements here
+  // Node to element adjacency.
   //
-  for (int iM = 0; iM < nMsh; iM++) {
-    auto& msh = com_mod.msh[iM];
+  std::vector<int> nodeElemPtr(tnNo+1, 0);
 
-    if (!com_mod.shlEq || !msh.lShl) { 
-      continue;
-    }
+  for (int i = 0; i < n; i++) {
+    nodeElemPtr[elemNodes[i]+1] += 1;
+  }
 
-    if (msh.eType != ElementType::TRI3) {
-      continue;
-    }
+  for (int a = 0; a < tnNo; a++) {
+    nodeElemPtr[a+1] += nodeElemPtr[a];
+  }
 
-    if (msh.eType == ElementType::NRB) {
-      continue;
-    }
+  std::vector<int> nodeElems(n);
+  std::vector<int> next(nodeElemPtr.begin(), nodeElemPtr.end()-1);
 
-    for (int e = 0; e < msh.nEl; e++) {
-      for (int a = 0; a < 2*msh.eNoN; a++) { 
-        int rowN;
+  for (int e = 0; e < num_elems; e++) {
+    for (int i = elemPtr[e]; i < elemPtr[e+1]; i++) {
+      nodeElems[next[elemNodes[i]]++] = e;
+    }
+  }
 
-        if (a < msh.eNoN) {
-          rowN = msh.IEN(a,e);
-        } else { 
-          rowN = msh.eIEN(a-msh.eNoN,e);
-        }
+  // Count the columns of each row, then fill and sort them.
+  //
+  std::vector<int> marker(tnNo, -1);
+  rowPtr.resize(tnNo+1);
+  rowPtr(0) = 0;
 
-        if (rowN == -1) { 
-          continue;
+  for (int rowN = 0; rowN < tnNo; rowN++) { 
+    int num_cols = 0;
+    for (int i = nodeElemPtr[rowN]; i < nodeElemPtr[rowN+1]; i++) {
+      int e = nodeElems[i];
+      for (int j = elemPtr[e]; j < elemPtr[e+1]; j++) {
+        int colN = elemNodes[j];
+        if (marker[colN] != rowN) {
+          marker[colN] = rowN;
+          num_cols += 1;
         }
+      }
+    }
+    rowPtr(rowN+1) = rowPtr(rowN) + num_cols;
+  }
 
-        int colN;
-
-        for (int b = 0; b < 2*msh.eNoN; b++) {
-          if (b < msh.eNoN) {
-            colN = msh.IEN(b,e);
-          } else { 
-            colN = msh.eIEN(b-msh.eNoN,e);
-          }
-          if (colN == -1) { 
-            continue;
-          }
+  nnz = rowPtr(tnNo);
+  colPtr.resize(nnz); 
+  std::fill(marker.begin(), marker.end(), -1);
 
-          add_col(tnNo, rowN, colN, mnnzeic, uInd);
+  for (int rowN = 0; rowN < tnNo; rowN++) { 
+    int j = rowPtr(rowN);
+    for (int i = nodeElemPtr[rowN]; i < nodeElemPtr[rowN+1]; i++) {
+      int e = nodeElems[i];
+      for (int l = elemPtr[e]; l < elemPtr[e+1]; l++) {
+        int colN = elemNodes[l];
+        if (marker[colN] != rowN) {
+          marker[colN] = rowN;
+          colPtr(j++) = colN;
         }
       }
     }
+    std::sort(colPtr.data() + rowPtr(rowN), colPtr.data() + rowPtr(rowN+1));
   }
 
+  // Rows changed by the treatment of undeforming Neumann BC faces below, 
+  // kept sorted.
+  //
+  std::unordered_map<int, std::vector<int>> new_rows;
+
+  auto row_size = [&](const int rowN) -> int {
+    auto it = new_rows.find(rowN);
+    return (it != new_rows.end()) ? it->second.size() : rowPtr(rowN+1) - rowPtr(rowN);
+  };
+
+  auto row_col = [&](const int rowN, const int i) -> int {
+    auto it = new_rows.find(rowN);
+    return (it != new_rows.end()) ? it->second[i] : colPtr(rowPtr(rowN) + i);
+  };
+
+  auto add_col = [&](const int rowN, const int colN) {
+    auto it = new_rows.find(rowN);
+    if (it == new_rows.end()) {
+      it = new_rows.emplace(rowN, std::vector<int>(colPtr.data() + rowPtr(rowN), colPtr.data() + rowPtr(rowN+1))).first;
+    }
+    auto& cols = it->second;
+    auto pos = std::lower_bound(cols.begin(), cols.end(), colN);
+    if ((pos == cols.end()) || (*pos != colN)) {
+      cols.insert(pos, colN);
+    }
+  };
+
   // Now reset idMap for undeforming Neumann BC faces. Then insert
   // master node as a column entry in each row for all the slave nodes.
   // This step is performed even for ghost master nodes where the idMap
@@ -270,7 +337,7 @@ void lhsa(Simulation* simulation, int& nnz)
           }
           idMap(rowN) = masN;
           // Insert master to the row if not already present
-          add_col(tnNo, rowN, masN, mnnzeic, uInd);
+          add_col(rowN, masN);
         }
 
         flag = true; 
@@ -278,27 +345,20 @@ void lhsa(Simulation* simulation, int& nnz)
     }
   }
 
-  // Change uInd if idMap has been changed
+  // Change the rows if idMap has been changed
   //
   if (flag) {
     for (int a = 0; a < tnNo; a++) {
       int rowN = idMap(a);
 
       // If the mapping is not changed, examine the mapping of the
-      // column entries of uInd. Don't do anything if the mapping is
-      // unchanged. If the mapping is changed, then add to the column\
-      // indices of uInd if the entry is not already present.
+      // column entries of the row. Don't do anything if the mapping is
+      // unchanged. If the mapping is changed, then add to the column
+      // indices of the row if the entry is not already present.
       //
       if (rowN == a) {
-        int i = -1;
-
-        while (true) { 
-          i = i + 1;
-          int b = uInd(i,rowN);
-          // Terminate if end of column entries are reached
-          if (b == -1) {
-            break;
-          }
+        for (int i = 0; i < row_size(rowN); i++) {
+          int b = row_col(rowN, i);
           int colN = idMap(b);
           // Ignore if the column entry mapping is not changed.
           // This entry is already present and will be used to
@@ -311,10 +371,7 @@ void lhsa(Simulation* simulation, int& nnz)
           // search all column entries and insert the new node if
           // it is not present. This step is performed to assemble
           // the Divergence (C) matrix
-          add_col(tnNo, rowN, colN, mnnzeic, uInd);
-          if (i == mnnzeic-1) {
-            break;
-          }
+          add_col(rowN, colN);
         }
 
       // If the row mapping is changed, insert the mapped/unmapped
@@ -322,90 +379,232 @@ void lhsa(Simulation* simulation, int& nnz)
       // already present.
 
       } else { 
-        int i = -1;
-        while (true) { 
-          i = i + 1;
-          int b = uInd(i,a);
-          // Terminate if end of column entries are reached
-          if (b == -1) {
-            break;
-          }
+        for (int i = 0; i < row_size(a); i++) {
+          int b = row_col(a, i);
 
           // Add unmapped column to assemble gradient matrix
-          add_col(tnNo, rowN, b, mnnzeic, uInd);
+          add_col(rowN, b);
 
           // If column is mapped, add the mapped column to assemble
           // stiffness matrix
           int colN = idMap(b);
           if (b != colN) {
-            add_col(tnNo, rowN, colN, mnnzeic, uInd);
-          }
-          if (i == mnnzeic-1) {
-            break;
+            add_col(rowN, colN);
           }
         }
       }
     }
   }
 
-  // Finding number of non-zeros in colPtr vector
-  nnz = 0;
+  // Rebuild the compact form of rowPtr and colPtr with the changed rows.
+  //
+  if (new_rows.size() != 0) {
+    Vector<int> newRowPtr(tnNo+1);
+    newRowPtr(0) = 0;
+    for (int rowN = 0; rowN < tnNo; rowN++) { 
+      newRowPtr(rowN+1) = newRowPtr(rowN) + row_size(rowN);
+    }
+
+    nnz = newRowPtr(tnNo);
+    Vector<int> newColPtr(nnz);
+
+    for (int rowN = 0; rowN < tnNo; rowN++) { 
+      for (int i = 0; i < row_size(rowN); i++) {
+        newColPtr(newRowPtr(rowN) + i) = row_col(rowN, i);
+      }
+    }
+
+    rowPtr = newRowPtr;
+    colPtr = newColPtr;
+  }
+
   for (int rowN = 0; rowN < tnNo; rowN++) { 
-    if (uInd(0,rowN) == -1) {
+    if (rowPtr(rowN+1) == rowPtr(rowN)) {
       throw std::runtime_error("An isolated node " + std::to_string(rowN) + " has been found during assambly");
     }
-    for (int i = 0; i < mnnzeic; i++) {
-      if (uInd(i,rowN) != -1) {
-        nnz = nnz + 1;
+  }
+
+  double elapsed_time = utils::cput() - start_time;
+  double max_time = elapsed_time;
+  MPI_Reduce(&elapsed_time, &max_time, 1, cm_mod::mpreal, MPI_MAX, cm_mod.master, cm.com());
+
+  if (cm.mas(cm_mod)) {
+    simulation->logger << " Sparse matrix structure: " << nnz << " non-zeros on master process, " 
+        << max_time << " s" << std::endl;
+  }
+}
+
+/// @brief Color the elements of each mesh so that the elements of a color
+/// share no nodes. Element contributions of a color can then be assembled 
+/// into the global residual and stiffness matrix concurrently.
+///
+/// Elements are first grouped by their domain ID (eId) so that all elements 
+/// of a color belong to the same set of domains. Colors are assigned using a 
+/// greedy algorithm: an element gets the smallest color in its group not
+/// already used by an element it shares a node with.
+///
+/// Modifies:
+///   com_mod.msh[].nColors
+///   com_mod.msh[].colorPtr
+///   com_mod.msh[].colorElems
+//
+void set_elem_colors(ComMod& com_mod)
+{
+  const int tnNo = com_mod.tnNo;
+
+  for (auto& msh : com_mod.msh) {
+    const int nEl = msh.nEl;
+    const int eNoN = msh.eNoN;
+    msh.nColors = 0;
+
+    if (nEl == 0) {
+      continue;
+    }
+
+    // Node to element adjacency.
+    //
+    std::vector<int> nodeElemPtr(tnNo+1, 0);
+    for (int e = 0; e < nEl; e++) {
+      for (int a = 0; a < eNoN; a++) {
+        nodeElemPtr[msh.IEN(a,e)+1] += 1;
       }
     }
-  }
+    for (int i = 0; i < tnNo; i++) {
+      nodeElemPtr[i+1] += nodeElemPtr[i];
+    }
 
-  // Now constructing compact form of rowPtr and colPtr
-  //
-  com_mod.colPtr.resize(nnz); 
-  com_mod.rowPtr.resize(tnNo+1);
-  int j = 0;
-  com_mod.rowPtr(0) = 0;
+    std::vector<int> nodeElems(nodeElemPtr[tnNo]);
+    std::vector<int> next(nodeElemPtr.begin(), nodeElemPtr.end()-1);
+    for (int e = 0; e < nEl; e++) {
+      for (int a = 0; a < eNoN; a++) {
+        nodeElems[next[msh.IEN(a,e)]++] = e;
+      }
+    }
 
-  for (int rowN = 0; rowN < tnNo; rowN++) { 
-    for (int i = 0; i < mnnzeic; i++) {
-      if (uInd(i, rowN) != -1) {
-        com_mod.colPtr(j) = uInd(i, rowN);
-        j = j + 1;
+    // Group elements by domain ID.
+    //
+    std::vector<int> order(nEl);
+    std::iota(order.begin(), order.end(), 0);
+
+    if (msh.eId.size() == nEl) {
+      std::stable_sort(order.begin(), order.end(), [&msh](int e1, int e2) { return msh.eId(e1) < msh.eId(e2); });
+    }
+
+    // Greedy coloring, the colors of each group start after the 
+    // colors used by the previous group.
+    //
+    std::vector<int> color(nEl, -1);
+    std::vector<int> mark;
+    int first_color = 0;
+    int num_colors = 0;
+
+    for (int k = 0; k < nEl; k++) {
+      int e = order[k];
+
+      if ((k > 0) && (msh.eId.size() == nEl) && (msh.eId(e) != msh.eId(order[k-1]))) {
+        first_color = num_colors;
+      }
+
+      for (int a = 0; a < eNoN; a++) {
+        int Ac = msh.IEN(a,e);
+        for (int j = nodeElemPtr[Ac]; j < nodeElemPtr[Ac+1]; j++) {
+          int c = color[nodeElems[j]];
+          if (c >= first_color) {
+            mark[c] = e;
+          }
+        }
+      }
+
+      int c = first_color;
+      while ((c < num_colors) && (mark[c] == e)) {
+        c += 1;
+      }
+
+      if (c == num_colors) {
+        num_colors += 1;
+        mark.push_back(-1);
       }
+
+      color[e] = c;
+    }
+
+    // Store the elements of each color in increasing element order.
+    //
+    msh.nColors = num_colors;
+    msh.colorPtr.resize(num_colors+1);
+    msh.colorElems.resize(nEl);
+    msh.colorPtr = 0;
+
+    for (int e = 0; e < nEl; e++) {
+      msh.colorPtr(color[e]+1) += 1;
+    }
+    for (int c = 0; c < num_colors; c++) {
+      msh.colorPtr(c+1) += msh.colorPtr(c);
+    }
+
+    std::vector<int> pos(num_colors);
+    for (int c = 0; c < num_colors; c++) {
+      pos[c] = msh.colorPtr(c);
+    }
+    for (int e = 0; e < nEl; e++) {
+      msh.colorElems(pos[color[e]]++) = e;
     }
-    com_mod.rowPtr(rowN+1) = j;
   }
 }
 
-//-------
-// resiz
-//-------
+/// @brief Build the map from element local matrix entries to the columns of 
+/// the CSR matrix values (com_mod.Val) so that assembly does not need to
+/// search colPtr for each entry. 
+///
+/// Must be called after lhsa(); the map is valid as long as rowPtr/colPtr
+/// and the mesh connectivity do not change.
+///
+/// Modifies:
+///   com_mod.msh[].valPtr
 //
-void resiz(const int tnNo, int& mnnzeic, Array<int>& uInd)
+void set_elem_val_ptr(ComMod& com_mod)
 {
-  int n = mnnzeic;
-  Array<int> tmp(n, tnNo);
-  tmp = -1;
+  using namespace consts;
+
+  const auto& rowPtr = com_mod.rowPtr;
+  const auto& colPtr = com_mod.colPtr;
+
+  for (auto& msh : com_mod.msh) {
+    msh.valPtr.clear();
 
-  for (int i = 0; i < uInd.nrows(); i++) {
-    for (int j = 0; j < uInd.ncols(); j++) {
-      tmp(i,j) = uInd(i,j);
+    // Shells with triangular elements are assembled with their extended 
+    // connectivity (eIEN).
+    if (com_mod.shlEq && msh.eType == ElementType::TRI3) {
+      continue;
     }
-  }
 
-  mnnzeic = n + std::max(5, n/5);
-  uInd.resize(mnnzeic, tnNo);
-  uInd = -1;
+    const int eNoN = msh.eNoN;
+    msh.valPtr.resize(eNoN*eNoN, msh.nEl);
 
-  for (int i = 0; i < tmp.nrows(); i++) {
-    for (int j = 0; j < tmp.ncols(); j++) {
-      uInd(i,j) = tmp(i,j);
+    for (int e = 0; e < msh.nEl; e++) {
+      for (int a = 0; a < eNoN; a++) {
+        int rowN = msh.IEN(a,e);
+
+        for (int b = 0; b < eNoN; b++) {
+          int colN = msh.IEN(b,e);
+          int left = rowPtr(rowN);
+          int right = rowPtr(rowN+1);
+          int ptr = (right + left) / 2;
+
+          while (colN != colPtr(ptr)) {
+            if (colN > colPtr(ptr)) { 
+              left  = ptr;
+            } else { 
+              right = ptr;
+            }
+            ptr = (right + left) / 2;
+          }
+
+          msh.valPtr(a*eNoN+b,e) = ptr;
+        }
+      }
     }
   }
 }
 
 };
-
-
@@ -36,13 +36,16 @@
 
 namespace lhsa_ns {
 
-  void add_col(const int tnNo, const int rowN, const int colN, int& mnnzeic, Array<int>& uInd);
-
   void do_assem(ComMod& com_mod, const int d, const Vector<int>& eqN, const Array3<double>& lK, const Array<double>& lR);
 
+  void do_assem(ComMod& com_mod, const mshType& lM, const int e, const int d, const Vector<int>& eqN, 
+      const Array3<double>& lK, const Array<double>& lR);
+
   void lhsa(Simulation* simulation, int& nnz);
 
-  void resiz(const int tnNo, int& mnnzeic, Array<int>& uInd);
+  void set_elem_colors(ComMod& com_mod);
+
+  void set_elem_val_ptr(ComMod& com_mod);
 
 };
 
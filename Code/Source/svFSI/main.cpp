@@ -69,6 +69,8 @@ void add_eq_linear_algebra(ComMod& com_mod, eqType& lEq)
 {
   lEq.linear_algebra = LinearAlgebraFactory::create_interface(lEq.linear_algebra_type);
   lEq.linear_algebra->set_preconditioner(lEq.linear_algebra_preconditioner);
+  lEq.linear_algebra->set_preconditioner_reuse(lEq.linear_algebra_rebuild_interval, 
+      lEq.linear_algebra_rebuild_iterations, lEq.linear_algebra_refresh_values);
   lEq.linear_algebra->initialize(com_mod, lEq);
 
   if (lEq.linear_algebra_assembly_type != consts::LinearAlgebraType::none) {
@@ -848,6 +850,9 @@ int main(int argc, char *argv[])
     // Run the simulation.
     run_simulation(simulation);
 
+    // Wait for the last restart file to be written.
+    output::wait_restart(simulation);
+
     #ifdef debug_main
     dmsg << "resetSim: " << simulation->com_mod.resetSim;
     #endif
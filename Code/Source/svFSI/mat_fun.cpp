@@ -69,6 +69,25 @@ mat_det(const Array<double>& A, const int nd)
   if (nd == 2) {
     D = A(0,0)*A(1,1) - A(0,1)*A(1,0);
 
+  // Same expansion as below without allocating the minors.
+  //
+  } else if (nd == 3) {
+    for (int i = 0; i < nd; i++) { 
+      double Am[2][2];
+      int n = 0;
+
+      for (int j = 0; j < nd; j++) { 
+        if (i == j) {
+          continue; 
+        }
+        for (int k = 0; k < nd-1; k++) { 
+          Am[k][n] = A(k+1,j);
+        } 
+        n = n + 1;
+      }
+      D = D + pow(-1.0, static_cast<double>(2+i)) * A(0,i) * (Am[0][0]*Am[1][1] - Am[0][1]*Am[1][0]);
+    }
+
   } else { 
     Array<double> Am(nd-1, nd-1);
 
@@ -98,12 +117,21 @@ Array<double>
 mat_dev(const Array<double>& A, const int nd)
 {
   Array<double> result(nd,nd);
+  mat_dev(A, nd, result);
+  return result;
+}
 
+void mat_dev(const Array<double>& A, const int nd, Array<double>& result)
+{
   double trA = mat_trace(A,nd);
+  double s = trA / static_cast<double>(nd);
 
-  result = A - (trA / static_cast<double>(nd)) * mat_id(nd);
-
-  return result;
+  for (int j = 0; j < nd; j++) {
+    for (int i = 0; i < nd; i++) {
+      double Id = (i == j) ? 1.0 : 0.0;
+      result(i,j) = A(i,j) - s * Id;
+    }
+  }
 }
 
 /// @brief Create a matrix from outer product of two vectors.
@@ -112,26 +140,34 @@ Array<double>
 mat_dyad_prod(const Vector<double>& u, const Vector<double>& v, const int nd)
 {
   Array<double> result(nd,nd);
+  mat_dyad_prod(u, v, nd, result);
+  return result;
+}
 
+void mat_dyad_prod(const Vector<double>& u, const Vector<double>& v, const int nd, Array<double>& result)
+{
   for (int j = 0; j < nd; j++) {
     for (int i = 0; i < nd; i++) {
       result(i,j) = u(i) * v(j);
     }
   }
-
-  return result;
 }
 
 Array<double> 
 mat_id(const int nd)
 {
   Array<double> A(nd,nd);
+  mat_id(nd, A);
+  return A;
+}
+
+void mat_id(const int nd, Array<double>& A)
+{
+  A = 0.0;
 
   for (int i = 0; i < nd; i++) {
     A(i,i) = 1.0;
   }
-
-  return A;
 }
 
 /// @brief This function computes inverse of a square matrix
@@ -139,9 +175,34 @@ mat_id(const int nd)
 Array<double> 
 mat_inv(const Array<double>& A, const int nd, bool debug)
 {
-  int iok = 0;
   Array<double> Ainv(nd,nd);
 
+  if (nd <= 3) {
+    mat_inv(A, nd, Ainv);
+    return Ainv;
+  }
+
+  double d = mat_det(A, nd);
+  if (utils::is_zero(fabs(d))) {
+    throw std::runtime_error("Singular matrix detected to compute inverse");
+  }
+
+  if (nd < 10) {
+    Ainv = mat_inv_ge(A, nd, debug);
+  } else {
+    Ainv = mat_inv_lp(A, nd);
+  } 
+
+  return Ainv;
+}
+
+/// @brief Compute the inverse of a square matrix, nd <= 3 is computed
+/// directly into Ainv.
+//
+void mat_inv(const Array<double>& A, const int nd, Array<double>& Ainv)
+{
+  int iok = 0;
+
   if (nd == 2) {
     double d = mat_det(A, nd);
     if (utils::is_zero(fabs(d))) {
@@ -173,22 +234,13 @@ mat_inv(const Array<double>& A, const int nd, bool debug)
     Ainv(2,1) = (A(0,1)*A(2,0) - A(0,0)*A(2,1)) / d;
     Ainv(2,2) = (A(0,0)*A(1,1) - A(0,1)*A(1,0)) / d;
 
-  } else if ((nd > 3) && (nd < 10)) {
-    double d = mat_det(A, nd);
-    if (utils::is_zero(fabs(d))) {
-      iok = -1;
-    }
-    Ainv = mat_inv_ge(A, nd, debug);
-
   } else {
-    Ainv = mat_inv_lp(A, nd);
+    Ainv = mat_inv(A, nd);
   } 
 
   if (iok != 0) {
      throw std::runtime_error("Singular matrix detected to compute inverse");
   }
-
-  return Ainv;
 }
 
 /// @brief This function computes inverse of a square matrix using Gauss Elimination method
@@ -495,6 +547,17 @@ mat_inv_lp_eigen(const Array<double>& A, const int nd)
 //
 Vector<double> 
 mat_mul(const Array<double>& A, const Vector<double>& v)
+{
+  Vector<double> result(A.nrows());
+  mat_mul(A, v, result);
+  return result;
+}
+
+/// @brief Multiply a matrix by a vector.
+///
+/// Compute result directly into the passed argument.
+//
+void mat_mul(const Array<double>& A, const Vector<double>& v, Vector<double>& result)
 {
   int num_rows = A.nrows();
   int num_cols = A.ncols();
@@ -504,8 +567,6 @@ mat_mul(const Array<double>& A, const Vector<double>& v)
         std::to_string(v.size()) + ").");
   }
 
-  Vector<double> result(num_rows);
-
   for (int i = 0; i < num_rows; i++) {
     double sum = 0.0;
 
@@ -515,8 +576,6 @@ mat_mul(const Array<double>& A, const Vector<double>& v)
 
     result(i) = sum;
   }
-
-  return result;
 }
 
 /// @brief Multiply a matrix by a matrix.
@@ -586,14 +645,17 @@ Array<double>
 mat_symm(const Array<double>& A, const int nd)
 {
   Array<double> S(nd, nd);
+  mat_symm(A, nd, S);
+  return S;
+}
 
+void mat_symm(const Array<double>& A, const int nd, Array<double>& S)
+{
   for (int i = 0; i < nd; i++) { 
     for (int j = 0; j < nd; j++) { 
       S(i,j) = 0.5* (A(i,j) + A(j,i));
     }
   }
-
-  return S;
 }
 
 
@@ -603,14 +665,17 @@ Array<double>
 mat_symm_prod(const Vector<double>& u, const Vector<double>& v, const int nd)
 {
   Array<double> result(nd, nd);
+  mat_symm_prod(u, v, nd, result);
+  return result;
+}
 
+void mat_symm_prod(const Vector<double>& u, const Vector<double>& v, const int nd, Array<double>& result)
+{
   for (int i = 0; i < nd; i++) { 
     for (int j = 0; j < nd; j++) { 
       result(i,j) = 0.5 * (u(i)*v(j) + u(j)*v(i));
     }
   }
-
-  return result;
 }
 
 /// @brief Trace of second order matrix of rank nd
@@ -656,8 +721,15 @@ ten_asym_prod12(const Array<double>& A, const Array<double>& B, const int nd)
 Tensor4<double>
 ten_ddot(const Tensor4<double>& A, const Tensor4<double>& B, const int nd)
 {
-  int nn = pow(nd,4);
   Tensor4<double> C(nd,nd,nd,nd);
+  ten_ddot(A, B, nd, C);
+  return C;
+}
+
+void ten_ddot(const Tensor4<double>& A, const Tensor4<double>& B, const int nd, Tensor4<double>& C)
+{
+  int nn = pow(nd,4);
+  C = 0.0;
 
   if (nd == 2) {
     for (int ii = 0; ii < nn; ii++) {
@@ -692,8 +764,6 @@ ten_ddot(const Tensor4<double>& A, const Tensor4<double>& B, const int nd)
 
     }
   }
-
-  return C;
 }
 
 /// @brief T_ijkl = A_imjn * B_mnkl
@@ -701,8 +771,15 @@ ten_ddot(const Tensor4<double>& A, const Tensor4<double>& B, const int nd)
 Tensor4<double>
 ten_ddot_2412(const Tensor4<double>& A, const Tensor4<double>& B, const int nd)
 {
-  int nn = pow(nd,4);
   Tensor4<double> C(nd,nd,nd,nd);
+  ten_ddot_2412(A, B, nd, C);
+  return C;
+}
+
+void ten_ddot_2412(const Tensor4<double>& A, const Tensor4<double>& B, const int nd, Tensor4<double>& C)
+{
+  int nn = pow(nd,4);
+  C = 0.0;
 
   if (nd == 2) {
     for (int ii = 0; ii < nn; ii++) {
@@ -737,16 +814,21 @@ ten_ddot_2412(const Tensor4<double>& A, const Tensor4<double>& B, const int nd)
                               + A(i,2,j,2)*B(2,2,k,l);
     }
   }
-
-  return C;
 }
 
 
 Tensor4<double>
 ten_ddot_3424(const Tensor4<double>& A, const Tensor4<double>& B, const int nd)
 {
-  int nn = pow(nd,4);
   Tensor4<double> C(nd,nd,nd,nd);
+  ten_ddot_3424(A, B, nd, C);
+  return C;
+}
+
+void ten_ddot_3424(const Tensor4<double>& A, const Tensor4<double>& B, const int nd, Tensor4<double>& C)
+{
+  int nn = pow(nd,4);
+  C = 0.0;
 
   if (nd == 2) {
     for (int ii = 0; ii < nn; ii++) {
@@ -781,8 +863,6 @@ ten_ddot_3424(const Tensor4<double>& A, const Tensor4<double>& B, const int nd)
 
     }
   }
-
-  return C;
 }
 
 
@@ -814,8 +894,14 @@ void ten_init(const int nd)
 Tensor4<double>  
 ten_dyad_prod(const Array<double>& A, const Array<double>& B, const int nd)
 {   
-  int nn = pow(nd,4);
   Tensor4<double> C(nd,nd,nd,nd);
+  ten_dyad_prod(A, B, nd, C);
+  return C;
+}
+
+void ten_dyad_prod(const Array<double>& A, const Array<double>& B, const int nd, Tensor4<double>& C)
+{   
+  int nn = pow(nd,4);
   
   for (int ii = 0; ii < nn; ii++) {
     int i = t_ind(0,ii);
@@ -824,8 +910,6 @@ ten_dyad_prod(const Array<double>& A, const Array<double>& B, const int nd)
     int l = t_ind(3,ii);
     C(i,j,k,l) = A(i,j) * B(k,l);
   }
-
-  return C;
 }
 
 /// @brief Create a 4th order order symmetric identity tensor
@@ -834,6 +918,13 @@ Tensor4<double>
 ten_ids(const int nd)
 {
   Tensor4<double> A(nd,nd,nd,nd);
+  ten_ids(nd, A);
+  return A;
+}
+
+void ten_ids(const int nd, Tensor4<double>& A)
+{
+  A = 0.0;
 
   for (int i = 0; i < nd; i++) {
     for (int j = 0; j < nd; j++) {
@@ -841,8 +932,6 @@ ten_ids(const int nd)
       A(i,j,j,i) = A(i,j,j,i) + 0.5;
     }      
   }      
-
-  return A;
 }
 
 /// @brief Double dot product of a 4th order tensor and a 2nd order tensor
@@ -882,8 +971,14 @@ ten_mddot(const Tensor4<double>& A, const Array<double>& B, const int nd)
 Tensor4<double> 
 ten_symm_prod(const Array<double>& A, const Array<double>& B, const int nd)
 {
-  int nn = pow(nd,4);
   Tensor4<double> C(nd,nd,nd,nd);
+  ten_symm_prod(A, B, nd, C);
+  return C;
+}
+
+void ten_symm_prod(const Array<double>& A, const Array<double>& B, const int nd, Tensor4<double>& C)
+{
+  int nn = pow(nd,4);
   
   for (int ii = 0; ii < nn; ii++) {
     int i = t_ind(0,ii);
@@ -892,15 +987,19 @@ ten_symm_prod(const Array<double>& A, const Array<double>& B, const int nd)
     int l = t_ind(3,ii);
     C(i,j,k,l) = 0.5* ( A(i,k)*B(j,l) + A(i,l)*B(j,k) );
   } 
-
-  return C;
 }
 
 Tensor4<double>
 ten_transpose(const Tensor4<double>& A, const int nd)
 { 
-  int nn = pow(nd,4);
   Tensor4<double> result(nd,nd,nd,nd);
+  ten_transpose(A, nd, result);
+  return result;
+}
+
+void ten_transpose(const Tensor4<double>& A, const int nd, Tensor4<double>& result)
+{ 
+  int nn = pow(nd,4);
   
   for (int ii = 0; ii < nn; ii++) {
     int i = t_ind(0,ii);
@@ -909,26 +1008,28 @@ ten_transpose(const Tensor4<double>& A, const int nd)
     int l = t_ind(3,ii);
     result(i,j,k,l) = A(k,l,i,j);
   }
-  
-  return result;
 }
 
 /// Reproduces Fortran TRANSPOSE.
 //
 Array<double> 
 transpose(const Array<double>& A)
+{
+  Array<double> result(A.ncols(), A.nrows());
+  transpose(A, result);
+  return result;
+}
+
+void transpose(const Array<double>& A, Array<double>& result)
 {
   int num_rows = A.nrows();
   int num_cols = A.ncols();
-  Array<double> result(num_cols, num_rows);
 
   for (int i = 0; i < num_rows; i++) {
     for (int j = 0; j < num_cols; j++) {
       result(j,i) = A(i,j);
     }
   }
-
-  return result;
 }
 
 void mat_mul6x3(const Array<double>& A, const Array<double>& B, Array<double>& C)
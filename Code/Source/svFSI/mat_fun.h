@@ -79,6 +79,28 @@ namespace mat_fun {
 
     void ten_init(const int nd);
 
+    // The following functions compute their result directly into the passed
+    // argument, which must already have the right size and must not be one 
+    // of the other arguments. They are used by the Gauss point kernels to 
+    // avoid allocating temporaries (see ElementWorkspace).
+    //
+    void mat_dev(const Array<double>& A, const int nd, Array<double>& result);
+    void mat_dyad_prod(const Vector<double>& u, const Vector<double>& v, const int nd, Array<double>& result);
+    void mat_id(const int nsd, Array<double>& result);
+    void mat_inv(const Array<double>& A, const int nd, Array<double>& result);
+    void mat_mul(const Array<double>& A, const Vector<double>& v, Vector<double>& result);
+    void mat_symm(const Array<double>& A, const int nd, Array<double>& result);
+    void mat_symm_prod(const Vector<double>& u, const Vector<double>& v, const int nd, Array<double>& result);
+
+    void ten_ddot(const Tensor4<double>& A, const Tensor4<double>& B, const int nd, Tensor4<double>& result);
+    void ten_ddot_2412(const Tensor4<double>& A, const Tensor4<double>& B, const int nd, Tensor4<double>& result);
+    void ten_ddot_3424(const Tensor4<double>& A, const Tensor4<double>& B, const int nd, Tensor4<double>& result);
+    void ten_dyad_prod(const Array<double>& A, const Array<double>& B, const int nd, Tensor4<double>& result);
+    void ten_ids(const int nd, Tensor4<double>& result);
+    void ten_symm_prod(const Array<double>& A, const Array<double>& B, const int nd, Tensor4<double>& result);
+    void ten_transpose(const Tensor4<double>& A, const int nd, Tensor4<double>& result);
+
+    void transpose(const Array<double>& A, Array<double>& result);
 };
 
 #endif
@@ -48,22 +48,31 @@ namespace mat_models {
 void actv_strain(const ComMod& com_mod, const CepMod& cep_mod, const double gf, 
     const int nfd, const Array<double>& fl, Array<double>& Fa) 
 {
-  using namespace mat_fun;
-
   int nsd = com_mod.nsd;
-  auto af = fl.col(0);
-  auto as = fl.col(1);
-  auto an = utils::cross(fl);
+  auto af = fl.rcol(0);
+  auto as = fl.rcol(1);
+
+  // Cross product of the fiber and sheet directions, see utils::cross().
+  double an[3];
+
+  if (nsd == 2) {
+    an[0] = fl(1,0);
+    an[1] = -fl(0,0);
+  } else {
+    an[0] = fl(1,0)*fl(2,1) - fl(2,0)*fl(1,1);
+    an[1] = fl(2,0)*fl(0,1) - fl(0,0)*fl(2,1);
+    an[2] = fl(0,0)*fl(1,1) - fl(1,0)*fl(0,1);
+  }
 
   double gn = 4.0 * gf;
   double gs = 1.0 / ((1.0+gf) * (1.0+gn)) - 1.0;
 
-  auto IDm = mat_id(nsd);
-  auto Hf = mat_dyad_prod(af, af, nsd);
-  auto Hs = mat_dyad_prod(as, as, nsd);
-  auto Hn = mat_dyad_prod(an, an, nsd);
-
-  Fa = IDm + gf*Hf + gs*Hs + gn*Hn;
+  for (int j = 0; j < nsd; j++) {
+    for (int i = 0; i < nsd; i++) {
+      double IDm = (i == j) ? 1.0 : 0.0;
+      Fa(i,j) = IDm + gf*(af(i)*af(j)) + gs*(as(i)*as(j)) + gn*(an[i]*an[j]);
+    }
+  }
 }
 
 void cc_to_voigt(const int nsd, const Tensor4<double>& CC, Array<double>& Dm)
@@ -131,19 +140,374 @@ void get_fib_stress(const ComMod& com_mod, const CepMod& cep_mod, const fibStrsT
   if (utils::btest(Tfl.fType, iBC_std)) {
     g = Tfl.g;
   } else if (utils::btest(Tfl.fType, iBC_ustd)) { 
-    Vector<double> gv(1), tv(1);
+    double g_v[1], t_v[1];
+    Vector<double> gv(1, g_v), tv(1, t_v);
     ifft(com_mod, Tfl.gt, gv, tv);
     g = gv[0];
   }
 }
 
+/// @brief Call f(i,j,k,l) for each component of a 4th order tensor of rank nd.
+//
+template <typename Func>
+static void ten_loop(const int nd, Func f)
+{
+  for (int l = 0; l < nd; l++) {
+    for (int k = 0; k < nd; k++) {
+      for (int j = 0; j < nd; j++) {
+        for (int i = 0; i < nd; i++) {
+          f(i,j,k,l);
+        }
+      }
+    }
+  }
+}
+
+/// @brief Compute the isochoric elasticity tensor CC = PP:(CCb:PP)^T from the
+/// fictitious elasticity tensor CCb, with the projection tensor 
+/// PP = Ids - (1/nd) Ci x C.
+//
+static void ten_iso_proj(const int nsd, const Array<double>& Ci, const Array<double>& C, const Tensor4<double>& Ids,
+    const Tensor4<double>& CCb, Tensor4<double>& CC, ElementWorkspace& ws)
+{
+  using namespace mat_fun;
+
+  double nd = static_cast<double>(nsd);
+  auto PP = ws.tensor4(nsd,nsd,nsd,nsd);
+  auto CCt = ws.tensor4(nsd,nsd,nsd,nsd);
+  auto CCtt = ws.tensor4(nsd,nsd,nsd,nsd);
+
+  ten_loop(nsd, [&](int i, int j, int k, int l) {
+    PP(i,j,k,l) = Ids(i,j,k,l) - (1.0/nd) * (Ci(i,j)*C(k,l));
+  });
+
+  ten_ddot(CCb, PP, nsd, CCt);
+  ten_transpose(CCt, nsd, CCtt);
+  ten_ddot(PP, CCtt, nsd, CC);
+}
+
+/// @brief Compute the isochoric and total stress S and elasticity tensor CC
+/// from the fictitious stress Sb and elasticity tensor CCb.
+//
+static void get_s_cc_iso(const int nsd, const Array<double>& C, const Array<double>& Ci, const Tensor4<double>& Ids, 
+    const Array<double>& Sb, const Tensor4<double>& CCb, const double J, const double J2d, const double p, 
+    const double pl, Array<double>& S, Tensor4<double>& CC, ElementWorkspace& ws)
+{
+  using namespace mat_fun;
+
+  double nd = static_cast<double>(nsd);
+  double r1  = J2d*mat_ddot(C, Sb, nsd) / nd;
+
+  for (int j = 0; j < nsd; j++) {
+    for (int i = 0; i < nsd; i++) {
+      S(i,j) = J2d*Sb(i,j) - r1*Ci(i,j);
+    }
+  }
+
+  ten_iso_proj(nsd, Ci, C, Ids, CCb, CC, ws);
+
+  ten_loop(nsd, [&](int i, int j, int k, int l) {
+    CC(i,j,k,l) = CC(i,j,k,l) - (2.0/nd) * ( Ci(i,j)*S(k,l) + S(i,j)*Ci(k,l) );
+  });
+
+  for (int j = 0; j < nsd; j++) {
+    for (int i = 0; i < nsd; i++) {
+      S(i,j) = S(i,j) + p*J*Ci(i,j);
+    }
+  }
+
+  double g1 = 2.0*(r1 - p*J);
+  double g2 = pl*J - 2.0*r1/nd;
+
+  ten_loop(nsd, [&](int i, int j, int k, int l) {
+    double symm = 0.5 * (Ci(i,k)*Ci(j,l) + Ci(i,l)*Ci(j,k));
+    CC(i,j,k,l) = CC(i,j,k,l) + g1 * symm + g2 * (Ci(i,j)*Ci(k,l));
+  });
+}
+
+/// @brief Compute the isochoric stress S and elasticity tensor CC from the 
+/// fictitious stress Sb and elasticity tensor CCb.
+//
+static void get_s_cc_iso_dev(const int nsd, const Array<double>& C, const Array<double>& Ci, const Tensor4<double>& Ids, 
+    const Array<double>& Sb, const Tensor4<double>& CCb, const double J2d, Array<double>& S, Tensor4<double>& CC, 
+    ElementWorkspace& ws)
+{
+  using namespace mat_fun;
+
+  double nd = static_cast<double>(nsd);
+  double r1  = J2d*mat_ddot(C, Sb, nsd) / nd;
+
+  for (int j = 0; j < nsd; j++) {
+    for (int i = 0; i < nsd; i++) {
+      S(i,j) = J2d*Sb(i,j) - r1*Ci(i,j);
+    }
+  }
+
+  ten_iso_proj(nsd, Ci, C, Ids, CCb, CC, ws);
+
+  ten_loop(nsd, [&](int i, int j, int k, int l) {
+    double symm = 0.5 * (Ci(i,k)*Ci(j,l) + Ci(i,l)*Ci(j,k));
+    CC(i,j,k,l) = CC(i,j,k,l) + 2.0*r1 * (symm - (1.0/nd) * (Ci(i,j)*Ci(k,l))) - 
+        (2.0/nd) * (Ci(i,j)*S(k,l) + S(i,j)*Ci(k,l));
+  });
+}
+
+/// @brief Compute the fictitious stress Sb and elasticity tensor CCb of the 
+/// Mooney-Rivlin model.
+//
+static void get_sb_ccb_mr(const stModelType& stM, const int nsd, const Array<double>& Idm, const Array<double>& C, 
+    const Tensor4<double>& Ids, const Array<double>& fl, const double Tfa, const double Inv1, const double J2d, 
+    const double J4d, Array<double>& Sb, Tensor4<double>& CCb)
+{
+  double g1  = 2.0 * (stM.C10 + Inv1*stM.C01);
+  double g2  = -2.0 * stM.C01;
+
+  // Fiber reinforcement/active stress
+  for (int j = 0; j < nsd; j++) {
+    for (int i = 0; i < nsd; i++) {
+      Sb(i,j) = g1*Idm(i,j) + g2*J2d*C(i,j);
+      Sb(i,j) = Sb(i,j) + Tfa*(fl(i,0)*fl(j,0));
+    }
+  }
+
+  g1  = 4.0*J4d* stM.C01;
+  ten_loop(nsd, [&](int i, int j, int k, int l) {
+    CCb(i,j,k,l) = g1 * (Idm(i,j)*Idm(k,l) - Ids(i,j,k,l));
+  });
+}
+
+/// @brief Compute the fictitious stress Sb and elasticity tensor CCb of the 
+/// HGO (Holzapfel-Gasser-Ogden) model.
+//
+static void get_sb_ccb_hgo(const stModelType& stM, const int nsd, const Array<double>& Idm, const Array<double>& C, 
+    const Array<double>& fl, const double Tfa, const double Inv1, const double J2d, const double J4d, 
+    Array<double>& Sb, Tensor4<double>& CCb, ElementWorkspace& ws)
+{
+  using namespace mat_fun;
+
+  auto Cfl = ws.vector(nsd);
+  double kap = stM.kap;
+  mat_mul(C, fl.rcol(0), Cfl);
+  double Inv4 = J2d*utils::norm(fl.rcol(0), Cfl);
+  mat_mul(C, fl.rcol(1), Cfl);
+  double Inv6 = J2d*utils::norm(fl.rcol(1), Cfl);
+
+  double Eff = kap*Inv1 + (1.0-3.0*kap)*Inv4 - 1.0;
+  double Ess = kap*Inv1 + (1.0-3.0*kap)*Inv6 - 1.0;
+
+  auto Hff = ws.array(nsd,nsd);
+  auto Hss = ws.array(nsd,nsd);
+
+  for (int j = 0; j < nsd; j++) {
+    for (int i = 0; i < nsd; i++) {
+      Hff(i,j) = kap*Idm(i,j) + (1.0-3.0*kap)*(fl(i,0)*fl(j,0));
+      Hss(i,j) = kap*Idm(i,j) + (1.0-3.0*kap)*(fl(i,1)*fl(j,1));
+    }
+  }
+
+  double g1 = stM.C10;
+  double g2 = stM.aff * Eff * exp(stM.bff*Eff*Eff);
+  double g3 = stM.ass * Ess * exp(stM.bss*Ess*Ess);
+
+  // Fiber reinforcement/active stress
+  for (int j = 0; j < nsd; j++) {
+    for (int i = 0; i < nsd; i++) {
+      Sb(i,j) = 2.0*(g1*Idm(i,j) + g2*Hff(i,j) + g3*Hss(i,j));
+      Sb(i,j) = Sb(i,j) + Tfa*(fl(i,0)*fl(j,0));
+    }
+  }
+
+  g1 = stM.aff*(1.0 + 2.0*stM.bff*Eff*Eff)*exp(stM.bff*Eff*Eff);
+  g2 = stM.ass*(1.0 + 2.0*stM.bss*Ess*Ess)*exp(stM.bss*Ess*Ess);
+  g1 = 4.0*J4d*g1;
+  g2 = 4.0*J4d*g2;
+
+  ten_loop(nsd, [&](int i, int j, int k, int l) {
+    CCb(i,j,k,l) = g1 * (Hff(i,j)*Hff(k,l)) + g2 * (Hss(i,j)*Hss(k,l));
+  });
+}
+
+/// @brief Compute the fictitious stress Sb and elasticity tensor CCb of the 
+/// Guccione (1995) transversely isotropic model.
+//
+static void get_sb_ccb_gucci(const stModelType& stM, const int nsd, const Array<double>& Idm, const Array<double>& C, 
+    const Array<double>& fl, const double Tfa, const double J2d, const double J4d, Array<double>& Sb, 
+    Tensor4<double>& CCb, ElementWorkspace& ws)
+{
+  using namespace mat_fun;
+
+  // Compute isochoric component of E
+  auto E = ws.array(nsd,nsd);
+
+  for (int j = 0; j < nsd; j++) {
+    for (int i = 0; i < nsd; i++) {
+      E(i,j) = 0.50 * (J2d*C(i,j) - Idm(i,j));
+    }
+  }
+
+  // Transform into local orthogonal coordinate system, the third
+  // direction is the cross product of the first two, see utils::cross().
+  auto Rm = ws.array(nsd,nsd);
+
+  for (int i = 0; i < nsd; i++) {
+    Rm(i,0) = fl(i,0);
+    Rm(i,1) = fl(i,1);
+  }
+
+  Rm(0,2) = fl(1,0)*fl(2,1) - fl(2,0)*fl(1,1);
+  Rm(1,2) = fl(2,0)*fl(0,1) - fl(0,0)*fl(2,1);
+  Rm(2,2) = fl(0,0)*fl(1,1) - fl(1,0)*fl(0,1);
+
+  // Project E to local orthogocal coordinate system
+  auto ERm = ws.array(nsd,nsd);
+  auto RmT = ws.array(nsd,nsd);
+  auto Es = ws.array(nsd,nsd);
+  mat_mul(E, Rm, ERm);
+  transpose(Rm, RmT);
+  mat_mul(RmT, ERm, Es);
+
+  double g1 = stM.bff;
+  double g2 = stM.bss;
+  double g3 = stM.bfs;
+
+  double QQ = g1 *  Es(0,0)*Es(0,0) + 
+              g2 * (Es(1,1)*Es(1,1) + Es(2,2)*Es(2,2) + Es(1,2)*Es(1,2) + Es(2,1)*Es(2,1)) +
+              g3 * (Es(0,1)*Es(0,1) + Es(1,0)*Es(1,0) + Es(0,2)*Es(0,2) + Es(2,0)*Es(2,0));
+
+  double r2 = stM.C10 * exp(QQ);
+
+  // Fiber stiffness contribution := (dE*_ab / dE_IJ)
+  auto R0 = ws.array(nsd,nsd);
+  auto R1 = ws.array(nsd,nsd);
+  auto R2 = ws.array(nsd,nsd);
+  auto R3 = ws.array(nsd,nsd);
+  auto R4 = ws.array(nsd,nsd);
+  auto R5 = ws.array(nsd,nsd);
+
+  mat_dyad_prod(Rm.rcol(0), Rm.rcol(0), nsd, R0);
+  mat_dyad_prod(Rm.rcol(1), Rm.rcol(1), nsd, R1);
+  mat_dyad_prod(Rm.rcol(2), Rm.rcol(2), nsd, R2);
+
+  mat_symm_prod(Rm.rcol(0), Rm.rcol(1), nsd, R3);
+  mat_symm_prod(Rm.rcol(1), Rm.rcol(2), nsd, R4);
+  mat_symm_prod(Rm.rcol(2), Rm.rcol(0), nsd, R5);
+
+  for (int j = 0; j < nsd; j++) {
+    for (int i = 0; i < nsd; i++) {
+      Sb(i,j) = g1 *  Es(0,0) * R0(i,j) + 
+                g2 * (Es(1,1) * R1(i,j) + Es(2,2)*R2(i,j) + 2.0*Es(1,2)*R4(i,j)) +
+          2.0 * g3 * (Es(0,1) * R3(i,j) + Es(0,2)*R5(i,j));
+    }
+  }
+
+  double r4 = r2*J4d;
+
+  ten_loop(nsd, [&](int i, int j, int k, int l) {
+    CCb(i,j,k,l) = r4*(2.0*(Sb(i,j)*Sb(k,l)) + g1 * (R0(i,j)*R0(k,l)) + 
+                           g2 * ((R1(i,j)*R1(k,l)) + (R2(i,j)*R2(k,l)) + 2.0*(R4(i,j)*R4(k,l))) +
+                     2.0 * g3 * ((R3(i,j)*R3(k,l)) + (R5(i,j)*R5(k,l))));
+  });
+
+  // Fiber reinforcement/active stress
+  for (int j = 0; j < nsd; j++) {
+    for (int i = 0; i < nsd; i++) {
+      Sb(i,j) = Sb(i,j) * r2;
+      Sb(i,j) = Sb(i,j) + Tfa*(fl(i,0)*fl(j,0));
+    }
+  }
+}
+
+/// @brief Compute the fictitious stress Sb and elasticity tensor CCb of the 
+/// HO (Holzapfel-Ogden) model.
+//
+static void get_sb_ccb_ho(const stModelType& stM, const int nsd, const Array<double>& Idm, const Array<double>& C, 
+    const Array<double>& fl, const double Tfa, const double Inv1, const double J2d, const double J4d, 
+    Array<double>& Sb, Tensor4<double>& CCb, ElementWorkspace& ws)
+{
+  using namespace mat_fun;
+
+  auto Cfl = ws.vector(nsd);
+  mat_mul(C, fl.rcol(0), Cfl);
+  double Inv4 = J2d*utils::norm(fl.rcol(0), Cfl);
+  mat_mul(C, fl.rcol(1), Cfl);
+  double Inv6 = J2d*utils::norm(fl.rcol(1), Cfl);
+  double Inv8 = J2d*utils::norm(fl.rcol(0), Cfl);
+
+  double Eff = Inv4 - 1.0;
+  double Ess = Inv6 - 1.0;
+  double Efs = Inv8;
+
+  double g1 = stM.a * exp(stM.b*(Inv1-3.0));
+  double g2 = 2.0 * stM.afs * Efs * exp(stM.bfs*Efs*Efs);
+  auto Hfs = ws.array(nsd,nsd);
+  mat_symm_prod(fl.rcol(0), fl.rcol(1), nsd, Hfs);
+
+  for (int j = 0; j < nsd; j++) {
+    for (int i = 0; i < nsd; i++) {
+      Sb(i,j) = g1*Idm(i,j) + g2*Hfs(i,j);
+    }
+  }
+
+  Efs = Efs * Efs;
+  g1 = 2.0*J4d*stM.b*g1;
+  g2 = 4.0*J4d*stM.afs*(1.0 + 2.0*stM.bfs*Efs)* exp(stM.bfs*Efs);
+
+  ten_loop(nsd, [&](int i, int j, int k, int l) {
+    CCb(i,j,k,l) = g1 * (Idm(i,j)*Idm(k,l)) + g2 * (Hfs(i,j)*Hfs(k,l));
+  });
+
+  //  Fiber reinforcement/active stress
+  if (Eff > 0.0) {
+    g1 = Tfa;
+
+    g1 = g1 + 2.0 * stM.aff * Eff * exp(stM.bff*Eff*Eff);
+    auto Hff = ws.array(nsd,nsd);
+    mat_dyad_prod(fl.rcol(0), fl.rcol(0), nsd, Hff);
+
+    for (int j = 0; j < nsd; j++) {
+      for (int i = 0; i < nsd; i++) {
+        Sb(i,j) = Sb(i,j) + g1*Hff(i,j);
+      }
+    }
+
+    Eff = Eff * Eff;
+    g1  = 4.0*J4d*stM.aff*(1.0 + 2.0*stM.bff*Eff)*exp(stM.bff*Eff);
+
+    ten_loop(nsd, [&](int i, int j, int k, int l) {
+      CCb(i,j,k,l) = CCb(i,j,k,l) + g1*(Hff(i,j)*Hff(k,l));
+    });
+  }
+
+  if (Ess > 0.0) {
+    g2 = 2.0 * stM.ass * Ess * exp(stM.bss*Ess*Ess);
+    auto Hss = ws.array(nsd,nsd);
+    mat_dyad_prod(fl.rcol(1), fl.rcol(1), nsd, Hss);
+
+    for (int j = 0; j < nsd; j++) {
+      for (int i = 0; i < nsd; i++) {
+        Sb(i,j) = Sb(i,j) + g2*Hss(i,j);
+      }
+    }
+
+    Ess = Ess * Ess;
+    g2  = 4.0*J4d*stM.ass*(1.0 + 2.0*stM.bss*Ess)*exp(stM.bss*Ess);
+
+    ten_loop(nsd, [&](int i, int j, int k, int l) {
+      CCb(i,j,k,l) = CCb(i,j,k,l) + g2*(Hss(i,j)*Hss(k,l));
+    });
+  }
+}
+
 /// @brief Compute 2nd Piola-Kirchhoff stress and material stiffness tensors
 /// including both dilational and isochoric components.
 ///
+/// The temporary arrays are taken from the element workspace ws and released 
+/// on return.
+///
 /// Reproduces the Fortran 'GETPK2CC' subroutine.
 //
 void get_pk2cc(const ComMod& com_mod, const CepMod& cep_mod, const dmnType& lDmn, const Array<double>& F, const int nfd,
-    const Array<double>& fl, const double ya, Array<double>& S, Array<double>& Dm)
+    const Array<double>& fl, const double ya, Array<double>& S, Array<double>& Dm, ElementWorkspace& ws)
 {
   using namespace consts;
   using namespace mat_fun;
@@ -158,6 +522,7 @@ void get_pk2cc(const ComMod& com_mod, const CepMod& cep_mod, const dmnType& lDmn
   int nsd = com_mod.nsd;
   S = 0.0;
   Dm = 0.0;
+  ElementWorkspace::Scope scope(ws);
 
   // Some preliminaries
   const auto& stM = lDmn.stM;
@@ -174,33 +539,41 @@ void get_pk2cc(const ComMod& com_mod, const CepMod& cep_mod, const dmnType& lDmn
   }
 
   // Electromechanics coupling - active strain
-  auto Fe  = F;
-  auto Fa = mat_id(nsd);
-  auto Fai = Fa;
+  auto Fe = ws.array(nsd,nsd);
+  auto Fa = ws.array(nsd,nsd);
+  auto Fai = ws.array(nsd,nsd);
+  Fe = F;
+  mat_id(nsd, Fa);
+  Fai = Fa;
 
   if (cep_mod.cem.aStrain) {
     actv_strain(com_mod, cep_mod, ya, nfd, fl, Fa);
-    Fai = mat_inv(Fa, nsd);
-    Fe = mat_mul(F, Fai);
+    mat_inv(Fa, nsd, Fai);
+    mat_mul(F, Fai, Fe);
   }
 
   double J = mat_det(Fe, nsd);
   double J2d = pow(J, (-2.0/nd));
   double J4d = J2d*J2d;
 
-  auto Idm = mat_id(nsd);
-  auto C = mat_mul(transpose(Fe), Fe);
-  Array<double> E(nsd,nsd);
+  auto Idm = ws.array(nsd,nsd);
+  auto FeT = ws.array(nsd,nsd);
+  auto C = ws.array(nsd,nsd);
+  auto E = ws.array(nsd,nsd);
+  auto Ci = ws.array(nsd,nsd);
+  mat_id(nsd, Idm);
+  transpose(Fe, FeT);
+  mat_mul(FeT, Fe, C);
+
   for (int i = 0; i < nsd; i++) {
     for (int j = 0; j < nsd; j++) {
       E(i,j) = 0.50 * (C(i,j) - Idm(i,j));
     }
   }
 
-  auto Ci = mat_inv(C, nsd);
+  mat_inv(C, nsd, Ci);
   double trE = mat_trace(E, nsd);
   double Inv1 = J2d * mat_trace(C,nsd);
-  double Inv2 = 0.50 * (Inv1*Inv1 - J4d * mat_trace(mat_mul(C,C), nsd));
 
   // Contribution of dilational penalty terms to S and CC
   double p  = 0.0;
@@ -212,12 +585,22 @@ void get_pk2cc(const ComMod& com_mod, const CepMod& cep_mod, const dmnType& lDmn
 
   // Now, compute isochoric and total stress, elasticity tensors
   //
-  Tensor4<double> CC(nsd,nsd,nsd,nsd);
+  auto CC = ws.tensor4(nsd,nsd,nsd,nsd);
+  auto Ids = ws.tensor4(nsd,nsd,nsd,nsd);
+  ten_ids(nsd, Ids);
+
+  // Fictitious stress and elasticity tensors
+  auto Sb = ws.array(nsd,nsd);
+  auto CCb = ws.tensor4(nsd,nsd,nsd,nsd);
 
   switch (stM.isoType) {
     case ConstitutiveModelType::stIso_lin: {
       double g1 = stM.C10;    // mu
-      S = g1*Idm;
+      for (int j = 0; j < nsd; j++) {
+        for (int i = 0; i < nsd; i++) {
+          S(i,j) = g1*Idm(i,j);
+        }
+      }
       return; 
     } break;
 
@@ -226,8 +609,15 @@ void get_pk2cc(const ComMod& com_mod, const CepMod& cep_mod, const dmnType& lDmn
       double g1 = stM.C10;         // lambda
       double g2 = stM.C01 * 2.0;   // 2*mu
 
-      S = g1*trE*Idm + g2*E;
-      CC = g1 * ten_dyad_prod(Idm, Idm, nsd) + g2*ten_ids(nsd);
+      for (int j = 0; j < nsd; j++) {
+        for (int i = 0; i < nsd; i++) {
+          S(i,j) = g1*trE*Idm(i,j) + g2*E(i,j);
+        }
+      }
+
+      ten_loop(nsd, [&](int i, int j, int k, int l) {
+        CC(i,j,k,l) = g1 * (Idm(i,j)*Idm(k,l)) + g2*Ids(i,j,k,l);
+      });
     } break;
 
     // modified St.Venant-Kirchhoff
@@ -235,18 +625,29 @@ void get_pk2cc(const ComMod& com_mod, const CepMod& cep_mod, const dmnType& lDmn
       double g1 = stM.C10; // kappa
       double g2 = stM.C01;  // mu
 
-      S = g1*log(J)*Ci + g2*(C-Idm);
-      CC = g1 * ( -2.0*log(J)*ten_symm_prod(Ci, Ci, nsd) +
-         ten_dyad_prod(Ci, Ci, nsd) ) + 2.0*g2*ten_ids(nsd);
+      for (int j = 0; j < nsd; j++) {
+        for (int i = 0; i < nsd; i++) {
+          S(i,j) = g1*log(J)*Ci(i,j) + g2*(C(i,j)-Idm(i,j));
+        }
+      }
+
+      ten_loop(nsd, [&](int i, int j, int k, int l) {
+        double symm = 0.5 * (Ci(i,k)*Ci(j,l) + Ci(i,l)*Ci(j,k));
+        CC(i,j,k,l) = g1 * ( -2.0*log(J)*symm + Ci(i,j)*Ci(k,l) ) + 2.0*g2*Ids(i,j,k,l);
+      });
     } break;
 
     // NeoHookean model
     case ConstitutiveModelType::stIso_nHook: {
       double g1 = 2.0 * stM.C10;
-      auto Sb = g1*Idm;
 
       // Fiber reinforcement/active stress
-      Sb += Tfa * mat_dyad_prod(fl.col(0), fl.col(0), nsd);
+      for (int j = 0; j < nsd; j++) {
+        for (int i = 0; i < nsd; i++) {
+          Sb(i,j) = g1*Idm(i,j);
+          Sb(i,j) += Tfa * (fl(i,0)*fl(j,0));
+        }
+      }
 
       double r1 = g1 * Inv1 / nd;
       for (int j = 0; j < S.ncols(); j++) {
@@ -255,35 +656,29 @@ void get_pk2cc(const ComMod& com_mod, const CepMod& cep_mod, const dmnType& lDmn
         }
       }
 
-      CC = (-2.0/nd) * ( ten_dyad_prod(Ci, S, nsd) + ten_dyad_prod(S, Ci, nsd));
-      S += p*J*Ci;
-      CC += 2.0*(r1 - p*J) * ten_symm_prod(Ci, Ci, nsd)  +  (pl*J - 2.0*r1/nd) * ten_dyad_prod(Ci, Ci, nsd);
+      ten_loop(nsd, [&](int i, int j, int k, int l) {
+        CC(i,j,k,l) = (-2.0/nd) * ( Ci(i,j)*S(k,l) + S(i,j)*Ci(k,l) );
+      });
 
+      for (int j = 0; j < nsd; j++) {
+        for (int i = 0; i < nsd; i++) {
+          S(i,j) += p*J*Ci(i,j);
+        }
+      }
+
+      double g2 = 2.0*(r1 - p*J);
+      double g3 = pl*J - 2.0*r1/nd;
+
+      ten_loop(nsd, [&](int i, int j, int k, int l) {
+        double symm = 0.5 * (Ci(i,k)*Ci(j,l) + Ci(i,l)*Ci(j,k));
+        CC(i,j,k,l) += g2 * symm  +  g3 * (Ci(i,j)*Ci(k,l));
+      });
     } break;
 
     //  Mooney-Rivlin model
     case ConstitutiveModelType::stIso_MR: {
-      double g1  = 2.0 * (stM.C10 + Inv1*stM.C01);
-      double g2  = -2.0 * stM.C01;
-      auto Sb = g1*Idm + g2*J2d*C;
-
-      // Fiber reinforcement/active stress
-      Sb = Sb + Tfa*mat_dyad_prod(fl.col(0), fl.col(0), nsd);
-
-      g1  = 4.0*J4d* stM.C01;
-      auto CCb = g1 * (ten_dyad_prod(Idm, Idm, nsd) - ten_ids(nsd));
-
-      double r1  = J2d*mat_ddot(C, Sb, nsd) / nd;
-      S = J2d*Sb - r1*Ci;
-
-      auto PP = ten_ids(nsd) - (1.0/nd) * ten_dyad_prod(Ci, C, nsd);
-      CC = ten_ddot(CCb, PP, nsd);
-      CC = ten_transpose(CC, nsd);
-      CC = ten_ddot(PP, CC, nsd);
-      CC = CC - (2.0/nd) * ( ten_dyad_prod(Ci, S, nsd) + ten_dyad_prod(S, Ci, nsd) );
-
-      S  = S + p*J*Ci;
-      CC = CC + 2.0*(r1 - p*J) * ten_symm_prod(Ci, Ci, nsd) + (pl*J - 2.0*r1/nd) * ten_dyad_prod(Ci, Ci, nsd);
+      get_sb_ccb_mr(stM, nsd, Idm, C, Ids, fl, Tfa, Inv1, J2d, J4d, Sb, CCb);
+      get_s_cc_iso(nsd, C, Ci, Ids, Sb, CCb, J, J2d, p, pl, S, CC, ws);
     } break;
 
     // HGO (Holzapfel-Gasser-Ogden) model with additive splitting of
@@ -292,43 +687,8 @@ void get_pk2cc(const ComMod& com_mod, const CepMod& cep_mod, const dmnType& lDmn
       if (nfd != 2) {
         throw std::runtime_error("[get_pk2cc] Min fiber directions not defined for HGO material model.");
       }
-      double kap = stM.kap;
-      double Inv4 = J2d*utils::norm(fl.col(0), mat_mul(C, fl.col(0)));
-      double Inv6 = J2d*utils::norm(fl.col(1), mat_mul(C, fl.col(1)));
-
-      double Eff = kap*Inv1 + (1.0-3.0*kap)*Inv4 - 1.0;
-      double Ess = kap*Inv1 + (1.0-3.0*kap)*Inv6 - 1.0;
-
-      auto Hff = mat_dyad_prod(fl.col(0), fl.col(0), nsd);
-      Hff = kap*Idm + (1.0-3.0*kap)*Hff;
-      auto Hss = mat_dyad_prod(fl.col(1), fl.col(1), nsd);
-      Hss = kap*Idm + (1.0-3.0*kap)*Hss;
-
-      double g1 = stM.C10;
-      double g2 = stM.aff * Eff * exp(stM.bff*Eff*Eff);
-      double g3 = stM.ass * Ess * exp(stM.bss*Ess*Ess);
-      auto Sb = 2.0*(g1*Idm + g2*Hff + g3*Hss);
-
-      // Fiber reinforcement/active stress
-      Sb = Sb + Tfa*mat_dyad_prod(fl.col(0), fl.col(0), nsd);
-
-      g1 = stM.aff*(1.0 + 2.0*stM.bff*Eff*Eff)*exp(stM.bff*Eff*Eff);
-      g2 = stM.ass*(1.0 + 2.0*stM.bss*Ess*Ess)*exp(stM.bss*Ess*Ess);
-      g1 = 4.0*J4d*g1;
-      g2 = 4.0*J4d*g2;
-
-      auto CCb = g1 * ten_dyad_prod(Hff, Hff, nsd) + g2 * ten_dyad_prod(Hss, Hss, nsd);
-      double r1  = J2d*mat_ddot(C, Sb, nsd) / nd;
-      S = J2d*Sb - r1*Ci;
-
-      auto PP = ten_ids(nsd) - (1.0/nd) * ten_dyad_prod(Ci, C, nsd);
-      CC = ten_ddot(CCb, PP, nsd);
-      CC = ten_transpose(CC, nsd);
-      CC = ten_ddot(PP, CC, nsd);
-      CC = CC - (2.0/nd) * ( ten_dyad_prod(Ci, S, nsd) + ten_dyad_prod(S, Ci, nsd) );
-
-      S = S + p*J*Ci;
-      CC = CC + 2.0*(r1 - p*J) * ten_symm_prod(Ci, Ci, nsd) + (pl*J - 2.0*r1/nd) * ten_dyad_prod(Ci, Ci, nsd);
+      get_sb_ccb_hgo(stM, nsd, Idm, C, fl, Tfa, Inv1, J2d, J4d, Sb, CCb, ws);
+      get_s_cc_iso(nsd, C, Ci, Ids, Sb, CCb, J, J2d, p, pl, S, CC, ws);
     } break;
 
     // Guccione (1995) transversely isotropic model
@@ -336,71 +696,8 @@ void get_pk2cc(const ComMod& com_mod, const CepMod& cep_mod, const dmnType& lDmn
       if (nfd != 2) {
         throw std::runtime_error("[get_pk2cc] Min fiber directions not defined for Guccione material model.");
       }
-
-      // Compute isochoric component of E
-      auto E = 0.50 * (J2d*C - Idm);
-
-      // Transform into local orthogonal coordinate system
-      Array<double> Rm(nsd,nsd);
-
-      Rm.set_col(0, fl.col(0));
-      Rm.set_col(1, fl.col(1));
-      Rm.set_col(2, cross(fl));
-
-      // Project E to local orthogocal coordinate system
-      auto Es = mat_mul(E, Rm);
-      Es = mat_mul(transpose(Rm), Es);
-
-      double g1 = stM.bff;
-      double g2 = stM.bss;
-      double g3 = stM.bfs;
-
-      double QQ = g1 *  Es(0,0)*Es(0,0) + 
-                  g2 * (Es(1,1)*Es(1,1) + Es(2,2)*Es(2,2) + Es(1,2)*Es(1,2) + Es(2,1)*Es(2,1)) +
-                  g3 * (Es(0,1)*Es(0,1) + Es(1,0)*Es(1,0) + Es(0,2)*Es(0,2) + Es(2,0)*Es(2,0));
-
-      double r2 = stM.C10 * exp(QQ);
-
-      // Fiber stiffness contribution := (dE*_ab / dE_IJ)
-      Array3<double> RmRm(nsd,nsd,6);
-
-      RmRm.set_slice(0, mat_dyad_prod(Rm.col(0), Rm.col(0), nsd));
-      RmRm.set_slice(1, mat_dyad_prod(Rm.col(1), Rm.col(1), nsd));
-      RmRm.set_slice(2, mat_dyad_prod(Rm.col(2), Rm.col(2), nsd));
-
-      RmRm.set_slice(3, mat_symm_prod(Rm.col(0), Rm.col(1), nsd));
-      RmRm.set_slice(4, mat_symm_prod(Rm.col(1), Rm.col(2), nsd));
-      RmRm.set_slice(5, mat_symm_prod(Rm.col(2), Rm.col(0), nsd));
-
-      auto Sb = g1 *  Es(0,0) * RmRm.slice(0) + 
-                g2 * (Es(1,1) * RmRm.slice(1) + Es(2,2)*RmRm.slice(2) + 2.0*Es(1,2)*RmRm.slice(4)) +
-          2.0 * g3 * (Es(0,1) * RmRm.slice(3) + Es(0,2)*RmRm.slice(5));
-
-      auto CCb = 2.0*ten_dyad_prod(Sb, Sb, nsd);
-      Sb = Sb * r2;
-
-      // Fiber reinforcement/active stress
-      Sb = Sb + Tfa*mat_dyad_prod(fl.col(0), fl.col(0), nsd);
-
-      double r1 = J2d*mat_ddot(C, Sb, nsd) / nd;
-      S = J2d*Sb - r1*Ci;
-      r2  = r2*J4d;
-
-      CCb = r2*(CCb + g1 * ten_dyad_prod(RmRm.slice(0), RmRm.slice(0), nsd) + 
-                      g2 * (ten_dyad_prod(RmRm.slice(1), RmRm.slice(1), nsd) +
-                           ten_dyad_prod(RmRm.slice(2), RmRm.slice(2), nsd) +
-                           ten_dyad_prod(RmRm.slice(4), RmRm.slice(4), nsd)*2.0) +
-                2.0 * g3 * (ten_dyad_prod(RmRm.slice(3), RmRm.slice(3), nsd) +
-                ten_dyad_prod(RmRm.slice(5), RmRm.slice(5), nsd)));
-
-      auto PP = ten_ids(nsd) - (1.0/nd) * ten_dyad_prod(Ci, C, nsd);
-      CC = ten_ddot(CCb, PP, nsd);
-      CC  = ten_transpose(CC, nsd);
-      CC  = ten_ddot(PP, CC, nsd);
-      CC  = CC - (2.0/nd) * ( ten_dyad_prod(Ci, S, nsd) + ten_dyad_prod(S, Ci, nsd) );
-
-      S  = S + p*J*Ci;
-      CC = CC + 2.0*(r1 - p*J) * ten_symm_prod(Ci, Ci, nsd) + (pl*J - 2.0*r1/nd) * ten_dyad_prod(Ci, Ci, nsd);
+      get_sb_ccb_gucci(stM, nsd, Idm, C, fl, Tfa, J2d, J4d, Sb, CCb, ws);
+      get_s_cc_iso(nsd, C, Ci, Ids, Sb, CCb, J, J2d, p, pl, S, CC, ws);
     } break;
 
     //  HO (Holzapfel-Ogden) model for myocardium (2009)
@@ -408,66 +705,19 @@ void get_pk2cc(const ComMod& com_mod, const CepMod& cep_mod, const dmnType& lDmn
       if (nfd != 2) {
         throw std::runtime_error("[get_pk2cc] Min fiber directions not defined for Holzapfel material model.");
       }
-      double Inv4 = J2d*utils::norm(fl.col(0), mat_mul(C, fl.col(0)));
-      double Inv6 = J2d*utils::norm(fl.col(1), mat_mul(C, fl.col(1)));
-      double Inv8 = J2d*utils::norm(fl.col(0), mat_mul(C, fl.col(1)));
-
-      double Eff = Inv4 - 1.0;
-      double Ess = Inv6 - 1.0;
-      double Efs = Inv8;
-
-      double g1 = stM.a * exp(stM.b*(Inv1-3.0));
-      double g2 = 2.0 * stM.afs * Efs * exp(stM.bfs*Efs*Efs);
-      auto Hfs = mat_symm_prod(fl.col(0), fl.col(1), nsd);
-      auto Sb = g1*Idm + g2*Hfs;
-
-      Efs = Efs * Efs;
-      g1 = 2.0*J4d*stM.b*g1;
-      g2 = 4.0*J4d*stM.afs*(1.0 + 2.0*stM.bfs*Efs)* exp(stM.bfs*Efs);
-      auto CCb  = g1 * ten_dyad_prod(Idm, Idm, nsd) + g2 * ten_dyad_prod(Hfs, Hfs, nsd);
-
-      //  Fiber reinforcement/active stress
-      if (Eff > 0.0) {
-        g1 = Tfa;
-
-        g1 = g1 + 2.0 * stM.aff * Eff * exp(stM.bff*Eff*Eff);
-        auto Hff = mat_dyad_prod(fl.col(0), fl.col(0), nsd);
-        Sb  = Sb + g1*Hff;
-
-        Eff = Eff * Eff;
-        g1  = 4.0*J4d*stM.aff*(1.0 + 2.0*stM.bff*Eff)*exp(stM.bff*Eff);
-        CCb = CCb + g1*ten_dyad_prod(Hff, Hff, nsd);
-      }
-
-      if (Ess > 0.0) {
-        g2 = 2.0 * stM.ass * Ess * exp(stM.bss*Ess*Ess);
-        auto Hss = mat_dyad_prod(fl.col(1), fl.col(1), nsd);
-        Sb  = Sb + g2*Hss;
-
-        Ess = Ess * Ess;
-        g2  = 4.0*J4d*stM.ass*(1.0 + 2.0*stM.bss*Ess)*exp(stM.bss*Ess);
-        CCb = CCb + g2*ten_dyad_prod(Hss, Hss, nsd);
-      }
-
-      double r1 = J2d*mat_ddot(C, Sb, nsd) / nd;
-      S  = J2d*Sb - r1*Ci;
-
-      auto PP = ten_ids(nsd) - (1.0/nd) * ten_dyad_prod(Ci, C, nsd);
-      CC = ten_ddot(CCb, PP, nsd);
-      CC  = ten_transpose(CC, nsd);
-      CC  = ten_ddot(PP, CC, nsd);
-      CC  = CC - (2.0/nd) * ( ten_dyad_prod(Ci, S, nsd) + ten_dyad_prod(S, Ci, nsd) );
-
-      S   = S + p*J*Ci;
-      CC  = CC + 2.0*(r1 - p*J) * ten_symm_prod(Ci, Ci, nsd) + (pl*J - 2.0*r1/nd) * ten_dyad_prod(Ci, Ci, nsd);
+      get_sb_ccb_ho(stM, nsd, Idm, C, fl, Tfa, Inv1, J2d, J4d, Sb, CCb, ws);
+      get_s_cc_iso(nsd, C, Ci, Ids, Sb, CCb, J, J2d, p, pl, S, CC, ws);
 
       if (cep_mod.cem.aStrain) {
-        S = mat_mul(Fai, S);
-        S = mat_mul(S, transpose(Fai));
-        CCb = 0.0;
-        CCb = ten_dyad_prod(Fai, Fai, nsd);
-        CC = ten_ddot_3424(CC, CCb, nsd);
-        CC = ten_ddot_2412(CCb, CC, nsd);
+        auto FaiS = ws.array(nsd,nsd);
+        auto FaiT = ws.array(nsd,nsd);
+        auto CCt = ws.tensor4(nsd,nsd,nsd,nsd);
+        mat_mul(Fai, S, FaiS);
+        transpose(Fai, FaiT);
+        mat_mul(FaiS, FaiT, S);
+        ten_dyad_prod(Fai, Fai, nsd, CCb);
+        ten_ddot_3424(CC, CCb, nsd, CCt);
+        ten_ddot_2412(CCb, CCt, nsd, CC);
       }
     } break;
 
@@ -481,10 +731,13 @@ void get_pk2cc(const ComMod& com_mod, const CepMod& cep_mod, const dmnType& lDmn
 
 /// @brief Compute isochoric (deviatoric) component of 2nd Piola-Kirchhoff stress and material stiffness tensors.
 ///
+/// The temporary arrays are taken from the element workspace ws and released 
+/// on return.
+///
 /// Reproduces 'SUBROUTINE GETPK2CCdev(lDmn, F, nfd, fl, ya, S, Dm, Ja)'. 
 //
 void get_pk2cc_dev(const ComMod& com_mod, const CepMod& cep_mod, const dmnType& lDmn, const Array<double>& F, const int nfd, 
-    const Array<double>& fl, const double ya, Array<double>& S, Array<double>& Dm, double& Ja)
+    const Array<double>& fl, const double ya, Array<double>& S, Array<double>& Dm, double& Ja, ElementWorkspace& ws)
 {
   using namespace consts;
   using namespace mat_fun;
@@ -499,6 +752,7 @@ void get_pk2cc_dev(const ComMod& com_mod, const CepMod& cep_mod, const dmnType&
   int nsd = com_mod.nsd;
   S = 0.0;
   Dm = 0.0;
+  ElementWorkspace::Scope scope(ws);
 
   // Some preliminaries
   auto& stM = lDmn.stM;
@@ -514,14 +768,17 @@ void get_pk2cc_dev(const ComMod& com_mod, const CepMod& cep_mod, const dmnType&
   }
 
   // Electromechanics coupling - active strain
-  auto Fe = F;
-  auto Fa = mat_id(nsd);
-  auto Fai = Fa;
+  auto Fe = ws.array(nsd,nsd);
+  auto Fa = ws.array(nsd,nsd);
+  auto Fai = ws.array(nsd,nsd);
+  Fe = F;
+  mat_id(nsd, Fa);
+  Fai = Fa;
 
   if (cep_mod.cem.aStrain) {
     actv_strain(com_mod, cep_mod, ya, nfd, fl, Fa);
-    Fai = mat_inv(Fa, nsd);
-    Fe = mat_mul(F, Fai);
+    mat_inv(Fa, nsd, Fai);
+    mat_mul(F, Fai, Fe);
   }
 
   #ifdef debug_get_pk2cc_dev 
@@ -534,18 +791,26 @@ void get_pk2cc_dev(const ComMod& com_mod, const CepMod& cep_mod, const dmnType&
   double J2d = pow(J, (-2.0/nd));
   double J4d = J2d * J2d;
 
-  auto IDm = mat_id(nsd);
-  auto C = mat_mul(transpose(Fe), Fe);
-  auto E = 0.5 * (C - IDm);
-  auto Ci = mat_inv(C, nsd);
+  auto IDm = ws.array(nsd,nsd);
+  auto FeT = ws.array(nsd,nsd);
+  auto C = ws.array(nsd,nsd);
+  auto Ci = ws.array(nsd,nsd);
+  mat_id(nsd, IDm);
+  transpose(Fe, FeT);
+  mat_mul(FeT, Fe, C);
+  mat_inv(C, nsd, Ci);
 
-  double trE = mat_trace(E, nsd);
   double Inv1 = J2d * mat_trace(C,nsd);
-  double Inv2 = 0.5 * (Inv1*Inv1 - J4d*mat_trace(mat_mul(C,C), nsd));
 
   // Isochoric part of 2nd Piola-Kirchhoff and elasticity tensors
   //
-  Tensor4<double> CC(nsd,nsd,nsd,nsd);
+  auto CC = ws.tensor4(nsd,nsd,nsd,nsd);
+  auto Ids = ws.tensor4(nsd,nsd,nsd,nsd);
+  ten_ids(nsd, Ids);
+
+  // Fictitious stress and elasticity tensors
+  auto Sb = ws.array(nsd,nsd);
+  auto CCb = ws.tensor4(nsd,nsd,nsd,nsd);
 
   switch (stM.isoType) {
 
@@ -553,45 +818,35 @@ void get_pk2cc_dev(const ComMod& com_mod, const CepMod& cep_mod, const dmnType&
     //
     case ConstitutiveModelType::stIso_nHook: {
       double g1 = 2.0 * stM.C10;
-      auto Sb = g1 * IDm;
 
       // Fiber reinforcement/active stress
-      auto u = fl.col(0);
-      Sb += Tfa * mat_dyad_prod(u, u, nsd);
+      for (int j = 0; j < nsd; j++) {
+        for (int i = 0; i < nsd; i++) {
+          Sb(i,j) = g1 * IDm(i,j);
+          Sb(i,j) += Tfa * (fl(i,0)*fl(j,0));
+        }
+      }
 
       double r1 = g1 * Inv1 / nd;
-      S = J2d*Sb - r1*Ci;
 
-      CC = 2.0 * r1 * (ten_symm_prod(Ci, Ci, nsd) - 1.0/nd * ten_dyad_prod(Ci, Ci, nsd)) - 
-                2.0/nd * (ten_dyad_prod(Ci, S, nsd) + ten_dyad_prod(S, Ci, nsd));
-  
+      for (int j = 0; j < nsd; j++) {
+        for (int i = 0; i < nsd; i++) {
+          S(i,j) = J2d*Sb(i,j) - r1*Ci(i,j);
+        }
+      }
+
+      ten_loop(nsd, [&](int i, int j, int k, int l) {
+        double symm = 0.5 * (Ci(i,k)*Ci(j,l) + Ci(i,l)*Ci(j,k));
+        CC(i,j,k,l) = 2.0 * r1 * (symm - 1.0/nd * (Ci(i,j)*Ci(k,l))) - 
+            2.0/nd * (Ci(i,j)*S(k,l) + S(i,j)*Ci(k,l));
+      });
     } break; 
 
     // Mooney-Rivlin model
     //
     case ConstitutiveModelType::stIso_MR: {
-      double g1 = 2.0 * (stM.C10 + Inv1*stM.C01);
-      double g2 = -2.0 * stM.C01;
-      auto Sb = g1*IDm + g2*J2d*C;
-
-      // Fiber reinforcement/active stress
-      auto u = fl.col(0);
-      Sb += Tfa * mat_dyad_prod(u, u, nsd);
-      g1 = 4.0 * J4d * stM.C01;
-      auto CCb = g1 * (ten_dyad_prod(IDm, IDm, nsd) - ten_ids(nsd));
-
-      double r1  = J2d*mat_ddot(C, Sb, nsd) / nd;
-      S = J2d*Sb - r1*Ci;
-
-      auto PP = ten_ids(nsd) - (1.0/nd) * ten_dyad_prod(Ci, C, nsd);
-
-      CC = ten_ddot(CCb, PP, nsd);
-      CC = ten_transpose(CC, nsd);
-      CC = ten_ddot(PP, CC, nsd);
-
-      CC = CC + 2.0 * r1 * (ten_symm_prod(Ci, Ci, nsd) - (1.0/nd) * ten_dyad_prod(Ci, Ci, nsd)) - 
-                (2.0/nd) * (ten_dyad_prod(Ci, S, nsd) + ten_dyad_prod(S, Ci, nsd));
-
+      get_sb_ccb_mr(stM, nsd, IDm, C, Ids, fl, Tfa, Inv1, J2d, J4d, Sb, CCb);
+      get_s_cc_iso_dev(nsd, C, Ci, Ids, Sb, CCb, J2d, S, CC, ws);
     } break; 
 
     // HGO (Holzapfel-Gasser-Ogden) model with additive splitting of
@@ -601,46 +856,8 @@ void get_pk2cc_dev(const ComMod& com_mod, const CepMod& cep_mod, const dmnType&
       if (nfd != 2) {
         throw std::runtime_error("[get_pk2cc_dev] Min fiber directions not defined for HGO material model.");
       }
-
-      double kap = stM.kap;
-      double Inv4 = J2d * norm(fl.col(0), mat_mul(C, fl.col(0)));
-      double Inv6 = J2d * norm(fl.col(1), mat_mul(C, fl.col(1)));
-
-      double Eff = kap*Inv1 + (1.0 - 3.0*kap) * Inv4 - 1.0;
-      double Ess = kap*Inv1 + (1.0 - 3.0*kap) * Inv6 - 1.0;
-
-      auto Hff = mat_dyad_prod(fl.col(0), fl.col(0), nsd);
-      Hff = kap*IDm + (1.0 - 3.0*kap) * Hff;
-
-      auto Hss = mat_dyad_prod(fl.col(1), fl.col(1), nsd);
-      Hss  = kap*IDm + (1.0 - 3.0*kap) * Hss;
-
-      double g1 = stM.C10;
-      double g2 = stM.aff * Eff * exp(stM.bff*Eff*Eff);
-      double g3 = stM.ass * Ess * exp(stM.bss*Ess*Ess);
-      auto Sb = 2.0 * (g1*IDm + g2*Hff + g3*Hss);
-
-      // Fiber reinforcement/active stress
-      //
-      Sb += Tfa *  mat_dyad_prod(fl.col(0), fl.col(0), nsd); 
-
-      g1 = stM.aff*(1.0 + 2.0*stM.bff*Eff*Eff) * exp(stM.bff*Eff*Eff);
-      g2 = stM.ass*(1.0 + 2.0*stM.bss*Ess*Ess) * exp(stM.bss*Ess*Ess);
-      g1 = 4.0*J4d * g1;
-      g2 = 4.0*J4d * g2;
-
-      auto CCb = g1 * ten_dyad_prod(Hff, Hff, nsd) + g2 * ten_dyad_prod(Hss, Hss, nsd);
-
-      double r1  = J2d*mat_ddot(C, Sb, nsd) / nd;
-      S = J2d*Sb - r1*Ci;
-
-      auto PP = ten_ids(nsd) - (1.0/nd) * ten_dyad_prod(Ci, C, nsd);
-      CC = ten_ddot(CCb, PP, nsd);
-      CC = ten_transpose(CC, nsd);
-      CC = ten_ddot(PP, CC, nsd);
-
-      CC = CC + 2.0*r1 * (ten_symm_prod(Ci, Ci, nsd) - 1.0/nd * ten_dyad_prod(Ci, Ci, nsd)) - 2.0/nd * (ten_dyad_prod(Ci, S, nsd) +
-          ten_dyad_prod(S, Ci, nsd));
+      get_sb_ccb_hgo(stM, nsd, IDm, C, fl, Tfa, Inv1, J2d, J4d, Sb, CCb, ws);
+      get_s_cc_iso_dev(nsd, C, Ci, Ids, Sb, CCb, J2d, S, CC, ws);
     } break; 
 
     // Guccione (1995) transversely isotropic model
@@ -649,138 +866,33 @@ void get_pk2cc_dev(const ComMod& com_mod, const CepMod& cep_mod, const dmnType&
       if (nfd != 2) {
         throw std::runtime_error("[get_pk2cc_dev] Min fiber directions not defined for Guccione material model.");
       }
-
-      // Compute isochoric component of E
-      auto E = 0.5 * (J2d*C - IDm);
-
-      // Transform into local orthogonal coordinate system
-      Array<double> Rm(nsd,nsd);
-      Rm.set_col(0, fl.col(0));
-      Rm.set_col(1, fl.col(1));
-      Rm.set_col(2, cross(fl));
-
-      // Project E to local orthogocal coordinate system
-      auto Es = mat_mul(E, Rm);
-      Es = mat_mul(transpose(Rm), Es);
-
-      double g1 = stM.bff;
-      double g2 = stM.bss;
-      double g3 = stM.bfs;
-
-      auto QQ = g1 *  Es(0,0)*Es(0,0) + 
-                g2 * (Es(1,1)*Es(1,1)  +  Es(2,2)*Es(2,2)  +  Es(1,2)*Es(1,2) + Es(2,1)*Es(2,1)) + 
-                g3 * (Es(0,1)*Es(0,1)  +  Es(1,0)*Es(1,0)  +  Es(0,2)*Es(0,2) + Es(2,0)*Es(2,0));
-
-      auto r2 = stM.C10 * exp(QQ);
-
-      // Fiber stiffness contribution := (dE*_ab / dE_IJ)
-      //
-      Array3<double> RmRm(nsd,nsd,6);
-
-      RmRm.set_slice(0, mat_dyad_prod(Rm.col(0), Rm.col(0), nsd));
-      RmRm.set_slice(1, mat_dyad_prod(Rm.col(1), Rm.col(1), nsd));
-      RmRm.set_slice(2, mat_dyad_prod(Rm.col(2), Rm.col(2), nsd));
-
-      RmRm.set_slice(3, mat_symm_prod(Rm.col(0), Rm.col(1), nsd));
-      RmRm.set_slice(4, mat_symm_prod(Rm.col(1), Rm.col(2), nsd));
-      RmRm.set_slice(5, mat_symm_prod(Rm.col(2), Rm.col(0), nsd));
-  
-      auto Sb = g1*Es(0,0)*RmRm.slice(0) + 
-               g2*(Es(1,1)*RmRm.slice(1) + Es(2,2)*RmRm.slice(2) + 2.0*Es(1,2)*RmRm.slice(4)) +
-           2.0*g3*(Es(0,1)*RmRm.slice(3) + Es(0,2)*RmRm.slice(5));
-
-      auto CCb = 2.0*ten_dyad_prod(Sb, Sb, nsd);
-      Sb = Sb * r2;
-
-      // Fiber reinforcement/active stress
-      Sb += Tfa*mat_dyad_prod(fl.col(0), fl.col(0), nsd);
-
-      double r1 = J2d*mat_ddot(C, Sb, nsd) / nd;
-      S = J2d*Sb - r1*Ci;
-      r2 = r2*J4d;
-
-      CCb = r2*(CCb + g1*ten_dyad_prod(RmRm.slice(0), RmRm.slice(0), nsd) + 
-                g2*(ten_dyad_prod(RmRm.slice(1), RmRm.slice(1), nsd) +
-                ten_dyad_prod(RmRm.slice(2), RmRm.slice(2), nsd) +
-                ten_dyad_prod(RmRm.slice(4), RmRm.slice(4), nsd)*2.0) +
-                2.0*g3*(ten_dyad_prod(RmRm.slice(3), RmRm.slice(3), nsd) +
-                ten_dyad_prod(RmRm.slice(5), RmRm.slice(5), nsd)));
-
-      auto PP  = ten_ids(nsd) - (1.0/nd) * ten_dyad_prod(Ci, C, nsd);
-      CC  = ten_ddot(CCb, PP, nsd);
-      CC = ten_transpose(CC, nsd);
-      CC = ten_ddot(PP, CC, nsd);
-      CC = CC + 2.0*r1 * (ten_symm_prod(Ci, Ci, nsd) -
-                          1.0/nd * ten_dyad_prod(Ci, Ci, nsd)) - 
-                          2.0/nd * (ten_dyad_prod(Ci, S, nsd) +
-                          ten_dyad_prod(S, Ci, nsd));
+      get_sb_ccb_gucci(stM, nsd, IDm, C, fl, Tfa, J2d, J4d, Sb, CCb, ws);
+      get_s_cc_iso_dev(nsd, C, Ci, Ids, Sb, CCb, J2d, S, CC, ws);
     } break; 
 
     // HO (Holzapfel-Ogden) model for myocardium (2009)
     //
+    // [NOTE] The stress of this model is kept in a local array so S is 
+    // returned as zero, only the elasticity tensor is returned.
+    //
     case ConstitutiveModelType::stIso_HO: {
       if (nfd != 2) {
         throw std::runtime_error("[get_pk2cc_dev] Min fiber directions not defined for Holzapfel material model.");
       }
-
-      double Inv4 = J2d*norm(fl.col(0), mat_mul(C, fl.col(0)));
-      double Inv6 = J2d*norm(fl.col(1), mat_mul(C, fl.col(1)));
-      double Inv8 = J2d*norm(fl.col(0), mat_mul(C, fl.col(1)));
-
-      double Eff = Inv4 - 1.0;
-      double Ess = Inv6 - 1.0;
-      double Efs = Inv8;
-
-      double g1 = stM.a * exp(stM.b*(Inv1-3.0));
-      double g2 = 2.0 * stM.afs * Efs * exp(stM.bfs*Efs*Efs);
-      auto Hfs = mat_symm_prod(fl.col(0), fl.col(1), nsd);
-      auto Sb = g1*IDm + g2*Hfs;
-
-      Efs  = Efs * Efs;
-      g1 = 2.0*J4d*stM.b*g1;
-      g2 = 4.0*J4d*stM.afs*(1.0 + 2.0*stM.bfs*Efs)* exp(stM.bfs*Efs);
-      auto CCb = g1 * ten_dyad_prod(IDm, IDm, nsd) + g2 * ten_dyad_prod(Hfs, Hfs, nsd);
-
-      // Fiber reinforcement/active stress
-      //
-      if (Eff > 0.0) {
-        g1 = Tfa;
-        g1  = g1 + 2.0 * stM.aff * Eff * exp(stM.bff*Eff*Eff);
-        auto Hff = mat_dyad_prod(fl.col(0), fl.col(0), nsd);
-        Sb  = Sb + g1*Hff;
-
-        Eff = Eff * Eff;
-        g1  = 4.0*J4d*stM.aff*(1.0 + 2.0*stM.bff*Eff)*exp(stM.bff*Eff);
-        CCb = CCb + g1*ten_dyad_prod(Hff, Hff, nsd);
-      }
-
-      if (Ess >  0.0) {
-        g2 = 2.0 * stM.ass * Ess * exp(stM.bss*Ess*Ess);
-        auto Hss = mat_dyad_prod(fl.col(1), fl.col(1), nsd);
-        Sb  = Sb + g2*Hss;
-
-        Ess = Ess * Ess;
-        g2  = 4.0*J4d*stM.ass*(1.0 + 2.0*stM.bss*Ess)*exp(stM.bss*Ess);
-        CCb = CCb + g2*ten_dyad_prod(Hss, Hss, nsd);
-      }
-
-      double r1 = J2d*mat_ddot(C, Sb, nsd) / nd;
-      auto S = J2d*Sb - r1*Ci;
-
-      auto PP = ten_ids(nsd) - (1.0/nd) * ten_dyad_prod(Ci, C, nsd);
-      CC = ten_ddot(CCb, PP, nsd);
-      CC = ten_transpose(CC, nsd);
-      CC = ten_ddot(PP, CC, nsd);
-      CC = CC + 2.0*r1 * (ten_symm_prod(Ci, Ci, nsd) - 1.0/nd * ten_dyad_prod(Ci, Ci, nsd)) -
-                2.0/nd * (ten_dyad_prod(Ci, S, nsd) + ten_dyad_prod(S, Ci, nsd));
+      auto S = ws.array(nsd,nsd);
+      get_sb_ccb_ho(stM, nsd, IDm, C, fl, Tfa, Inv1, J2d, J4d, Sb, CCb, ws);
+      get_s_cc_iso_dev(nsd, C, Ci, Ids, Sb, CCb, J2d, S, CC, ws);
 
       if (cep_mod.cem.aStrain) {
-        S = mat_fun::mat_mul(Fai, S);
-        S = mat_fun::mat_mul(S, mat_fun::transpose(Fai));
-        CCb = 0.0;
-        CCb = ten_dyad_prod(Fai, Fai, nsd);
-        CC = ten_ddot(CC, CCb, nsd);
-        CC = ten_ddot(CCb, CC, nsd);
+        auto FaiS = ws.array(nsd,nsd);
+        auto FaiT = ws.array(nsd,nsd);
+        auto CCt = ws.tensor4(nsd,nsd,nsd,nsd);
+        mat_fun::mat_mul(Fai, S, FaiS);
+        mat_fun::transpose(Fai, FaiT);
+        mat_fun::mat_mul(FaiS, FaiT, S);
+        ten_dyad_prod(Fai, Fai, nsd, CCb);
+        ten_ddot(CC, CCb, nsd, CCt);
+        ten_ddot(CCb, CCt, nsd, CC);
       }
 
     } break;
@@ -82,11 +82,12 @@ void construct_mesh(ComMod& com_mod, CepMod& cep_mod, const mshType& lM, const A
   #endif
 
   Vector<int> ptr(eNoN);
-  Vector<double> pSl(nsymd), ya_l(eNoN), N(eNoN);
+  Vector<double> pSl(nsymd), ya_l(eNoN);
   Array<double> xl(nsd,eNoN), al(tDof,eNoN), yl(tDof,eNoN), dl(tDof,eNoN),
                 dol(nsd,eNoN), pS0l(nsymd,eNoN), Nx(nsd,eNoN), lR(dof,eNoN);
   Array3<double> lK(dof*dof,eNoN,eNoN);
   Array<double> ksix(nsd,nsd), bfl(nsd,eNoN);
+  auto& ws = com_mod.elem_workspace[0];
 
   for (int e = 0; e < lM.nEl; e++) {
     // Update domain and proceed if domain phys and eqn phys match
@@ -145,18 +146,18 @@ void construct_mesh(ComMod& com_mod, CepMod& cep_mod, const mshType& lM, const A
       }
 
       double w = lM.w(g);
-      N = lM.N.col(g);
+      auto N = lM.N.rcol(g);
       pS0l = 0.0;
 
       if (nsd == 3) {
-        l_elas::l_elas_3d(com_mod, eNoN, w, N, Nx, al, dl, bfl, pS0l, pSl, lR, lK);
+        l_elas::l_elas_3d(com_mod, eNoN, w, N, Nx, al, dl, bfl, pS0l, pSl, lR, lK, ws);
 
       } else if (nsd == 2) {
-        l_elas::l_elas_2d(com_mod, eNoN, w, N, Nx, al, dl, bfl, pS0l, pSl, lR, lK);
+        l_elas::l_elas_2d(com_mod, eNoN, w, N, Nx, al, dl, bfl, pS0l, pSl, lR, lK, ws);
       }
     }
 
-    eq.linear_algebra->assemble(com_mod, eNoN, ptr, lK, lR);
+    eq.linear_algebra->assemble_element(com_mod, lM, e, eNoN, ptr, lK, lR);
   }
 }
 
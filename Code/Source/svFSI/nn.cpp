@@ -442,8 +442,11 @@ void get_xi(const int nsd, consts::ElementType eType, const int eNoN, const Arra
 void gnn(const int eNoN, const int nsd, const int insd, Array<double>& Nxi, Array<double>& x, Array<double>& Nx, 
     double& Jac, Array<double>& ks)
 {
-  Array<double> xXi(nsd,insd);   
-  Array<double> xiX(insd,nsd);
+  // Use stack storage, this is called for every element.
+  double xXi_data[9] = {0.0};
+  double xiX_data[9] = {0.0};
+  Array<double> xXi(nsd, insd, xXi_data);   
+  Array<double> xiX(insd, nsd, xiX_data);
 
   Jac = 0.0;
   Nx  = 0.0;
@@ -527,6 +530,107 @@ void gnn(const int eNoN, const int nsd, const int insd, Array<double>& Nxi, Arra
   }
 }
 
+/// @brief Clear the cached element geometric factors of a mesh.
+//
+void clear_geo_cache(mshType& lM)
+{
+  lM.geoCache = false;
+  lM.geoNx.clear();
+  lM.geoJac.clear();
+  lM.geoKsix.clear();
+}
+
+/// @brief Copy the cached shape function gradients, Jacobian and ksix metric 
+/// of element 'e' into 'Nx', 'Jac' and 'ks'. 
+///
+/// Returns false if the mesh does not have a valid cache, in which case the
+/// caller computes them with gnn().
+//
+bool get_geo_cache(const mshType& lM, const int e, Array<double>& Nx, double& Jac, Array<double>& ks)
+{
+  if (!lM.geoCache) {
+    return false;
+  }
+
+  int nsd = lM.geoKsix.nrows();
+  int eNoN = lM.geoNx.ncols();
+
+  for (int a = 0; a < eNoN; a++) {
+    for (int i = 0; i < nsd; i++) {
+      Nx(i,a) = lM.geoNx(i,a,e);
+    }
+  }
+
+  for (int j = 0; j < nsd; j++) {
+    for (int i = 0; i < nsd; i++) {
+      ks(i,j) = lM.geoKsix(i,j,e);
+    }
+  }
+
+  Jac = lM.geoJac(e);
+
+  return true;
+}
+
+/// @brief Compute and store the physical shape function gradients, Jacobian 
+/// and ksix metric of every element of a mesh.
+///
+/// These are constant over an element and over time only for linear simplex 
+/// elements (TET4, TRI3) on a mesh that does not move, so the cache is not 
+/// built otherwise. It must be rebuilt if the mesh coordinates change.
+//
+void init_geo_cache(const ComMod& com_mod, mshType& lM)
+{
+  clear_geo_cache(lM);
+
+  if (!com_mod.geoCache || com_mod.mvMsh || !lM.lShpF || lM.lShl || lM.lFib || (lM.nFs != 1)) {
+    return;
+  }
+
+  if ((lM.eType != ElementType::TET4) && (lM.eType != ElementType::TRI3)) {
+    return;
+  }
+
+  const int nsd = com_mod.nsd;
+  const int eNoN = lM.eNoN;
+  const auto& x = com_mod.x;
+
+  lM.geoNx.resize(nsd, eNoN, lM.nEl);
+  lM.geoJac.resize(lM.nEl);
+  lM.geoKsix.resize(nsd, nsd, lM.nEl);
+
+  Array<double> xl(nsd,eNoN), Nx(nsd,eNoN), ks(nsd,nsd);
+  auto Nxi = lM.Nx.rslice(0);
+
+  for (int e = 0; e < lM.nEl; e++) {
+    for (int a = 0; a < eNoN; a++) {
+      int Ac = lM.IEN(a,e);
+      for (int i = 0; i < nsd; i++) {
+        xl(i,a) = x(i,Ac);
+      }
+    }
+
+    double Jac = 0.0;
+    gnn(eNoN, nsd, nsd, Nxi, xl, Nx, Jac, ks);
+
+    for (int a = 0; a < eNoN; a++) {
+      for (int i = 0; i < nsd; i++) {
+        lM.geoNx(i,a,e) = Nx(i,a);
+      }
+    }
+
+    for (int j = 0; j < nsd; j++) {
+      for (int i = 0; i < nsd; i++) {
+        lM.geoKsix(i,j,e) = ks(i,j);
+      }
+    }
+
+    lM.geoJac(e) = Jac;
+  }
+
+  lM.geoCache = true;
+}
+
 /// @brief This routine returns a surface normal vector at element "e" and Gauss point
 /// 'g' of face 'lFa' that is the normal weighted by Jac, i.e.
 /// Jac = SQRT(NORM(n)), the Jacobian of the mapping from parent surface element to
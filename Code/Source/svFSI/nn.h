@@ -37,6 +37,10 @@
 
 namespace nn {
 
+  void clear_geo_cache(mshType& lM);
+
+  bool get_geo_cache(const mshType& lM, const int e, Array<double>& Nx, double& Jac, Array<double>& ks);
+
   void get_gip(const int insd, consts::ElementType eType, const int nG, Vector<double>& w, Array<double>& xi);
   void get_gip(Simulation* simulation, faceType& face);
   void get_gip(mshType& mesh);
@@ -73,6 +77,8 @@ namespace nn {
   void gn_nxx(const int l, const int eNoN, const int nsd, const int insd, Array<double>& Nxi, Array<double>& Nxi2, Array<double>& lx,
       Array<double>& Nx, Array<double>& Nxx);
 
+  void init_geo_cache(const ComMod& com_mod, mshType& lM);
+
   void select_ele(const ComMod& com_mod, mshType& mesh);
 
   void select_eleb(Simulation* simulation,  mshType& mesh, faceType& face);
@@ -32,9 +32,15 @@
 // desined to interface with user.
 
 #include "output.h"
+#include "LinearAlgebra.h"
 #include "utils.h"
 
+#include <fcntl.h>
+#include <filesystem>
 #include <math.h>
+#include <sstream>
+#include <thread>
+#include <unistd.h>
 
 namespace output {
 
@@ -160,6 +166,17 @@ void output_result(Simulation* simulation,  std::array<double,3>& timeP, const i
   auto calld_str = std::to_string(static_cast<int>(round(tmp)));
   sOut += "  " + c1 + std::to_string(eq.FSILS.RI.itr) + " " + db_str + " " + calld_str + c2;
 
+  // Preconditioner update for the last solve if it may be reused. 
+  //
+  // NS     1-2  3.82E1  [ -62 7.92E-4 7.92E-4 3.60E-4]  [   5  -15  23]  pc:reuse
+  //                                                                      --------
+  if (eq.linear_algebra != nullptr) {
+    auto prec_status = eq.linear_algebra->preconditioner_status();
+    if (prec_status != "") {
+      sOut += "  pc:" + prec_status;
+    }
+  }
+
   if (com_mod.nEq > 1) {
     logger << sOut << std::endl;
   } else {
@@ -172,7 +189,14 @@ void read_restart_header(ComMod& com_mod, std::array<int,7>& tStamp, double& tim
   auto& cTS = com_mod.cTS;
   auto& time = com_mod.time;
 
+  int magic = 0;
+  int version = 0;
+  int recLn = 0;
+
+  restart_file.read((char*)&magic, sizeof(magic));
+  restart_file.read((char*)&version, sizeof(version));
   restart_file.read((char*)tStamp.data(), sizeof(tStamp));
+  restart_file.read((char*)&recLn, sizeof(recLn));
   restart_file.read((char*)&cTS, sizeof(cTS));
   restart_file.read((char*)&time, sizeof(time));
   restart_file.read((char*)&timeP, sizeof(timeP));
@@ -182,7 +206,222 @@ void read_restart_header(ComMod& com_mod, std::array<int,7>& tStamp, double& tim
   }
 }
 
+/// @brief Restart file being written by a background thread.
+///
+/// The state is copied into one of two staging records so that the next
+/// restart record can be filled while the previous one is still being
+/// written.
+//
+class RestartWriter
+{
+  public:
+    /// Whether a restart file is being written
+    bool pending = false;
+
+    /// Whether this process wrote its record successfully
+    bool ok = true;
+
+    /// File written and the file it is published as when complete 
+    std::string fName;
+    std::string lastName;
+
+    /// If true the file is renamed to lastName, else hard linked
+    bool rename = false;
+
+    std::array<std::string,2> records;
+    int current = 0;
+
+    std::thread thread;
+
+    /// The thread is joined here if wait_restart() was not called, e.g. 
+    /// when an exception ended the simulation.
+    ~RestartWriter() 
+    {
+      if (thread.joinable()) {
+        thread.join();
+      }
+    }
+};
+
+static RestartWriter restart_writer;
+
+/// Identifies svFSIplus restart records ("SVRS"), written at the start of
+/// each record followed by restart_version.
+static const int restart_magic = 0x53525653;
+
+/// Version of the restart record layout, increased when the layout changes.
+static const int restart_version = 1;
+
+/// @brief Compute the 64-bit FNV-1a hash of 'size' bytes used to detect 
+/// corrupted or partially written restart records.
+//
+uint64_t restart_checksum(const char* data, const size_t size)
+{
+  uint64_t hash = 14695981039346656037ULL;
+
+  for (size_t i = 0; i < size; i++) {
+    hash = (hash ^ static_cast<unsigned char>(data[i])) * 1099511628211ULL;
+  }
+
+  return hash;
+}
+
+/// @brief Check the format of a restart file and read the record length 
+/// stored in the header of its first record, the position is not changed. 
+///
+/// The record length is that of the simulation that wrote the file which is 
+/// different from com_mod.recLn when the mesh has changed (e.g. remeshing).
+/// It is set to 0 if the file is too short.
+///
+/// Returns false if the file was not written with the current restart
+/// format, e.g. by an older version.
+//
+bool read_restart_format(std::ifstream& restart_file, int& recLn)
+{
+  auto pos = restart_file.tellg();
+  int magic = 0;
+  int version = 0;
+  bool ok = true;
+  recLn = 0;
+
+  restart_file.seekg(0);
+  restart_file.read((char*)&magic, sizeof(magic));
+  restart_file.read((char*)&version, sizeof(version));
+  restart_file.seekg(sizeof(ComMod::stamp), std::ios::cur);
+  restart_file.read((char*)&recLn, sizeof(recLn));
+
+  if (!restart_file.good()) {
+    recLn = 0;
+  } else if ((magic != restart_magic) || (version != restart_version)) {
+    recLn = 0;
+    ok = false;
+  }
+
+  restart_file.clear();
+  restart_file.seekg(pos);
+
+  return ok;
+}
+
+/// @brief Check the checksum of the restart record of length 'recLn' at the 
+/// current position of 'restart_file', the position is not changed.
+//
+bool check_restart_record(std::ifstream& restart_file, const int recLn)
+{
+  if (recLn <= static_cast<int>(sizeof(uint64_t))) {
+    return false;
+  }
+
+  const size_t size = recLn - sizeof(uint64_t);
+  auto pos = restart_file.tellg();
+
+  std::string record(size, '\0');
+  uint64_t checksum = 0;
+  restart_file.read(&record[0], size);
+  restart_file.read((char*)&checksum, sizeof(checksum));
+  bool ok = restart_file.good() && (checksum == restart_checksum(record.data(), size));
+
+  restart_file.clear();
+  restart_file.seekg(pos);
+
+  return ok;
+}
+
+/// @brief Pad a restart record to the record length and append its checksum.
+//
+void finish_restart_record(const ComMod& com_mod, std::string& record)
+{
+  const size_t size = com_mod.recLn - sizeof(uint64_t);
+
+  if (record.size() > size) {
+    throw std::runtime_error("The restart record size " + std::to_string(record.size()) + 
+        " is larger than the record length " + std::to_string(size) + ".");
+  }
+
+  record.resize(size, '\0');
+  uint64_t checksum = restart_checksum(record.data(), size);
+  record.append((char*)&checksum, sizeof(checksum));
+}
+
+/// @brief Write the record of a process at 'pos' in a restart file shared by 
+/// all processes. 
+///
+/// The file is not truncated when opened so processes can write their records 
+/// in any order. If 'size' > 0 the file size is set to 'size', used by the 
+/// master to remove data left from a previous larger file.
+//
+bool write_restart_record(const std::string& fName, const std::string& record, const off_t pos, const off_t size)
+{
+  int fd = open(fName.c_str(), O_WRONLY | O_CREAT, 0644);
+  if (fd < 0) {
+    return false;
+  }
+
+  bool ok = true;
+  size_t offset = 0;
+
+  while (ok && (offset < record.size())) {
+    auto n = pwrite(fd, record.data() + offset, record.size() - offset, pos + offset);
+    if (n <= 0) {
+      ok = false;
+    } else {
+      offset += n;
+    }
+  }
+
+  if (ok && (size > 0)) {
+    ok = (ftruncate(fd, size) == 0);
+  }
+
+  return (close(fd) == 0) && ok;
+}
+
+/// @brief Wait for the restart file written in the background to be 
+/// complete and publish it as the last restart file.
+///
+/// The '<stFileName>_last.bin' file is only updated here so it always refers 
+/// to a complete restart file. This must be called by all processes.
+//
+void wait_restart(Simulation* simulation)
+{
+  auto& com_mod = simulation->com_mod;
+  auto& cm_mod = simulation->cm_mod;
+  auto& cm = com_mod.cm;
+  auto& writer = restart_writer;
+
+  if (!writer.pending) {
+    return;
+  }
+
+  writer.thread.join();
+  writer.pending = false;
+
+  int ok = cm.reduce(cm_mod, static_cast<int>(writer.ok), MPI_MIN);
+  if (!ok) {
+    throw std::runtime_error("Failed to write the restart file '" + writer.fName + "'.");
+  }
+
+  if (cm.mas(cm_mod)) {
+    std::error_code ec;
+    if (writer.rename) {
+      std::filesystem::rename(writer.fName, writer.lastName, ec);
+    } else {
+      std::filesystem::remove(writer.lastName, ec);
+      std::filesystem::create_hard_link(writer.fName, writer.lastName, ec);
+    }
+  }
+}
+
 /// @brief Reproduces the Fortran 'WRITERESTART' subroutine.
+///
+/// The state is copied into a staging record and written to the restart 
+/// file by a background thread while the time stepping continues, the file 
+/// is published as the last restart file by wait_restart().
+///
+/// Each process writes a record of length com_mod.recLn at the position 
+/// (myID-1)*recLn, its last 8 bytes are the checksum of the record. The 
+/// header starts with the format magic number and version, and stores the
+/// record length following the stamp.
 //
 void write_restart(Simulation* simulation, std::array<double,3>& timeP)
 {
@@ -229,7 +468,6 @@ void write_restart(Simulation* simulation, std::array<double,3>& timeP)
   dmsg << "stFileRepl: " << stFileRepl;
   #endif 
 
-  int fid = 27;
   int myID = cm.tF(cm_mod);
 
   auto fName = stFileName + "_last.bin";
@@ -248,6 +486,9 @@ void write_restart(Simulation* simulation, std::array<double,3>& timeP)
   std::cout;
   #endif 
 
+  // When the last restart file is replaced it is written to a temporary
+  // file renamed when complete.
+  //
   if (!com_mod.stFileRepl) {
     char fName_num[100];
     if (cTS >= 1000) {
@@ -256,26 +497,16 @@ void write_restart(Simulation* simulation, std::array<double,3>& timeP)
       sprintf(fName_num, "%03d", cTS);
     }
     fName = stFileName + "_" + fName_num + ".bin";
+  } else {
+    fName = tmpS + ".tmp";
   }
 
-  // Create the file.
+  // Copy the state into the staging record not used by the
+  // restart file possibly still being written.
   //
-  if (cm.mas(cm_mod)) {
-    int np = cm.np();
-    std::ofstream restart_file(fName, std::ios::out | std::ios::binary);
-    char data{0};
-    for (int i = 0; i < np * recLn; i++) {
-      //restart_file.write((char*)&data, sizeof(char));
-    }
-    restart_file.close();
-  }
-
-  // This call is to block all processors
-  cm.bcast(cm_mod, &fid);
-
-  std::ofstream restart_file(fName, std::ios::out | std::ios::binary | std::ios::in);
-  std::streampos write_pos = (myID - 1) * recLn;
-  restart_file.seekp(write_pos);
+  auto& writer = restart_writer;
+  auto& record = writer.records[1 - writer.current];
+  std::ostringstream restart_file(std::ios::out | std::ios::binary);
 
   write_restart_header(com_mod, timeP, restart_file);
   restart_file.write((char*)cplBC.xn.data(), cplBC.xn.msize());
@@ -304,8 +535,6 @@ void write_restart(Simulation* simulation, std::array<double,3>& timeP)
         } else if (cepEq) {
           restart_file.write((char*)Xion.data(), Xion.msize());
           restart_file.write((char*)cem.Ya.data(), cem.Ya.msize());
-        } else {
-          restart_file.write((char*)Dn.data(), Dn.msize());
         }
       }
 
@@ -333,30 +562,62 @@ void write_restart(Simulation* simulation, std::array<double,3>& timeP)
     }
   }
 
-  restart_file.close();
+  record = restart_file.str();
+  finish_restart_record(com_mod, record);
 
-  // Create a soft link to the bin file for the last time step.
+  // Wait for the previous restart file and start writing this one.
   //
-  if (!com_mod.stFileRepl && cm.mas(cm_mod)) {
-    std::string cmd = "ln -f " + fName + " " + tmpS;
-    std::system(cmd.c_str());
+  wait_restart(simulation);
+
+  writer.current = 1 - writer.current;
+  writer.fName = fName;
+  writer.lastName = tmpS;
+  writer.rename = stFileRepl;
+  writer.pending = true;
+
+  off_t pos = static_cast<off_t>(myID - 1) * recLn;
+  off_t size = 0;
+  if (cm.mas(cm_mod)) {
+    size = static_cast<off_t>(cm.np()) * recLn;
   }
+
+  writer.thread = std::thread([&writer, &record, fName, pos, size]() { 
+    writer.ok = write_restart_record(fName, record, pos, size); 
+  });
 }
 
-void write_restart_header(ComMod& com_mod, std::array<double,3>& timeP, std::ofstream& restart_file)
+/// @brief Write the header of a restart record for the current time step.
+//
+void write_restart_header(ComMod& com_mod, std::array<double,3>& timeP, std::ostream& restart_file)
+{
+  Vector<double> iNorm(com_mod.nEq);
+
+  for (int iEq = 0; iEq < com_mod.nEq; iEq++) {
+    iNorm(iEq) = com_mod.eq[iEq].iNorm;
+  }
+
+  write_restart_header(com_mod, timeP, com_mod.cTS, com_mod.time, iNorm, restart_file);
+}
+
+/// @brief Write the header of a restart record for the state at time step
+/// 'cTS'.
+//
+void write_restart_header(ComMod& com_mod, std::array<double,3>& timeP, const int cTS, const double time, 
+    const Vector<double>& iNorm, std::ostream& restart_file)
 {
-  auto const cTS = com_mod.cTS;
-  auto const time = com_mod.time;
   auto& stamp = com_mod.stamp;
   double cpu_time = utils::cput() - timeP[0];
 
+  restart_file.write((char*)&restart_magic, sizeof(restart_magic));
+  restart_file.write((char*)&restart_version, sizeof(restart_version));
   restart_file.write((char*)stamp.data(), sizeof(stamp));
+  restart_file.write((char*)&com_mod.recLn, sizeof(com_mod.recLn));
   restart_file.write((char*)&cTS, sizeof(cTS));
   restart_file.write((char*)&time, sizeof(time));
   restart_file.write((char*)&cpu_time, sizeof(cpu_time));
 
-  for (auto& eq : com_mod.eq) {
-    restart_file.write((char*)&eq.iNorm, sizeof(eq.iNorm));
+  for (int iEq = 0; iEq < com_mod.nEq; iEq++) {
+    restart_file.write((char*)&iNorm(iEq), sizeof(double));
   }
 }
 
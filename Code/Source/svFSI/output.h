@@ -33,18 +33,35 @@
 
 #include "Simulation.h"
 
+#include<cstdint>
 #include<fstream>
 #include<iostream>
+#include<sys/types.h>
 
 namespace output {
 
 void output_result(Simulation* simulation,  std::array<double,3>& timeP, const int co, const int iEq);
 
+bool read_restart_format(std::ifstream& restart_file, int& recLn);
+
 void read_restart_header(ComMod& com_mod, std::array<int,7>& tStamp, double& timeP, std::ifstream& restart_file);
 
+uint64_t restart_checksum(const char* data, const size_t size);
+
+bool check_restart_record(std::ifstream& restart_file, const int recLn);
+
+void finish_restart_record(const ComMod& com_mod, std::string& record);
+
+bool write_restart_record(const std::string& fName, const std::string& record, const off_t pos, const off_t size);
+
+void wait_restart(Simulation* simulation);
+
 void write_restart(Simulation* simulation, std::array<double,3>& timeP);
 
-void write_restart_header(ComMod& com_mod, std::array<double,3>& timeP, std::ofstream& restart_file);
+void write_restart_header(ComMod& com_mod, std::array<double,3>& timeP, std::ostream& restart_file);
+
+void write_restart_header(ComMod& com_mod, std::array<double,3>& timeP, const int cTS, const double time, 
+    const Vector<double>& iNorm, std::ostream& restart_file);
 
 void write_results(ComMod& com_mod, const std::array<double,3>& timeP, const std::string& fName, const bool sstEq);
 
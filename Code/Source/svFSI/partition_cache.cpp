@@ -0,0 +1,374 @@
+/* Copyright (c) Stanford University, The Regents of the University of California, and others.
+ *
+ * All Rights Reserved.
+ *
+ * See Copyright-SimVascular.txt for additional details.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "partition_cache.h"
+
+#include "lhs.h"
+
+#include "mpi.h"
+
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace partition_cache {
+
+// Cache file header: magic number ("SVPC"), version, size and hash of the
+// data that follow.
+//
+static const int cache_magic = 0x43505653;
+static const int cache_version = 1;
+static const size_t header_size = 2*sizeof(int) + 2*sizeof(uint64_t);
+
+static const uint64_t fnv_offset = 14695981039346656037ULL;
+
+/// @brief Add the bytes of 'data' to the 64-bit FNV-1a hash 'hash'.
+//
+uint64_t fnv1a(uint64_t hash, const void* data, const size_t size)
+{
+  auto bytes = static_cast<const unsigned char*>(data);
+
+  for (size_t i = 0; i < size; i++) {
+    hash = (hash ^ bytes[i]) * 1099511628211ULL;
+  }
+
+  return hash;
+}
+
+/// @brief Return the name of the cache file 'name' of processor 'id'.
+//
+std::string file_name(const std::string& path, const std::string& name, const int id)
+{
+  return path + "/" + name + "_" + std::to_string(id) + ".bin";
+}
+
+/// @brief Return the key of the cached meshes, the 64-bit FNV-1a hash of 
+/// the global meshes and faces and of the processor weights, or an empty 
+/// string if the meshes can't be cached (NURBS).
+///
+/// The hash covers the data distributed with the partition cache: the 
+/// element and face connectivities, the node maps, the element IDs and 
+/// the fiber directions. Only called on the master, which holds the 
+/// global meshes.
+//
+std::string mesh_hash(const ComMod& com_mod, const Array<double>& wgt)
+{
+  uint64_t hash = fnv_offset;
+
+  auto add = [&hash](const void* data, const size_t size) -> void {
+    hash = fnv1a(hash, data, size);
+  };
+
+  auto add_int = [&add](const int value) -> void {
+    add(&value, sizeof(value));
+  };
+
+  auto add_string = [&add, &add_int](const std::string& value) -> void {
+    add_int(value.size());
+    add(value.data(), value.size());
+  };
+
+  auto add_vector = [&add, &add_int](const auto& v) -> void {
+    add_int(v.size());
+    add(v.data(), v.size()*sizeof(*v.data()));
+  };
+
+  add_int(com_mod.gtnNo);
+  add_int(com_mod.nMsh);
+
+  for (auto& msh : com_mod.msh) {
+    if (msh.eType == consts::ElementType::NRB) {
+      return "";
+    }
+
+    add_string(msh.name);
+    add_int(static_cast<int>(msh.eType));
+    add_int(msh.eNoN);
+    add_int(msh.gnNo);
+    add_int(msh.gnEl);
+    add_int(msh.nFn);
+    add_vector(msh.gIEN);
+    add_vector(msh.gN);
+    add_vector(msh.eId);
+    add_vector(msh.fN);
+
+    add_int(msh.nFa);
+    for (auto& fa : msh.fa) {
+      add_string(fa.name);
+      add_int(fa.eNoN);
+      add_int(fa.nEl);
+      add_int(fa.gnEl);
+      add_int(fa.nNo);
+      add_vector(fa.gE);
+      add_vector(fa.IEN);
+      add_vector(fa.gN);
+    }
+  }
+
+  add_vector(wgt);
+
+  std::ostringstream key;
+  key << std::hex << std::setw(16) << std::setfill('0') << hash;
+  return key.str();
+}
+
+/// @brief Return the key of the cached FSILS data, the hash of the arguments 
+/// of fsils_lhs_create(): the nodes and sparsity pattern of this processor.
+//
+static uint64_t lhs_key(const ComMod& com_mod, const int nnz)
+{
+  uint64_t hash = fnv_offset;
+  int tnNo = com_mod.tnNo;
+
+  hash = fnv1a(hash, &com_mod.gtnNo, sizeof(int));
+  hash = fnv1a(hash, &tnNo, sizeof(int));
+  hash = fnv1a(hash, &nnz, sizeof(int));
+  hash = fnv1a(hash, com_mod.ltg.data(), tnNo*sizeof(int));
+  hash = fnv1a(hash, com_mod.rowPtr.data(), (tnNo+1)*sizeof(int));
+  hash = fnv1a(hash, com_mod.colPtr.data(), nnz*sizeof(int));
+
+  return hash;
+}
+
+/// @brief Set up com_mod.lhs from the FSILS node ordering, sparsity pattern 
+/// and communication structure saved in the partition cache.
+///
+/// The cached data are only used if they were computed for the same nodes 
+/// and sparsity pattern (com_mod.ltg, rowPtr and colPtr) on all processors. 
+/// The pattern built by lhsa() also depends on the boundary conditions, so 
+/// it is checked rather than cached. 
+///
+/// Returns false if fsils_lhs_create() must be called.
+//
+bool read_lhs(ComMod& com_mod, const CmMod& cm_mod, fsi_linear_solver::FSILS_commuType& commu, const int nnz, 
+    const int nFaces)
+{
+  auto& cm = com_mod.cm;
+
+  if (com_mod.partCachePath.empty()) {
+    return false;
+  }
+
+  CacheReader reader;
+  int found = reader.open(file_name(com_mod.partCachePath, "lhs", cm.idcm())) && 
+      (reader.read<uint64_t>() == lhs_key(com_mod, nnz));
+
+  if (cm.reduce(cm_mod, found, MPI_MIN) == 0) {
+    return false;
+  }
+
+  auto& lhs = com_mod.lhs;
+  lhs.mynNo = reader.read<int>();
+  lhs.shnNo = reader.read<int>();
+  reader.read(lhs.map);
+  reader.read(lhs.rowPtr);
+  reader.read(lhs.colPtr);
+  reader.read(lhs.diagPtr);
+  reader.read(lhs.transPtr);
+
+  lhs.nReq = reader.read<int>();
+  lhs.cS.resize(lhs.nReq);
+
+  for (auto& cS : lhs.cS) {
+    cS.iP = reader.read<int>();
+    cS.n = reader.read<int>();
+    reader.read(cS.ptr);
+  }
+
+  fsi_linear_solver::fsils_lhs_restore(lhs, commu, com_mod.gtnNo, com_mod.tnNo, nnz, nFaces);
+
+  return true;
+}
+
+/// @brief Save the FSILS data of com_mod.lhs set by fsils_lhs_create() to 
+/// the partition cache.
+//
+void write_lhs(ComMod& com_mod, const int nnz)
+{
+  if (com_mod.partCachePath.empty()) {
+    return;
+  }
+
+  auto& lhs = com_mod.lhs;
+  CacheWriter writer;
+
+  writer.write(lhs_key(com_mod, nnz));
+  writer.write(lhs.mynNo);
+  writer.write(lhs.shnNo);
+  writer.write(lhs.map);
+  writer.write(lhs.rowPtr);
+  writer.write(lhs.colPtr);
+  writer.write(lhs.diagPtr);
+  writer.write(lhs.transPtr);
+
+  writer.write(lhs.nReq);
+  for (auto& cS : lhs.cS) {
+    writer.write(cS.iP);
+    writer.write(cS.n);
+    writer.write(cS.ptr);
+  }
+
+  writer.save(file_name(com_mod.partCachePath, "lhs", com_mod.cm.idcm()));
+}
+
+//-------------
+// CacheWriter
+//-------------
+
+/// @brief Write the buffered data to 'file_name'. 
+///
+/// The data are written to a temporary file renamed when complete so an 
+/// interrupted run does not leave a partial cache file. Returns false if 
+/// the data were discarded or the file could not be written, the cache is 
+/// then not used.
+//
+bool CacheWriter::save(const std::string& file_name) const
+{
+  if (discarded_) {
+    return false;
+  }
+
+  std::error_code ec;
+  std::filesystem::create_directories(std::filesystem::path(file_name).parent_path(), ec);
+
+  std::string tmp_file = file_name + ".tmp";
+  std::ofstream file(tmp_file, std::ios::binary);
+  if (!file.is_open()) {
+    return false;
+  }
+
+  uint64_t size = buffer_.size();
+  uint64_t hash = fnv1a(fnv_offset, buffer_.data(), buffer_.size());
+
+  file.write((char*)&cache_magic, sizeof(int));
+  file.write((char*)&cache_version, sizeof(int));
+  file.write((char*)&size, sizeof(uint64_t));
+  file.write((char*)&hash, sizeof(uint64_t));
+  file.write(buffer_.data(), buffer_.size());
+  file.close();
+
+  if (!file) {
+    std::filesystem::remove(tmp_file, ec);
+    return false;
+  }
+
+  std::filesystem::rename(tmp_file, file_name, ec);
+  return !ec;
+}
+
+//-------------
+// CacheReader
+//-------------
+
+CacheReader::~CacheReader()
+{
+  close();
+}
+
+/// @brief Map the cache file 'file_name' into memory. 
+///
+/// Returns false if the file does not exist or its header or checksum do 
+/// not match.
+//
+bool CacheReader::open(const std::string& file_name)
+{
+  close();
+
+  int fd = ::open(file_name.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+
+  struct stat file_stat;
+  if ((fstat(fd, &file_stat) != 0) || (static_cast<size_t>(file_stat.st_size) < header_size)) {
+    ::close(fd);
+    return false;
+  }
+
+  void* data = mmap(nullptr, file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+
+  if (data == MAP_FAILED) {
+    return false;
+  }
+
+  data_ = static_cast<const char*>(data);
+  size_ = file_stat.st_size;
+  pos_ = 0;
+
+  int magic = read<int>();
+  int version = read<int>();
+  uint64_t size = read<uint64_t>();
+  uint64_t hash = read<uint64_t>();
+
+  if ((magic != cache_magic) || (version != cache_version) || (size != size_ - header_size) || 
+      (fnv1a(fnv_offset, data_ + header_size, size) != hash)) {
+    close();
+    return false;
+  }
+
+  return true;
+}
+
+/// @brief Unmap the cache file.
+//
+void CacheReader::close()
+{
+  if (data_ != nullptr) {
+    munmap(const_cast<char*>(data_), size_);
+  }
+
+  data_ = nullptr;
+  size_ = 0;
+  pos_ = 0;
+}
+
+/// @brief Copy the next 'size' bytes of the file to 'data'.
+//
+void CacheReader::copy(void* data, const size_t size)
+{
+  if ((data_ == nullptr) || (pos_ + size > size_)) {
+    throw std::runtime_error("[partition_cache] Reading past the end of a partition cache file.");
+  }
+
+  if (size > 0) {
+    memcpy(data, data_ + pos_, size);
+  }
+  pos_ += size;
+}
+
+};
@@ -0,0 +1,176 @@
+/* Copyright (c) Stanford University, The Regents of the University of California, and others.
+ *
+ * All Rights Reserved.
+ *
+ * See Copyright-SimVascular.txt for additional details.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef PARTITION_CACHE_H 
+#define PARTITION_CACHE_H 
+
+#include "Array.h"
+#include "ComMod.h"
+#include "Vector.h"
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+/// @brief The partition cache stores the data of each processor computed 
+/// when the meshes are distributed: the local meshes and faces, the gN and 
+/// ltg node maps and the FSILS sparsity pattern and communication structure. 
+/// A later run with the same meshes and number of processors reads them back 
+/// instead of partitioning the meshes with ParMETIS, migrating the elements 
+/// and finding the nodes shared between processors.
+///
+/// The files of a run are stored in the folder 
+///
+///   <Partition_cache_folder>/<hash>_<np>-procs
+///
+/// where the hash identifies the meshes (see mesh_hash()). Each processor 
+/// writes its own files mesh_<id>.bin and lhs_<id>.bin and maps them into 
+/// memory to read them.
+//
+namespace partition_cache {
+
+uint64_t fnv1a(uint64_t hash, const void* data, const size_t size);
+
+std::string file_name(const std::string& path, const std::string& name, const int id);
+
+std::string mesh_hash(const ComMod& com_mod, const Array<double>& wgt);
+
+bool read_lhs(ComMod& com_mod, const CmMod& cm_mod, fsi_linear_solver::FSILS_commuType& commu, const int nnz, 
+    const int nFaces);
+
+void write_lhs(ComMod& com_mod, const int nnz);
+
+/// @brief Buffer the data written to a partition cache file.
+///
+/// Vectors and arrays are stored with their sizes so that CacheReader can 
+/// allocate them.
+//
+class CacheWriter 
+{
+  public:
+    template <typename T>
+    void write(const T& value)
+    {
+      append(&value, sizeof(T));
+    }
+
+    template <typename T>
+    void write(const Vector<T>& v)
+    {
+      int n = v.size();
+      write(n);
+      append(v.data(), n*sizeof(T));
+    }
+
+    template <typename T>
+    void write(const Array<T>& a)
+    {
+      int nr = a.nrows();
+      int nc = a.ncols();
+      write(nr);
+      write(nc);
+      append(a.data(), a.size()*sizeof(T));
+    }
+
+    void discard()
+    {
+      buffer_.clear();
+      discarded_ = true;
+    }
+
+    bool save(const std::string& file_name) const;
+
+  private:
+    void append(const void* data, const size_t size)
+    {
+      auto bytes = static_cast<const char*>(data);
+      buffer_.insert(buffer_.end(), bytes, bytes + size);
+    }
+
+    std::vector<char> buffer_;
+    bool discarded_ = false;
+};
+
+/// @brief Read a partition cache file mapped into memory.
+///
+/// open() checks the header and the checksum of the file, the data are then 
+/// read back in the order they were written by CacheWriter.
+//
+class CacheReader 
+{
+  public:
+    CacheReader() = default;
+    CacheReader(const CacheReader&) = delete;
+    CacheReader& operator=(const CacheReader&) = delete;
+    ~CacheReader();
+
+    bool open(const std::string& file_name);
+    void close();
+    bool is_open() const { return data_ != nullptr; }
+
+    template <typename T>
+    T read()
+    {
+      T value;
+      copy(&value, sizeof(T));
+      return value;
+    }
+
+    template <typename T>
+    void read(Vector<T>& v)
+    {
+      int n = read<int>();
+      v.clear();
+      v.resize(n);
+      copy(v.data(), n*sizeof(T));
+    }
+
+    template <typename T>
+    void read(Array<T>& a)
+    {
+      int nr = read<int>();
+      int nc = read<int>();
+      a.clear();
+      a.resize(nr, nc);
+      copy(a.data(), a.size()*sizeof(T));
+    }
+
+  private:
+    void copy(void* data, const size_t size);
+
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+    size_t pos_ = 0;
+};
+
+};
+
+#endif
@@ -1260,6 +1260,7 @@ void shl_post(Simulation* simulation, const mshType& lM, const int m, Array<doub
   Array<double> sF(m,tnNo), dl(tDof,eNoN), x0(3,eNoN), xc(3,eNoN), 
       fN(3,nFn), fNa0(2,eNoN), Nx(2,lM.eNoN);
   Array3<double> Bb(3,3,6);
+  auto& ws = com_mod.elem_workspace[0];
 
   // Initialize arrays
   sA = 0.0;
@@ -1492,7 +1493,7 @@ void shl_post(Simulation* simulation, const mshType& lM, const int m, Array<doub
           aa_x[1][1] = aa_x[1][1] + aCov(l,1)*aCov(l,1);
         }
 
-        shells::shell_bend_cst(com_mod, lM, e, ptr, x0, xc, bb_0, bb_x, Bb, false);
+        shells::shell_bend_cst(com_mod, lM, e, ptr, x0, xc, bb_0, bb_x, Bb, false, ws);
 
         // Set weight of the Gauss point
         w = Jac0*0.50;
@@ -1514,7 +1515,7 @@ void shl_post(Simulation* simulation, const mshType& lM, const int m, Array<doub
       //
       Array<double> Sm(3,2);       
       Array3<double> Dm(3,3,3);
-      shells::shl_strs_res(com_mod, eq.dmn[cDmn], nFn, fNa0, aa_0, aa_x, bb_0, bb_x, lam3, Sm, Dm);
+      shells::shl_strs_res(com_mod, eq.dmn[cDmn], nFn, fNa0, aa_0, aa_x, bb_0, bb_x, lam3, Sm, Dm, ws);
 
       // Shell in-plane deformation gradient tensor
       //
@@ -1739,6 +1740,7 @@ void tpost(Simulation* simulation, const mshType& lM, const int m, Array<double>
 
   Array<double> Im(nsd, nsd);
   double Je = 0.0; 
+  auto& ws = com_mod.elem_workspace[0];
 
   for (int e = 0; e < lM.nEl; e++) {
     int cDmn = all_fun::domain(com_mod, lM, iEq, e);
@@ -1934,7 +1936,7 @@ void tpost(Simulation* simulation, const mshType& lM, const int m, Array<double>
             Array<double> Dm(nsymd,nsymd);
             double Ja;
             
-            mat_models::get_pk2cc_dev(com_mod, cep_mod, eq.dmn[cDmn], F, nFn, fN, ya, S, Dm, Ja);
+            mat_models::get_pk2cc_dev(com_mod, cep_mod, eq.dmn[cDmn], F, nFn, fN, ya, S, Dm, Ja, ws);
 
             auto C = mat_mul(transpose(F), F);
             S = S + p*mat_inv(C, nsd);
@@ -1948,7 +1950,7 @@ void tpost(Simulation* simulation, const mshType& lM, const int m, Array<double>
 
           } else if (cPhys == EquationType::phys_struct) {
             Array<double> Dm(nsymd,nsymd);
-            mat_models::get_pk2cc(com_mod, cep_mod, eq.dmn[cDmn], F, nFn, fN, ya, S, Dm);
+            mat_models::get_pk2cc(com_mod, cep_mod, eq.dmn[cDmn], F, nFn, fN, ya, S, Dm, ws);
 
             auto P1 = mat_mul(F, S);
             sigma = mat_mul(P1, transpose(F));
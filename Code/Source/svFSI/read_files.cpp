@@ -40,6 +40,7 @@
 
 #include "Array.h"
 #include "CepMod.h"
+#include "SpatialIndex.h"
 #include "VtkData.h"
 
 #include "fsils_api.hpp"
@@ -62,80 +63,17 @@ namespace read_files_ns {
 ///
 /// \todo [TODO:DaveP] this has not been tested.
 //
-void face_match(ComMod& com_mod, faceType& lFa, faceType& gFa, Vector<int>& ptr)
+void face_match(faceType& lFa, faceType& gFa, Vector<int>& ptr)
 {
-  using namespace read_msh_ns;
-  int nsd = com_mod.nsd;
-  int nBlkd = round(pow(static_cast<double>(gFa.nNo)/1000.0, 0.333));
-  if (nBlkd == 0) {
-    nBlkd = 1;
-  }
-
-  int nBlk = pow(nBlkd, nsd);
-  Vector<double> xMin(nsd), xMax(nsd); 
-  double eps = std::numeric_limits<double>::epsilon();
-
-  for (int i = 0;  i < nsd; i++) {
-    xMin[i] = std::min(lFa.x.min(), gFa.x.min());
-    xMax[i] = std::max(lFa.x.max(), gFa.x.max());
-
-    if (xMin[i] <  0.0) {
-      xMin[i] = xMin[i] * (1.0 + eps);
-    } else { 
-      xMin[i] = xMin[i] * (1.0 - eps);
-    }
-
-    if (xMax[i] < 0.0) {
-      xMax[i] = xMax[i] * (1.0 - eps);
-    } else { 
-       xMax[i] = xMax[i] * (1.0 + eps);
-    }
-  }
-
-  auto dx = (xMax - xMin) / static_cast<double>(nBlkd);
-  std::vector<bool> nFlt = {true, true, true};
-
-  for (int i = 0; i < nsd; i++) { 
-     if (utils::is_zero(dx[i])) {
-       nFlt[i] = false;
-     }
-  }
-
-  std::vector<blkType> blk(nBlk);
-  std::vector<int> nodeBlk(gFa.nNo); 
+  PointTree gTree;
+  gTree.build(gFa.x);
 
   for (int a = 0; a < gFa.nNo; a++) {
-    auto coord = gFa.x.col(a);
-    int iBlk = find_blk(nsd, nBlkd, nFlt, xMin, dx, coord);
-    nodeBlk[a] = iBlk;
-    blk[iBlk].n = blk[iBlk].n + 1;
-  }
+    double minS;
+    int b = gTree.find_nearest(lFa.x.col_data(a), minS);
 
-  for (int iBlk = 0; iBlk < nBlk; iBlk++) {
-    blk[iBlk].gN = Vector<int>(blk[iBlk].n);
-    blk[iBlk].n = 0;
-  }
-
-  for (int a = 0; a < gFa.nNo; a++) {
-    int iBlk = nodeBlk[a];
-    blk[iBlk].gN[blk[iBlk].n] = a;
-    blk[iBlk].n = blk[iBlk].n + 1;
-  }
-
-  for (int a = 0; a < gFa.nNo; a++) {
-    auto coord = lFa.x.col(a);
-    int iBlk = find_blk(nsd, nBlkd, nFlt, xMin, dx, coord);
-    auto minS = std::numeric_limits<double>::max();
-
-    for (int i = 0;  i < blk[iBlk].n; i++) {
-      int b = blk[iBlk].gN[i];
-      auto diff = lFa.x.col(a) - gFa.x.col(b);
-      double ds = sqrt(diff*diff);
-
-      if (ds < minS) {
-        minS = ds;
-        ptr[a] = b;
-      }
+    if (b != -1) {
+      ptr[a] = b;
     }
 
     if (ptr[a] == -1) { 
@@ -1035,6 +973,11 @@ void read_cep_domain(Simulation* simulation, EquationParameters* eq_params, Doma
     throw std::runtime_error("[read_cep_domain] Implicit time integration for tenTusscher-Panfilov model can give unexpected results. Use FE or RK4 instead");
   }
 
+  if (((lDmn.cep.odes.tIntType == TimeIntegratioType::RL) || (lDmn.cep.odes.tIntType == TimeIntegratioType::RL2)) && 
+      (lDmn.cep.cepType != ElectrophysiologyModelType::TTP) && (lDmn.cep.cepType != ElectrophysiologyModelType::BO)) {
+    throw std::runtime_error("[read_cep_domain] Rush-Larsen time integration is only supported for the tenTusscher-Panfilov and Bueno-Orovio models.");
+  }
+
   if (lDmn.cep.odes.tIntType == TimeIntegratioType::CN2) {
     lDmn.cep.odes.maxItr = 5;
     lDmn.cep.odes.absTol = 1e-8;
@@ -1986,6 +1929,7 @@ void read_ls(Simulation* simulation, EquationParameters* eq_params, consts::Solv
     {SolverType::lSolver_GMRES, LinearSolverType::LS_TYPE_GMRES},
     {SolverType::lSolver_CG, LinearSolverType::LS_TYPE_CG},
     {SolverType::lSolver_BICGS, LinearSolverType::LS_TYPE_BICGS},
+    {SolverType::lSolver_PGMRES, LinearSolverType::LS_TYPE_PGMRES},
   };
 
   // Get solver type.
@@ -2042,6 +1986,9 @@ void read_ls(Simulation* simulation, EquationParameters* eq_params, consts::Solv
   auto prec_type = consts::preconditioner_name_to_type.at(linear_algebra.preconditioner());
   lEq.linear_algebra_preconditioner = consts::preconditioner_name_to_type.at(linear_algebra.preconditioner());
   lEq.linear_algebra_assembly_type = LinearAlgebra::name_to_type.at(linear_algebra.assembly()); 
+  lEq.linear_algebra_rebuild_interval = linear_algebra.preconditioner_rebuild_interval();
+  lEq.linear_algebra_rebuild_iterations = linear_algebra.preconditioner_rebuild_iterations();
+  lEq.linear_algebra_refresh_values = linear_algebra.preconditioner_refresh_values();
 
   // Check that equation physics is compatible with the LinearAlgebra type. 
   for (auto& domain : lEq.dmn) {
@@ -2082,6 +2029,8 @@ void read_ls(Simulation* simulation, EquationParameters* eq_params, consts::Solv
     lEq.FSILS.CG.absTol = lEq.FSILS.RI.absTol;
 
     lEq.FSILS.GM.sD = lEq.FSILS.RI.sD;
+
+    lEq.FSILS.GM.pipelined = linear_solver.ns_gm_pipelined.value();
   } 
 
   #ifdef debug_read_ls
@@ -2745,7 +2694,7 @@ void read_trac_bcff(ComMod& com_mod, MBType& lMB, faceType& lFa, const std::stri
   Vector<int> ptr(lFa.nNo);
   ptr = -1;
   gFa.name = "face from traction vtp";
-  face_match(com_mod, lFa, gFa, ptr);
+  face_match(lFa, gFa, ptr);
 
   // Copy pressure/traction data to MB data structure
   //
@@ -48,7 +48,7 @@ namespace read_files_ns {
   using EquationPhys = std::vector<consts::EquationType>;
   using EquationProps = std::array<std::array<consts::PhysicalProperyType, consts::maxNProp>, 20>;
 
-  void face_match(ComMod& com_mod, faceType& lFa, faceType& gFa, Vector<int>& ptr);
+  void face_match(faceType& lFa, faceType& gFa, Vector<int>& ptr);
 
   void read_bc(Simulation* simulation, EquationParameters* eq_params, eqType& lEq, BoundaryConditionParameters* bc_params, bcType& lBc);
 
@@ -40,6 +40,7 @@
 #include "nn.h"
 #include "read_msh.h"
 #include "utils.h"
+#include "SpatialIndex.h"
 #include "vtk_xml.h"
 #include "vtk_xml_parser.h"
 
@@ -596,46 +597,6 @@ void check_ien(Simulation* simulation, mshType& mesh)
   }
 }
 
-/// @brief Compute the block ID for the given coordinate.
-//
-int find_blk(const int nsd, const int nBkd, const std::vector<bool>& nFlt, const Vector<double>&xMin, const Vector<double>&dx, const Vector<double>& x)
-{
-  int i = 0;
-  int j = 0;
-  int k = 0;
-  int block_id;
-
-  if (nFlt[0]) {
-    i = static_cast<int>((x[0] - xMin[0]) / dx[0]);
-  }
-
-  if (i == nBkd) {
-    i = nBkd - 1;
-  }
-
-  if (nFlt[1]) {
-    j = static_cast<int>((x[1] - xMin[1]) / dx[1]);
-  }
-
-  if (j == nBkd) {
-    j = nBkd - 1;
-  }
-
-  if (nsd == 3) {
-    if (nFlt[2]) {
-      k = static_cast<int>((x[2] - xMin[2]) / dx[2]);
-    }
-    if (k == nBkd) {
-      k = nBkd - 1;
-    }
-    block_id = k + (j + i*nBkd)*nBkd;
-  } else {
-    block_id = j + i*nBkd;
-  }
-
-  return block_id;
-}
-
 /// @brief Check and reorder line connectivity if needed.
 ///
 /// \todo [NOTE] Not implemented.
@@ -922,113 +883,44 @@ void match_faces(const ComMod& com_mod, const faceType& lFa, const faceType& pFa
     tol = ptol;
   }
 
-  // We want to have approximately 1000 nodes in each block. So we
-  // calculate nBkd, which is the number of separate blockes in each
-  // direction, based on that.
-  //
-  int a = pFa.nNo;
-  int nBkd = static_cast<int>( pow(a/1000.0, 0.333) + 0.5) ;
-  if (nBkd == 0) {
-    nBkd = 1;
-  }
-  int nsd = com_mod.nsd;;
-  int nBk = pow(nBkd, nsd);
-  #ifdef debug_match_faces
-  dmsg << "a: " << a;
-  dmsg << "nBkd: " << nBkd;
-  dmsg << "nBk: " << nBk;
-  #endif
-
-  // Find the extents of the domain and size of each block.
+  // Build a k-d tree over the nodes of the other face and find the 
+  // nearest one for every node on this face.
   //
-  auto lfa_nodes = lFa.gN + iSh;
-  auto pfa_nodes = pFa.gN + jSh;
-  Vector<double> xMin(com_mod.nsd), xMax(com_mod.nsd);
-
-  for (int i = 0; i < nsd; i++) {
-    auto lfa_coords = com_mod.x.rows(i, lfa_nodes);
-    auto pfa_coords = com_mod.x.rows(i, pfa_nodes);
-    xMin[i] = std::min(lfa_coords.min(), pfa_coords.min());
-    xMax[i] = std::max(lfa_coords.max(), pfa_coords.max());
-
-    if (xMin[i] < 0.0) {
-      xMin[i] = xMin[i]*(1.0+eps);
-    } else { 
-      xMin[i] = xMin[i]*(1.0-eps);
-    } 
+  int nsd = com_mod.nsd;
+  Array<double> xp(nsd, pFa.nNo);
 
-    if (xMax[i] < 0.0) { 
-      xMax[i] = xMax[i]*(1.0-eps);
-    } else { 
-      xMax[i] = xMax[i]*(1.0+eps);
-    } 
+  for (int b = 0; b < pFa.nNo; b++) {
+    int Bc = pFa.gN[b] + jSh;
+    for (int i = 0; i < nsd; i++) {
+      xp(i,b) = com_mod.x(i,Bc);
+    }
   }
 
-  auto dx = (xMax - xMin) / static_cast<double>(nBkd);
-  std::vector<bool> nFlt(nsd);
+  PointTree pTree;
+  pTree.build(xp);
 
-  for (int i = 0; i < nsd; i++) {
-    if (utils::is_zero(dx[i])) {
-      nFlt[i] = false;
-    } else {
-      nFlt[i] = true;
-    } 
-  }
-  
-  Vector<int> nodeBlk(a); 
-  std::vector<blkType> blk(nBk);
-
-  // Find an estimation for size of each block
+  // If the faces are on the same mesh a node is not matched to itself. 
   //
-  for (int a = 0; a < pFa.nNo; a++) {
-    int Ac  = pFa.gN[a] + jSh;
-    auto coord = com_mod.x.col(Ac);
-    int iBk = find_blk(nsd, nBkd, nFlt, xMin, dx, coord);
-    nodeBlk[a] = iBk;
-    blk[iBk].n = blk[iBk].n + 1;
-  }
+  std::vector<int> pNode;
 
-  for (int iBk = 0; iBk < nBk; iBk++) {
-    blk[iBk].gN = Vector<int>(blk[iBk].n);
-    blk[iBk].n = 0;
+  if (iM == jM) {
+    pNode.assign(com_mod.msh[jM].gnNo, -1);
+    for (int b = 0; b < pFa.nNo; b++) {
+      pNode[pFa.gN[b]] = b;
+    }
   }
 
-  for (int a = 0; a < pFa.nNo; a++) {
-    int Ac = pFa.gN[a];
-    int iBk = nodeBlk[a];
-    blk[iBk].gN(blk[iBk].n) = Ac;
-    blk[iBk].n = blk[iBk].n + 1;
-  } 
-
-  // Doing the calculation for every single node on this face.
-  //
   int cnt  = 0;
+  Vector<double> coord(nsd);
 
   for (int a = 0; a < lFa.nNo; a++) {
     int Ac  = lFa.gN[a];
-    auto coord = com_mod.x.col(Ac+iSh);
-    int iBk = find_blk(nsd, nBkd, nFlt, xMin, dx, coord);
-
-    // Check all nodes on the other face.
-    auto minS = std::numeric_limits<double>::max();
-    int i;
-
-    for (int b = 0; b < blk[iBk].n; b++) {
-      int Bc = blk[iBk].gN[b];
-      if ((iM == jM) && (Ac == Bc)) {
-        continue;
-      }
-
-      auto diff = com_mod.x.col(Bc+jSh) - com_mod.x.col(Ac+iSh);
-      double ds = sqrt(diff*diff); 
-
-      if (ds < minS) { 
-        minS = ds;
-        i = Bc;
-      }
-    }
+    coord = com_mod.x.col(Ac+iSh);
+    int skip = (iM == jM) ? pNode[Ac] : -1;
 
-    int Bc = i;
+    double minS;
+    int b = pTree.find_nearest(coord.data(), minS, skip);
+    int Bc = (b == -1) ? -1 : pFa.gN[b];
 
     if (tol < 0.0) {
       push_stack(lPrj, {Ac, Bc});
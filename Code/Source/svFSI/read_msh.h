@@ -41,13 +41,6 @@
 
 namespace read_msh_ns {
 
-  class blkType
-  {
-    public:
-      int n = 0;
-      Vector<int> gN;
-  };
-
   void calc_elem_ar(ComMod& com_mod, const CmMod& cm_mod, mshType& lM, bool& rflag);
   void calc_elem_jac(ComMod& com_mod, const CmMod& cm_mod, mshType& lM, bool& rflag);
   void calc_elem_skew(ComMod& com_mod, const CmMod& cm_mod, mshType& lM, bool& rflag);
@@ -67,8 +60,6 @@ namespace read_msh_ns {
   void check_tri6_conn(mshType& mesh);
   void check_wedge_conn(mshType& mesh);
 
-  int find_blk(const int nsd, const int nBkd, const std::vector<bool>& nFlt, const Vector<double>&xMin, const Vector<double>&dx, const Vector<double>& x);
-
   void load_var_ini(Simulation* simulation, const ComMod& com_mod);
 
   void match_faces(const ComMod& com_mod, const faceType& face1, const faceType& face2, const double tol, utils::stackType& lPrj);
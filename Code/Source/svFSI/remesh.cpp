@@ -37,58 +37,16 @@
 #include "read_msh.h"
 #include "remeshTet.h"
 #include "vtk_xml.h"
+#include "SpatialIndex.h"
 
 #include <array>
 #include<iostream>
 #include <filesystem>
 #include<fstream>
+#include <sstream>
 
 namespace remesh {
 
-/// @brief Distribute the new mesh elements to all processors
-//
-void distre(ComMod& com_mod, CmMod& cm_mod, mshType& lM, int& nEl, Vector<int>& gE)
-{
-  auto& cm = com_mod.cm;
-  int gnEl = lM.gnEl;
-  int eNoN = lM.eNoN;
-
-  #define n_debug_distre
-  #ifdef debug_distre
-  DebugMsg dmsg(__func__, cm.idcm());
-  dmsg.banner();
-  dmsg << "eNoN: " << eNoN;
-  #endif
-
-  Vector<int> part(gnEl);
-  nEl = 0;
-
-  for (int e = 0; e < gnEl; e++) {
-    int i = 0;
-    for (int a = 0; a < eNoN; a++) {
-      int Ac = lM.gIEN(a,e);
-      if (lM.gpN(Ac) == cm.tF(cm_mod)) {
-        i = i + 1;
-      }
-    }
-
-    if (i == eNoN) { 
-      nEl = nEl + 1;
-      part(e) = 1;
-    }
-  }
-
-  gE.resize(nEl);
-  nEl = 0;
-
-  for (int e = 0; e < gnEl; e++) {
-    if (part(e) > 0) {
-      gE(nEl) = e;
-      nEl = nEl + 1;
-    }
-  }
-}
-
 /// @brief Reproduces Fortran 'SUBROUTINE DISTMSHSRF(lFa, lM, iOpt)'
 //
 void dist_msh_srf(ComMod& com_mod, ChnlMod& chnl_mod, faceType& lFa, mshType& lM, const int iOpt)
@@ -310,261 +268,6 @@ void distrn(ComMod& com_mod, CmMod& cm_mod, const int iM, mshType& lM, Array<dou
   lM.gpN = part;
 }
 
-//--------
-// find_n
-//--------
-// Find element in the old mesh for each node in the new mesh
-//
-// Reproduces Fortran 'SUBROUTINE FINDN(xp, iM, Dg, eList, Ec, Nsf)'
-//
-void find_n(ComMod& com_mod, const Vector<double>& Xp, const int iM, const Array<double>& Dg, 
-    const Vector<int>& eList, int& Ec, Vector<double>& Nsf, int pcount)
-{
-  const int nsd = com_mod.nsd;
-  auto& msh = com_mod.msh[iM];
-  int ne = eList.size();
-  Array<double> Amat(nsd+1,msh.eNoN);
-
-  Nsf = 0.0;
-
-  for (int e = 0; e < ne; e++) {
-    //std::cout << "[find_n] --------------- e " << e+1 << std::endl;
-    Ec = eList(e);
-
-    if (Ec == -1) {
-      break;
-    }
-
-    Amat = 1.0;
-
-    for (int a = 0; a <  msh.eNoN; a++) {
-      int Ac = msh.IEN(a,Ec);
-      for (int i = 0; i < nsd; i++) {
-        Amat(i,a) = com_mod.x(i,Ac) + Dg(i,Ac);
-      }
-    }
-
-    Amat = mat_fun::mat_inv(Amat, msh.eNoN);
-
-    double tol = 1e-14;
-    int a = 0;
-
-    for (int i = 0; i < nsd+1; i++) {
-      Nsf(i) = 0.0;
-
-      for (int j = 0; j < msh.eNoN; j++) {
-        Nsf(i) = Nsf(i) + Amat(i,j)*Xp(j);
-      }
-
-      if ( (Nsf(i) > -tol) && (Nsf(i) < (1.0+tol))) {
-        a = a + 1;
-      }
-    }
-
-    if (a == nsd+1) {
-      return;
-    }
-  }
-
-  Ec = -1;
-  Nsf = 0.0;
-}
-
-/// @brief Create list of connected/adjacent elements for old/source mesh
-///
-/// Reproduces Fortran 'SUBROUTINE GETADJESRC(lM, kneList)'
-//
-void get_adj_esrc(ComMod& com_mod, mshType& lM, Array<int>& kneList)
-{
-  #define n_debug_get_adj_esrc
-  #ifdef debug_get_adj_esrc
-  DebugMsg dmsg(__func__, com_mod.cm.idcm());
-  dmsg.banner();
-  #endif
-
-  auto& rmsh = com_mod.rmsh;
-
-  // First get elements around all nodes
-  //
-  Vector<int> nL(lM.nNo);
-
-  for (int e = 0; e < lM.nEl; e++) {
-    for (int a = 0; a < lM.eNoN; a++) {
-      int Ac = lM.IEN(a,e);
-      Ac = lM.lN(Ac);
-      nL(Ac) = nL(Ac) + 1;
-    }
-  }
-
-  int maxKNE = 0;
-  if (nL.size() != 0) {
-    maxKNE = std::max(nL.max(), 0);
-  }
-
-  Array<int> tmpList(maxKNE, lM.nNo);
-  tmpList = -1;  // Stores element IDs
-  nL = 0;        // Stores element counts
-
-  for (int e = 0; e < lM.nEl; e++) {
-    for (int a = 0; a < lM.eNoN; a++) {
-      int Ac = lM.IEN(a,e);
-      Ac = lM.lN(Ac);
-      tmpList(nL(Ac), Ac) = e;
-      nL(Ac) = nL(Ac) + 1;
-    }
-  }
-
-  int b = 2 * maxKNE;
-
-  // Now get elements around each element and avoid redundancy
-  //
-  get_elems:
-    b = b + maxKNE;
-    nL.resize(lM.nEl);
-    kneList.resize(b, lM.nEl);
-    kneList = -1;
-    bool flag = false;
-
-    for (int e = 0; e < lM.nEl; e++) {
-      for (int a = 0; a < lM.eNoN; a++) {
-        int Ac = lM.IEN(a,e);
-        Ac = lM.lN(Ac);
-
-        for (int i = 0; i < maxKNE; i++) {
-          if (tmpList(i,Ac) != -1) {
-            flag = true;
-
-            for (int j = 0; j < nL(e); j++) {
-              if (kneList(j,e) == tmpList(i,Ac)) {
-                flag = false;
-                break;
-              }
-            }
-
-            if (flag) {
-              nL(e) = nL(e) + 1;
-              if (nL(e) >= b) goto get_elems;
-              kneList(nL(e)-1, e) = tmpList(i,Ac);
-            }
-          } else {
-            break;
-          }
-
-        } // for i
-
-      } // for a
-
-    } // for e
-
-  maxKNE = 0;
-  if (nL.size() != 0) {
-    maxKNE = std::max(nL.max(), 0);
-  }
-
-  tmpList.resize(b,lM.nEl);
-  tmpList = kneList;
-  kneList.resize(maxKNE, lM.nEl);
-  kneList = -1;
-
-  for (int e = 0; e < lM.nEl; e++) {
-    for (int i = 0; i < maxKNE; i++) {
-      kneList(i, e) = tmpList(i, e);
-    }
-  }
-}
-
-/// @brief Create list of connected/adjacent nodes for new/target mesh
-///
-/// Reproduces Fortran 'SUBROUTINE GETADJNTGT(lM, nNo, nEl, gN, gE, knnList)'
-//
-void get_adj_ntgt(ComMod& com_mod, mshType& lM, const int nNo, const int nEl, const Vector<int>& gN, 
-    const Vector<int>& gE, Array<int>& knnList)
-{
-  Vector<int> lN(lM.gnNo);
-
-  for (int a = 0; a < nNo; a++) {
-    int Ac = gN(a);
-    lN(Ac) = a;
-  }
-
-  Vector<int> nL(nNo);
-
-  for (int e = 0; e < nEl; e++) {
-    int Ec = gE(e);
-
-    for (int a = 0; a < lM.eNoN; a++) {
-      int Ac = lM.gIEN(a,Ec);
-      int i = lN(Ac);
-
-      for (int b = 0; b < lM.eNoN; b++) {
-        if (b == a) {
-          continue;
-        }
-        int Bc = lM.gIEN(b,Ec);
-        nL(i) = nL(i) + 1;
-      }
-    }
-  }
-
-  int maxKNN = 0;
-  if (nL.size() != 0) {
-    maxKNN = std::max(nL.max(), 0);
-  }
-
-  Array<int> tmpList(maxKNN, nNo);
-
-  tmpList = -1;
-  nL = 0;
-
-  for (int e = 0; e < nEl; e++) {
-    int Ec = gE(e);
-
-    for (int a = 0; a < lM.eNoN; a++) {
-      int Ac = lM.gIEN(a,Ec);
-      int i = lN(Ac);
-
-      for (int b = 0; b < lM.eNoN; b++) {
-        if (a == b) {
-          continue;
-        }
-
-        int Bc = lM.gIEN(b,Ec);
-        int j = lN(Bc);
-        bool flag = true;
-
-        for (int n = 0; n < nL(i); n++) {
-          if (tmpList(n,i) ==  j) {
-            flag = false;
-            break;
-          }
-        }
-
-        if (flag) {
-          tmpList(nL(i), i) = j;
-          nL(i) = nL(i) + 1;
-        }
-      }
-    }
-  }
-
-  maxKNN = 0;
-  if (nL.size() != 0) {
-    maxKNN = std::max(nL.max(), 0);
-  }
-  knnList.resize(maxKNN, nNo);
-  knnList = -1;
-
-  for (int a = 0; a < nNo; a++) {
-    //std::cout << "[get_adj_ntgt] " << a+1 << std::endl;
-    for (int i = 0; i < maxKNN; i++) {
-      knnList(i,a) = tmpList(i,a);
-      //std::cout << knnList(i,a)+1 << " ";
-    }
-    //std::cout << std::endl;
-  }
-
-}
-
 /// @brief Interpolation of data variables from source mesh to target mesh
 //
 void interp(ComMod& com_mod, CmMod& cm_mod, const int lDof, const int iM, mshType& tMsh, Array<double>& sD, Array<double>& tgD)
@@ -618,70 +321,31 @@ void interp(ComMod& com_mod, CmMod& cm_mod, const int lDof, const int iM, mshTyp
   dmsg << "nNo: " << nNo;
   #endif
 
-  // Distribute elements of the new mesh to all processors
-  #ifdef debug_interp
-  dmsg << "Distribute elements ..." << "";
-  #endif
-  int nEl = 0;
-  Vector<int> gE;
-  distre(com_mod, cm_mod, tMsh, nEl, gE);
-  //CALL DISTRE(tMsh, nEl, gE)
-  #ifdef debug_interp
-  dmsg << "nEl: " << nEl;
-  #endif
-
-  // Setup data structures for octree search
-  // Get adjacent cells for source (old) mesh
+  // Build a bounding volume hierarchy over the elements of the source 
+  // (old) mesh in its current configuration
   //
   #ifdef debug_interp
-  dmsg << "Setup data structures for octree search ... " << "";
-  #endif
-  Array<int> srcAdjEl;
-  get_adj_esrc(com_mod, msh[iM], srcAdjEl);
-  //CALL GETADJESRC(msh(iM), srcAdjEl)
-  int maxKNE = srcAdjEl.nrows();
-  #ifdef debug_interp
-  dmsg << "maxKNE: " << maxKNE;
-  //dmsg << "srcAdjEl: " << srcAdjEl;
+  dmsg << "Build source mesh element tree ... " << "";
   #endif
+  Array<double> xd(nsd,tnNo);
 
-  // Get adjacent nodes for each node on the new mesh
-  //
-  // tgtAdjNd stores node IDs.
-  //
-  #ifdef debug_interp
-  dmsg << "Get adjacent nodes " << " ...";
-  #endif
-  Array<int> tgtAdjNd;
-  get_adj_ntgt(com_mod, tMsh, nNo, nEl, gN, gE, tgtAdjNd);
-  //CALL GETADJNTGT(tMsh, nNo, nEl, gN, gE, tgtAdjNd)
+  for (int Ac = 0; Ac < tnNo; Ac++) {
+    for (int j = 0; j < nsd; j++) {
+      xd(j,Ac) = com_mod.x(j,Ac) + Dg(j,Ac);
+    }
+  }
 
-  int maxKNN = tgtAdjNd.nrows();
-  //DEALLOCATE(gE)
-  #ifdef debug_interp
-  dmsg << "maxKNN: " << maxKNN;
-  dmsg << "nNo: " << nNo;
-  //dmsg << "tgtAdjNd: " << tgtAdjNd;
-  #endif
+  ElementTree srcTree;
+  srcTree.build(xd, msh[iM].IEN);
 
-  Vector<double> Xp(nsd+1), Nsf(eNoN); 
+  Vector<double> Nsf(eNoN); 
   Array<double> gNsf(eNoN,nNo); 
-  Vector<int> tagNd(gnNo), rootEl(nNo), masEList(msh[iM].nEl);
-  //ALLOCATE(Xp(nsd+1), Nsf(eNoN), gNsf(eNoN,nNo), tagNd(gnNo), gE(nNo), rootEl(nNo), chckNp(nNo), masEList(msh(iM).nEl))
-  rootEl = -1;
-
-  std::vector<bool> chckNp(nNo);
-  std::fill(chckNp.begin(), chckNp.end(), false);
-
-  for (int e = 0; e < msh[iM].nEl; e++) {
-    masEList(e) = e;
-  }
+  Vector<int> tagNd(gnNo), gE(nNo);
 
   // Determine boundary nodes on the new mesh, where interpolation is
   // not needed, or boundary search is performed
   //
   Vector<int> tmpL(gnNo);
-  //tmpL = -1;
   #ifdef debug_interp
   dmsg << "gnNo: " << gnNo;
   #endif
@@ -710,8 +374,6 @@ void interp(ComMod& com_mod, CmMod& cm_mod, const int lDof, const int iM, mshTyp
     }
   }
 
-  //DEALLOCATE(tmpL)
-
   // tagNd stores procesors IDs ?
   int bTag = 2*cm.np();
 
@@ -719,7 +381,6 @@ void interp(ComMod& com_mod, CmMod& cm_mod, const int lDof, const int iM, mshTyp
     int Ac = gN(a);
 
     if (srfNds(a) > 0) {
-      chckNp[a] = true;
       tagNd(Ac) = bTag;
       gE(a) = -1;
 
@@ -729,219 +390,35 @@ void interp(ComMod& com_mod, CmMod& cm_mod, const int lDof, const int iM, mshTyp
     }
   }
   
-  // Find a starting element through brute search and the starting node
-  // is used to initialize the queue (local numbering)
+  // Find the source mesh element containing each of the remaining nodes
   //
   #ifdef debug_interp
-  dmsg << "Find a starting element ... " << "";
+  dmsg << "Node-Cell search begins ... " << "";
   #endif
-  utils::queueType rootNdQ;
+  double tol = 1e-14;
 
   for (int a = 0; a < nNo; a++) {
-    #ifdef debug_interp_1
-    dmsg << "---------- a " << std::to_string(a+1) + " ----------";
-    #endif
-    if (chckNp[a]) {
+    if (srfNds(a) > 0) {
       continue; 
     }
-    int Ac = gN(a);
-    Xp = 1.0;
-    int Ec = -1;
-    for (int i = 0; i < nsd; i++) {
-      Xp(i) = tMsh.x(i,Ac);
-    }
 
-    find_n(com_mod, Xp, iM, Dg, masEList, Ec, Nsf, 0);
+    int Ac = gN(a);
+    int Ec = srcTree.find_element(tMsh.x.col_data(Ac), tol, Nsf.data());
     #ifdef debug_interp_1
+    dmsg << "Ac: " << Ac+1;
     dmsg << "Ec: " << Ec+1; 
     #endif
-    //CALL FINDN(Xp, iM, Dg, masEList, Ec, Nsf)
-    chckNp[a] = true;
 
-    // Once an element in the source mesh is found, set 'this' element as
-    // 'root' element for all the neighbor nodes of the target mesh. Then
-    // add these neighbor nodes to the queue to form the 'front'
-    //
     if (Ec > -1) {
       gE(a) = Ec;
       tagNd(Ac) = cm.tF(cm_mod);
-      #ifdef debug_interp_s
-      if (Ac == 8864-1) {
-        dmsg << "#### 1 Ac: " << Ac+1; 
-      }
-      #endif
 
       for (int i = 0; i < eNoN; i++) {
         gNsf(i,a) = Nsf(i);
       }
-      //gNsf(:,a) = Nsf(:)
-
-      for (int nn = 0; nn < maxKNN; nn++) {
-        int b = tgtAdjNd(nn,a);
-
-        if (b > -1) {
-          #ifdef debug_interp_1
-          dmsg << "nn: " << std::to_string(nn+1) +  "  b: " + std::to_string(b+1); 
-          #endif
-          utils::enqueue(rootNdQ, b);
-          rootEl(b) = Ec;
-        }
-      }
-
-      if (rootNdQ.n > 1) {
-        break;
-      }
     }
   }
 
-  // Node-Cell search begins here. Uses fastest grid-to-grid algorithm
-  // based on advancing front in the nearest vicinity
-  //
-  #ifdef debug_interp
-  dmsg << " " << "";
-  dmsg << "Node-Cell search begins ... " << "";
-  #endif
-  Vector<int> eList(maxKNE); 
-  int probe;
-  int pcount = 0;
- 
-  while (dequeue(rootNdQ, probe)) {
-    #ifdef debug_interp_1
-    dmsg << " " << " ";
-    dmsg << "---------- probe " << std::to_string(probe+1) + " ----------";
-    dmsg << "pcount: " << pcount+1;
-    #endif
-    pcount += 1;
-
-    if (std::all_of(chckNp.begin(), chckNp.end(), [](bool v) { return v; })) {
-      break;
-    }
-
-    if (chckNp[probe]) {
-      continue;
-    }
-
-    int Ac = gN(probe);
-    Xp = 1.0;
-    for (int i = 0; i < nsd; i++) {
-      Xp(i) = tMsh.x(i,Ac);
-    }
-    eList = -1;
-    bool flag = false;
-    #ifdef debug_interp_1
-    dmsg << "Ac: " << Ac+1;
-    dmsg << "rootEl(probe): " << rootEl(probe)+1;
-    #endif
-
-    for (int e = 0; e < maxKNE; e++) {
-      int Ec = srcAdjEl(e,rootEl(probe));
-      if (Ec > -1) {
-        eList(e) = Ec;
-        #ifdef debug_interp_1
-        //dmsg << "srcAdjEl:  e Ec: " << std::to_string(e+1) + " " + std::to_string(Ec+1);
-        #endif
-      }
-    }
-
-    for (int itry = 1; itry <= 2; itry++) {
-      #ifdef debug_interp_1
-      dmsg << ">>>>> try: " << itry; 
-      dmsg << "pcount: " << pcount; 
-      dmsg << "Xp: " << Xp; 
-      dmsg << "eList: " << eList; 
-      #endif
-      int Ec;
-      find_n(com_mod, Xp, iM, Dg, eList, Ec, Nsf, pcount);
-      #ifdef debug_interp_1
-      dmsg << "Ec: " << Ec+1; 
-      #endif
-
-      #ifdef debug_interp_s
-      if (pcount == 19195+1) {
-        dmsg << "eList: " << eList; 
-        exit(0);
-      }
-      #endif
-
-      // If an element is found, the neighbors of the node are initialized
-      // with this element as root element and are added to the queue
-      // (front propagation)
-
-      if (Ec > -1) {
-        gE(probe) = Ec;
-        tagNd(Ac) = cm.tF(cm_mod);
-
-        for (int i = 0; i < Nsf.size(); i++) {
-          gNsf(i,probe) = Nsf(i);
-        }
-
-        for (int nn = 0; nn < maxKNN; nn++) {
-          int a = tgtAdjNd(nn,probe);
-
-          if (a > -1) {
-            #ifdef debug_interp_1
-            //dmsg << "tgtAdjNd:   nn a Ec: " << std::to_string(nn+1) + " " + std::to_string(a+1) + " " + std::to_string(Ec+1); 
-            #endif
-            utils::enqueue(rootNdQ, a);
-            rootEl(a) = Ec;
-          }
-        }
-
-        eList.resize(maxKNE); 
-        eList = -1;
-        break;
-      }
-
-      // If failed in first attempt, try again with increased search area
-      // but add neighbors uniquely without repetition
-      //
-      if (itry == 1) {
-        tmpL.resize(nEl);
-        tmpL = 0;
-        int ne = 0;
-        flag = false; 
-
-        for (int e = 0; e < maxKNE; e++) {
-          int Ec = eList(e);
-
-          if (Ec > -1) {
-            for (int a = 0; a < maxKNE; a++) {
-              int Bc = srcAdjEl(a,Ec);
-
-              if (Bc != -1 && Bc != Ec) {
-                flag = true; 
-
-                for (int i = 0; i < ne; i++) {
-                  if (Bc == tmpL(i)) {
-                    flag = false; 
-                    break;
-                  }
-                }
-
-                if (flag) {
-                  tmpL(ne) = Bc;
-                  ne = ne + 1;
-                }
-              }
-            }
-          }
-        }
-
-        eList.resize(ne);
-        eList = -1;
-        for (int i = 0; i < ne; i++) {
-          eList(i) = tmpL(i);
-        }
-
-      } else if (itry == 2) {
-        eList.resize(maxKNE); 
-        eList = -1;
-      }
-    } // itry
-
-    chckNp[probe] = true;
-  }
-
   tmpL.resize(gnNo);
   tmpL = 0;
 
@@ -981,33 +458,6 @@ void interp(ComMod& com_mod, CmMod& cm_mod, const int lDof, const int iM, mshTyp
     tagNd(Ac) = tmpL(Ac);
   }
 
-  // Now use brute force to find left over non-interpolated nodes
-  //
-  #ifdef debug_interp
-  dmsg << "Find left over non-interpolated nodes ... " << "";
-  #endif
-  for (int a = 0; a < nNo; a++) {
-    int Ac = gN(a);
-
-    if (tagNd(Ac) == 0) {
-      Xp = 1.0;
-      for (int i = 0; i < nsd; i++) {
-        Xp(i) = tMsh.x(i,Ac);
-      }
-
-      int Ec = -1;
-      find_n(com_mod, Xp, iM, Dg, masEList, Ec, Nsf, 0);
-
-      if (Ec > -1) {
-        gE(a) = Ec;
-        tagNd(Ac) = cm.tF(cm_mod);
-        for (int i = 0; i < Nsf.size(); i++) {
-          gNsf(i,a) = Nsf(i);
-        }
-      }
-    }
-  }
-
   // Nodes belonging to other procs are reassigned 0
   #ifdef debug_interp
   dmsg << "Nodes in other procs set to 0 ..." << "";
@@ -1055,39 +505,36 @@ void interp(ComMod& com_mod, CmMod& cm_mod, const int lDof, const int iM, mshTyp
   // face node/IEN structure to NOT be changed during remeshing.
   //
   tmpL.resize(nNo);
-  bool flag = false; 
-
-  for (int a = 0; a < nNo; a++) {
-    int Ac = gN(a);
-
-    if (srfNds(a) != 0) {      // srfNds is a bool (1|0) vector.
-      flag = false; 
+  std::vector<int> faNodes;
 
-      for (int iFa = 0; iFa < msh[iM].nFa; iFa++) {
-        auto& fa = msh[iM].fa[iFa];
+  for (int iFa = 0; iFa < msh[iM].nFa; iFa++) {
+    auto& fa = msh[iM].fa[iFa];
+    for (int b = 0; b < fa.nNo; b++) {
+      faNodes.push_back(fa.gN(b));
+    }
+  }
 
-        for (int b = 0; b <fa.nNo; b++) {
-          int Bc = fa.gN(b);
-          double dS = 0.0; 
+  int nFaNodes = faNodes.size();
+  Array<double> xFa(nsd, nFaNodes);
 
-          for (int i = 0; i < nsd; i++) {
-            double sum = com_mod.x(i,Bc) + Dg(i,Bc) - tMsh.x(i,Ac);
-            dS += sum * sum;
-          }
+  for (int b = 0; b < nFaNodes; b++) {
+    for (int i = 0; i < nsd; i++) {
+      xFa(i,b) = xd(i,faNodes[b]);
+    }
+  }
 
-          dS = sqrt(dS);
+  PointTree faTree;
+  faTree.build(xFa);
 
-          if (dS < 1.E-12) {
-            tmpL(a) = Bc;
-            flag = true;
-            break;
-          }
-        }
+  for (int a = 0; a < nNo; a++) {
+    int Ac = gN(a);
 
-        if (flag) break;
-      }
+    if (srfNds(a) != 0) {      // srfNds is a bool (1|0) vector.
+      double dS;
+      int b = faTree.find_nearest(tMsh.x.col_data(Ac), dS);
 
-      if (flag) {
+      if (b != -1 && dS < 1.E-12) {
+        tmpL(a) = faNodes[b];
         int Bc = msh[iM].lN(tmpL(a));
         for (int i = 0; i < tmpX.nrows(); i++) { 
           tmpX(i,a) = sD(i,Bc);
@@ -1473,17 +920,14 @@ void remesh_restart(Simulation* simulation)
   #endif
   std::filesystem::remove(sTmp);
 
-  // Create the file.
-  //
-  if (cm.mas(cm_mod)) {
-    std::ofstream restart_file(sTmp, std::ios::out | std::ios::binary);
-    restart_file.close();
-  }
-
-  // This call is to block all processors
   cm.bcast(cm_mod, &rmsh.rTS);
 
-  // Write something.
+  // Write the restart record of this process.
+  //
+  // The record holds the state on the mesh before remeshing so it has the 
+  // current record length, which is stored in the record header and used to 
+  // read the file after the record length has been recomputed for the new mesh.
+  // The header has the time step and time of that state.
   //
   auto fTmp = stFileName + "_" + std::to_string(rmsh.rTS) + ".bin";
   auto const recLn = com_mod.recLn;
@@ -1494,10 +938,8 @@ void remesh_restart(Simulation* simulation)
   dmsg << "dFlag: " << dFlag;
   #endif
 
-  std::ofstream restart_file(fTmp, std::ios::out | std::ios::binary | std::ios::app);
-  std::streampos write_pos = (cm.tF(cm_mod) - 1) * recLn;
-  restart_file.seekp(write_pos);
-  output::write_restart_header(com_mod, timeP, restart_file);
+  std::ostringstream restart_file(std::ios::out | std::ios::binary);
+  output::write_restart_header(com_mod, timeP, rmsh.rTS, rmsh.time, rmsh.iNorm, restart_file);
 
   auto& cplBC = com_mod.cplBC;
   restart_file.write((char*)cplBC.xn.data(), cplBC.xn.msize());
@@ -1508,11 +950,23 @@ void remesh_restart(Simulation* simulation)
     restart_file.write((char*)rmsh.D0.data(), rmsh.D0.msize());
   }
 
-  restart_file.close();
+  auto record = restart_file.str();
+  output::finish_restart_record(com_mod, record);
+
+  off_t size = 0;
+  if (cm.mas(cm_mod)) {
+    size = static_cast<off_t>(cm.np()) * recLn;
+  }
+  bool ok = output::write_restart_record(fTmp, record, static_cast<off_t>(cm.tF(cm_mod) - 1) * recLn, size);
+
+  if (!cm.reduce(cm_mod, static_cast<int>(ok), MPI_MIN)) {
+    throw std::runtime_error("Failed to write the restart file '" + fTmp + "'.");
+  }
 
   if (cm.mas(cm_mod)) {
-    std::string link_cmd = "ln -f " + fTmp + " " + sTmp;
-    std::system(link_cmd.c_str());
+    std::error_code ec;
+    std::filesystem::remove(sTmp, ec);
+    std::filesystem::create_hard_link(fTmp, sTmp, ec);
   }
 
   auto& x = com_mod.x;
@@ -44,13 +44,32 @@
 #include "utils.h"
 #include <math.h>
 #include "svZeroD_subroutines.h"
+#include "genBC_interface/GenBCInterface.h"
+
+#include <map>
+#include <memory>
 
 namespace set_bc {
 
+/// @brief genBC loaded as a shared library, if Couple_to_genBC's 
+/// ZeroD_code_file_path is a .so or .dylib file.
+static std::unique_ptr<GenBCInterface> genbc_interface;
+
+/// @brief Groups of coupled Neumann faces (cplBC.fa indexes) whose 0D 
+/// pressures do not depend on the flowrates of the other faces in the group.
+/// The faces of a group are perturbed together by calc_der_cpl_bc().
+static std::vector<std::vector<int>> cpl_der_groups;
+
+/// @brief The time step for which cpl_der_groups was set.
+static int cpl_der_time_step = -1;
+
 /// @brief This function calculates updated cplBC pressures or flowrates from 0D,
 /// as well as the resistance matrix M ~ dP/dQ from 0D using finite difference.
 /// Updates the pressure or flowrates stored in cplBC.fa[i].y and the resistance
 /// matrix M ~ dP/dQ stored in eq.bc[iBc].r.
+///
+/// Faces whose pressures don't depend on each other's flowrates are perturbed
+/// together in a single 0D solve (see cpl_der_groups).
 /// @param com_mod 
 /// @param cm_mod 
 void calc_der_cpl_bc(ComMod& com_mod, const CmMod& cm_mod)
@@ -207,33 +226,128 @@ void calc_der_cpl_bc(ComMod& com_mod, const CmMod& cm_mod)
     orgQ[i] = cplBC.fa[i].Qn;
   }
 
+  // The coupled Neumann faces and their BCs
+  std::vector<int> neuFa;
+  std::map<int,int> faBc;
+
   for (int iBc = 0; iBc < eq.nBc; iBc++) {
     auto& bc = eq.bc[iBc];
     int i = bc.cplBCptr;
-
     if (i != -1 && utils::btest(bc.bType, iBC_Neu)) {
+      neuFa.push_back(i);
+      faBc[i] = iBc;
+    }
+  }
 
-        // Finite difference perturbation in flowrate
-        cplBC.fa[i].Qn = orgQ[i] + diff;
+  auto integ_0d = [&]() {
+    if (cplBC.useGenBC) {
+      set_bc::genBC_Integ_X(com_mod, cm_mod, "D");
+    } else if (cplBC.useSvZeroD) {
+      svZeroD::calc_svZeroD(com_mod, cm_mod, 'D');
+    } else {
+      set_bc::cplBC_Integ_X(com_mod, cm_mod, RCRflag);
+    }
+  };
 
-        // Call genBC or cplBC again with perturbed flowrate
-        if (cplBC.useGenBC) {
-          set_bc::genBC_Integ_X(com_mod, cm_mod, "D");
-        } else if (cplBC.useSvZeroD) {
-          svZeroD::calc_svZeroD(com_mod, cm_mod, 'D');
-        } else {
-          set_bc::cplBC_Integ_X(com_mod, cm_mod, RCRflag);
+  auto restore = [&]() {
+    for (size_t j = 0; j < cplBC.fa.size(); j++) {
+      cplBC.fa[j].y = orgY[j];
+      cplBC.fa[j].Qn = orgQ[j];
+    }
+  };
+
+  // At the first call of each time step perturb the faces one at a time and
+  // record how the pressure of every face responds. Faces that do not affect 
+  // each other's pressure are then grouped so the other Newton iterations 
+  // of the time step only need one 0D solve per group instead of one per 
+  // face. The grouping is redone every time step because the coupling can 
+  // change, e.g. when a valve in the 0D model opens or closes.
+  //
+  // Face j depends on face i if perturbing face i changes the pressure of 
+  // face j by more than cplTol times the change of its own pressure.
+  //
+  const double cplTol = 1.0e-6;
+
+  if ((cpl_der_time_step != com_mod.cTS) || cpl_der_groups.empty()) {
+    const int nNeu = neuFa.size();
+    Array<double> dY(nNeu,nNeu);
+
+    for (int k = 0; k < nNeu; k++) {
+      int i = neuFa[k];
+
+      // Finite difference perturbation in flowrate
+      cplBC.fa[i].Qn = orgQ[i] + diff;
+
+      // Call genBC or cplBC again with perturbed flowrate
+      integ_0d();
+
+      // Finite difference calculation of the resistance dP/dQ
+      eq.bc[faBc[i]].r = (cplBC.fa[i].y - orgY[i]) / diff;
+
+      for (int l = 0; l < nNeu; l++) {
+        int j = neuFa[l];
+        dY(l,k) = cplBC.fa[j].y - orgY[j];
+      }
+
+      // Restore the original pressures and flowrates
+      restore();
+    }
+
+    std::vector<std::vector<int>> groups;
+
+    for (int k = 0; k < nNeu; k++) {
+      bool added = false;
+
+      for (auto& group : groups) {
+        bool coupled = false;
+
+        for (int l : group) {
+          if ((fabs(dY(l,k)) > cplTol*fabs(dY(k,k))) || (fabs(dY(k,l)) > cplTol*fabs(dY(l,l)))) {
+            coupled = true;
+            break;
+          }
         }
 
-        // Finite difference calculation of the resistance dP/dQ
-        bc.r = (cplBC.fa[i].y - orgY[i]) / diff;
+        if (!coupled) {
+          group.push_back(k);
+          added = true;
+          break;
+        }
+      }
 
-        // Restore the original pressures and flowrates
-        for (size_t j = 0; j < cplBC.fa.size(); j++) {
-          cplBC.fa[j].y = orgY[j];
-          cplBC.fa[j].Qn = orgQ[j];
-}
-     }
+      if (!added) {
+        groups.push_back({k});
+      }
+    }
+
+    cpl_der_groups.clear();
+
+    for (auto& group : groups) {
+      std::vector<int> faces;
+      for (int k : group) {
+        faces.push_back(neuFa[k]);
+      }
+      cpl_der_groups.push_back(faces);
+    }
+
+    cpl_der_time_step = com_mod.cTS;
+    return;
+  }
+
+  // Perturb all of the faces of a group together.
+  //
+  for (auto& group : cpl_der_groups) {
+    for (int i : group) {
+      cplBC.fa[i].Qn = orgQ[i] + diff;
+    }
+
+    integ_0d();
+
+    for (int i : group) {
+      eq.bc[faBc[i]].r = (cplBC.fa[i].y - orgY[i]) / diff;
+    }
+
+    restore();
   }
 }
 
@@ -335,7 +449,7 @@ void genBC_Integ_X(ComMod& com_mod, const CmMod& cm_mod, const std::string& genF
   auto& cplBC = com_mod.cplBC;
   auto& cm = com_mod.cm;
 
-  int len = cplBC.binPath.size() + cplBC.commuName.size() + 1;
+  int len = cplBC.binPath.size() + cplBC.commuName.size() + 2;
   char command[len];
   strcpy(command, cplBC.binPath.c_str());
   strcat(command, " ");
@@ -353,86 +467,126 @@ void genBC_Integ_X(ComMod& com_mod, const CmMod& cm_mod, const std::string& genF
       }
     }
 
-    // Write coupling info (number of Dirichlet and Neumann surfaces, pressure, 
-    // flow rate) from 3D to cplBC communication file (for GenBC, usually 
-    // called GenBC.int)
-    int int_size = sizeof(int);
-    int double_size = sizeof(double);
-    int flag_size = genFlag.length();
-
-    std::ofstream genBC_writer;
-    genBC_writer.open(cplBC.commuName, std::ios::out|std::ios::binary);
-    if (!genBC_writer.is_open()) {
-      throw std::runtime_error("Failed to open the genBC initialization file '" + cplBC.commuName + "' to write.");
-    }
-    // Flag for how genBC behaves (I: Initializing, T: Iteration loop, L: Last iteration, D: Derivative)
-    genBC_writer.write( (char*)&flag_size, int_size);
-    genBC_writer.write(genFlag.c_str(), flag_size);
-    genBC_writer.write( (char*)&flag_size, int_size);
+    // Call genBC built as a shared library with in-memory buffers.
+    //
+    if (GenBCInterface::is_library(cplBC.binPath)) {
+      if (genbc_interface == nullptr) {
+        genbc_interface = std::make_unique<GenBCInterface>();
+        genbc_interface->load_library(cplBC.binPath);
+      }
+
+      std::vector<double> P, Q, y;
+
+      for (int iFa = 0; iFa < cplBC.nFa; iFa++) {
+        auto& fa = cplBC.fa[iFa];
+        if (fa.bGrp == CplBCType::cplBC_Dir) {
+          P.push_back(fa.Po);
+          P.push_back(fa.Pn);
+        } else if (fa.bGrp == CplBCType::cplBC_Neu) {
+          Q.push_back(fa.Qo);
+          Q.push_back(fa.Qn);
+        }
+      }
+
+      genbc_interface->integ(genFlag, dt, nDir, nNeu, P, Q, y);
+
+      int j = 0;
+      for (int iFa = 0; iFa < cplBC.nFa; iFa++) {
+        if (cplBC.fa[iFa].bGrp == CplBCType::cplBC_Dir) {
+          cplBC.fa[iFa].y = y[j++];
+        }
+      }
+
+      for (int iFa = 0; iFa < cplBC.nFa; iFa++) {
+        if (cplBC.fa[iFa].bGrp == CplBCType::cplBC_Neu) {
+          cplBC.fa[iFa].y = y[j++];
+        }
+      }
+
+    // Call the genBC executable through the communication file.
+    //
+    } else {
+      // Write coupling info (number of Dirichlet and Neumann surfaces, pressure, 
+      // flow rate) from 3D to cplBC communication file (for GenBC, usually 
+      // called GenBC.int)
+      int int_size = sizeof(int);
+      int double_size = sizeof(double);
+      int flag_size = genFlag.length();
+
+      std::ofstream genBC_writer;
+      genBC_writer.open(cplBC.commuName, std::ios::out|std::ios::binary);
+      if (!genBC_writer.is_open()) {
+        throw std::runtime_error("Failed to open the genBC initialization file '" + cplBC.commuName + "' to write.");
+      }
+      // Flag for how genBC behaves (I: Initializing, T: Iteration loop, L: Last iteration, D: Derivative)
+      genBC_writer.write( (char*)&flag_size, int_size);
+      genBC_writer.write(genFlag.c_str(), flag_size);
+      genBC_writer.write( (char*)&flag_size, int_size);
     
-    genBC_writer.write( (char*)&double_size, int_size);
-    genBC_writer.write( (char*)&dt, double_size);
-    genBC_writer.write( (char*)&double_size, int_size);
+      genBC_writer.write( (char*)&double_size, int_size);
+      genBC_writer.write( (char*)&dt, double_size);
+      genBC_writer.write( (char*)&double_size, int_size);
     
-    genBC_writer.write( (char*)&int_size, int_size);
-    genBC_writer.write( (char*)&nDir, int_size);
-    genBC_writer.write( (char*)&int_size, int_size);
+      genBC_writer.write( (char*)&int_size, int_size);
+      genBC_writer.write( (char*)&nDir, int_size);
+      genBC_writer.write( (char*)&int_size, int_size);
     
-    genBC_writer.write( (char*)&int_size, int_size);
-    genBC_writer.write( (char*)&nNeu, int_size);
-    genBC_writer.write( (char*)&int_size, int_size);
+      genBC_writer.write( (char*)&int_size, int_size);
+      genBC_writer.write( (char*)&nNeu, int_size);
+      genBC_writer.write( (char*)&int_size, int_size);
 
-    for (int iFa = 0; iFa < cplBC.nFa; iFa++) {
-      if (cplBC.fa[iFa].bGrp == CplBCType::cplBC_Dir) {
-        genBC_writer.write( (char*)&double_size, int_size);
-        genBC_writer.write( (char*)&cplBC.fa[iFa].Po, double_size);
-        genBC_writer.write( (char*)&double_size, int_size);
-        genBC_writer.write( (char*)&double_size, int_size);
-        genBC_writer.write( (char*)&cplBC.fa[iFa].Pn, double_size);
-        genBC_writer.write( (char*)&double_size, int_size);
+      for (int iFa = 0; iFa < cplBC.nFa; iFa++) {
+        if (cplBC.fa[iFa].bGrp == CplBCType::cplBC_Dir) {
+          genBC_writer.write( (char*)&double_size, int_size);
+          genBC_writer.write( (char*)&cplBC.fa[iFa].Po, double_size);
+          genBC_writer.write( (char*)&double_size, int_size);
+          genBC_writer.write( (char*)&double_size, int_size);
+          genBC_writer.write( (char*)&cplBC.fa[iFa].Pn, double_size);
+          genBC_writer.write( (char*)&double_size, int_size);
+        }
       }
-    }
     
-    for (int iFa = 0; iFa < cplBC.nFa; iFa++) {
-      if (cplBC.fa[iFa].bGrp == CplBCType::cplBC_Neu) {
-        genBC_writer.write( (char*)&double_size, int_size);
-        genBC_writer.write( (char*)&cplBC.fa[iFa].Qo, double_size);
-        genBC_writer.write( (char*)&double_size, int_size);
-        genBC_writer.write( (char*)&double_size, int_size);
-        genBC_writer.write( (char*)&cplBC.fa[iFa].Qn, double_size);
-        genBC_writer.write( (char*)&double_size, int_size);
+      for (int iFa = 0; iFa < cplBC.nFa; iFa++) {
+        if (cplBC.fa[iFa].bGrp == CplBCType::cplBC_Neu) {
+          genBC_writer.write( (char*)&double_size, int_size);
+          genBC_writer.write( (char*)&cplBC.fa[iFa].Qo, double_size);
+          genBC_writer.write( (char*)&double_size, int_size);
+          genBC_writer.write( (char*)&double_size, int_size);
+          genBC_writer.write( (char*)&cplBC.fa[iFa].Qn, double_size);
+          genBC_writer.write( (char*)&double_size, int_size);
+        }
       }
-    }
-    genBC_writer.close();
+      genBC_writer.close();
     
-    // Call genBC executable which reads the communication file GenBC.int
-    system(command);
+      // Call genBC executable which reads the communication file GenBC.int
+      system(command);
 
-    // Read outputs from genBC, which are in the same GenBC.int
-    std::ifstream genBC_reader(cplBC.commuName, std::ios::out | std::ios::binary);
-    if (!genBC_reader.is_open()) {
-      throw std::runtime_error("Failed to open the genBC interface file '" + cplBC.commuName + "' to read.");
-    }
+      // Read outputs from genBC, which are in the same GenBC.int
+      std::ifstream genBC_reader(cplBC.commuName, std::ios::out | std::ios::binary);
+      if (!genBC_reader.is_open()) {
+        throw std::runtime_error("Failed to open the genBC interface file '" + cplBC.commuName + "' to read.");
+      }
 
-    int size_buffer;
+      int size_buffer;
 
-    for (int iFa = 0; iFa < cplBC.nFa; iFa++) {
-      if (cplBC.fa[iFa].bGrp == CplBCType::cplBC_Dir) {
-        genBC_reader.read( (char*)&size_buffer, int_size );
-        genBC_reader.read( (char*)&cplBC.fa[iFa].y, size_buffer );
-        genBC_reader.read( (char*)&size_buffer, int_size );
+      for (int iFa = 0; iFa < cplBC.nFa; iFa++) {
+        if (cplBC.fa[iFa].bGrp == CplBCType::cplBC_Dir) {
+          genBC_reader.read( (char*)&size_buffer, int_size );
+          genBC_reader.read( (char*)&cplBC.fa[iFa].y, size_buffer );
+          genBC_reader.read( (char*)&size_buffer, int_size );
+        }
       }
-    }
 
-    for (int iFa = 0; iFa < cplBC.nFa; iFa++) {
-      if (cplBC.fa[iFa].bGrp == CplBCType::cplBC_Neu) {
-        genBC_reader.read( (char*)&size_buffer, int_size );
-        genBC_reader.read( (char*)&cplBC.fa[iFa].y, size_buffer );
-        genBC_reader.read( (char*)&size_buffer, int_size );
+      for (int iFa = 0; iFa < cplBC.nFa; iFa++) {
+        if (cplBC.fa[iFa].bGrp == CplBCType::cplBC_Neu) {
+          genBC_reader.read( (char*)&size_buffer, int_size );
+          genBC_reader.read( (char*)&cplBC.fa[iFa].y, size_buffer );
+          genBC_reader.read( (char*)&size_buffer, int_size );
+        }
       }
-    }
 
-    genBC_reader.close();
+      genBC_reader.close();
+    }
   }
 
   // If there are multiple procs (not sequential), broadcast genBC outputs to
@@ -628,6 +782,7 @@ void set_bc_cmm_l(ComMod& com_mod, const CmMod& cm_mod, const faceType& lFa, con
   int iM = lFa.iM;
   Array<double> al(tDof,3), dl(tDof,3), xl(3,3), bfl(3,3); 
   Vector<int> ptr(3);
+  auto& ws = com_mod.elem_workspace[0];
 
   // Constructing the CMM contributions to the LHS/RHS and
   // assembling them
@@ -664,7 +819,7 @@ void set_bc_cmm_l(ComMod& com_mod, const CmMod& cm_mod, const faceType& lFa, con
     vwp = vwp / 3.0;
 
     // Add CMM BCs contributions to the LHS/RHS
-    cmm::cmm_b(com_mod, lFa, e, al, dl, xl, bfl, pSl, vwp, ptr);
+    cmm::cmm_b(com_mod, lFa, e, al, dl, xl, bfl, pSl, vwp, ptr, ws);
   }
 
 }
@@ -1223,8 +1378,7 @@ void set_bc_dir_wl(ComMod& com_mod, const bcType& lBc, const mshType& lM, const
     }
 
     // Set function spaces for velocity and pressure on mesh
-    std::array<fsType,2> fs;
-    fs::get_thood_fs(com_mod, fs, lM, flag, 1);
+    const auto& fs = fs::thood_fs(lM, flag, 1);
 
     Array<double> xwl(nsd,fs[0].eNoN); 
     Vector<double> Nw(fs[0].eNoN); 
@@ -89,6 +89,7 @@ void construct_shell(ComMod& com_mod, const mshType& lM, const Array<double>& Ag
   Array<double> xl(nsd,eNoN), al(tDof,eNoN), yl(tDof,eNoN), dl(tDof,eNoN),
                 bfl(nsd,eNoN), fN(3,nFn), lR(dof,eNoN);
   Array3<double> lK(dof*dof,eNoN,eNoN); 
+  auto& ws = com_mod.elem_workspace[0];
 
   // Loop over all elements of mesh
   //
@@ -167,7 +168,7 @@ void construct_shell(ComMod& com_mod, const mshType& lM, const Array<double>& Ag
     //  Constant strain triangles, no numerical integration
     //
     if (lM.eType == ElementType::TRI3) {
-      shell_cst(com_mod, lM, e, eNoN, nFn, fN, al, yl, dl, xl, bfl, ptr);
+      shell_cst(com_mod, lM, e, eNoN, nFn, fN, al, yl, dl, xl, bfl, ptr, ws);
 
     } else {
       lR = 0.0;
@@ -178,7 +179,7 @@ void construct_shell(ComMod& com_mod, const mshType& lM, const Array<double>& Ag
 
       // Gauss integration
       for (int g = 0; g < lM.nG; g++) {
-        shell_3d(com_mod, lM, g, eNoN, nFn, fN, al, yl, dl, xl, bfl, lR, lK);
+        shell_3d(com_mod, lM, g, eNoN, nFn, fN, al, yl, dl, xl, bfl, lR, lK, ws);
       }
     }
 
@@ -196,7 +197,7 @@ void construct_shell(ComMod& com_mod, const mshType& lM, const Array<double>& Ag
 void shell_3d(ComMod& com_mod, const mshType& lM, const int g, const int eNoN, 
     const int nFn, const Array<double>& fN,
     const Array<double>& al, const Array<double>& yl, const Array<double>& dl, const Array<double>& xl,
-    const Array<double>& bfl, Array<double>& lR, Array3<double>& lK)
+    const Array<double>& bfl, Array<double>& lR, Array3<double>& lK, ElementWorkspace& ws)
 {
   std::cout << "========== shell_3d ==========" << std::endl;
   std::cout << "[shell_3d] g: " << g << std::endl;
@@ -216,8 +217,8 @@ void shell_3d(ComMod& com_mod, const mshType& lM, const int g, const int eNoN,
   double rho = eq.dmn[cDmn].prop.at(PhysicalProperyType::solid_density);
   double dmp = dmn.prop.at(PhysicalProperyType::damping);
   double ht = eq.dmn[cDmn].prop.at(PhysicalProperyType::shell_thickness);
-  Vector<double> fb({dmn.prop.at(PhysicalProperyType::f_x), dmn.prop.at(PhysicalProperyType::f_y), 
-      dmn.prop.at(PhysicalProperyType::f_z)});
+  double fb[3] = {dmn.prop.at(PhysicalProperyType::f_x), dmn.prop.at(PhysicalProperyType::f_y), 
+      dmn.prop.at(PhysicalProperyType::f_z)};
   double amd = eq.am * rho  +  eq.af * eq.gam * dt * dmp;
   double afl = eq.af * eq.beta * dt * dt;
 
@@ -225,12 +226,15 @@ void shell_3d(ComMod& com_mod, const mshType& lM, const int g, const int eNoN,
   int j = i + 1;
   int k = j + 1;
 
+  ElementWorkspace::Scope scope(ws);
+
   // Get the reference configuration
-  auto x0 = xl;
+  auto x0 = ws.array(xl.nrows(), xl.ncols());
+  x0 = xl;
 
   // Get the current configuration
   //
-  Array<double> xc(3,eNoN);
+  auto xc = ws.array(3,eNoN);
 
   for (int a = 0; a < eNoN; a++) {
     xc(0,a) = x0(0,a) + dl(i,a);
@@ -240,9 +244,6 @@ void shell_3d(ComMod& com_mod, const mshType& lM, const int g, const int eNoN,
 
   // Define shape functions and their derivatives at Gauss point
   //
-  Vector<double> N; 
-  Array<double> Nx, Nxx;
-
   /* [TODO] Nurbs are not supported.
   if (lM.eType == ElementType::eType_NRB) {
     N = lM.N.rcol(g);
@@ -254,9 +255,9 @@ void shell_3d(ComMod& com_mod, const mshType& lM, const int g, const int eNoN,
     Nxx = lM.fs(0).Nxx.rslice(g);
   }
   */
-  N = lM.fs[0].N.rcol(g);
-  Nx = lM.fs[0].Nx.rslice(g);
-  Nxx = lM.fs[0].Nxx.rslice(g);
+  auto N = lM.fs[0].N.rcol(g);
+  auto Nx = lM.fs[0].Nx.rslice(g);
+  auto Nxx = lM.fs[0].Nxx.rslice(g);
 
 //=====================================================================
 //    TODO: Might have to call GNNxx for Jacobian transformation. Check
@@ -270,15 +271,18 @@ void shell_3d(ComMod& com_mod, const mshType& lM, const int g, const int eNoN,
   // Compute preliminaries on the reference configuration
   // Covariant and contravariant bases (reference config)
   //
-  Array<double> aCov0(3,2), aCnv0(3,2);
-  Vector<double> nV0(3);
+  auto aCov0 = ws.array(3,2);
+  auto aCnv0 = ws.array(3,2);
+  auto nV0 = ws.vector(3);
   nn::gnns(nsd, lM.eNoN, Nx, x0, nV0, aCov0, aCnv0);
   double Jac0 = sqrt(utils::norm(nV0));
-  nV0 = nV0 / Jac0;
+  for (int l = 0; l < 3; l++) {
+    nV0(l) = nV0(l) / Jac0;
+  }
 
   // Second derivatives for computing curvature coeffs. (ref. config)
   //
-  Array3<double> r0_xx(2,2,3);
+  auto r0_xx = ws.array3(2,2,3);
 
   for (int a = 0; a < eNoN; a++) {
     for (int i = 0; i < 3; i++) {
@@ -310,7 +314,7 @@ void shell_3d(ComMod& com_mod, const mshType& lM, const int g, const int eNoN,
 
   // Compute fiber orientation in curvature coordinates
   //
-  Array<double> fNa0(2,nFn);
+  auto fNa0 = ws.array(2,nFn);
 
   for (int iFn = 0; iFn < nFn; iFn++) {
     for (int l = 0; l < 3; l++) { 
@@ -322,14 +326,17 @@ void shell_3d(ComMod& com_mod, const mshType& lM, const int g, const int eNoN,
   // Now compute preliminaries on the current configuration
   // Covariant and contravariant bases (current/spatial config)
   //
-  Array<double> aCov(3,2), aCnv(3,2);
-  Vector<double> nV(3);
+  auto aCov = ws.array(3,2);
+  auto aCnv = ws.array(3,2);
+  auto nV = ws.vector(3);
   nn::gnns(nsd, eNoN, Nx, xc, nV, aCov, aCnv);
   double Jac = sqrt(utils::norm(nV));
-  nV = nV / Jac;
+  for (int l = 0; l < 3; l++) {
+    nV(l) = nV(l) / Jac;
+  }
 
   // Second derivatives for computing curvature coeffs. (cur. config)
-  Array3<double> r_xx(2,2,3);
+  auto r_xx = ws.array3(2,2,3);
 
   for (int a = 0; a < eNoN; a++) {
      r_xx(0,0,i) = r_xx(0,0,i) + Nxx(0,a)*xc(i,a);
@@ -363,15 +370,15 @@ void shell_3d(ComMod& com_mod, const mshType& lM, const int g, const int eNoN,
   // stress and elasticity tensors through the shell thickness. These
   // resultants are computed in Voigt notation.
   //
-  Array3<double> Dm(3,3,3);
-  Array<double> Sm(3,2);
+  auto Dm = ws.array3(3,3,3);
+  auto Sm = ws.array(3,2);
   double lam3;
 
-  shl_strs_res(com_mod, dmn, nFn, fNa0, aa_0, aa_x, bb_0, bb_x, lam3, Sm, Dm);
+  shl_strs_res(com_mod, dmn, nFn, fNa0, aa_0, aa_x, bb_0, bb_x, lam3, Sm, Dm, ws);
 
   // Variation in the membrane strain
   //
-  Array3<double> Bm(3,3,eNoN);
+  auto Bm = ws.array3(3,3,eNoN);
 
   for (int a = 0; a < eNoN; a++) {
     Bm(0,0,a) = Nx(0,a)*aCov(0,0);
@@ -393,7 +400,7 @@ void shell_3d(ComMod& com_mod, const mshType& lM, const int g, const int eNoN,
   //
   //     Second derivatives of the position vector (current)
   //
-  Array<double> Kc(3,3);
+  auto Kc = ws.array(3,3);
 
   for (int i = 0; i < 3; i++) {
     Kc(0,i) = r_xx(0,0,i);
@@ -402,13 +409,22 @@ void shell_3d(ComMod& com_mod, const mshType& lM, const int g, const int eNoN,
   }
 
   // N matrix
-  auto Nm = mat_id(3) - mat_dyad_prod(nV, nV, 3);
-  Nm = Nm / Jac;
+  auto Nm = ws.array(3,3);
+  auto nVnV = ws.array(3,3);
+  mat_id(3, Nm);
+  mat_dyad_prod(nV, nV, 3, nVnV);
+
+  for (int l = 0; l < 3; l++) {
+    for (int m = 0; m < 3; m++) {
+      Nm(l,m) = (Nm(l,m) - nVnV(l,m)) / Jac;
+    }
+  }
 
   // M1, M2 matrices
   //
-  Array<double> Mm(3,3);
-  Array3<double> KNmMm(3,3,2);
+  auto Mm = ws.array(3,3);
+  auto NmMm = ws.array(3,3);
+  auto KNmMm = ws.array3(3,3,2);
 
   for (int l = 0; l < 2; l++) { 
     Mm = 0.0;
@@ -421,12 +437,14 @@ void shell_3d(ComMod& com_mod, const mshType& lM, const int g, const int eNoN,
     Mm(2,0) = -Mm(0,2);
     Mm(2,1) = -Mm(1,2);
 
-    KNmMm.set_slice(l, mat_mul(Kc, mat_mul(Nm, Mm)));
+    mat_mul(Nm, Mm, NmMm);
+    auto KNmMm_l = KNmMm.rslice(l);
+    mat_mul(Kc, NmMm, KNmMm_l);
   }
 
   // Define variation in bending strain tensor (Bb), Voigt notation
   //
-  Array3<double> Bb(3,3,eNoN);
+  auto Bb = ws.array3(3,3,eNoN);
 
   for (int a = 0; a < eNoN; a++) {
     for (int i = 0; i < 3; i++) {
@@ -446,18 +464,29 @@ void shell_3d(ComMod& com_mod, const mshType& lM, const int g, const int eNoN,
 
   //  Contribution to tangent matrices: Dm * Bm, Dm*Bb
   //
-  Array3<double> D0Bm(3,3,eNoN), D1Bm(3,3,eNoN), D1Bb(3,3,eNoN), D2Bb(3,3,eNoN);
+  auto D0Bm = ws.array3(3,3,eNoN);
+  auto D1Bm = ws.array3(3,3,eNoN);
+  auto D1Bb = ws.array3(3,3,eNoN);
+  auto D2Bb = ws.array3(3,3,eNoN);
 
   for (int a = 0; a < eNoN; a++) {
-    D0Bm.set_slice(a, mat_mul(Dm.rslice(0), Bm.rslice(a)));
-    D1Bm.set_slice(a, mat_mul(Dm.rslice(1), Bm.rslice(a)));
-    D1Bb.set_slice(a, mat_mul(Dm.rslice(1), Bb.rslice(a)));
-    D2Bb.set_slice(a, mat_mul(Dm.rslice(2), Bb.rslice(a)));
+    auto D0Bm_a = D0Bm.rslice(a);
+    auto D1Bm_a = D1Bm.rslice(a);
+    auto D1Bb_a = D1Bb.rslice(a);
+    auto D2Bb_a = D2Bb.rslice(a);
+    mat_mul(Dm.rslice(0), Bm.rslice(a), D0Bm_a);
+    mat_mul(Dm.rslice(1), Bm.rslice(a), D1Bm_a);
+    mat_mul(Dm.rslice(1), Bb.rslice(a), D1Bb_a);
+    mat_mul(Dm.rslice(2), Bb.rslice(a), D2Bb_a);
   }
 
   // Acceleration and mass damping at the integration point
   //
-  auto ud = -fb;
+  auto ud = ws.vector(3);
+
+  for (int l = 0; l < 3; l++) {
+    ud(l) = -fb[l];
+  }
 
   for (int a = 0; a < eNoN; a++) {
     ud(0) = ud(0) + N(a)*(rho*(al(i,a)-bfl(0,a)) + dmp*yl(i,a));
@@ -567,7 +596,7 @@ void shell_3d(ComMod& com_mod, const mshType& lM, const int g, const int eNoN,
 //
 void shell_bend_cst(ComMod& com_mod, const mshType& lM, const int e, const Vector<int>& ptr, 
     Array<double>& x0, Array<double>& xc, double bb_0[2][2], double bb_x[2][2], 
-    Array3<double>& Bb, const bool vflag)
+    Array3<double>& Bb, const bool vflag, ElementWorkspace& ws)
 {
   using namespace consts;
   using namespace mat_fun;
@@ -602,9 +631,11 @@ void shell_bend_cst(ComMod& com_mod, const mshType& lM, const int e, const Vecto
     }
   }
 
+  ElementWorkspace::Scope scope(ws);
+
   //  Edge vectors of the main element (reference config)
   //
-  Array<double> a0(3,6); 
+  auto a0 = ws.array(3,6);
 
   for (int i = 0; i < 3; i++) {
     a0(i,0) = x0(i,2) - x0(i,1);
@@ -614,7 +645,7 @@ void shell_bend_cst(ComMod& com_mod, const mshType& lM, const int e, const Vecto
 
   // Edge vectors of the main element (current config)
   //
-  Array<double> a(3,6); 
+  auto a = ws.array(3,6);
 
   for (int i = 0; i < 3; i++) {
     a(i,0) = xc(i,2) - xc(i,1);
@@ -623,7 +654,7 @@ void shell_bend_cst(ComMod& com_mod, const mshType& lM, const int e, const Vecto
   }
 
   // Covariant and contravariant bases in reference config
-  Array<double> tmpA(3,3);
+  auto tmpA = ws.array(3,3);
 
   for (int i = 0; i < 3; i++) {
     for (int j = 0; j < 3; j++) {
@@ -631,11 +662,14 @@ void shell_bend_cst(ComMod& com_mod, const mshType& lM, const int e, const Vecto
     }
   }
 
-  Array<double> aCov0(3,2), aCnv0(3,2);
-  Vector<double> nV0(3);
+  auto aCov0 = ws.array(3,2);
+  auto aCnv0 = ws.array(3,2);
+  auto nV0 = ws.vector(3);
   nn::gnns(nsd, lM.eNoN, lM.Nx.rslice(0), tmpA, nV0, aCov0, aCnv0);
   double Jac0 = sqrt(utils::norm(nV0));
-  nV0 = nV0 / Jac0;
+  for (int i = 0; i < 3; i++) {
+    nV0(i) = nV0(i) / Jac0;
+  }
 
   // Covariant and contravariant bases in current config
   //
@@ -645,16 +679,23 @@ void shell_bend_cst(ComMod& com_mod, const mshType& lM, const int e, const Vecto
     }
   }
 
-  Array<double> aCov(3,2), aCnv(3,2);
-  Vector<double> nV(3);
+  auto aCov = ws.array(3,2);
+  auto aCnv = ws.array(3,2);
+  auto nV = ws.vector(3);
   nn::gnns(nsd, lM.eNoN, lM.Nx.rslice(0), tmpA, nV, aCov, aCnv);
   double Jac = sqrt(norm(nV));
-  nV = nV / Jac;
+  for (int i = 0; i < 3; i++) {
+    nV(i) = nV(i) / Jac;
+  }
 
   // Update the position vector of the `artificial' or `ghost' nodes
   // depending on the boundary condition.
   //
   if (bFlag) {
+    auto eI = ws.vector(3);
+    auto nI = ws.vector(3);
+    auto nInI = ws.array(3,3);
+
     for (int j = lM.eNoN; j < eNoN; j++) {
       if (ptr(j) != -1) {
         continue;
@@ -669,19 +710,20 @@ void shell_bend_cst(ComMod& com_mod, const mshType& lM, const int e, const Vecto
       // Reference config
       // eI = eI0 = aI0/|aI0| (reference config)
       //
-      auto aIi = 1.0 / sqrt(norm(a0.col(i)));
-      auto eI = a0.col(i) * aIi;
+      double aIi = 1.0 / sqrt(norm(a0.rcol(i)));
+      for (int l = 0; l < 3; l++) {
+        eI(l) = a0(l,i) * aIi;
+      }
 
       // nI = nI0 = eI0 x n0 (reference config)
       //
-      Vector<double> nI(3);
       nI(0) = eI(1)*nV0(2) - eI(2)*nV0(1);
       nI(1) = eI(2)*nV0(0) - eI(0)*nV0(2);
       nI(2) = eI(0)*nV0(1) - eI(1)*nV0(0);
 
       // xJ = xI + 2(nI \ctimes nI)aP
       //
-      auto nInI = mat_dyad_prod(nI, nI, 3);
+      mat_dyad_prod(nI, nI, 3, nInI);
       x0(0,j) = 2.0 * (nInI(0,0)*a0(0,p) + nInI(0,1)*a0(1,p) + nInI(0,2)*a0(2,p)) + x0(0,i);
       x0(1,j) = 2.0 * (nInI(1,0)*a0(0,p) + nInI(1,1)*a0(1,p) + nInI(1,2)*a0(2,p)) + x0(1,i);
       x0(2,j) = 2.0 * (nInI(2,0)*a0(0,p) + nInI(2,1)*a0(1,p) + nInI(2,2)*a0(2,p)) + x0(2,i);
@@ -689,8 +731,10 @@ void shell_bend_cst(ComMod& com_mod, const mshType& lM, const int e, const Vecto
       // Current config
       // eI = aI/|aI| (current config)
       //
-      aIi = 1.0 / sqrt(utils::norm(a.col(i)));
-      eI = a.col(i)*aIi;
+      aIi = 1.0 / sqrt(utils::norm(a.rcol(i)));
+      for (int l = 0; l < 3; l++) {
+        eI(l) = a(l,i)*aIi;
+      }
 
       // nI = eI x n (currnt config)
       //
@@ -700,7 +744,7 @@ void shell_bend_cst(ComMod& com_mod, const mshType& lM, const int e, const Vecto
 
       // xJ = xI + 2(nI \ctimes nI)aP
       //
-      nInI = mat_dyad_prod(nI, nI, 3);
+      mat_dyad_prod(nI, nI, 3, nInI);
       xc(0,j) = 2.0*(nInI(0,0)*a(0,p) + nInI(0,1)*a(1,p) + nInI(0,2)*a(2,p)) + xc(0,i);
       xc(1,j) = 2.0*(nInI(1,0)*a(0,p) + nInI(1,1)*a(1,p) + nInI(1,2)*a(2,p)) + xc(1,i);
       xc(2,j) = 2.0*(nInI(2,0)*a(0,p) + nInI(2,1)*a(1,p) + nInI(2,2)*a(2,p)) + xc(2,i);
@@ -731,82 +775,86 @@ void shell_bend_cst(ComMod& com_mod, const mshType& lM, const int e, const Vecto
 
   // a.gCnv (reference config)
   //
-  Array<double> adg0(3,3);
-  adg0(0,0) = norm(a0.col(3), aCnv0.col(0));    // xi_4
-  adg0(0,1) = norm(a0.col(4), aCnv0.col(0));    // xi_5
-  adg0(0,2) = norm(a0.col(5), aCnv0.col(0));    // xi_6
+  auto adg0 = ws.array(3,3);
+  adg0(0,0) = norm(a0.rcol(3), aCnv0.rcol(0));    // xi_4
+  adg0(0,1) = norm(a0.rcol(4), aCnv0.rcol(0));    // xi_5
+  adg0(0,2) = norm(a0.rcol(5), aCnv0.rcol(0));    // xi_6
 
-  adg0(1,0) = norm(a0.col(3), aCnv0.col(1));    // eta_4
-  adg0(1,1) = norm(a0.col(4), aCnv0.col(1));    // eta_5
-  adg0(1,2) = norm(a0.col(5), aCnv0.col(1));    // eta_6
+  adg0(1,0) = norm(a0.rcol(3), aCnv0.rcol(1));    // eta_4
+  adg0(1,1) = norm(a0.rcol(4), aCnv0.rcol(1));    // eta_5
+  adg0(1,2) = norm(a0.rcol(5), aCnv0.rcol(1));    // eta_6
 
-  adg0(2,0) = norm(a0.col(3), nV0);        // z_4
-  adg0(2,1) = norm(a0.col(4), nV0);        // z_5
-  adg0(2,2) = norm(a0.col(5), nV0);        // z_6
+  adg0(2,0) = norm(a0.rcol(3), nV0);        // z_4
+  adg0(2,1) = norm(a0.rcol(4), nV0);        // z_5
+  adg0(2,2) = norm(a0.rcol(5), nV0);        // z_6
 
   // a.gCnv (current config)
   //
-  Array<double> adg(3,3);
-  adg(0,0) = norm(a.col(3), aCnv.col(0));   // xi_4
-  adg(0,1) = norm(a.col(4), aCnv.col(0));   // xi_5
-  adg(0,2) = norm(a.col(5), aCnv.col(0));   // xi_6
+  auto adg = ws.array(3,3);
+  adg(0,0) = norm(a.rcol(3), aCnv.rcol(0));   // xi_4
+  adg(0,1) = norm(a.rcol(4), aCnv.rcol(0));   // xi_5
+  adg(0,2) = norm(a.rcol(5), aCnv.rcol(0));   // xi_6
 
-  adg(1,0) = norm(a.col(3), aCnv.col(1));   // eta_4
-  adg(1,1) = norm(a.col(4), aCnv.col(1));   // eta_5
-  adg(1,2) = norm(a.col(5), aCnv.col(1));   // eta_6
+  adg(1,0) = norm(a.rcol(3), aCnv.rcol(1));   // eta_4
+  adg(1,1) = norm(a.rcol(4), aCnv.rcol(1));   // eta_5
+  adg(1,2) = norm(a.rcol(5), aCnv.rcol(1));   // eta_6
 
-  adg(2,0) = norm(a.col(3), nV);        // z_4
-  adg(2,1) = norm(a.col(4), nV);        // z_5
-  adg(2,2) = norm(a.col(5), nV);        // z_6
+  adg(2,0) = norm(a.rcol(3), nV);        // z_4
+  adg(2,1) = norm(a.rcol(4), nV);        // z_5
+  adg(2,2) = norm(a.rcol(5), nV);        // z_6
 
   // Xi matrix (reference config)
   //
-  auto xi0 = adg0;
+  auto xi0 = ws.array(3,3);
+  xi0 = adg0;
   xi0(0,2) = adg0(0,2) + 1.0;    // xi_6
   xi0(1,0) = adg0(1,0) + 1.0;    // eta_4
 
   //  Xi matrix (current config)
   //
-  auto xi = adg;
+  auto xi = ws.array(3,3);
+  xi = adg;
   xi(0,2) = adg(0,2) + 1.0;     // xi_6
   xi(1,0) = adg(1,0) + 1.0;     // eta_4
 
   // Tmat and inverse (reference config)
   //
-  Array<double> Tm0(3,3);
+  auto Tmat0 = ws.array(3,3);
 
   for (int i = 0; i < 3; i++) {
-    Tm0(i,0) = xi0(0,i)*(xi0(0,i) - 1.0);   // xi**2 - xi
-    Tm0(i,1) = xi0(1,i)*(xi0(1,i) - 1.0);   // eta**2 - eta
-    Tm0(i,2) = xi0(0,i)*xi0(1,i);           // xi * eta
+    Tmat0(i,0) = xi0(0,i)*(xi0(0,i) - 1.0);   // xi**2 - xi
+    Tmat0(i,1) = xi0(1,i)*(xi0(1,i) - 1.0);   // eta**2 - eta
+    Tmat0(i,2) = xi0(0,i)*xi0(1,i);           // xi * eta
   }
 
-  Tm0 = mat_inv(Tm0, 3);
+  auto Tm0 = ws.array(3,3);
+  mat_inv(Tmat0, 3, Tm0);
 
   // Tmat and inverse (current config)
   //
-  Array<double> Tm(3,3);
+  auto Tmat = ws.array(3,3);
 
   for (int i = 0; i < 3; i++) {
-    Tm(i,0) = xi(0,i)*(xi(0,i) - 1.0);   // xi**2 - xi
-    Tm(i,1) = xi(1,i)*(xi(1,i) - 1.0);   // eta**2 - eta
-    Tm(i,2) = xi(0,i)*xi(1,i);           // xi * eta
+    Tmat(i,0) = xi(0,i)*(xi(0,i) - 1.0);   // xi**2 - xi
+    Tmat(i,1) = xi(1,i)*(xi(1,i) - 1.0);   // eta**2 - eta
+    Tmat(i,2) = xi(0,i)*xi(1,i);           // xi * eta
   }
 
-  Tm = mat_inv(Tm, 3);
+  auto Tm = ws.array(3,3);
+  mat_inv(Tmat, 3, Tm);
 
   // v = Inv(T) * z (reference config)
   //
-  Vector<double> v0(3);
+  double v0[3];
 
-  v0(0) = Tm0(0,0)*xi0(2,0) + Tm0(0,1)*xi0(2,1) + Tm0(0,2)*xi0(2,2);
-  v0(1) = Tm0(1,0)*xi0(2,0) + Tm0(1,1)*xi0(2,1) + Tm0(1,2)*xi0(2,2);
-  v0(2) = Tm0(2,0)*xi0(2,0) + Tm0(2,1)*xi0(2,1) + Tm0(2,2)*xi0(2,2);
+  v0[0] = Tm0(0,0)*xi0(2,0) + Tm0(0,1)*xi0(2,1) + Tm0(0,2)*xi0(2,2);
+  v0[1] = Tm0(1,0)*xi0(2,0) + Tm0(1,1)*xi0(2,1) + Tm0(1,2)*xi0(2,2);
+  v0[2] = Tm0(2,0)*xi0(2,0) + Tm0(2,1)*xi0(2,1) + Tm0(2,2)*xi0(2,2);
 
   // Curvature coefficients (ref. config)
-  bb_0[0][0] = 2.0 * v0(0);
-  bb_0[1][1] = 2.0 * v0(1);
-  bb_0[0][1] = v0(2);
+  bb_0[0][0] = 2.0 * v0[0];
+  bb_0[1][1] = 2.0 * v0[1];
+  bb_0[0][1] = v0[2];
   bb_0[1][0] = bb_0[0][1];
 
   // v = Inv(T) * z (current config)
@@ -832,7 +880,7 @@ void shell_bend_cst(ComMod& com_mod, const mshType& lM, const int e, const Vecto
   //
   // B1 bar
   //
-  Array<double> B1b(3,6);
+  auto B1b = ws.array(3,6);
 
   for (int i = 0; i < 3; i++) {
     B1b(i,0) = -Tm(i,0) * ((2.0*xi(0,0)-1.0)*v[0] + xi(1,0)*v[2]);
@@ -847,7 +895,7 @@ void shell_bend_cst(ComMod& com_mod, const mshType& lM, const int e, const Vecto
 
   //  H1
   //
-  Array<double> H1(6,18);
+  auto H1 = ws.array(6,18);
 
   for (int i = 0; i < 3; i++) {
     H1(0, i) = aCnv(i,0)*adg(1,0);
@@ -875,7 +923,7 @@ void shell_bend_cst(ComMod& com_mod, const mshType& lM, const int e, const Vecto
   }
 
   // H2
-  Array<double> H2(18,18);
+  auto H2 = ws.array(18,18);
   H2( 0, 3) = -1.0;
   H2( 1, 4) = -1.0;
   H2( 2, 5) = -1.0;
@@ -911,11 +959,15 @@ void shell_bend_cst(ComMod& com_mod, const mshType& lM, const int e, const Vecto
   }
 
   // N matrix
-  auto Nm = mat_id(3) - mat_dyad_prod(nV, nV, 3);
+  auto Nm = ws.array(3,3);
+  auto nVnV = ws.array(3,3);
+  mat_id(3, Nm);
+  mat_dyad_prod(nV, nV, 3, nVnV);
+  Nm -= nVnV;
 
   // M1, M2 matrices
   //
-  Array3<double> Mm(3,3,2);
+  auto Mm = ws.array3(3,3,2);
 
   for (int i = 0; i < 2; i++) {
     Mm(0,1,i) = -aCov(2,i);
@@ -930,9 +982,14 @@ void shell_bend_cst(ComMod& com_mod, const mshType& lM, const int e, const Vecto
 
   // H3 matrix
   //
-  Array<double> H3(3,18);
-  tmpA = mat_mul(Nm, Mm.rslice(0));
-  tmpA = -tmpA / Jac;
+  auto H3 = ws.array(3,18);
+  mat_mul(Nm, Mm.rslice(0), tmpA);
+
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      tmpA(i,j) = -tmpA(i,j) / Jac;
+    }
+  }
 
   H3(0,0) = a(0,3)*tmpA(0,0) + a(1,3)*tmpA(1,0) + a(2,3)*tmpA(2,0);
   H3(0,1) = a(0,3)*tmpA(0,1) + a(1,3)*tmpA(1,1) + a(2,3)*tmpA(2,1);
@@ -946,8 +1003,13 @@ void shell_bend_cst(ComMod& com_mod, const mshType& lM, const int e, const Vecto
   H3(2,1) = a(0,5)*tmpA(0,1) + a(1,5)*tmpA(1,1) + a(2,5)*tmpA(2,1);
   H3(2,2) = a(0,5)*tmpA(0,2) + a(1,5)*tmpA(1,2) + a(2,5)*tmpA(2,2);
 
-  tmpA = mat_mul(Nm, Mm.rslice(1));
-  tmpA = -tmpA / Jac;
+  mat_mul(Nm, Mm.rslice(1), tmpA);
+
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      tmpA(i,j) = -tmpA(i,j) / Jac;
+    }
+  }
 
   H3(0,3) = a(0,3)*tmpA(0,0) + a(1,3)*tmpA(1,0) + a(2,3)*tmpA(2,0);
   H3(0,4) = a(0,3)*tmpA(0,1) + a(1,3)*tmpA(1,1) + a(2,3)*tmpA(2,1);
@@ -968,17 +1030,30 @@ void shell_bend_cst(ComMod& com_mod, const mshType& lM, const int e, const Vecto
   }
 
   // Variation in bending strain (Bb = -2*(B1b*H1*H2 + Tinv*H3*H2))
-  auto H1H2 = mat_mul(H1, H2);
-  auto Bb1 = mat_mul(B1b, H1H2);
-  auto H3H2 = mat_mul(H3, H2);
-  Bb1 = -2.0 * (Bb1 + mat_mul(Tm, H3H2));
+  auto H1H2 = ws.array(6,18);
+  auto Bb1 = ws.array(3,18);
+  auto H3H2 = ws.array(3,18);
+  auto TmH3H2 = ws.array(3,18);
+  mat_mul(H1, H2, H1H2);
+  mat_mul(B1b, H1H2, Bb1);
+  mat_mul(H3, H2, H3H2);
+  mat_mul(Tm, H3H2, TmH3H2);
+
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 18; j++) {
+      Bb1(i,j) = -2.0 * (Bb1(i,j) + TmH3H2(i,j));
+    }
+  }
+
   Bb.set_values(Bb1);
   //Bb   = RESHAPE(Bb1, SHAPE(Bb))
 
   //  Update Bb for boundary elements
   if (bFlag) {
     std::vector<bool> lFix = {false, false, false};
-    auto Im = mat_id(3);
+    auto Im = ws.array(3,3);
+    auto BbA = ws.array(3,3);
+    mat_id(3, Im);
 
     for (int j = lM.eNoN; j < eNoN; j++) {
       if (ptr(j) != -1) {
@@ -998,37 +1073,44 @@ void shell_bend_cst(ComMod& com_mod, const mshType& lM, const int e, const Vecto
       }
 
       double aIi, cI;
-      Vector<double> eI(3), nI(3);
-      Array<double> nInI(3,3), eIeI(3,3), eIaP(3,3); 
+      auto eI = ws.vector(3);
+      auto nI = ws.vector(3);
+      auto nInI = ws.array(3,3);
+      auto eIeI = ws.array(3,3);
+      auto eIaP = ws.array(3,3);
 
       if (utils::btest(lM.sbc(i,e),enum_int(BoundaryConditionType::bType_fix))) {
         // eI = eI0 = aI0/|aI0| (reference config)
-        aIi = 1.0 / sqrt(norm(a0.col(i)));
-        eI = a0.col(i) * aIi;
+        aIi = 1.0 / sqrt(norm(a0.rcol(i)));
+        for (int l = 0; l < 3; l++) {
+          eI(l) = a0(l,i) * aIi;
+        }
 
         // nI = nI0 = eI0 x n0 (reference config)
         nI(0) = eI(1)*nV0(2) - eI(2)*nV0(1);
         nI(1) = eI(2)*nV0(0) - eI(0)*nV0(2);
         nI(2) = eI(0)*nV0(1) - eI(1)*nV0(0);
-        nInI = mat_dyad_prod(nI, nI, 3);
+        mat_dyad_prod(nI, nI, 3, nInI);
 
       } else { 
         // eI = aI/|aI| (current config)
-        aIi = 1.0 / sqrt(norm(a.col(i)));
-        eI = a.col(i)*aIi;
+        aIi = 1.0 / sqrt(norm(a.rcol(i)));
+        for (int l = 0; l < 3; l++) {
+          eI(l) = a(l,i)*aIi;
+        }
 
         // nI = eI x n (currnt config)
         //
-        Vector<double> nI(3);
+        auto nI = ws.vector(3);
 
         nI(0) = eI(1)*nV(2) - eI(2)*nV(1);
         nI(1) = eI(2)*nV(0) - eI(0)*nV(2);
         nI(2) = eI(0)*nV(1) - eI(1)*nV(0);
 
-        cI = norm(a.col(i),a.col(p))*aIi*aIi;
-        nInI = mat_dyad_prod(nI, nI, 3);
-        eIeI = mat_dyad_prod(eI, eI, 3);
-        eIaP = mat_dyad_prod(eI, a.col(p), 3);
+        cI = norm(a.rcol(i),a.rcol(p))*aIi*aIi;
+        mat_dyad_prod(nI, nI, 3, nInI);
+        mat_dyad_prod(eI, eI, 3, eIeI);
+        mat_dyad_prod(eI, a.rcol(p), 3, eIaP);
       }
 
       // Update Bb now
@@ -1041,22 +1123,37 @@ void shell_bend_cst(ComMod& com_mod, const mshType& lM, const int e, const Vecto
         // E_I
         //
         if (!lFix[i]) {
-          tmpA = -Im + 2.0 * eIeI;
-          Bb.rslice(i) = Bb.rslice(i) + mat_mul(Bb.rslice(j), tmpA);
+          for (int l = 0; l < 3; l++) {
+            for (int m = 0; m < 3; m++) {
+              tmpA(l,m) = -Im(l,m) + 2.0 * eIeI(l,m);
+            }
+          }
+          mat_mul(Bb.rslice(j), tmpA, BbA);
+          Bb.rslice(i) += BbA;
         }
 
         // E_P
         //
         if (!lFix[p]) {
-          tmpA = -2.0 *(cI*Im - 2.0 *cI*eIeI + aIi*eIaP);
-          Bb.rslice(p) = Bb.rslice(p) + mat_mul(Bb.rslice(j), tmpA);
+          for (int l = 0; l < 3; l++) {
+            for (int m = 0; m < 3; m++) {
+              tmpA(l,m) = -2.0 *(cI*Im(l,m) - 2.0 *cI*eIeI(l,m) + aIi*eIaP(l,m));
+            }
+          }
+          mat_mul(Bb.rslice(j), tmpA, BbA);
+          Bb.rslice(p) += BbA;
         }
 
         // E_F
         //
         if (!lFix[f]) {
-          tmpA = 2.0 * ((1.0-cI)*Im - (1.0-2.0*cI)*eIeI -aIi*eIaP);
-          Bb.rslice(f) = Bb.rslice(f) + mat_mul(Bb.rslice(j), tmpA);
+          for (int l = 0; l < 3; l++) {
+            for (int m = 0; m < 3; m++) {
+              tmpA(l,m) = 2.0 * ((1.0-cI)*Im(l,m) - (1.0-2.0*cI)*eIeI(l,m) -aIi*eIaP(l,m));
+            }
+          }
+          mat_mul(Bb.rslice(j), tmpA, BbA);
+          Bb.rslice(f) += BbA;
         }
 
         Bb.rslice(j) = 0.0;
@@ -1068,8 +1165,13 @@ void shell_bend_cst(ComMod& com_mod, const mshType& lM, const int e, const Vecto
 
         // E_I
         if (!lFix[i]) {
-          tmpA = -Im + 2.0*eIeI;
-          Bb.rslice(i) = Bb.rslice(i) + mat_mul(Bb.rslice(j), tmpA);
+          for (int l = 0; l < 3; l++) {
+            for (int m = 0; m < 3; m++) {
+              tmpA(l,m) = -Im(l,m) + 2.0*eIeI(l,m);
+            }
+          }
+          mat_mul(Bb.rslice(j), tmpA, BbA);
+          Bb.rslice(i) += BbA;
         }
 
 	lFix[p] = true; 
@@ -1084,8 +1186,13 @@ void shell_bend_cst(ComMod& com_mod, const mshType& lM, const int e, const Vecto
       } else if (utils::btest(lM.sbc(i,e),enum_int(BoundaryConditionType::bType_fix))) {
 
         if (!lFix[i]) {
-          tmpA = Im - 2.0*nInI;
-          Bb.rslice(i) = Bb.rslice(i) + mat_mul(Bb.rslice(j), tmpA);
+          for (int l = 0; l < 3; l++) {
+            for (int m = 0; m < 3; m++) {
+              tmpA(l,m) = Im(l,m) - 2.0*nInI(l,m);
+            }
+          }
+          mat_mul(Bb.rslice(j), tmpA, BbA);
+          Bb.rslice(i) += BbA;
         }
 
         lFix[p] = true;
@@ -1097,8 +1204,13 @@ void shell_bend_cst(ComMod& com_mod, const mshType& lM, const int e, const Vecto
       //
       } else if (utils::btest(lM.sbc(i,e),enum_int(BoundaryConditionType::bType_symm))) {
         if (!lFix[i]) {
-          tmpA = Im - 2.0*nInI;
-          Bb.rslice(i) = Bb.rslice(i) + mat_mul(Bb.rslice(j), tmpA);
+          for (int l = 0; l < 3; l++) {
+            for (int m = 0; m < 3; m++) {
+              tmpA(l,m) = Im(l,m) - 2.0*nInI(l,m);
+            }
+          }
+          mat_mul(Bb.rslice(j), tmpA, BbA);
+          Bb.rslice(i) += BbA;
         }
 
         tmpA.rcol(0) = eI;
@@ -1106,8 +1218,10 @@ void shell_bend_cst(ComMod& com_mod, const mshType& lM, const int e, const Vecto
         tmpA.rcol(2) = nI;
 
         Bb.rslice(j) = 0.0;
-        Bb.rslice(f) = mat_mul(Bb.rslice(f), tmpA);
-        Bb.rslice(p) = mat_mul(Bb.rslice(p), tmpA);
+        mat_mul(Bb.rslice(f), tmpA, BbA);
+        Bb.rslice(f) = BbA;
+        mat_mul(Bb.rslice(p), tmpA, BbA);
+        Bb.rslice(p) = BbA;
 
         for (int i = 0; i < 3; i++) {
           Bb(i,2,f) = 0.0;
@@ -1128,7 +1242,8 @@ void shell_bend_cst(ComMod& com_mod, const mshType& lM, const int e, const Vecto
 // Reproduces Fortran SHELLBF.
 //
 void shell_bf(ComMod& com_mod, const int eNoN, const double w, const Vector<double>& N, const Array<double>& Nx, 
-    const Array<double>& dl, const Array<double>& xl, const Array<double>& tfl, Array<double>& lR, Array3<double>& lK)
+    const Array<double>& dl, const Array<double>& xl, const Array<double>& tfl, Array<double>& lR, Array3<double>& lK,
+    ElementWorkspace& ws)
 {
   using namespace consts;
 
@@ -1148,8 +1263,9 @@ void shell_bf(ComMod& com_mod, const int eNoN, const double w, const Vector<doub
 
   // Get the current configuration and traction vector
   //
+  ElementWorkspace::Scope scope(ws);
   double tfn = 0.0;
-  Array<double> xc(3,eNoN);
+  auto xc = ws.array(3,eNoN);
   // [NOTE] This is a hack for enabling 'tfl' to be used as a vector in the Fortran.
   auto tfl_data = tfl.data();
 
@@ -1164,8 +1280,9 @@ void shell_bf(ComMod& com_mod, const int eNoN, const double w, const Vector<doub
   double wl = w * tfn;
 
   // Covariant and contravariant bases in current config
-  Array<double> gCov(3,2), gCnv(3,2);
-  Vector<double> nV(3);
+  auto gCov = ws.array(3,2);
+  auto gCnv = ws.array(3,2);
+  auto nV = ws.vector(3);
   nn::gnns(nsd, eNoN, Nx, xc, nV, gCov, gCnv);
 
   //  Local residual
@@ -1182,17 +1299,22 @@ void shell_bf(ComMod& com_mod, const int eNoN, const double w, const Vector<doub
 
   for (int b = 0; b < eNoN; b++) {
     for (int a = 0; a < eNoN; a++) {
-      auto lKp = gCov.rcol(0)*(N(b)*Nx(1,a) - N(a)*Nx(1,b)) - 
-          gCov.rcol(1)*(N(b)*Nx(0,a) - N(a)*Nx(0,b));
+      double s0 = N(b)*Nx(1,a) - N(a)*Nx(1,b);
+      double s1 = N(b)*Nx(0,a) - N(a)*Nx(0,b);
+      double lKp[3];
 
-      lK(1,a,b) = lK(1,a,b) - T1*lKp(2);
-      lK(2,a,b) = lK(2,a,b) + T1*lKp(1);
+      for (int l = 0; l < 3; l++) {
+        lKp[l] = gCov(l,0)*s0 - gCov(l,1)*s1;
+      }
+
+      lK(1,a,b) = lK(1,a,b) - T1*lKp[2];
+      lK(2,a,b) = lK(2,a,b) + T1*lKp[1];
 
-      lK(dof+0,a,b) = lK(dof+0,a,b) + T1*lKp(2);
-      lK(dof+2,a,b) = lK(dof+2,a,b) - T1*lKp(0);
+      lK(dof+0,a,b) = lK(dof+0,a,b) + T1*lKp[2];
+      lK(dof+2,a,b) = lK(dof+2,a,b) - T1*lKp[0];
 
-      lK(2*dof+0,a,b) = lK(2*dof+0,a,b) - T1*lKp(1);
-      lK(2*dof+1,a,b) = lK(2*dof+1,a,b) + T1*lKp(0);
+      lK(2*dof+0,a,b) = lK(2*dof+0,a,b) - T1*lKp[1];
+      lK(2*dof+1,a,b) = lK(2*dof+1,a,b) + T1*lKp[0];
     }
   }
 }
@@ -1208,7 +1330,7 @@ void shell_bf(ComMod& com_mod, const int eNoN, const double w, const Vector<doub
 //
 void shell_cst(ComMod& com_mod, const mshType& lM, const int e, const int eNoN, const int nFn, const Array<double>& fN,  
     const Array<double>& al, const Array<double>& yl, const Array<double>& dl, const Array<double>& xl, 
-    const Array<double>& bfl, const Vector<int>& ptr)
+    const Array<double>& bfl, const Vector<int>& ptr, ElementWorkspace& ws)
 {
   using namespace consts;
 
@@ -1234,9 +1356,9 @@ void shell_cst(ComMod& com_mod, const mshType& lM, const int e, const int eNoN,
   double rho = eq.dmn[cDmn].prop.at(PhysicalProperyType::solid_density);
   double dmp = dmn.prop.at(PhysicalProperyType::damping);
   double ht = eq.dmn[cDmn].prop.at(PhysicalProperyType::shell_thickness);
-  Vector<double> fb({dmn.prop.at(PhysicalProperyType::f_x), 
-                     dmn.prop.at(PhysicalProperyType::f_y), 
-                     dmn.prop.at(PhysicalProperyType::f_z)});
+  double fb[3] = {dmn.prop.at(PhysicalProperyType::f_x), 
+                  dmn.prop.at(PhysicalProperyType::f_y), 
+                  dmn.prop.at(PhysicalProperyType::f_z)};
   double amd = eq.am * rho  +  eq.af * eq.gam * dt * dmp;
   double afl = eq.af * eq.beta * dt * dt;
 
@@ -1253,12 +1375,15 @@ void shell_cst(ComMod& com_mod, const mshType& lM, const int e, const int eNoN,
   dmsg << "k: " << k;
   #endif
 
+  ElementWorkspace::Scope scope(ws);
+
   //  Get the reference configuration
-  auto x0 = xl;
+  auto x0 = ws.array(xl.nrows(), xl.ncols());
+  x0 = xl;
 
   // Get the current configuration
   //
-  Array<double> xc(3,eNoN);
+  auto xc = ws.array(3,eNoN);
 
   for (int a = 0; a < eNoN; a++) {
     xc(0,a) = x0(0,a) + dl(i,a);
@@ -1266,11 +1391,11 @@ void shell_cst(ComMod& com_mod, const mshType& lM, const int e, const int eNoN,
     xc(2,a) = x0(2,a) + dl(k,a);
   }
 
-  auto Nx = lM.Nx.slice(0);
+  auto Nx = lM.Nx.rslice(0);
 
   // Covariant and contravariant bases in reference config
   //
-  Array<double> tmpX(nsd,lM.eNoN);
+  auto tmpX = ws.array(nsd,lM.eNoN);
 
   for (int i = 0; i < nsd; i++) {
     for (int j = 0; j < lM.eNoN; j++) {
@@ -1278,14 +1403,17 @@ void shell_cst(ComMod& com_mod, const mshType& lM, const int e, const int eNoN,
     }
   }
  
-  Array<double> aCov0(3,2), aCnv0(3,2);
-  Vector<double> nV0(3);
+  auto aCov0 = ws.array(3,2);
+  auto aCnv0 = ws.array(3,2);
+  auto nV0 = ws.vector(3);
 
   nn::gnns(nsd, lM.eNoN, Nx, tmpX, nV0, aCov0, aCnv0);
   //CALL GNNS(lM%eNoN, Nx, tmpX, nV0, aCov0, aCnv0)
 
   double Jac0 = sqrt(utils::norm(nV0));
-  nV0 = nV0 / Jac0;
+  for (int i = 0; i < 3; i++) {
+    nV0(i) = nV0(i) / Jac0;
+  }
 
   // Covariant and contravariant bases in current config
 
@@ -1295,13 +1423,16 @@ void shell_cst(ComMod& com_mod, const mshType& lM, const int e, const int eNoN,
     }
   }
 
-  Array<double> aCov(3,2), aCnv(3,2);
-  Vector<double> nV(3);
+  auto aCov = ws.array(3,2);
+  auto aCnv = ws.array(3,2);
+  auto nV = ws.vector(3);
 
   nn::gnns(nsd, lM.eNoN, Nx, tmpX, nV, aCov, aCnv);
 
   double Jac = sqrt(utils::norm(nV));
-  nV = nV / Jac;
+  for (int i = 0; i < 3; i++) {
+    nV(i) = nV(i) / Jac;
+  }
 
   // Compute metric tensor in reference and current config
   //
@@ -1322,7 +1453,7 @@ void shell_cst(ComMod& com_mod, const mshType& lM, const int e, const int eNoN,
 
   // Compute fiber orientation in curvature coordinates
   //
-  Array<double> fNa0(2,nFn);
+  auto fNa0 = ws.array(2,nFn);
   //dmsg << "nFn: " << nFn;
   //dmsg << "fN: " << fN;
   //dmsg << "aCnv0: " << aCnv0;
@@ -1337,7 +1468,7 @@ void shell_cst(ComMod& com_mod, const mshType& lM, const int e, const int eNoN,
 
   // Define variation in membrane strain only for the main element
   //
-  Array3<double> Bm(3,3,lM.eNoN);
+  auto Bm = ws.array3(3,3,lM.eNoN);
 
   for (int a = 0; a < lM.eNoN; a++) {
      Bm(0,0,a) = Nx(0,a)*aCov(0,0);
@@ -1394,8 +1525,8 @@ void shell_cst(ComMod& com_mod, const mshType& lM, const int e, const int eNoN,
   // variation for CST elements
   //
   double bb_0[2][2], bb_x[2][2];
-  Array3<double> Bb(3,3,eNoN);
-  shell_bend_cst(com_mod, lM, e, ptr, x0, xc, bb_0, bb_x, Bb, true);
+  auto Bb = ws.array3(3,3,eNoN);
+  shell_bend_cst(com_mod, lM, e, ptr, x0, xc, bb_0, bb_x, Bb, true, ws);
   //CALL SHELLBENDCST(lM, e, ptr, x0, xc, bb_0, bb_x, Bb, .TRUE.)
   //dmsg << "Bb: " << Bb;
 
@@ -1413,10 +1544,10 @@ void shell_cst(ComMod& com_mod, const mshType& lM, const int e, const int eNoN,
   dmsg << "    : " << aa_x[1][0];
   dmsg << "    : " << aa_x[1][1];
   */
-  Array3<double> Dm(3,3,3); 
-  Array<double> Sm(3,2);
+  auto Dm = ws.array3(3,3,3);
+  auto Sm = ws.array(3,2);
   double lam3;
-  shl_strs_res(com_mod, dmn, nFn, fNa0, aa_0, aa_x, bb_0, bb_x, lam3, Sm, Dm);
+  shl_strs_res(com_mod, dmn, nFn, fNa0, aa_0, aa_x, bb_0, bb_x, lam3, Sm, Dm, ws);
 
   /*
   dmsg << " " << " ";
@@ -1431,25 +1562,32 @@ void shell_cst(ComMod& com_mod, const mshType& lM, const int e, const int eNoN,
 
   // Contribution to tangent matrices: Dm * Bm, Dm*Bb
   //
-  Array3<double> D0Bm(3,3,lM.eNoN), D1Bm(3,3,lM.eNoN);
+  auto D0Bm = ws.array3(3,3,lM.eNoN);
+  auto D1Bm = ws.array3(3,3,lM.eNoN);
 
   for (int a = 0; a < lM.eNoN; a++) {
-    D0Bm.rslice(a) = mat_fun::mat_mul(Dm.rslice(0), Bm.rslice(a));
-    D1Bm.rslice(a) = mat_fun::mat_mul(Dm.rslice(1), Bm.rslice(a));
+    auto D0Bm_a = D0Bm.rslice(a);
+    auto D1Bm_a = D1Bm.rslice(a);
+    mat_fun::mat_mul(Dm.rslice(0), Bm.rslice(a), D0Bm_a);
+    mat_fun::mat_mul(Dm.rslice(1), Bm.rslice(a), D1Bm_a);
   }
 
-  Array3<double> D1Bb(3,3,eNoN), D2Bb(3,3,eNoN);
+  auto D1Bb = ws.array3(3,3,eNoN);
+  auto D2Bb = ws.array3(3,3,eNoN);
 
   for (int a = 0; a < eNoN; a++) {
-    D1Bb.rslice(a) = mat_fun::mat_mul(Dm.rslice(1), Bb.rslice(a));
-    D2Bb.rslice(a) = mat_fun::mat_mul(Dm.rslice(2), Bb.rslice(a));
+    auto D1Bb_a = D1Bb.rslice(a);
+    auto D2Bb_a = D2Bb.rslice(a);
+    mat_fun::mat_mul(Dm.rslice(1), Bb.rslice(a), D1Bb_a);
+    mat_fun::mat_mul(Dm.rslice(2), Bb.rslice(a), D2Bb_a);
   }
 
   // Contribution to residual and stiffness matrices due to inertia and
   // body forces
   //
-  Array<double> lR(dof,eNoN);
-  Array3<double> lK(dof*dof,eNoN,eNoN);
+  auto lR = ws.array(dof,eNoN);
+  auto lK = ws.array3(dof*dof,eNoN,eNoN);
+  auto ud = ws.vector(3);
 
   for (int g = 0; g < lM.nG; g++) {
     auto N = lM.N.rcol(g);
@@ -1457,7 +1595,9 @@ void shell_cst(ComMod& com_mod, const mshType& lM, const int e, const int eNoN,
 
     // Acceleration and mass damping at the integration point
     //
-    auto ud = -fb;
+    for (int l = 0; l < 3; l++) {
+      ud(l) = -fb[l];
+    }
 
     for (int a = 0; a < lM.eNoN; a++) {
       ud(0) = ud(0) + N(a)*(rho*(al(i,a)-bfl(0,a)) + dmp*yl(i,a));
@@ -1662,7 +1802,8 @@ void shell_cst(ComMod& com_mod, const mshType& lM, const int e, const int eNoN,
 //----------
 //
 void shell_fp(ComMod& com_mod, const int eNoN, const double w, const Vector<double>& N, const Array<double>& Nx, 
-    const Array<double>& dl, const Array<double>& xl, const Array<double>& tfl, Array<double>& lR, Array3<double>& lK)
+    const Array<double>& dl, const Array<double>& xl, const Array<double>& tfl, Array<double>& lR, Array3<double>& lK,
+    ElementWorkspace& ws)
 {
   int nsd = com_mod.nsd;
   int dof = com_mod.dof;
@@ -1677,7 +1818,8 @@ void shell_fp(ComMod& com_mod, const int eNoN, const double w, const Vector<doub
 
   // Get the current configuration and traction vector
   //
-  Array<double> xc(3,eNoN);
+  ElementWorkspace::Scope scope(ws);
+  auto xc = ws.array(3,eNoN);
   double tfn = 0.0;
   // [NOTE] This is a hack enabling 'tfl' to be used
   // like a vector in the Fortan.
@@ -1693,9 +1835,9 @@ void shell_fp(ComMod& com_mod, const int eNoN, const double w, const Vector<doub
   double wl = w * tfn;
 
   // Covariant and contravariant bases in current config
-  Vector<double> nV(3); 
-  Array<double> gCov(3,2);
-  Array<double> gCnv(3,2);
+  auto nV = ws.vector(3);
+  auto gCov = ws.array(3,2);
+  auto gCnv = ws.array(3,2);
   nn::gnns(nsd, eNoN, Nx, xc, nV, gCov, gCnv);
 
   // Local residual
@@ -1712,16 +1854,22 @@ void shell_fp(ComMod& com_mod, const int eNoN, const double w, const Vector<doub
 
   for (int b = 0; b < eNoN; b++) {
     for (int a = 0; a < eNoN; a++) {
-      auto lKp = gCov.col(0) * (N(b)*Nx(1,a) - N(a)*Nx(1,b)) - gCov.col(1)*(N(b)*Nx(0,a) - N(a)*Nx(0,b));
+      double s0 = N(b)*Nx(1,a) - N(a)*Nx(1,b);
+      double s1 = N(b)*Nx(0,a) - N(a)*Nx(0,b);
+      double lKp[3];
+
+      for (int l = 0; l < 3; l++) {
+        lKp[l] = gCov(l,0)*s0 - gCov(l,1)*s1;
+      }
 
-      lK(1,a,b) = lK(1,a,b) - T1*lKp(2);
-      lK(2,a,b) = lK(2,a,b) + T1*lKp(1);
+      lK(1,a,b) = lK(1,a,b) - T1*lKp[2];
+      lK(2,a,b) = lK(2,a,b) + T1*lKp[1];
 
-      lK(dof+0,a,b) = lK(dof+0,a,b) + T1*lKp(2);
-      lK(dof+2,a,b) = lK(dof+2,a,b) - T1*lKp(0);
+      lK(dof+0,a,b) = lK(dof+0,a,b) + T1*lKp[2];
+      lK(dof+2,a,b) = lK(dof+2,a,b) - T1*lKp[0];
 
-      lK(2*dof,a,b) = lK(2*dof,a,b) - T1*lKp(1);
-      lK(2*dof+1,a,b) = lK(2*dof+1,a,b) + T1*lKp(0);
+      lK(2*dof,a,b) = lK(2*dof,a,b) - T1*lKp[1];
+      lK(2*dof+1,a,b) = lK(2*dof+1,a,b) + T1*lKp[0];
     }
   }
 }
@@ -1735,7 +1883,7 @@ void shell_fp(ComMod& com_mod, const int eNoN, const double w, const Vector<doub
 //
 void shl_strs_res(const ComMod& com_mod, const dmnType& lDmn, const int nFn, const Array<double>& fNa0, 
     const double aa_0[2][2], const double aa_x[2][2], const double bb_0[2][2], const double bb_x[2][2], 
-    double& lam3, Array<double>& Sm, Array3<double>& Dm)
+    double& lam3, Array<double>& Sm, Array3<double>& Dm, ElementWorkspace& ws)
 {
   using namespace consts;
 
@@ -1764,15 +1912,17 @@ void shl_strs_res(const ComMod& com_mod, const dmnType& lDmn, const int nFn, con
   Sm = 0.0;
   Dm = 0.0;
 
-  Vector<double> Sml(3);
-  Array<double> Dml(3,3);
+  ElementWorkspace::Scope scope(ws);
+  auto Sml = ws.vector(3);
+  auto Dml = ws.array(3,3);
 
   // Averaged SQRT(g33) over the thickness
   lam3 = 0.0;
 
   // Gauss integration through shell thickness
   //
-  Array<double> gg_0(2,2), gg_x(2,2);
+  auto gg_0 = ws.array(2,2);
+  auto gg_x = ws.array(2,2);
 
   for (int g = 0; g < 3; g++) { 
     //dmsg << "---------- g: " << g+1;
@@ -42,25 +42,27 @@ void construct_shell(ComMod& com_mod, const mshType& lM, const Array<double>& Ag
 void shell_3d(ComMod& com_mod, const mshType& lM, const int g, const int eNoN,
     const int nFn, const Array<double>& fN, const Array<double>& al, const Array<double>& yl, 
     const Array<double>& dl, const Array<double>& xl, const Array<double>& bfl, 
-    Array<double>& lR, Array3<double>& lK);
+    Array<double>& lR, Array3<double>& lK, ElementWorkspace& ws);
 
 void shell_bend_cst(ComMod& com_mod, const mshType& lM, const int e, const Vector<int>& ptr,
     Array<double>& x0, Array<double>& xc, double bb_0[2][2], double bb_x[2][2],
-    Array3<double>& Bb, const bool vflag);
+    Array3<double>& Bb, const bool vflag, ElementWorkspace& ws);
 
 void shell_bf(ComMod& com_mod, const int eNoN, const double w, const Vector<double>& N, const Array<double>& Nx,
-    const Array<double>& dl, const Array<double>& xl, const Array<double>& tfl, Array<double>& lR, Array3<double>& lK);
+    const Array<double>& dl, const Array<double>& xl, const Array<double>& tfl, Array<double>& lR, Array3<double>& lK,
+    ElementWorkspace& ws);
 
 void shell_cst(ComMod& com_mod, const mshType& lM, const int e, const int eNoN, const int nFn, const Array<double>& fN,
     const Array<double>& al, const Array<double>& yl, const Array<double>& dl, const Array<double>& xl,
-    const Array<double>& bfl, const Vector<int>& ptr);
+    const Array<double>& bfl, const Vector<int>& ptr, ElementWorkspace& ws);
 
 void shell_fp(ComMod& com_mod, const int eNoN, const double w, const Vector<double>& N, const Array<double>& Nx, 
-    const Array<double>& dl, const Array<double>& xl, const Array<double>& tfl, Array<double>& lR, Array3<double>& lK);
+    const Array<double>& dl, const Array<double>& xl, const Array<double>& tfl, Array<double>& lR, Array3<double>& lK,
+    ElementWorkspace& ws);
 
 void shl_strs_res(const ComMod& com_mod, const dmnType& lDmn, const int nFn, const Array<double>& fNa0,
     const double aa_0[2][2], const double aa_x[2][2], const double bb_0[2][2], const double bb_x[2][2],
-    double& lam3, Array<double>& Sm, Array3<double>& Dm);
+    double& lam3, Array<double>& Sm, Array3<double>& Dm, ElementWorkspace& ws);
 
 };
 
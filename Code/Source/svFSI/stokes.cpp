@@ -32,6 +32,7 @@
 
 #include "all_fun.h"
 #include "consts.h"
+#include "eq_assem.h"
 #include "fs.h"
 #include "lhsa.h"
 #include "nn.h"
@@ -72,7 +73,6 @@ void construct_stokes(ComMod& com_mod, const mshType& lM, const Array<double>& A
   const int dof = com_mod.dof;
   const int cEq = com_mod.cEq;
   const auto& eq = com_mod.eq[cEq];
-  auto& cDmn = com_mod.cDmn;
 
   #ifdef debug_construct_stokes
   dmsg << "cEq: " << cEq;
@@ -88,26 +88,22 @@ void construct_stokes(ComMod& com_mod, const mshType& lM, const Array<double>& A
   dmsg << "nsd: " <<  nsd;
   #endif
 
-  // FLUID: dof = nsd+1
-  Vector<int> ptr(eNoN); 
-  Array<double> xl(nsd,eNoN); 
-  Array<double> al(tDof,eNoN); 
-  Array<double> yl(tDof,eNoN); 
-  Array<double> bfl(nsd,eNoN); 
-  Array<double> lR(dof,eNoN); 
-  Array3<double> lK(dof*dof,eNoN,eNoN);
+  // Velocity and pressure function spaces, built once at initialization
+  //
+  const auto& fs_1 = fs::thood_fs(lM, lStab, 1);
+  const auto& fs_2 = fs::thood_fs(lM, lStab, 2);
 
-  // Loop over all elements of mesh
+  // Loop over the elements whose domain phys matches the eqn phys
   //
-  int num_c = lM.nEl / 10;
-
-  for (int e = 0; e < lM.nEl; e++) {
-    //Update domain and proceed if domain phys and eqn phys match
-    cDmn = all_fun::domain(com_mod, lM, cEq, e);
-    auto cPhys = eq.dmn[cDmn].phys;
-    if (cPhys != EquationType::phys_stokes) {
-      continue;
-    }
+  eq_assem::loop_elements(com_mod, lM, EquationType::phys_stokes, [&](const int e, ElementWorkspace& ws) {
+    // FLUID: dof = nsd+1
+    auto ptr = ws.ivector(eNoN); 
+    auto xl = ws.array(nsd,eNoN); 
+    auto al = ws.array(tDof,eNoN); 
+    auto yl = ws.array(tDof,eNoN); 
+    auto bfl = ws.array(nsd,eNoN); 
+    auto lR = ws.array(dof,eNoN); 
+    auto lK = ws.array3(dof*dof,eNoN,eNoN);
     bool pr_active = false;
 
     //  Update shape functions for NURBS
@@ -133,22 +129,18 @@ void construct_stokes(ComMod& com_mod, const mshType& lM, const Array<double>& A
     // Initialize residual and tangents
     lR = 0.0;
     lK = 0.0;
-    std::array<fsType,2> fs;
-
-    // Set function spaces for velocity and pressure.
-    fs::get_thood_fs(com_mod, fs, lM, lStab, 1);
 
     // Define element coordinates appropriate for function spaces
-    Array<double> xwl(nsd,fs[0].eNoN); 
-    Array<double> Nwx(nsd,fs[0].eNoN); 
+    auto xwl = ws.array(nsd,fs_1[0].eNoN); 
+    auto Nwx = ws.array(nsd,fs_1[0].eNoN); 
 
-    Array<double> xql(nsd,fs[1].eNoN); 
-    Array<double> Nqx(nsd,fs[1].eNoN);
+    auto xql = ws.array(nsd,fs_1[1].eNoN); 
+    auto Nqx = ws.array(nsd,fs_1[1].eNoN);
 
     xwl = xl;
 
     for (int i = 0; i < nsd; i++) { 
-      for (int j = 0; j < fs[1].eNoN; j++) { 
+      for (int j = 0; j < fs_1[1].eNoN; j++) { 
         xql(i,j) = xl(i,j);
       }
     }
@@ -156,79 +148,81 @@ void construct_stokes(ComMod& com_mod, const mshType& lM, const Array<double>& A
     // Gauss integration 1
     //
     double Jac{0.0};
-    Array<double> ksix(nsd,nsd);
+    auto ksix = ws.array(nsd,nsd);
 
-    for (int g = 0; g < fs[0].nG; g++) {
-      if (g == 0 || !fs[0].lShpF) {
-        auto Nx = fs[0].Nx.slice(g);
-        nn::gnn(fs[0].eNoN, nsd, nsd, Nx, xwl, Nwx, Jac, ksix);
+    for (int g = 0; g < fs_1[0].nG; g++) {
+      if (g == 0 || !fs_1[0].lShpF) {
+        if (!nn::get_geo_cache(lM, e, Nwx, Jac, ksix)) {
+          auto Nx = fs_1[0].Nx.rslice(g);
+          nn::gnn(fs_1[0].eNoN, nsd, nsd, Nx, xwl, Nwx, Jac, ksix);
+        }
         if (utils::is_zero(Jac)) {
            throw std::runtime_error("[construct_stokes] Jacobian for element " + std::to_string(e) + " is < 0.");
         }
       }
 
-      double w = fs[0].w(g) * Jac;
+      double w = fs_1[0].w(g) * Jac;
 
       // Compute momentum residual and tangent matrix.
       //
       if (nsd == 3) {
-        auto N0 = fs[0].N.col(g); 
-        auto N1 = fs[1].N.col(g); 
-        stokes_3d_m(com_mod, fs[0].eNoN, fs[1].eNoN, w, N0, N1, Nwx, al, yl, bfl, lR, lK);
+        auto N0 = fs_1[0].N.rcol(g); 
+        auto N1 = fs_1[1].N.rcol(g); 
+        stokes_3d_m(com_mod, fs_1[0].eNoN, fs_1[1].eNoN, w, N0, N1, Nwx, al, yl, bfl, lR, lK);
 
       } else if (nsd == 2) {
-        auto N0 = fs[0].N.col(g); 
-        auto N1 = fs[1].N.col(g); 
-        stokes_2d_m(com_mod, fs[0].eNoN, fs[1].eNoN, w, N0, N1, Nwx, al, yl, bfl, lR, lK);
+        auto N0 = fs_1[0].N.rcol(g); 
+        auto N1 = fs_1[1].N.rcol(g); 
+        stokes_2d_m(com_mod, fs_1[0].eNoN, fs_1[1].eNoN, w, N0, N1, Nwx, al, yl, bfl, lR, lK);
       }
 
     } // g: loop
 
-    // Set function spaces for velocity and pressure.
-    //
-    fs::get_thood_fs(com_mod, fs, lM, lStab, 2);
-
     // Gauss integration 2
     //
-    for (int g = 0; g < fs[1].nG; g++) {
-      if (g == 0 || !fs[0].lShpF) {
-        auto Nx = fs[0].Nx.slice(g);
-        nn::gnn(fs[0].eNoN, nsd, nsd, Nx, xwl, Nwx, Jac, ksix);
+    for (int g = 0; g < fs_2[1].nG; g++) {
+      if (g == 0 || !fs_2[0].lShpF) {
+        if (!nn::get_geo_cache(lM, e, Nwx, Jac, ksix)) {
+          auto Nx = fs_2[0].Nx.rslice(g);
+          nn::gnn(fs_2[0].eNoN, nsd, nsd, Nx, xwl, Nwx, Jac, ksix);
+        }
 
         if (utils::is_zero(Jac)) {
            throw std::runtime_error("[construct_stokes] Jacobian for element " + std::to_string(e) + " is < 0.");
         }
       }
 
-      if (g == 0 || !fs[1].lShpF) {
-        auto Nx = fs[1].Nx.slice(g);
-        nn::gnn(fs[1].eNoN, nsd, nsd, Nx, xql, Nqx, Jac, ksix);
+      if (g == 0 || !fs_2[1].lShpF) {
+        if (!nn::get_geo_cache(lM, e, Nqx, Jac, ksix)) {
+          auto Nx = fs_2[1].Nx.rslice(g);
+          nn::gnn(fs_2[1].eNoN, nsd, nsd, Nx, xql, Nqx, Jac, ksix);
+        }
 
         if (utils::is_zero(Jac)) {
            throw std::runtime_error("[construct_stokes] Jacobian for element " + std::to_string(e) + " is < 0.");
         }
       }
 
-      double w = fs[1].w(g) * Jac;
+      double w = fs_2[1].w(g) * Jac;
 
       // Compute continuity residual and tangent matrix.
       //
       if (nsd == 3) {
-        auto N0 = fs[0].N.col(g); 
-        auto N1 = fs[1].N.col(g); 
-        stokes_3d_c(com_mod, lStab, fs[0].eNoN, fs[1].eNoN, w, ksix, N0, N1, Nwx, Nqx, al, yl, bfl, lR, lK);
+        auto N0 = fs_2[0].N.rcol(g); 
+        auto N1 = fs_2[1].N.rcol(g); 
+        stokes_3d_c(com_mod, lStab, fs_2[0].eNoN, fs_2[1].eNoN, w, ksix, N0, N1, Nwx, Nqx, al, yl, bfl, lR, lK);
 
       } else if (nsd == 2) {
-        auto N0 = fs[0].N.col(g); 
-        auto N1 = fs[1].N.col(g); 
-        stokes_2d_c(com_mod, lStab, fs[0].eNoN, fs[1].eNoN, w, ksix, N0, N1, Nwx, Nqx,  al, yl, bfl, lR, lK);
+        auto N0 = fs_2[0].N.rcol(g); 
+        auto N1 = fs_2[1].N.rcol(g); 
+        stokes_2d_c(com_mod, lStab, fs_2[0].eNoN, fs_2[1].eNoN, w, ksix, N0, N1, Nwx, Nqx,  al, yl, bfl, lR, lK);
       }
 
     } // g: loop
 
-    eq.linear_algebra->assemble(com_mod, eNoN, ptr, lK, lR);
+    eq.linear_algebra->assemble_element(com_mod, lM, e, eNoN, ptr, lK, lR);
 
-  } // e: loop
+  }); // e: loop
 
 }
 
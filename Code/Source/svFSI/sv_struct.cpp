@@ -37,6 +37,7 @@
 
 #include "all_fun.h"
 #include "consts.h"
+#include "eq_assem.h"
 #include "lhsa.h"
 #include "mat_fun.h"
 #include "mat_fun_carray.h"
@@ -49,7 +50,7 @@ namespace struct_ns {
 
 void b_struct_2d(const ComMod& com_mod, const int eNoN, const double w, const Vector<double>& N, 
     const Array<double>& Nx, const Array<double>& dl, const Vector<double>& hl, const Vector<double>& nV, 
-    Array<double>& lR, Array3<double>& lK)
+    Array<double>& lR, Array3<double>& lK, ElementWorkspace& ws)
 {
   int cEq = com_mod.cEq;
   auto& eq = com_mod.eq[cEq];
@@ -61,10 +62,11 @@ void b_struct_2d(const ComMod& com_mod, const int eNoN, const double w, const Ve
   int i = eq.s;
   int j = i + 1;
 
-  Vector<double> nFi(2);  
-  Array<double> NxFi(2,eNoN);
+  ElementWorkspace::Scope scope(ws);
+  auto nFi = ws.vector(2);
+  auto NxFi = ws.array(2,eNoN);
 
-  Array<double> F(2,2); 
+  auto F = ws.array(2,2);
   F(0,0) = 1.0;
   F(1,1) = 1.0;
 
@@ -79,7 +81,8 @@ void b_struct_2d(const ComMod& com_mod, const int eNoN, const double w, const Ve
   }
 
   double Jac = F(0,0)*F(1,1) - F(0,1)*F(1,0);
-  auto Fi = mat_fun::mat_inv(F, 2);
+  auto Fi = ws.array(2,2);
+  mat_fun::mat_inv(F, 2, Fi);
 
   for (int a = 0; a  < eNoN; a++) {
     NxFi(0,a) = Nx(0,a)*Fi(0,0) + Nx(1,a)*Fi(1,0);
@@ -115,7 +118,7 @@ void b_struct_2d(const ComMod& com_mod, const int eNoN, const double w, const Ve
 /// @param lK Local stiffness matrix
 void b_struct_3d(const ComMod& com_mod, const int eNoN, const double w, const Vector<double>& N, 
     const Array<double>& Nx, const Array<double>& dl, const Vector<double>& hl, const Vector<double>& nV, 
-    Array<double>& lR, Array3<double>& lK)
+    Array<double>& lR, Array3<double>& lK, ElementWorkspace& ws)
 {
   #define n_debug_b_struct_3d 
   #ifdef debug_b_struct_3d 
@@ -140,10 +143,11 @@ void b_struct_3d(const ComMod& com_mod, const int eNoN, const double w, const Ve
   debug << "k: " << k;
   #endif
 
-  Vector<double> nFi(3);  
-  Array<double> NxFi(3,eNoN);
+  ElementWorkspace::Scope scope(ws);
+  auto nFi = ws.vector(3);
+  auto NxFi = ws.array(3,eNoN);
 
-  Array<double> F(3,3); 
+  auto F = ws.array(3,3);
   F(0,0) = 1.0;
   F(1,1) = 1.0;
   F(2,2) = 1.0;
@@ -165,7 +169,8 @@ void b_struct_3d(const ComMod& com_mod, const int eNoN, const double w, const Ve
   }
 
   double Jac = mat_fun::mat_det(F, 3);
-  auto Fi = mat_fun::mat_inv(F, 3);
+  auto Fi = ws.array(3,3);
+  mat_fun::mat_inv(F, 3, Fi);
 
   for (int a = 0; a  < eNoN; a++) {
     NxFi(0,a) = Nx(0,a)*Fi(0,0) + Nx(1,a)*Fi(1,0) + Nx(2,a)*Fi(2,0);
@@ -226,7 +231,6 @@ void construct_dsolid(ComMod& com_mod, CepMod& cep_mod, const mshType& lM, const
   const int dof = com_mod.dof;
   const int cEq = com_mod.cEq;
   const auto& eq = com_mod.eq[cEq];
-  auto cDmn = com_mod.cDmn;
   const int nsymd = com_mod.nsymd;
   auto& pS0 = com_mod.pS0;
   auto& pSn = com_mod.pSn;
@@ -247,23 +251,23 @@ void construct_dsolid(ComMod& com_mod, CepMod& cep_mod, const mshType& lM, const
   dmsg << "lM.nG: " << lM.nG;
   #endif
 
-  // STRUCT: dof = nsd
-
-  Vector<int> ptr(eNoN);
-  Vector<double> pSl(nsymd), ya_l(eNoN), N(eNoN);
-  Array<double> xl(nsd,eNoN), al(tDof,eNoN), yl(tDof,eNoN), dl(tDof,eNoN), 
-                bfl(nsd,eNoN), fN(nsd,nFn), pS0l(nsymd,eNoN), Nx(nsd,eNoN), lR(dof,eNoN);
-  Array3<double> lK(dof*dof,eNoN,eNoN);
-
-  // Loop over all elements of mesh
-
-  for (int e = 0; e < lM.nEl; e++) {
-    // Update domain and proceed if domain phys and eqn phys match
-    cDmn = all_fun::domain(com_mod, lM, cEq, e);
-    auto cPhys = eq.dmn[cDmn].phys;
-    if (cPhys != EquationType::phys_struct) {
-      continue; 
-    }
+  // Loop over the elements whose domain phys matches the eqn phys
+
+  eq_assem::loop_elements(com_mod, lM, EquationType::phys_struct, [&](const int e, ElementWorkspace& ws) {
+    // STRUCT: dof = nsd
+    auto ptr = ws.ivector(eNoN);
+    auto pSl = ws.vector(nsymd);
+    auto ya_l = ws.vector(eNoN);
+    auto xl = ws.array(nsd,eNoN);
+    auto al = ws.array(tDof,eNoN);
+    auto yl = ws.array(tDof,eNoN);
+    auto dl = ws.array(tDof,eNoN);
+    auto bfl = ws.array(nsd,eNoN);
+    auto fN = ws.array(nsd,nFn);
+    auto pS0l = ws.array(nsymd,eNoN);
+    auto Nx = ws.array(nsd,eNoN);
+    auto lR = ws.array(dof,eNoN);
+    auto lK = ws.array3(dof*dof,eNoN,eNoN);
 
     // Update shape functions for NURBS
     if (lM.eType == ElementType::NRB) {
@@ -299,7 +303,9 @@ void construct_dsolid(ComMod& com_mod, CepMod& cep_mod, const mshType& lM, const
       }
 
       if (pS0.size() != 0) { 
-        pS0l.set_col(a, pS0.col(Ac));
+        for (int i = 0; i < nsymd; i++) {
+          pS0l(i,a) = pS0(i,Ac);
+        }
       }
 
       if (cem.cpld) {
@@ -313,23 +319,23 @@ void construct_dsolid(ComMod& com_mod, CepMod& cep_mod, const mshType& lM, const
     lK = 0.0;
 
     double Jac{0.0};
-    Array<double> ksix(nsd,nsd);
+    auto ksix = ws.array(nsd,nsd);
 
     for (int g = 0; g < lM.nG; g++) {
       if (g == 0 || !lM.lShpF) {
-        auto Nx_g = lM.Nx.slice(g);
+        auto Nx_g = lM.Nx.rslice(g);
         nn::gnn(eNoN, nsd, nsd, Nx_g, xl, Nx, Jac, ksix);
         if (utils::is_zero(Jac)) {
           throw std::runtime_error("[construct_dsolid] Jacobian for element " + std::to_string(e) + " is < 0.");
         }
       }
       double w = lM.w(g) * Jac;
-      N = lM.N.col(g);
+      auto N = lM.N.rcol(g);
       pSl = 0.0;
 
       if (nsd == 3) {
-        struct_3d_carray(com_mod, cep_mod, eNoN, nFn, w, N, Nx, al, yl, dl, bfl, fN, pS0l, pSl, ya_l, lR, lK);
-        //struct_3d(com_mod, cep_mod, eNoN, nFn, w, N, Nx, al, yl, dl, bfl, fN, pS0l, pSl, ya_l, lR, lK);
+        struct_3d_carray(com_mod, cep_mod, eNoN, nFn, w, N, Nx, al, yl, dl, bfl, fN, pS0l, pSl, ya_l, lR, lK, ws);
+        //struct_3d(com_mod, cep_mod, eNoN, nFn, w, N, Nx, al, yl, dl, bfl, fN, pS0l, pSl, ya_l, lR, lK, ws);
 
 #if 0
         if (e == 0 && g == 0) {
@@ -342,7 +348,7 @@ void construct_dsolid(ComMod& com_mod, CepMod& cep_mod, const mshType& lM, const
 #endif
 
       } else if (nsd == 2) {
-        struct_2d(com_mod, cep_mod, eNoN, nFn, w, N, Nx, al, yl, dl, bfl, fN, pS0l, pSl, ya_l, lR, lK);
+        struct_2d(com_mod, cep_mod, eNoN, nFn, w, N, Nx, al, yl, dl, bfl, fN, pS0l, pSl, ya_l, lR, lK, ws);
       }
 
       // Prestress
@@ -357,8 +363,8 @@ void construct_dsolid(ComMod& com_mod, CepMod& cep_mod, const mshType& lM, const
       }
     } 
 
-    eq.linear_algebra->assemble(com_mod, eNoN, ptr, lK, lR);
-  } 
+    eq.linear_algebra->assemble_element(com_mod, lM, e, eNoN, ptr, lK, lR);
+  });
 }
 
 /// @brief Reproduces Fortran 'STRUCT2D' subroutine.
@@ -366,7 +372,7 @@ void construct_dsolid(ComMod& com_mod, CepMod& cep_mod, const mshType& lM, const
 void struct_2d(ComMod& com_mod, CepMod& cep_mod, const int eNoN, const int nFn, const double w, 
     const Vector<double>& N, const Array<double>& Nx, const Array<double>& al, const Array<double>& yl, 
     const Array<double>& dl, const Array<double>& bfl, const Array<double>& fN, const Array<double>& pS0l, 
-    Vector<double>& pSl, const Vector<double>& ya_l, Array<double>& lR, Array3<double>& lK) 
+    Vector<double>& pSl, const Vector<double>& ya_l, Array<double>& lR, Array3<double>& lK, ElementWorkspace& ws) 
 {
   using namespace consts;
   using namespace mat_fun;
@@ -377,6 +383,7 @@ void struct_2d(ComMod& com_mod, CepMod& cep_mod, const int eNoN, const int nFn,
   dmsg.banner();
   #endif
 
+  ElementWorkspace::Scope scope(ws);
   const int dof = com_mod.dof;
   int cEq = com_mod.cEq;
   auto& eq = com_mod.eq[cEq];
@@ -389,7 +396,7 @@ void struct_2d(ComMod& com_mod, CepMod& cep_mod, const int eNoN, const int nFn,
   double rho = dmn.prop.at(PhysicalProperyType::solid_density);
   double mu = dmn.prop.at(PhysicalProperyType::solid_viscosity);
   double dmp = dmn.prop.at(PhysicalProperyType::damping);
-  Vector<double> fb({dmn.prop.at(PhysicalProperyType::f_x), dmn.prop.at(PhysicalProperyType::f_y)});
+  double fb[2] = {dmn.prop.at(PhysicalProperyType::f_x), dmn.prop.at(PhysicalProperyType::f_y)};
   double afu = eq.af * eq.beta*dt*dt;
   double afv = eq.af * eq.gam*dt;
   double amd = eq.am * rho  +  eq.af * eq.gam * dt * dmp;
@@ -407,10 +414,13 @@ void struct_2d(ComMod& com_mod, CepMod& cep_mod, const int eNoN, const int nFn,
 
   // Inertia, body force and deformation tensor (F)
   //
-  Array<double> F(2,2), S0(2,2), vx(2,2);
-  Vector<double> ud(2);
+  auto F = ws.array(2,2);
+  auto S0 = ws.array(2,2);
+  auto vx = ws.array(2,2);
+  auto ud = ws.vector(2);
 
-  ud = -rho*fb;
+  ud(0) = -rho*fb[0];
+  ud(1) = -rho*fb[1];
   F = 0.0;
   F(0,0) = 1.0;
   F(1,1) = 1.0;
@@ -446,24 +456,35 @@ void struct_2d(ComMod& com_mod, CepMod& cep_mod, const int eNoN, const int nFn,
   S0(1,0) = S0(0,1);
 
   double Jac = mat_det(F, 2);
-  auto Fi = mat_inv(F, 2);
+  auto Fi = ws.array(2,2);
+  mat_inv(F, 2, Fi);
 
   // Viscous contribution
   // Velocity gradient in current configuration
-  auto VxFi = mat_mul(vx, Fi);
+  auto VxFi = ws.array(2,2);
+  mat_mul(vx, Fi, VxFi);
 
   // Deviatoric strain tensor
-  auto ddev = mat_dev(mat_symm(VxFi,2), 2);
+  auto dsym = ws.array(2,2);
+  auto ddev = ws.array(2,2);
+  mat_symm(VxFi, 2, dsym);
+  mat_dev(dsym, 2, ddev);
 
   // 2nd Piola-Kirchhoff stress due to viscosity
-  auto Svis = mat_mul(ddev, transpose(Fi));
-  Svis = 2.0 * mu * Jac * mat_mul(Fi, Svis);
-
-  Array<double> S(2,2), Dm(3,3);
-  mat_models::get_pk2cc(com_mod, cep_mod, dmn, F, nFn, fN, ya_g, S, Dm);
+  auto FiT = ws.array(2,2);
+  auto DdFiT = ws.array(2,2);
+  auto Svis = ws.array(2,2);
+  transpose(Fi, FiT);
+  mat_mul(ddev, FiT, DdFiT);
+  mat_mul(Fi, DdFiT, Svis);
+  Svis *= 2.0 * mu * Jac;
+
+  auto S = ws.array(2,2);
+  auto Dm = ws.array(3,3);
+  mat_models::get_pk2cc(com_mod, cep_mod, dmn, F, nFn, fN, ya_g, S, Dm, ws);
 
   // Elastic + Viscous stresses
-  S = S + Svis;
+  S += Svis;
 
   // Prestress
   pSl(0) = S(0,0);
@@ -471,13 +492,14 @@ void struct_2d(ComMod& com_mod, CepMod& cep_mod, const int eNoN, const int nFn,
   pSl(2) = S(0,1);
 
   // Total 2nd Piola-Kirchhoff stress
-  S = S + S0;
+  S += S0;
 
   // 1st Piola-Kirchhoff tensor (P)
   //
-  Array<double> P(2,2), DBm(3,2);
-  Array3<double> Bm(3,2,eNoN);
-  P = mat_fun::mat_mul(F, S);
+  auto P = ws.array(2,2);
+  auto DBm = ws.array(3,2);
+  auto Bm = ws.array3(3,2,eNoN);
+  mat_fun::mat_mul(F, S, P);
   #ifdef debug_struct_2d 
   debug << "P: " << P(0,0) << " " << P(0,1);
   debug << "   " << P(1,0) << " " << P(1,1);
@@ -502,7 +524,9 @@ void struct_2d(ComMod& com_mod, CepMod& cep_mod, const int eNoN, const int nFn,
     Bm(2,1,a) = (Nx(0,a)*F(1,1) + F(1,0)*Nx(1,a));
   }
 
-  Array<double> NxFi(2,eNoN), DdNx(2,eNoN), VxNx(2,eNoN);
+  auto NxFi = ws.array(2,eNoN);
+  auto DdNx = ws.array(2,eNoN);
+  auto VxNx = ws.array(2,eNoN);
 
   for (int a = 0; a < eNoN; a++) {
     NxFi(0,a) = Nx(0,a)*Fi(0,0) + Nx(1,a)*Fi(1,0);
@@ -593,7 +617,7 @@ void struct_2d(ComMod& com_mod, CepMod& cep_mod, const int eNoN, const int nFn,
 void struct_3d_carray(ComMod& com_mod, CepMod& cep_mod, const int eNoN, const int nFn, const double w, 
     const Vector<double>& N, const Array<double>& Nx, const Array<double>& al, const Array<double>& yl, 
     const Array<double>& dl, const Array<double>& bfl, const Array<double>& fN, const Array<double>& pS0l, 
-    Vector<double>& pSl, const Vector<double>& ya_l, Array<double>& lR, Array3<double>& lK) 
+    Vector<double>& pSl, const Vector<double>& ya_l, Array<double>& lR, Array3<double>& lK, ElementWorkspace& ws) 
 {
   using namespace consts;
   using namespace mat_fun;
@@ -779,7 +803,8 @@ void struct_3d_carray(ComMod& com_mod, CepMod& cep_mod, const int eNoN, const in
 
   // Auxilary quantities for computing stiffness tensor
   //
-  Array3<double> Bm(6,3,eNoN);
+  ElementWorkspace::Scope scope(ws);
+  auto Bm = ws.array3(6,3,eNoN);
 
   for (int a = 0; a < eNoN; a++) {
     Bm(0,0,a) = Nx(0,a)*F[0][0];
@@ -810,7 +835,9 @@ void struct_3d_carray(ComMod& com_mod, CepMod& cep_mod, const int eNoN, const in
   // Below quantities are used for viscous stress contribution
   // Shape function gradients in the current configuration
   //
-  Array<double> NxFi(3,eNoN), DdNx(3,eNoN), VxNx(3,eNoN);
+  auto NxFi = ws.array(3,eNoN);
+  auto DdNx = ws.array(3,eNoN);
+  auto VxNx = ws.array(3,eNoN);
 
   for (int a = 0; a < eNoN; a++) {
     NxFi(0,a) = Nx(0,a)*Fi[0][0] + Nx(1,a)*Fi[1][0] + Nx(2,a)*Fi[2][0];
@@ -833,7 +860,7 @@ void struct_3d_carray(ComMod& com_mod, CepMod& cep_mod, const int eNoN, const in
   double rmv = afv * mu * Jac;
   double NxSNx, T1, NxNx, BmDBm, Tv;
 
-  Array<double> DBm(6,3);
+  auto DBm = ws.array(6,3);
 
   for (int b = 0; b < eNoN; b++) {
 
@@ -985,7 +1012,7 @@ void struct_3d_carray(ComMod& com_mod, CepMod& cep_mod, const int eNoN, const in
 void struct_3d(ComMod& com_mod, CepMod& cep_mod, const int eNoN, const int nFn, const double w, 
     const Vector<double>& N, const Array<double>& Nx, const Array<double>& al, const Array<double>& yl, 
     const Array<double>& dl, const Array<double>& bfl, const Array<double>& fN, const Array<double>& pS0l, 
-    Vector<double>& pSl, const Vector<double>& ya_l, Array<double>& lR, Array3<double>& lK) 
+    Vector<double>& pSl, const Vector<double>& ya_l, Array<double>& lR, Array3<double>& lK, ElementWorkspace& ws) 
 {
   using namespace consts;
   using namespace mat_fun;
@@ -999,6 +1026,7 @@ void struct_3d(ComMod& com_mod, CepMod& cep_mod, const int eNoN, const int nFn,
   dmsg << "nFn: " << nFn;
   #endif
 
+  ElementWorkspace::Scope scope(ws);
   const int dof = com_mod.dof;
   int cEq = com_mod.cEq;
   auto& eq = com_mod.eq[cEq];
@@ -1011,9 +1039,9 @@ void struct_3d(ComMod& com_mod, CepMod& cep_mod, const int eNoN, const int nFn,
   double rho = dmn.prop.at(PhysicalProperyType::solid_density);
   double mu = dmn.prop.at(PhysicalProperyType::solid_viscosity);
   double dmp = dmn.prop.at(PhysicalProperyType::damping);
-  Vector<double> fb({dmn.prop.at(PhysicalProperyType::f_x), 
-                     dmn.prop.at(PhysicalProperyType::f_y), 
-                     dmn.prop.at(PhysicalProperyType::f_z)});
+  double fb[3] = {dmn.prop.at(PhysicalProperyType::f_x), 
+                  dmn.prop.at(PhysicalProperyType::f_y), 
+                  dmn.prop.at(PhysicalProperyType::f_z)};
 
   double afu = eq.af * eq.beta*dt*dt;
   double afv = eq.af * eq.gam*dt;
@@ -1034,15 +1062,19 @@ void struct_3d(ComMod& com_mod, CepMod& cep_mod, const int eNoN, const int nFn,
 
   // Inertia, body force and deformation tensor (F)
   //
-  Array<double> F(3,3), S0(3,3), vx(3,3);
-  Vector<double> ud(3);
+  auto F = ws.array(3,3);
+  auto S0 = ws.array(3,3);
+  auto vx = ws.array(3,3);
+  auto ud = ws.vector(3);
 
   double F_f[3][3]={}; 
   F_f[0][0] = 1.0;
   F_f[1][1] = 1.0;
   F_f[2][2] = 1.0;
 
-  ud = -rho*fb;
+  ud(0) = -rho*fb[0];
+  ud(1) = -rho*fb[1];
+  ud(2) = -rho*fb[2];
   F = 0.0;
   F(0,0) = 1.0;
   F(1,1) = 1.0;
@@ -1102,7 +1134,8 @@ void struct_3d(ComMod& com_mod, CepMod& cep_mod, const int eNoN, const int nFn,
   S0(0,2) = S0(2,0);
 
   double Jac = mat_det(F, 3);
-  auto Fi = mat_inv(F, 3);
+  auto Fi = ws.array(3,3);
+  mat_inv(F, 3, Fi);
 
   //std::cout << "[struct_3d] F: " << F << std::endl;
   //std::cout << "[struct_3d] S0: " << S0 << std::endl;
@@ -1110,26 +1143,36 @@ void struct_3d(ComMod& com_mod, CepMod& cep_mod, const int eNoN, const int nFn,
 
   // Viscous contribution
   // Velocity gradient in current configuration
-  auto VxFi = mat_mul(vx, Fi);
+  auto VxFi = ws.array(3,3);
+  mat_mul(vx, Fi, VxFi);
   //std::cout << "[struct_3d] VxFi: " << VxFi << std::endl;
 
   // Deviatoric strain tensor
-  auto ddev = mat_dev(mat_symm(VxFi,3), 3);
+  auto dsym = ws.array(3,3);
+  auto ddev = ws.array(3,3);
+  mat_symm(VxFi, 3, dsym);
+  mat_dev(dsym, 3, ddev);
   //std::cout << "[struct_3d] mat_symm(VxFi,3): " << mat_symm(VxFi,3) << std::endl;
   //std::cout << "[struct_3d] ddev: " << ddev << std::endl;
 
   // 2nd Piola-Kirchhoff stress due to viscosity
-  auto Svis = mat_mul(ddev, transpose(Fi));
-  Svis = 2.0 * mu * Jac * mat_mul(Fi, Svis);
+  auto FiT = ws.array(3,3);
+  auto DdFiT = ws.array(3,3);
+  auto Svis = ws.array(3,3);
+  transpose(Fi, FiT);
+  mat_mul(ddev, FiT, DdFiT);
+  mat_mul(Fi, DdFiT, Svis);
+  Svis *= 2.0 * mu * Jac;
 
   // 2nd Piola-Kirchhoff tensor (S) and material stiffness tensor in
   // Voigt notationa (Dm)
   //
-  Array<double> S(3,3), Dm(6,6); 
-  mat_models::get_pk2cc(com_mod, cep_mod, dmn, F, nFn, fN, ya_g, S, Dm);
+  auto S = ws.array(3,3);
+  auto Dm = ws.array(6,6);
+  mat_models::get_pk2cc(com_mod, cep_mod, dmn, F, nFn, fN, ya_g, S, Dm, ws);
 
   // Elastic + Viscous stresses
-  S = S + Svis;
+  S += Svis;
 
   #ifdef debug_struct_3d 
   dmsg << "Jac: " << Jac;
@@ -1152,8 +1195,9 @@ void struct_3d(ComMod& com_mod, CepMod& cep_mod, const int eNoN, const int nFn,
 
   // 1st Piola-Kirchhoff tensor (P)
   //
-  Array<double> P(3,3), DBm(6,3); 
-  Array3<double> Bm(6,3,eNoN); 
+  auto P = ws.array(3,3);
+  auto DBm = ws.array(6,3);
+  auto Bm = ws.array3(6,3,eNoN);
   mat_fun::mat_mul(F, S, P);
 
   // Local residual
@@ -1194,7 +1238,9 @@ void struct_3d(ComMod& com_mod, CepMod& cep_mod, const int eNoN, const int nFn,
   // Below quantities are used for viscous stress contribution
   // Shape function gradients in the current configuration
   //
-  Array<double> NxFi(3,eNoN), DdNx(3,eNoN), VxNx(3,eNoN);
+  auto NxFi = ws.array(3,eNoN);
+  auto DdNx = ws.array(3,eNoN);
+  auto VxNx = ws.array(3,eNoN);
 
   for (int a = 0; a < eNoN; a++) {
     NxFi(0,a) = Nx(0,a)*Fi(0,0) + Nx(1,a)*Fi(1,0) + Nx(2,a)*Fi(2,0);
@@ -41,6 +41,7 @@
 
 #include "trilinos_impl.h"
 #include "ComMod.h"
+#include <algorithm>
 #define NOOUTPUT
 
 // --- Define global Trilinos variables to be used in below functions ---------
@@ -94,8 +95,6 @@ std::vector<int> nnzPerRow;
 
 std::vector<int> localToGlobalSorted;
 
-int timecount = 0;
-
 bool coupledBC;
 
 // ----------------------------------------------------------------------------
@@ -172,6 +171,9 @@ void trilinos_lhs_create_(int &numGlobalNodes, int &numLocalNodes,
     indexBase = 0; 
   }
 
+  // Preconditioners refer to the matrix being replaced
+  destroyPreconditioner();
+
   dof = Dof; //constant size dof blocks
   ghostAndLocalNodes = numGhostAndLocalNodes;
   localNodes = numLocalNodes;
@@ -441,7 +443,8 @@ void trilinos_doassem_(int &numNodesPerElement, const int *eqN, const double *lK
 void trilinos_global_solve_(const double *Val, const double *RHS, double *x,
         const double *dirW, double &resNorm, double &initNorm, int &numIters,
         double &solverTime, double &dB, bool &converged, int &lsType,
-        double &relTol, int &maxIters, int &kspace, int &precondType)
+        double &relTol, int &maxIters, int &kspace, int &precondType,
+        int &precUpdate)
 {
   int nnzCount = 0; //cumulate count of block nnz per rows
   int count = 0;
@@ -512,7 +515,7 @@ void trilinos_global_solve_(const double *Val, const double *RHS, double *x,
 
   trilinos_solve_(x, dirW, resNorm, initNorm, numIters,
           solverTime, dB, converged, lsType,
-          relTol, maxIters, kspace, precondType, flagFassem);
+          relTol, maxIters, kspace, precondType, flagFassem, precUpdate);
 
 } // trilinos_global_solve_
 
@@ -536,11 +539,14 @@ void trilinos_global_solve_(const double *Val, const double *RHS, double *x,
  * \param kspace      specific for gmres dim of the stored Krylov space vectors
  * \param precondType defines type of preconditioner to use
  * \param isFassem    determines if F is already assembled at ghost nodes
+ * \param precUpdate  requested preconditioner update, TRILINOS_PREC_REBUILD,
+ *                    TRILINOS_PREC_REFRESH or TRILINOS_PREC_REUSE, returns the
+ *                    update actually performed
  */
 void trilinos_solve_(double *x, const double *dirW, double &resNorm,
         double &initNorm, int &numIters, double &solverTime, double &dB,
         bool &converged, int &lsType, double &relTol, int &maxIters,
-        int &kspace, int &precondType, bool &isFassem)
+        int &kspace, int &precondType, bool &isFassem, int &precUpdate)
 {
   #define n_debug_trilinos_solve
   #ifdef debug_trilinos_solve
@@ -550,6 +556,7 @@ void trilinos_solve_(double *x, const double *dirW, double &resNorm,
   std::cout << "[trilinos_solve] lsType: " << lsType << std::endl;
   std::cout << "[trilinos_solve] precondType: " << precondType << std::endl;
   std::cout << "[trilinos_solve] isFassem: " << isFassem << std::endl;
+  std::cout << "[trilinos_solve] precUpdate: " << precUpdate << std::endl;
   #endif
   bool flagFassem = isFassem;
 
@@ -601,7 +608,7 @@ void trilinos_solve_(double *x, const double *dirW, double &resNorm,
   Solver.SetAztecOption(AZ_output, AZ_none);
 #endif
 
-  setPreconditioner(precondType, Solver);
+  setPreconditioner(precondType, Solver, precUpdate);
 
   // Set convergence type as relative ||r|| <= relTol||b||
   Solver.SetAztecOption(AZ_conv, AZ_rhs);
@@ -610,8 +617,9 @@ void trilinos_solve_(double *x, const double *dirW, double &resNorm,
   int numRestarts = 1; //also changes for gmres
   int maxItersPerRestart = maxIters;
 
-  // Solver is GMRES by default
-  if (lsType ==TRILINOS_GMRES_SOLVER)
+  // Solver is GMRES by default, AztecOO has no pipelined GMRES so 
+  // the standard one is used for it.
+  if ((lsType == TRILINOS_GMRES_SOLVER) || (lsType == TRILINOS_PGMRES_SOLVER))
   {
     //special parameters to set orthog and kspace
     numRestarts = maxIters; //different definition for gmres
@@ -673,19 +681,21 @@ void trilinos_solve_(double *x, const double *dirW, double &resNorm,
   if (coupledBC) Trilinos::bdryVec->PutScalar(0.0);
   //0 out initial guess for iteration
   Trilinos::X->PutScalar(0.0);
-  // Free memory if MLPrec is invoked
-  if (ifpackPrec) {
-      delete ifpackPrec;
-      ifpackPrec = NULL;
-  }
-  if (MLPrec) {
-      delete MLPrec;
-      MLPrec = NULL;
-  }
+  // The ML/IFPACK preconditioner is kept for reuse, it is freed when it is
+  // rebuilt or by trilinos_lhs_free_()
 } // trilinos_solve_
 
 // ----------------------------------------------------------------------------
-void setPreconditioner(int precondType, AztecOO &Solver)
+/**
+ * Only the ML and IFPACK preconditioners can be reused between solves, the
+ * AztecOO native preconditioners are computed by Iterate() and always rebuilt.
+ *
+ * \param precondType  type of preconditioner to use
+ * \param Solver       AztecOO solver the preconditioner is set for
+ * \param precUpdate   requested preconditioner update, returns the update
+ *                     actually performed
+ */
+void setPreconditioner(int precondType, AztecOO &Solver, int &precUpdate)
 {
   //initialize reordering for ILU/ILUT preconditioners
   Solver.SetAztecOption(AZ_reorder, 1);
@@ -726,29 +736,50 @@ void setPreconditioner(int precondType, AztecOO &Solver)
   else if (precondType == TRILINOS_IC_PRECONDITIONER)
   {
     checkDiagonalIsZero();
-    setIFPACKPrec(Solver);
+    setIFPACKPrec(Solver, precUpdate);
+    return;
   }
   else if (precondType == TRILINOS_ICT_PRECONDITIONER)
   {
     checkDiagonalIsZero();
-    setIFPACKPrec(Solver); //add in parameter for string for different types
+    setIFPACKPrec(Solver, precUpdate); //add in parameter for string for different types
+    return;
   }
   else if (precondType == TRILINOS_ML_PRECONDITIONER)
-    setMLPrec(Solver);
+  {
+    setMLPrec(Solver, precUpdate);
+    return;
+  }
   else
   {
     std::cout << "ERROR: Preconditioner Type is undefined" << std::endl;
     exit(1);
   }
+
+  precUpdate = TRILINOS_PREC_REBUILD;
 } // setPreconditioner
 
 // ----------------------------------------------------------------------------
 /**
  * Tune parameters for htis and IFPACK
  * Ref: https://trilinos.org/oldsite/packages/ml/mlguide5.pdf
+ *
+ * TRILINOS_PREC_REFRESH recomputes the smoothers and coarse operators keeping
+ * the aggregates and prolongators of the existing hierarchy.
  */
-void setMLPrec(AztecOO &Solver)
+void setMLPrec(AztecOO &Solver, int &precUpdate)
 {
+  if (precUpdate == TRILINOS_PREC_REBUILD)
+    destroyPreconditioner();
+
+  if (MLPrec != NULL)
+  {
+    if (precUpdate == TRILINOS_PREC_REFRESH)
+      MLPrec->ReComputePreconditioner();
+    Solver.SetPrecOperator(MLPrec);
+    return;
+  }
+
   //break up into initializer
   Teuchos::ParameterList MLList;
   int *options = new int[AZ_OPTIONS_SIZE];
@@ -801,19 +832,10 @@ void setMLPrec(AztecOO &Solver)
   MLList.set("repartition: Zoltan dimensions",2);
 
   // create the preconditioner object based on options in MLList and compute hierarchy
-  if (MLPrec == NULL)
-    MLPrec = new ML_Epetra::MultiLevelPreconditioner(*Trilinos::K, MLList, false);
-
-  timecount = 0;
-  if (timecount == 0)
-    MLPrec->ComputePreconditioner();
-  else {//switch to recompute
-    MLPrec->ReComputePreconditioner();
-  }
+  MLPrec = new ML_Epetra::MultiLevelPreconditioner(*Trilinos::K, MLList, false);
+  MLPrec->ComputePreconditioner();
   Solver.SetPrecOperator(MLPrec);
-
-  //solver to separte function only recompute at separate time iter
-  timecount += 1;
+  precUpdate = TRILINOS_PREC_REBUILD;
 
   delete[] options;
   delete[] params;
@@ -823,9 +845,23 @@ void setMLPrec(AztecOO &Solver)
 /**
  * pass in IC, ICT
  * pass in string for which to turn on right now set to IC
+ *
+ * TRILINOS_PREC_REFRESH recomputes the factorization without reinitializing
+ * the subdomain structure.
  */
-void setIFPACKPrec(AztecOO &Solver)
+void setIFPACKPrec(AztecOO &Solver, int &precUpdate)
 {
+  if (precUpdate == TRILINOS_PREC_REBUILD)
+    destroyPreconditioner();
+
+  if (ifpackPrec != NULL)
+  {
+    if (precUpdate == TRILINOS_PREC_REFRESH)
+      ifpackPrec->Compute();
+    Solver.SetPrecOperator(&*ifpackPrec);
+    return;
+  }
+
   //Ifpack Factory;
   //std::string PrecType = "ILUT"; // exact solve on each subdomain
   //int OverlapLevel = 0; // one row of overlap among the processes
@@ -847,9 +883,27 @@ void setIFPACKPrec(AztecOO &Solver)
   ifpackPrec->Initialize();
   ifpackPrec->Compute();
   Solver.SetPrecOperator(&*ifpackPrec);
+  precUpdate = TRILINOS_PREC_REBUILD;
 
 } // setIFPACKPrec
 
+// ----------------------------------------------------------------------------
+/**
+ * free the ML and IFPACK preconditioners
+ */
+void destroyPreconditioner()
+{
+  if (ifpackPrec) {
+      delete ifpackPrec;
+      ifpackPrec = NULL;
+  }
+  if (MLPrec) {
+      MLPrec->DestroyPreconditioner();
+      delete MLPrec;
+      MLPrec = NULL;
+  }
+} // destroyPreconditioner
+
 // ----------------------------------------------------------------------------
 /**
  * This routine is to be used with preconditioners such as ILUT which require
@@ -962,11 +1016,7 @@ void trilinos_bc_create_(const double *v, bool &isCoupledBC)
  */
 void trilinos_lhs_free_()
 {
-  if (MLPrec) {
-      MLPrec->DestroyPreconditioner();
-      delete MLPrec;
-      MLPrec = NULL;
-  }
+  destroyPreconditioner();
   if (Trilinos::blockMap) {
       delete Trilinos::blockMap;
       Trilinos::blockMap = NULL;
@@ -1096,9 +1146,35 @@ class TrilinosLinearAlgebra::TrilinosImpl {
     void solve_assembled(ComMod& com_mod, eqType& lEq, const Vector<int>& incL, const Vector<double>& res);
     void init_dir_and_coup_neu(ComMod& com_mod, const Vector<int>& incL, const Vector<double>& res);
     void set_preconditioner(consts::PreconditionerType preconditioner);
+    void set_preconditioner_reuse(const int rebuild_interval, const int rebuild_iterations, const bool refresh_values);
+    std::string preconditioner_status();
+    int preconditioner_update();
+    void update_preconditioner_state(const int prec_update, const int num_iterations);
+    bool reuse_lhs(ComMod& com_mod);
 
     consts::PreconditionerType preconditioner_;
 
+    /// @brief Preconditioner reuse policy
+    int rebuild_interval_ = 1;
+    int rebuild_iterations_ = 0;
+    bool refresh_values_ = false;
+
+    /// @brief Number of solves using the preconditioner since it was rebuilt
+    int num_prec_solves_ = 0;
+
+    /// @brief Number of iterations of the last solve
+    int num_iterations_ = 0;
+
+    /// @brief Preconditioner update performed for the last solve
+    int prec_update_ = TRILINOS_PREC_REBUILD;
+
+    /// @brief Sparsity pattern the Trilinos matrix was created for
+    Vector<int> row_ptr_;
+    Vector<int> col_ptr_;
+
+    /// @brief The TrilinosImpl object that created the Trilinos matrix
+    static TrilinosImpl* lhs_owner_;
+
     /// @brief Local to global mapping
     Vector<int> ltg_;
 
@@ -1109,6 +1185,8 @@ class TrilinosLinearAlgebra::TrilinosImpl {
     Array<double> R_;
 };
 
+TrilinosLinearAlgebra::TrilinosImpl* TrilinosLinearAlgebra::TrilinosImpl::lhs_owner_ = nullptr;
+
 TrilinosLinearAlgebra::TrilinosImpl::TrilinosImpl()
 {
 }
@@ -1128,6 +1206,9 @@ void TrilinosLinearAlgebra::TrilinosImpl::alloc(ComMod& com_mod, eqType& lEq)
   #endif
 
   if (W_.size() != 0) {
+    if (reuse_lhs(com_mod)) {
+      return;
+    }
     W_.clear();
     R_.clear();
     trilinos_lhs_free_();
@@ -1142,6 +1223,36 @@ void TrilinosLinearAlgebra::TrilinosImpl::alloc(ComMod& com_mod, eqType& lEq)
   trilinos_lhs_create_(gtnNo, lhs.mynNo, tnNo, lhs.nnz, ltg_.data(), com_mod.ltg.data(), com_mod.rowPtr.data(), 
       com_mod.colPtr.data(), dof, cpp_index, task_id);
 
+  lhs_owner_ = this;
+
+  if (rebuild_interval_ != 1) {
+    row_ptr_ = com_mod.rowPtr;
+    col_ptr_ = com_mod.colPtr;
+  }
+}
+
+/// @brief Check if the Trilinos matrix created by the last alloc() can be used again.
+///
+/// The matrix is kept between solves only when the preconditioner may be reused 
+/// because the ML and IFPACK preconditioners refer to it. It is zeroed at the end 
+/// of each solve.
+//
+bool TrilinosLinearAlgebra::TrilinosImpl::reuse_lhs(ComMod& com_mod)
+{
+  if ((rebuild_interval_ == 1) || (lhs_owner_ != this)) {
+    return false;
+  }
+
+  if ((W_.nrows() != com_mod.dof) || (W_.ncols() != com_mod.tnNo)) {
+    return false;
+  }
+
+  if ((row_ptr_.size() != com_mod.rowPtr.size()) || (col_ptr_.size() != com_mod.colPtr.size())) {
+    return false;
+  }
+
+  return std::equal(row_ptr_.data(), row_ptr_.data() + row_ptr_.size(), com_mod.rowPtr.data()) &&
+         std::equal(col_ptr_.data(), col_ptr_.data() + col_ptr_.size(), com_mod.colPtr.data());
 }
 
 /// @brief Assemble local element arrays.
@@ -1249,6 +1360,66 @@ void TrilinosLinearAlgebra::TrilinosImpl::set_preconditioner(consts::Preconditio
   preconditioner_ = prec_type;
 }
 
+/// @brief Set the preconditioner reuse policy.
+void TrilinosLinearAlgebra::TrilinosImpl::set_preconditioner_reuse(const int rebuild_interval, 
+    const int rebuild_iterations, const bool refresh_values)
+{
+  rebuild_interval_ = rebuild_interval;
+  rebuild_iterations_ = rebuild_iterations;
+  refresh_values_ = refresh_values;
+}
+
+/// @brief Return how the preconditioner was updated for the last solve.
+std::string TrilinosLinearAlgebra::TrilinosImpl::preconditioner_status()
+{
+  if (rebuild_interval_ == 1) {
+    return "";
+  }
+
+  if (prec_update_ == TRILINOS_PREC_REFRESH) {
+    return "refresh";
+  } else if (prec_update_ == TRILINOS_PREC_REUSE) {
+    return "reuse";
+  }
+
+  return "rebuild";
+}
+
+/// @brief Determine how the preconditioner is updated for the next solve.
+///
+/// The preconditioner is rebuilt every 'rebuild_interval_' solves or if the last 
+/// solve took more than 'rebuild_iterations_' iterations, otherwise its values are 
+/// refreshed or it is reused unchanged. A missing preconditioner is always built.
+//
+int TrilinosLinearAlgebra::TrilinosImpl::preconditioner_update()
+{
+  if ((rebuild_interval_ > 0) && (num_prec_solves_ >= rebuild_interval_)) {
+    return TRILINOS_PREC_REBUILD;
+  }
+
+  if ((rebuild_iterations_ > 0) && (num_iterations_ > rebuild_iterations_)) {
+    return TRILINOS_PREC_REBUILD;
+  }
+
+  if (refresh_values_) {
+    return TRILINOS_PREC_REFRESH;
+  }
+
+  return TRILINOS_PREC_REUSE;
+}
+
+/// @brief Record the preconditioner update performed and the number of iterations of a solve.
+void TrilinosLinearAlgebra::TrilinosImpl::update_preconditioner_state(const int prec_update, const int num_iterations)
+{
+  if (prec_update == TRILINOS_PREC_REBUILD) {
+    num_prec_solves_ = 0;
+  }
+
+  prec_update_ = prec_update;
+  num_prec_solves_ += 1;
+  num_iterations_ = num_iterations;
+}
+
 /// @brief Solve a system of linear equations assembled by fsils.
 void TrilinosLinearAlgebra::TrilinosImpl::solve(ComMod& com_mod, eqType& lEq, const Vector<int>& incL, 
     const Vector<double>& res)
@@ -1276,9 +1447,13 @@ void TrilinosLinearAlgebra::TrilinosImpl::solve(ComMod& com_mod, eqType& lEq, co
     throw std::runtime_error("[TrilinosLinearAlgebra::solve] ERROR: '" + prec_name + "' is not a valid Trilinos preconditioner.");
   }
 
+  int prec_update = preconditioner_update();
+
   trilinos_global_solve_(Val.data(), R.data(), R_.data(), W_.data(), lEq.FSILS.RI.fNorm,
       lEq.FSILS.RI.iNorm, lEq.FSILS.RI.itr, lEq.FSILS.RI.callD, lEq.FSILS.RI.dB, lEq.FSILS.RI.suc,
-      solver_type, lEq.FSILS.RI.relTol, lEq.FSILS.RI.mItr, lEq.FSILS.RI.sD, prec_type);
+      solver_type, lEq.FSILS.RI.relTol, lEq.FSILS.RI.mItr, lEq.FSILS.RI.sD, prec_type, prec_update);
+
+  update_preconditioner_state(prec_update, lEq.FSILS.RI.itr);
 
   for (int a = 0; a < com_mod.tnNo; a++) {
     for (int i = 0; i < com_mod.R.nrows(); i++) {
@@ -1312,10 +1487,14 @@ void TrilinosLinearAlgebra::TrilinosImpl::solve_assembled(ComMod& com_mod, eqTyp
 
   init_dir_and_coup_neu(com_mod, incL, res);
 
+  int prec_update = preconditioner_update();
+
   trilinos_solve_(R_.data(), W_.data(), lEq.FSILS.RI.fNorm, lEq.FSILS.RI.iNorm, 
       lEq.FSILS.RI.itr, lEq.FSILS.RI.callD, lEq.FSILS.RI.dB, lEq.FSILS.RI.suc, 
       solver_type, lEq.FSILS.RI.relTol, lEq.FSILS.RI.mItr, lEq.FSILS.RI.sD, 
-      prec_type, assembled);
+      prec_type, assembled, prec_update);
+
+  update_preconditioner_state(prec_update, lEq.FSILS.RI.itr);
 
   for (int a = 0; a < com_mod.tnNo; a++) {
     for (int i = 0; i < com_mod.R.nrows(); i++) {
@@ -79,6 +79,7 @@
 #define TRILINOS_CG_SOLVER 798
 #define TRILINOS_GMRES_SOLVER 797
 #define TRILINOS_BICGSTAB_SOLVER 795
+#define TRILINOS_PGMRES_SOLVER 794
 
 // Define preconditioners as following naming in FSILS_struct
 #define NO_PRECONDITIONER 700
@@ -90,6 +91,11 @@
 #define TRILINOS_ICT_PRECONDITIONER 707
 #define TRILINOS_ML_PRECONDITIONER 708
 
+// Define how the preconditioner is updated for a solve
+#define TRILINOS_PREC_REBUILD 0
+#define TRILINOS_PREC_REFRESH 1
+#define TRILINOS_PREC_REUSE 2
+
 /// @brief Initialize all Epetra types we need separate from Fortran
 struct Trilinos
 {
@@ -210,12 +216,13 @@ public:
           double *x, const double *dirW, double &resNorm, double &initNorm,
           int &numIters, double &solverTime, double &dB, bool &converged,
           int &lsType, double &relTol, int &maxIters, int &kspace,
-          int &precondType);
+          int &precondType, int &precUpdate);
 
   void trilinos_solve_(double *x, const double *dirW, double &resNorm,
           double &initNorm, int &numIters, double &solverTime,
           double &dB, bool &converged, int &lsType, double &relTol,
-          int &maxIters, int &kspace, int &precondType, bool &isFassem);
+          int &maxIters, int &kspace, int &precondType, bool &isFassem,
+          int &precUpdate);
 
   void trilinos_lhs_free_();
 
@@ -224,11 +231,13 @@ public:
 #endif
 
 // --- Define functions to only be called in C++ ------------------------------
-void setPreconditioner(int precondType, AztecOO &Solver);
+void setPreconditioner(int precondType, AztecOO &Solver, int &precUpdate);
+
+void setMLPrec(AztecOO &Solver, int &precUpdate);
 
-void setMLPrec(AztecOO &Solver);
+void setIFPACKPrec(AztecOO &Solver, int &precUpdate);
 
-void setIFPACKPrec(AztecOO &Solver);
+void destroyPreconditioner();
 
 void checkDiagonalIsZero();
 
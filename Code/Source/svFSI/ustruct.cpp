@@ -43,7 +43,7 @@ namespace ustruct {
 
 void b_ustruct_2d(const ComMod& com_mod, const int eNoN, const double w, const Vector<double>& N, 
     const Array<double>& Nx, const Array<double>& dl, const Vector<double>& hl, const Vector<double>& nV, 
-    Array<double>& lR, Array3<double>& lK, Array3<double>& lKd)
+    Array<double>& lR, Array3<double>& lK, Array3<double>& lKd, ElementWorkspace& ws)
 {
   int cEq = com_mod.cEq;
   auto& eq = com_mod.eq[cEq];
@@ -54,10 +54,11 @@ void b_ustruct_2d(const ComMod& com_mod, const int eNoN, const double w, const V
   int i = eq.s;
   int j = i + 1;
 
-  Vector<double> nFi(2);  
-  Array<double> NxFi(2,eNoN);
+  ElementWorkspace::Scope scope(ws);
+  auto nFi = ws.vector(2);
+  auto NxFi = ws.array(2,eNoN);
 
-  Array<double> F(2,2); 
+  auto F = ws.array(2,2);
   F(0,0) = 1.0;
   F(1,1) = 1.0;
 
@@ -72,7 +73,8 @@ void b_ustruct_2d(const ComMod& com_mod, const int eNoN, const double w, const V
   }
 
   double Jac = F(0,0)*F(1,1) - F(0,1)*F(1,0);
-  auto Fi = mat_fun::mat_inv(F, 2);
+  auto Fi = ws.array(2,2);
+  mat_fun::mat_inv(F, 2, Fi);
 
   for (int a = 0; a  < eNoN; a++) {
     NxFi(0,a) = Nx(0,a)*Fi(0,0) + Nx(1,a)*Fi(1,0);
@@ -112,7 +114,7 @@ void b_ustruct_2d(const ComMod& com_mod, const int eNoN, const double w, const V
 /// @param lKd Local stiffness matrix (displacement)
 void b_ustruct_3d(const ComMod& com_mod, const int eNoN, const double w, const Vector<double>& N, 
     const Array<double>& Nx, const Array<double>& dl, const Vector<double>& hl, const Vector<double>& nV, 
-    Array<double>& lR, Array3<double>& lK, Array3<double>& lKd)
+    Array<double>& lR, Array3<double>& lK, Array3<double>& lKd, ElementWorkspace& ws)
 {
   int cEq = com_mod.cEq;
   auto& eq = com_mod.eq[cEq];
@@ -124,10 +126,11 @@ void b_ustruct_3d(const ComMod& com_mod, const int eNoN, const double w, const V
   int j = i + 1;
   int k = j + 1;
 
-  Vector<double> nFi(3);  
-  Array<double> NxFi(3,eNoN);
+  ElementWorkspace::Scope scope(ws);
+  auto nFi = ws.vector(3);
+  auto NxFi = ws.array(3,eNoN);
 
-  Array<double> F(3,3); 
+  auto F = ws.array(3,3);
   F(0,0) = 1.0;
   F(1,1) = 1.0;
   F(2,2) = 1.0;
@@ -148,7 +151,8 @@ void b_ustruct_3d(const ComMod& com_mod, const int eNoN, const double w, const V
   }
 
   double Jac = mat_fun::mat_det(F, 3);
-  auto Fi = mat_fun::mat_inv(F, 3);
+  auto Fi = ws.array(3,3);
+  mat_fun::mat_inv(F, 3, Fi);
 
   for (int a = 0; a  < eNoN; a++) {
     NxFi(0,a) = Nx(0,a)*Fi(0,0) + Nx(1,a)*Fi(1,0) + Nx(2,a)*Fi(2,0);
@@ -239,6 +243,11 @@ void construct_usolid(ComMod& com_mod, CepMod& cep_mod, const mshType& lM, const
   dmsg << "vmsStab: " << vmsStab;
   #endif
 
+  // Velocity and pressure function spaces, built once at initialization
+  //
+  const auto& fs_1 = fs::thood_fs(lM, vmsStab, 1);
+  const auto& fs_2 = fs::thood_fs(lM, vmsStab, 2);
+
   // USTRUCT: dof = nsd+1
   Vector<int> ptr(eNoN);
   Vector<double> pSl(nsymd), ya_l(eNoN), N(eNoN);
@@ -246,6 +255,8 @@ void construct_usolid(ComMod& com_mod, CepMod& cep_mod, const mshType& lM, const
                 bfl(nsd,eNoN), fN(nsd,nFn), pS0l(nsymd,eNoN), Nx(nsd,eNoN), lR(dof,eNoN);
   Array3<double> lK(dof*dof,eNoN,eNoN), lKd(dof*nsd,eNoN,eNoN);
 
+  auto& ws = com_mod.elem_workspace[0];
+
   for (int e = 0; e < lM.nEl; e++) {
     // Update domain and proceed if domain phys and eqn phys match
     cDmn = all_fun::domain(com_mod, lM, cEq, e);
@@ -254,6 +265,8 @@ void construct_usolid(ComMod& com_mod, CepMod& cep_mod, const mshType& lM, const
       continue;
     }
 
+    ws.reset();
+
     // Create local copies
     fN  = 0.0;
     ya_l = 0.0;
@@ -290,21 +303,17 @@ void construct_usolid(ComMod& com_mod, CepMod& cep_mod, const mshType& lM, const
     lR = 0.0;
     lK = 0.0;
     lKd = 0.0;
-    std::array<fsType,2> fs;
-
-    // Set function spaces for velocity and pressure.
-    fs::get_thood_fs(com_mod, fs, lM, vmsStab, 1);
 
     // Define element coordinates appropriate for function spaces
-    Array<double> xwl(nsd,fs[0].eNoN);
-    Array<double> Nwx(nsd,fs[0].eNoN);
-    Array<double> xql(nsd,fs[1].eNoN);
-    Array<double> Nqx(nsd,fs[1].eNoN);
+    auto xwl = ws.array(nsd,fs_1[0].eNoN);
+    auto Nwx = ws.array(nsd,fs_1[0].eNoN);
+    auto xql = ws.array(nsd,fs_1[1].eNoN);
+    auto Nqx = ws.array(nsd,fs_1[1].eNoN);
 
     xwl = xl;
 
     for (int i = 0; i < nsd; i++) {
-      for (int j = 0; j < fs[1].eNoN; j++) {
+      for (int j = 0; j < fs_1[1].eNoN; j++) {
         xql(i,j) = xl(i,j);
       }
     }
@@ -312,70 +321,67 @@ void construct_usolid(ComMod& com_mod, CepMod& cep_mod, const mshType& lM, const
     // Gauss integration 1
     //
     double Jac{0.0};
-    Array<double> ksix(nsd,nsd);
+    auto ksix = ws.array(nsd,nsd);
 
-    for (int g = 0; g < fs[0].nG; g++) {
-      if (g == 0 || !fs[0].lShpF) {
-        auto Nx = fs[0].Nx.slice(g);
-        nn::gnn(fs[0].eNoN, nsd, nsd, Nx, xwl, Nwx, Jac, ksix);
+    for (int g = 0; g < fs_1[0].nG; g++) {
+      if (g == 0 || !fs_1[0].lShpF) {
+        auto Nx = fs_1[0].Nx.rslice(g);
+        nn::gnn(fs_1[0].eNoN, nsd, nsd, Nx, xwl, Nwx, Jac, ksix);
         if (utils::is_zero(Jac)) {
            throw std::runtime_error("[construct_usolid] Jacobian for element " + std::to_string(e) + " is < 0.");
         }
       }
 
-      double w = fs[0].w(g) * Jac;
+      double w = fs_1[0].w(g) * Jac;
 
       if (nsd == 3) {
-        auto N0 = fs[0].N.col(g);
-        auto N1 = fs[1].N.col(g);
-        ustruct_3d_m(com_mod, cep_mod, vmsStab, fs[0].eNoN, fs[1].eNoN, nFn, w, Jac, N0, N1, Nwx, al, yl, dl, bfl, fN, ya_l, lR, lK, lKd);
+        auto N0 = fs_1[0].N.rcol(g);
+        auto N1 = fs_1[1].N.rcol(g);
+        ustruct_3d_m(com_mod, cep_mod, vmsStab, fs_1[0].eNoN, fs_1[1].eNoN, nFn, w, Jac, N0, N1, Nwx, al, yl, dl, bfl, fN, ya_l, lR, lK, lKd, ws);
 
       } else if (nsd == 2) {
-        auto N0 = fs[0].N.col(g);
-        auto N1 = fs[1].N.col(g);
-        ustruct_2d_m(com_mod, cep_mod, vmsStab, fs[0].eNoN, fs[1].eNoN, nFn, w, Jac, N0, N1, Nwx, al, yl, dl, bfl, fN, ya_l, lR, lK, lKd);
+        auto N0 = fs_1[0].N.rcol(g);
+        auto N1 = fs_1[1].N.rcol(g);
+        ustruct_2d_m(com_mod, cep_mod, vmsStab, fs_1[0].eNoN, fs_1[1].eNoN, nFn, w, Jac, N0, N1, Nwx, al, yl, dl, bfl, fN, ya_l, lR, lK, lKd, ws);
       }
 
-    } // for g = 0 to fs[0].nG
-
-    // Set function spaces for velocity/displacement and pressure.
-    fs::get_thood_fs(com_mod, fs, lM, vmsStab, 2);
+    } // for g = 0 to fs_1[0].nG
 
     // Gauss integration 2
     //
-    for (int g = 0; g < fs[1].nG; g++) {
-      if (g == 0 || !fs[0].lShpF) {
-        auto Nx = fs[0].Nx.slice(g);
-        nn::gnn(fs[0].eNoN, nsd, nsd, Nx, xwl, Nwx, Jac, ksix);
+    for (int g = 0; g < fs_2[1].nG; g++) {
+      if (g == 0 || !fs_2[0].lShpF) {
+        auto Nx = fs_2[0].Nx.rslice(g);
+        nn::gnn(fs_2[0].eNoN, nsd, nsd, Nx, xwl, Nwx, Jac, ksix);
         if (utils::is_zero(Jac)) {
            throw std::runtime_error("[construct_usolid] Jacobian for element " + std::to_string(e) + " is < 0.");
         }
       }
 
-      if (g == 0 || !fs[1].lShpF) {
-        auto Nx = fs[1].Nx.slice(g);
-        nn::gnn(fs[1].eNoN, nsd, nsd, Nx, xql, Nqx, Jac, ksix);
+      if (g == 0 || !fs_2[1].lShpF) {
+        auto Nx = fs_2[1].Nx.rslice(g);
+        nn::gnn(fs_2[1].eNoN, nsd, nsd, Nx, xql, Nqx, Jac, ksix);
         if (utils::is_zero(Jac)) {
            throw std::runtime_error("[construct_usolid] Jacobian for element " + std::to_string(e) + " is < 0.");
         }
       }
 
-      double w = fs[1].w(g) * Jac;
+      double w = fs_2[1].w(g) * Jac;
 
       if (nsd == 3) {
-        auto N0 = fs[0].N.col(g);
-        auto N1 = fs[1].N.col(g);
-        ustruct_3d_c(com_mod, cep_mod, vmsStab, fs[0].eNoN, fs[1].eNoN, w, Jac, N0, N1, Nwx, 
-            Nqx, al, yl, dl, bfl, ksix, lR, lK, lKd);
+        auto N0 = fs_2[0].N.rcol(g);
+        auto N1 = fs_2[1].N.rcol(g);
+        ustruct_3d_c(com_mod, cep_mod, vmsStab, fs_2[0].eNoN, fs_2[1].eNoN, w, Jac, N0, N1, Nwx, 
+            Nqx, al, yl, dl, bfl, ksix, lR, lK, lKd, ws);
 
       } else if (nsd == 2) {
-        auto N0 = fs[0].N.col(g);
-        auto N1 = fs[1].N.col(g);
-        ustruct_2d_c(com_mod, cep_mod, vmsStab, fs[0].eNoN, fs[1].eNoN, w, Jac, N0, N1, Nwx, 
-            Nqx, al, yl, dl, bfl, ksix, lR, lK, lKd);
+        auto N0 = fs_2[0].N.rcol(g);
+        auto N1 = fs_2[1].N.rcol(g);
+        ustruct_2d_c(com_mod, cep_mod, vmsStab, fs_2[0].eNoN, fs_2[1].eNoN, w, Jac, N0, N1, Nwx, 
+            Nqx, al, yl, dl, bfl, ksix, lR, lK, lKd, ws);
       }
 
-    } // for g = 0 to fs[1].nG
+    } // for g = 0 to fs_2[1].nG
 
     ustruct_do_assem(com_mod, eNoN, ptr, lKd, lK, lR);
 
@@ -410,11 +416,13 @@ void ustruct_2d_c(ComMod& com_mod, CepMod& cep_mod, const bool vmsFlag, const in
     const double w, const double Je, const Vector<double>& Nw,  const Vector<double>& Nq,
     const Array<double>& Nwx, const Array<double>& Nqx, const Array<double>& al, const Array<double>& yl, 
     const Array<double>& dl, const Array<double>& bfl, const Array<double>& Kxi, Array<double>& lR, Array3<double>& lK, 
-    Array3<double>& lKd)
+    Array3<double>& lKd, ElementWorkspace& ws)
 {
   using namespace consts;
   using namespace mat_fun;
 
+  ElementWorkspace::Scope scope(ws);
+
   #define n_debug_ustruct_2d_c
   #ifdef debug_ustruct_2d_c
   DebugMsg dmsg(__func__, com_mod.cm.idcm());
@@ -434,10 +442,9 @@ void ustruct_2d_c(ComMod& com_mod, CepMod& cep_mod, const bool vmsFlag, const in
   double ctV = 36.0;
   double mu = dmn.prop[PhysicalProperyType::solid_viscosity];
 
-  Vector<double> fb(2);
+  auto fb = ws.vector(2);
   fb[0] = dmn.prop[PhysicalProperyType::f_x];
   fb[1] = dmn.prop[PhysicalProperyType::f_y];
-  fb[2] = dmn.prop[PhysicalProperyType::f_z];
 
   double am = eq.am;
   double af = eq.af * eq.gam * dt;
@@ -458,9 +465,12 @@ void ustruct_2d_c(ComMod& com_mod, CepMod& cep_mod, const bool vmsFlag, const in
   // Inertia (velocity and acceleration), body force, fiber directions,
   // and deformation tensor (F) at integration point
   //
-  Vector<double> vd{-fb[0], -fb[1]};
-  Vector<double> v(2);
-  Array<double> vx(2,2), F(2,2);
+  auto vd = ws.vector(2);
+  vd(0) = -fb[0];
+  vd(1) = -fb[1];
+  auto v = ws.vector(2);
+  auto vx = ws.array(2,2);
+  auto F = ws.array(2,2);
   F(0,0) = 1.0;
   F(1,1) = 1.0;
 
@@ -483,13 +493,14 @@ void ustruct_2d_c(ComMod& com_mod, CepMod& cep_mod, const bool vmsFlag, const in
   }
 
   double Jac = mat_fun::mat_det(F, 2);
-  auto Fi = mat_fun::mat_inv(F, 2);
+  auto Fi = ws.array(2,2);
+  mat_fun::mat_inv(F, 2, Fi);
 
   // Pressure and its gradients 
   //
   double p = 0.0;
   double pd = 0.0;
-  Vector<double> px(2);
+  auto px = ws.vector(2);
 
   for (int a = 0; a < eNoNq; a++) {
     p = p + Nq(a)*yl(k,a);
@@ -509,14 +520,17 @@ void ustruct_2d_c(ComMod& com_mod, CepMod& cep_mod, const bool vmsFlag, const in
   //
   double tauM = 0.0;
   double tauC = 0.0;
-  Array<double> Kx(2,2); 
+  auto Kx = ws.array(2,2); 
 
   if (vmsFlag) {
     mat_models::get_tau(com_mod, eq.dmn[cDmn], Jac, Je, tauM, tauC);
 
     // Stabilization parameter for solid viscosity
-    Kx = mat_mul(Kxi, Fi);
-    Kx = mat_mul(transpose(Fi), Kx);
+    auto KxiFi = ws.array(2,2);
+    auto FiT = ws.array(2,2);
+    mat_mul(Kxi, Fi, KxiFi);
+    transpose(Fi, FiT);
+    mat_mul(FiT, KxiFi, Kx);
 
     double tauV = Kx(0,0)*Kx(0,0) + Kx(1,0)*Kx(1,0) + 
                   Kx(0,1)*Kx(0,1) + Kx(1,1)*Kx(1,1);
@@ -529,48 +543,48 @@ void ustruct_2d_c(ComMod& com_mod, CepMod& cep_mod, const bool vmsFlag, const in
     tauC = 0.0;
   }
 
-  Array<double> NwxFi(2,eNoNw);
+  auto NwxFi = ws.array(2,eNoNw);
 
   for (int a = 0; a < eNoNw; a++) {
     NwxFi(0,a) = Nwx(0,a)*Fi(0,0) + Nwx(1,a)*Fi(1,0);
     NwxFi(1,a) = Nwx(0,a)*Fi(0,1) + Nwx(1,a)*Fi(1,1);
   }
 
-  Array<double> NqxFi(2,eNoNw);
+  auto NqxFi = ws.array(2,eNoNw);
 
   for (int a = 0; a < eNoNq; a++) {
     NqxFi(0,a) = Nqx(0,a)*Fi(0,0) + Nqx(1,a)*Fi(1,0);
     NqxFi(1,a) = Nqx(0,a)*Fi(0,1) + Nqx(1,a)*Fi(1,1);
   }
 
-  Array<double> VxFi(2,2);
+  auto VxFi = ws.array(2,2);
 
   VxFi(0,0) = vx(0,0)*Fi(0,0) + vx(0,1)*Fi(1,0);
   VxFi(0,1) = vx(0,0)*Fi(0,1) + vx(0,1)*Fi(1,1);
   VxFi(1,0) = vx(1,0)*Fi(0,0) + vx(1,1)*Fi(1,0);
   VxFi(1,1) = vx(1,0)*Fi(0,1) + vx(1,1)*Fi(1,1);
 
-  Vector<double> PxFi(2);
+  auto PxFi = ws.vector(2);
   PxFi(0) = px(0)*Fi(0,0) + px(1)*Fi(1,0);
   PxFi(1) = px(0)*Fi(0,1) + px(1)*Fi(1,1);
 
   double rC  = beta*pd + VxFi(0,0) + VxFi(1,1);
 
-  Vector<double> rM(2);
+  auto rM = ws.vector(2);
   rM(0) = rho*vd(0) + PxFi(0);
   rM(1) = rho*vd(1) + PxFi(1);
 
   // Local residual
   //
-  Vector<double> rMNqx(eNoNq);
+  auto rMNqx = ws.vector(eNoNq);
 
   for (int a = 0; a < eNoNq; a++) {
     rMNqx(a) = rM(0)*NqxFi(0,a) + rM(1)*NqxFi(1,a);
     lR(2,a) = lR(2,a) + w*Jac*(Nq(a)*rC + tauM*rMNqx(a));
   }
 
-  Vector<double> rMNwx(eNoNw);
-  Array<double> VxNwx(3,eNoNw);
+  auto rMNwx = ws.vector(eNoNw);
+  auto VxNwx = ws.array(3,eNoNw);
 
   for (int a = 0; a < eNoNw; a++) {
     rMNwx(a) = rM(0)*NwxFi(0,a) + rM(1)*NwxFi(1,a);
@@ -627,11 +641,13 @@ void ustruct_3d_c(ComMod& com_mod, CepMod& cep_mod, const bool vmsFlag, const in
     const double w, const double Je, const Vector<double>& Nw,  const Vector<double>& Nq,
     const Array<double>& Nwx, const Array<double>& Nqx, const Array<double>& al, const Array<double>& yl, 
     const Array<double>& dl, const Array<double>& bfl, const Array<double>& Kxi, Array<double>& lR, Array3<double>& lK, 
-    Array3<double>& lKd)
+    Array3<double>& lKd, ElementWorkspace& ws)
 {
   using namespace consts;
   using namespace mat_fun;
 
+  ElementWorkspace::Scope scope(ws);
+
   #define n_debug_ustruct_3d_c
   #ifdef debug_ustruct_3d_c
   DebugMsg dmsg(__func__, com_mod.cm.idcm());
@@ -651,7 +667,7 @@ void ustruct_3d_c(ComMod& com_mod, CepMod& cep_mod, const bool vmsFlag, const in
   double ctV = 36.0;
   double mu = dmn.prop[PhysicalProperyType::solid_viscosity];
 
-  Vector<double> fb(3);
+  auto fb = ws.vector(3);
   fb[0] = dmn.prop[PhysicalProperyType::f_x];
   fb[1] = dmn.prop[PhysicalProperyType::f_y];
   fb[2] = dmn.prop[PhysicalProperyType::f_z];
@@ -676,9 +692,13 @@ void ustruct_3d_c(ComMod& com_mod, CepMod& cep_mod, const bool vmsFlag, const in
   // Inertia (velocity and acceleration), body force, fiber directions,
   // and deformation tensor (F) at integration point
   //
-  Vector<double> vd{-fb[0], -fb[1], -fb[2]};
-  Vector<double> v(3);
-  Array<double> vx(3,3), F(3,3);
+  auto vd = ws.vector(3);
+  vd(0) = -fb[0];
+  vd(1) = -fb[1];
+  vd(2) = -fb[2];
+  auto v = ws.vector(3);
+  auto vx = ws.array(3,3);
+  auto F = ws.array(3,3);
   F(0,0) = 1.0;
   F(1,1) = 1.0;
   F(2,2) = 1.0;
@@ -718,13 +738,14 @@ void ustruct_3d_c(ComMod& com_mod, CepMod& cep_mod, const bool vmsFlag, const in
   }
 
   double Jac = mat_fun::mat_det(F, 3);
-  auto Fi = mat_fun::mat_inv(F, 3);
+  auto Fi = ws.array(3,3);
+  mat_fun::mat_inv(F, 3, Fi);
 
   // Pressure and its gradients 
   //
   double p = 0.0;
   double pd = 0.0;
-  Vector<double> px(3);
+  auto px = ws.vector(3);
 
   for (int a = 0; a < eNoNq; a++) {
     p = p + Nq(a)*yl(l,a);
@@ -745,14 +766,17 @@ void ustruct_3d_c(ComMod& com_mod, CepMod& cep_mod, const bool vmsFlag, const in
   //
   double tauM = 0.0;
   double tauC = 0.0;
-  Array<double> Kx(3,3); 
+  auto Kx = ws.array(3,3); 
 
   if (vmsFlag) {
     mat_models::get_tau(com_mod, eq.dmn[cDmn], Jac, Je, tauM, tauC);
 
     // Stabilization parameter for solid viscosity
-    Kx = mat_mul(Kxi, Fi);
-    Kx = mat_mul(transpose(Fi), Kx);
+    auto KxiFi = ws.array(3,3);
+    auto FiT = ws.array(3,3);
+    mat_mul(Kxi, Fi, KxiFi);
+    transpose(Fi, FiT);
+    mat_mul(FiT, KxiFi, Kx);
 
     double tauV = Kx(0,0)*Kx(0,0) + Kx(1,0)*Kx(1,0) + Kx(2,0)*Kx(2,0) + 
                   Kx(0,1)*Kx(0,1) + Kx(1,1)*Kx(1,1) + Kx(2,1)*Kx(2,1) + 
@@ -766,7 +790,7 @@ void ustruct_3d_c(ComMod& com_mod, CepMod& cep_mod, const bool vmsFlag, const in
     tauC = 0.0;
   }
 
-  Array<double> NwxFi(3,eNoNw);
+  auto NwxFi = ws.array(3,eNoNw);
 
   for (int a = 0; a < eNoNw; a++) {
     NwxFi(0,a) = Nwx(0,a)*Fi(0,0) + Nwx(1,a)*Fi(1,0) + Nwx(2,a)*Fi(2,0);
@@ -774,7 +798,7 @@ void ustruct_3d_c(ComMod& com_mod, CepMod& cep_mod, const bool vmsFlag, const in
     NwxFi(2,a) = Nwx(0,a)*Fi(0,2) + Nwx(1,a)*Fi(1,2) + Nwx(2,a)*Fi(2,2);
   }
 
-  Array<double> NqxFi(3,eNoNw);
+  auto NqxFi = ws.array(3,eNoNw);
 
   for (int a = 0; a < eNoNq; a++) {
     NqxFi(0,a) = Nqx(0,a)*Fi(0,0) + Nqx(1,a)*Fi(1,0) + Nqx(2,a)*Fi(2,0);
@@ -782,7 +806,7 @@ void ustruct_3d_c(ComMod& com_mod, CepMod& cep_mod, const bool vmsFlag, const in
     NqxFi(2,a) = Nqx(0,a)*Fi(0,2) + Nqx(1,a)*Fi(1,2) + Nqx(2,a)*Fi(2,2);
   }
 
-  Array<double> VxFi(3,3);
+  auto VxFi = ws.array(3,3);
 
   VxFi(0,0) = vx(0,0)*Fi(0,0) + vx(0,1)*Fi(1,0) + vx(0,2)*Fi(2,0);
   VxFi(0,1) = vx(0,0)*Fi(0,1) + vx(0,1)*Fi(1,1) + vx(0,2)*Fi(2,1);
@@ -796,29 +820,29 @@ void ustruct_3d_c(ComMod& com_mod, CepMod& cep_mod, const bool vmsFlag, const in
   VxFi(2,1) = vx(2,0)*Fi(0,1) + vx(2,1)*Fi(1,1) + vx(2,2)*Fi(2,1);
   VxFi(2,2) = vx(2,0)*Fi(0,2) + vx(2,1)*Fi(1,2) + vx(2,2)*Fi(2,2);
 
-  Vector<double> PxFi(3);
+  auto PxFi = ws.vector(3);
   PxFi(0) = px(0)*Fi(0,0) + px(1)*Fi(1,0) + px(2)*Fi(2,0);
   PxFi(1) = px(0)*Fi(0,1) + px(1)*Fi(1,1) + px(2)*Fi(2,1);
   PxFi(2) = px(0)*Fi(0,2) + px(1)*Fi(1,2) + px(2)*Fi(2,2);
 
   double rC  = beta*pd + VxFi(0,0) + VxFi(1,1) + VxFi(2,2);
 
-  Vector<double> rM(3);
+  auto rM = ws.vector(3);
   rM(0) = rho*vd(0) + PxFi(0);
   rM(1) = rho*vd(1) + PxFi(1);
   rM(2) = rho*vd(2) + PxFi(2);
 
   // Local residual
   //
-  Vector<double> rMNqx(eNoNq);
+  auto rMNqx = ws.vector(eNoNq);
 
   for (int a = 0; a < eNoNq; a++) {
     rMNqx(a) = rM(0)*NqxFi(0,a) + rM(1)*NqxFi(1,a) + rM(2)*NqxFi(2,a);
     lR(3,a) = lR(3,a) + w*Jac*(Nq(a)*rC + tauM*rMNqx(a));
   }
 
-  Vector<double> rMNwx(eNoNw);
-  Array<double> VxNwx(3,eNoNw);
+  auto rMNwx = ws.vector(eNoNw);
+  auto VxNwx = ws.array(3,eNoNw);
 
   for (int a = 0; a < eNoNw; a++) {
     rMNwx(a) = rM(0)*NwxFi(0,a) + rM(1)*NwxFi(1,a) + rM(2)*NwxFi(2,a);
@@ -887,11 +911,13 @@ void ustruct_2d_m(ComMod& com_mod, CepMod& cep_mod, const bool vmsFlag, const in
     const int nFn, const double w, const double Je, const Vector<double>& Nw,  const Vector<double>& Nq, 
     const Array<double>& Nwx, const Array<double>& al, const Array<double>& yl, const Array<double>& dl, 
     const Array<double>& bfl, const Array<double>& fN, const Vector<double>& ya_l, Array<double>& lR, 
-    Array3<double>& lK, Array3<double>& lKd)
+    Array3<double>& lK, Array3<double>& lKd, ElementWorkspace& ws)
 {
   using namespace consts;
   using namespace mat_fun;
 
+  ElementWorkspace::Scope scope(ws);
+
   #define n_debug_ustruct_2d_m
   #ifdef debug_ustruct_2d_m
   DebugMsg dmsg(__func__, com_mod.cm.idcm());
@@ -909,7 +935,7 @@ void ustruct_2d_m(ComMod& com_mod, CepMod& cep_mod, const bool vmsFlag, const in
 
   // Define parameters
   //
-  Vector<double> fb(2);
+  auto fb = ws.vector(2);
   fb[0] = dmn.prop[PhysicalProperyType::f_x];
   fb[1] = dmn.prop[PhysicalProperyType::f_y];
 
@@ -933,9 +959,12 @@ void ustruct_2d_m(ComMod& com_mod, CepMod& cep_mod, const bool vmsFlag, const in
   // Inertia (velocity and acceleration), body force, fiber directions,
   // and deformation tensor (F) at integration point
   //
-  Vector<double> vd{-fb[0], -fb[1]};
-  Vector<double> v(2);
-  Array<double> vx(2,2), F(2,2);
+  auto vd = ws.vector(2);
+  vd(0) = -fb[0];
+  vd(1) = -fb[1];
+  auto v = ws.vector(2);
+  auto vx = ws.array(2,2);
+  auto F = ws.array(2,2);
   double ya_g = 0.0;
   F(0,0) = 1.0;
   F(1,1) = 1.0;
@@ -961,7 +990,8 @@ void ustruct_2d_m(ComMod& com_mod, CepMod& cep_mod, const bool vmsFlag, const in
   }
 
   double Jac = mat_fun::mat_det(F, 2);
-  auto Fi = mat_fun::mat_inv(F, 2);
+  auto Fi = ws.array(2,2);
+  mat_fun::mat_inv(F, 2, Fi);
 
   // Pressure and its time derivative
   //
@@ -975,20 +1005,30 @@ void ustruct_2d_m(ComMod& com_mod, CepMod& cep_mod, const bool vmsFlag, const in
 
   // Compute deviatoric 2nd Piola-Kirchhoff stress tensor (Siso) and
   // isochoric elasticity tensor in Voigt notation (Dm)
-  Array<double> Siso(2,2), Dm(3,3);
+  auto Siso = ws.array(2,2);
+  auto Dm = ws.array(3,3);
   double Ja = 0;
-  mat_models::get_pk2cc_dev(com_mod, cep_mod, eq.dmn[cDmn], F, nFn, fN, ya_g, Siso, Dm, Ja);
+  mat_models::get_pk2cc_dev(com_mod, cep_mod, eq.dmn[cDmn], F, nFn, fN, ya_g, Siso, Dm, Ja, ws);
 
   // Viscous contribution
   // Velocity gradient in current configuration
-  auto VxFi = mat_mul(vx, Fi);
+  auto VxFi = ws.array(2,2);
+  mat_mul(vx, Fi, VxFi);
 
   // Deviatoric strain tensor
-  auto ddev = mat_dev(mat_symm(VxFi,2), 2);
+  auto dsym = ws.array(2,2);
+  auto ddev = ws.array(2,2);
+  mat_symm(VxFi, 2, dsym);
+  mat_dev(dsym, 2, ddev);
 
   // 2nd Piola-Kirchhoff stress due to viscosity
-  auto Svis = mat_mul(ddev, transpose(Fi));
-  Svis = 2.0*mu*Jac*mat_mul(Fi, Svis);
+  auto FiT = ws.array(2,2);
+  auto DdFiT = ws.array(2,2);
+  auto Svis = ws.array(2,2);
+  transpose(Fi, FiT);
+  mat_mul(ddev, FiT, DdFiT);
+  mat_mul(Fi, DdFiT, Svis);
+  Svis *= 2.0 * mu * Jac;
 
   // Compute rho and beta depending on the volumetric penalty model
   //
@@ -1010,23 +1050,24 @@ void ustruct_2d_m(ComMod& com_mod, CepMod& cep_mod, const bool vmsFlag, const in
   }
 
   // Total isochoric 2nd Piola-Kirchhoff stress
-  Siso = Siso + Svis;
+  Siso += Svis;
 
   // Deviatoric 1st Piola-Kirchhoff tensor (P)
   //
-  auto Pdev = mat_fun::mat_mul(F, Siso);
+  auto Pdev = ws.array(2,2);
+  mat_fun::mat_mul(F, Siso, Pdev);
 
 
   // Shape function gradients in the current configuration
   //
-  Array<double> NxFi(2,eNoNw);
+  auto NxFi = ws.array(2,eNoNw);
 
   for (int a = 0; a < eNoNw; a++) {
     NxFi(0,a) = Nwx(0,a)*Fi(0,0) + Nwx(1,a)*Fi(1,0);
     NxFi(1,a) = Nwx(0,a)*Fi(0,1) + Nwx(1,a)*Fi(1,1);
   }
 
-  double rC  = beta*pd + VxFi(1,1) + VxFi(2,2);
+  double rC  = beta*pd + VxFi(0,0) + VxFi(1,1);
   double rCl = -p + tauC*rC;
 
   // Local residual
@@ -1045,7 +1086,7 @@ void ustruct_2d_m(ComMod& com_mod, CepMod& cep_mod, const bool vmsFlag, const in
 
   // Auxilary quantities for computing stiffness tensors
   //
-  Array3<double> Bm(3,2,eNoNw);
+  auto Bm = ws.array3(3,2,eNoNw);
 
   for (int a = 0; a < eNoNw; a++) {
     Bm(0,0,a) = Nwx(0,a)*F(0,0);
@@ -1054,11 +1095,12 @@ void ustruct_2d_m(ComMod& com_mod, CepMod& cep_mod, const bool vmsFlag, const in
     Bm(1,0,a) = Nwx(1,a)*F(0,1);
     Bm(1,1,a) = Nwx(1,a)*F(1,1);
 
-    Bm(2,0,a) = Nwx(2,a)*F(0,2) + F(0,0)*Nwx(1,a);
-    Bm(2,1,a) = Nwx(2,a)*F(1,2) + F(1,0)*Nwx(1,a);
+    Bm(2,0,a) = Nwx(0,a)*F(0,1) + F(0,0)*Nwx(1,a);
+    Bm(2,1,a) = Nwx(0,a)*F(1,1) + F(1,0)*Nwx(1,a);
   }
 
-  Array<double> VxNx(2,eNoNw), DdNx(2,eNoNw);
+  auto VxNx = ws.array(2,eNoNw);
+  auto DdNx = ws.array(2,eNoNw);
 
   for (int a = 0; a < eNoNw; a++) {
     DdNx(0,a) = ddev(0,0)*NxFi(0,a) + ddev(0,1)*NxFi(1,a);
@@ -1074,7 +1116,7 @@ void ustruct_2d_m(ComMod& com_mod, CepMod& cep_mod, const bool vmsFlag, const in
       T1{0.0}, T2{0.0}, T3{0.0},
       Tv{0.0}, Ku{0.0};
 
-  Array<double> DBm(3,2);
+  auto DBm = ws.array(3,2);
 
   for (int b = 0; b < eNoNw; b++) {
     for (int a = 0; a < eNoNw; a++) {
@@ -1188,11 +1230,13 @@ void ustruct_3d_m(ComMod& com_mod, CepMod& cep_mod, const bool vmsFlag, const in
     const int nFn, const double w, const double Je, const Vector<double>& Nw,  const Vector<double>& Nq, 
     const Array<double>& Nwx, const Array<double>& al, const Array<double>& yl, const Array<double>& dl, 
     const Array<double>& bfl, const Array<double>& fN, const Vector<double>& ya_l, Array<double>& lR, 
-    Array3<double>& lK, Array3<double>& lKd)
+    Array3<double>& lK, Array3<double>& lKd, ElementWorkspace& ws)
 {
   using namespace consts;
   using namespace mat_fun;
 
+  ElementWorkspace::Scope scope(ws);
+
   #define n_debug_ustruct_3d_m
   #ifdef debug_ustruct_3d_m
   DebugMsg dmsg(__func__, com_mod.cm.idcm());
@@ -1212,7 +1256,7 @@ void ustruct_3d_m(ComMod& com_mod, CepMod& cep_mod, const bool vmsFlag, const in
   //
   double mu = dmn.prop[PhysicalProperyType::solid_viscosity];
 
-  Vector<double> fb(3);
+  auto fb = ws.vector(3);
   fb[0] = dmn.prop[PhysicalProperyType::f_x];
   fb[1] = dmn.prop[PhysicalProperyType::f_y];
   fb[2] = dmn.prop[PhysicalProperyType::f_z];
@@ -1238,9 +1282,13 @@ void ustruct_3d_m(ComMod& com_mod, CepMod& cep_mod, const bool vmsFlag, const in
   // Inertia (velocity and acceleration), body force, fiber directions,
   // and deformation tensor (F) at integration point
   //
-  Vector<double> vd{-fb[0], -fb[1], -fb[2]};
-  Vector<double> v(3);
-  Array<double> vx(3,3), F(3,3);
+  auto vd = ws.vector(3);
+  vd(0) = -fb[0];
+  vd(1) = -fb[1];
+  vd(2) = -fb[2];
+  auto v = ws.vector(3);
+  auto vx = ws.array(3,3);
+  auto F = ws.array(3,3);
   double ya_g = 0.0;
   F(0,0) = 1.0;
   F(1,1) = 1.0;
@@ -1283,7 +1331,8 @@ void ustruct_3d_m(ComMod& com_mod, CepMod& cep_mod, const bool vmsFlag, const in
   }
 
   double Jac = mat_fun::mat_det(F, 3);
-  auto Fi = mat_fun::mat_inv(F, 3);
+  auto Fi = ws.array(3,3);
+  mat_fun::mat_inv(F, 3, Fi);
 
   // Pressure and its time derivative
   //
@@ -1298,21 +1347,31 @@ void ustruct_3d_m(ComMod& com_mod, CepMod& cep_mod, const bool vmsFlag, const in
   // Compute deviatoric 2nd Piola-Kirchhoff stress tensor (Siso) and
   // isochoric elasticity tensor in Voigt notation (Dm)
   //
-  Array<double> Siso(3,3), Dm(6,6);
+  auto Siso = ws.array(3,3);
+  auto Dm = ws.array(6,6);
   double Ja = 0;
-  mat_models::get_pk2cc_dev(com_mod, cep_mod, eq.dmn[cDmn], F, nFn, fN, ya_g, Siso, Dm, Ja);
+  mat_models::get_pk2cc_dev(com_mod, cep_mod, eq.dmn[cDmn], F, nFn, fN, ya_g, Siso, Dm, Ja, ws);
 
   // Viscous contribution
   //
   // Velocity gradient in current configuration
-  auto VxFi = mat_mul(vx, Fi);
+  auto VxFi = ws.array(3,3);
+  mat_mul(vx, Fi, VxFi);
 
   // Deviatoric strain tensor
-  auto ddev = mat_dev(mat_symm(VxFi,3), 3);
+  auto dsym = ws.array(3,3);
+  auto ddev = ws.array(3,3);
+  mat_symm(VxFi, 3, dsym);
+  mat_dev(dsym, 3, ddev);
 
   // 2nd Piola-Kirchhoff stress due to viscosity
-  auto Svis = mat_mul(ddev, transpose(Fi));
-  Svis = 2.0 * mu * Jac * mat_mul(Fi, Svis);
+  auto FiT = ws.array(3,3);
+  auto DdFiT = ws.array(3,3);
+  auto Svis = ws.array(3,3);
+  transpose(Fi, FiT);
+  mat_mul(ddev, FiT, DdFiT);
+  mat_mul(Fi, DdFiT, Svis);
+  Svis *= 2.0 * mu * Jac;
 
   // Compute rho and beta depending on the volumetric penalty model
   //
@@ -1334,15 +1393,16 @@ void ustruct_3d_m(ComMod& com_mod, CepMod& cep_mod, const bool vmsFlag, const in
   }
 
   // Total isochoric 2nd Piola-Kirchhoff stress
-  Siso = Siso + Svis;
+  Siso += Svis;
 
   // Deviatoric 1st Piola-Kirchhoff tensor (P)
   //
-  auto Pdev = mat_fun::mat_mul(F, Siso);
+  auto Pdev = ws.array(3,3);
+  mat_fun::mat_mul(F, Siso, Pdev);
 
   // Shape function gradients in the current configuration
   //
-  Array<double> NxFi(3,eNoNw);
+  auto NxFi = ws.array(3,eNoNw);
 
   for (int a = 0; a < eNoNw; a++) {
     NxFi(0,a) = Nwx(0,a)*Fi(0,0) + Nwx(1,a)*Fi(1,0) + Nwx(2,a)*Fi(2,0);
@@ -1376,7 +1436,7 @@ void ustruct_3d_m(ComMod& com_mod, CepMod& cep_mod, const bool vmsFlag, const in
 
   // Auxilary quantities for computing stiffness tensors
   //
-  Array3<double> Bm(6,3,eNoNw);
+  auto Bm = ws.array3(6,3,eNoNw);
 
   for (int a = 0; a < eNoNw; a++) {
     Bm(0,0,a) = Nwx(0,a)*F(0,0);
@@ -1404,7 +1464,8 @@ void ustruct_3d_m(ComMod& com_mod, CepMod& cep_mod, const bool vmsFlag, const in
     Bm(5,2,a) = (Nwx(2,a)*F(2,0) + F(2,2)*Nwx(0,a));
   }
 
-  Array<double> VxNx(3,eNoNw), DdNx(3,eNoNw);
+  auto VxNx = ws.array(3,eNoNw);
+  auto DdNx = ws.array(3,eNoNw);
 
   for (int a = 0; a < eNoNw; a++) {
     DdNx(0,a) = ddev(0,0)*NxFi(0,a) + ddev(0,1)*NxFi(1,a) + ddev(0,2)*NxFi(2,a);
@@ -1422,6 +1483,7 @@ void ustruct_3d_m(ComMod& com_mod, CepMod& cep_mod, const bool vmsFlag, const in
   double r23 = 2.0 / 3.0;
   double NxSNx{0.0}, BtDB{0.0}, NxNx{0.0};
   double Tv{0.0}, Ku{0.0};
+  auto DBm = ws.array(6,3);
 
   for (int b = 0; b < eNoNw; b++) {
     for (int a = 0; a < eNoNw; a++) {
@@ -1431,7 +1493,7 @@ void ustruct_3d_m(ComMod& com_mod, CepMod& cep_mod, const bool vmsFlag, const in
        + Nwx(1,a)*Siso(1,2)*Nwx(2,b) + Nwx(2,a)*Siso(2,0)*Nwx(0,b)
        + Nwx(2,a)*Siso(2,1)*Nwx(1,b) + Nwx(2,a)*Siso(2,2)*Nwx(2,b);
 
-      auto DBm = mat_mul(Dm, Bm.rslice(b));
+      mat_mul(Dm, Bm.rslice(b), DBm);
       NxNx = NxFi(0,a)*NxFi(0,b) + NxFi(1,a)*NxFi(1,b) + NxFi(2,a)*NxFi(2,b);
 
       // dM1_dV1 + af/am *dM_1/dU_1
@@ -37,11 +37,11 @@ namespace ustruct {
 
 void b_ustruct_2d(const ComMod& com_mod, const int eNoN, const double w, const Vector<double>& N, 
     const Array<double>& Nx, const Array<double>& dl, const Vector<double>& hl, const Vector<double>& nV, 
-    Array<double>& lR, Array3<double>& lK, Array3<double>& lKd);
+    Array<double>& lR, Array3<double>& lK, Array3<double>& lKd, ElementWorkspace& ws);
 
 void b_ustruct_3d(const ComMod& com_mod, const int eNoN, const double w, const Vector<double>& N, 
     const Array<double>& Nx, const Array<double>& dl, const Vector<double>& hl, const Vector<double>& nV, 
-    Array<double>& lR, Array3<double>& lK, Array3<double>& lKd);
+    Array<double>& lR, Array3<double>& lK, Array3<double>& lKd, ElementWorkspace& ws);
 
 void construct_usolid(ComMod& com_mod, CepMod& cep_mod, const mshType& lM, const Array<double>& Ag, const Array<double>& Yg, 
     const Array<double>& Dg);
@@ -52,25 +52,25 @@ void ustruct_2d_c(ComMod& com_mod, CepMod& cep_mod, const bool vmsFlag, const in
     const double w, const double Je, const Vector<double>& Nw,  const Vector<double>& Nq,
     const Array<double>& Nwx, const Array<double>& Nqx, const Array<double>& al, const Array<double>& yl,
     const Array<double>& dl, const Array<double>& bfl, const Array<double>& Kxi, Array<double>& lR, Array3<double>& lK, 
-    Array3<double>& lKd);
+    Array3<double>& lKd, ElementWorkspace& ws);
 
 void ustruct_2d_m(ComMod& com_mod, CepMod& cep_mod, const bool vmsFlag, const int eNoNw, const int eNoNq,
     const int nFn, const double w, const double Je, const Vector<double>& Nw,  const Vector<double>& Nq,
     const Array<double>& Nwx, const Array<double>& al, const Array<double>& yl, const Array<double>& dl,
     const Array<double>& bfl, const Array<double>& fN, const Vector<double>& ya_l, Array<double>& lR,
-    Array3<double>& lK, Array3<double>& lKd);
+    Array3<double>& lK, Array3<double>& lKd, ElementWorkspace& ws);
 
 void ustruct_3d_c(ComMod& com_mod, CepMod& cep_mod, const bool vmsFlag, const int eNoNw, const int eNoNq,
     const double w, const double Je, const Vector<double>& Nw,  const Vector<double>& Nq,
     const Array<double>& Nwx, const Array<double>& Nqx, const Array<double>& al, const Array<double>& yl, 
     const Array<double>& dl, const Array<double>& bfl, const Array<double>& Kxi, Array<double>& lR, Array3<double>& lK, 
-    Array3<double>& lKd);
+    Array3<double>& lKd, ElementWorkspace& ws);
 
 void ustruct_3d_m(ComMod& com_mod, CepMod& cep_mod, const bool vmsFlag, const int eNoNw, const int eNoNq, 
     const int nFn, const double w, const double Je, const Vector<double>& Nw,  const Vector<double>& Nq, 
     const Array<double>& Nwx, const Array<double>& al, const Array<double>& yl, const Array<double>& dl, 
     const Array<double>& bfl, const Array<double>& fN, const Vector<double>& ya_l, Array<double>& lR, 
-    Array3<double>& lK, Array3<double>& lKd);
+    Array3<double>& lK, Array3<double>& lKd, ElementWorkspace& ws);
 
 void ustruct_do_assem(ComMod& com_mod, const int d, const Vector<int>& eqN, const Array3<double>& lKd, 
     const Array3<double>& lK, const Array<double>& lR);
@@ -72,9 +72,17 @@ double cput()
 
 Vector<double> 
 cross(const Array<double>& V) 
+{
+  Vector<double> U(V.nrows());
+  cross(V, U);
+  return U;
+}
+
+/// @brief Compute the cross product of the columns of V directly into U.
+//
+void cross(const Array<double>& V, Vector<double>& U)
 {
   int num_rows = V.nrows();
-  Vector<double> U(num_rows);
 
   if (num_rows == 2) {
     U(0) =  V(1,0);
@@ -84,8 +92,6 @@ cross(const Array<double>& V)
     U(1) = V(2,0)*V(0,1) - V(0,0)*V(2,1);
     U(2) = V(0,0)*V(1,1) - V(1,0)*V(0,1);
   } 
-
-  return U;
 }
 
 bool btest(int value, int pos)
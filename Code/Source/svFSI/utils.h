@@ -64,6 +64,7 @@ int CountBits(int n);
 double cput();
 
 Vector<double> cross(const Array<double>& V);
+void cross(const Array<double>& V, Vector<double>& U);
 
 bool dequeue(queueType& que, int& iVal);
 void enqueue(queueType& que, int iVal);
@@ -38,9 +38,11 @@
 #include "consts.h"
 #include "post.h"
 
+#include <fstream>
 #include <iomanip>
 #include <sstream>
 #include <stdio.h>
+#include <tuple>
 
 #include <vtkUnstructuredGrid.h>
 #include <vtkSmartPointer.h>
@@ -896,6 +898,209 @@ void write_vtu_debug(ComMod& com_mod, mshType& lM, const std::string& fName)
   delete vtk_writer;
 }
 
+//------------------
+// write_vtu_pieces
+//------------------
+// Write the results of write_vtus() as one .vtu piece per processor and a 
+// .pvtu file, written by the master, referencing the pieces.
+//
+// Each piece stores the nodes and elements local to its processor, so no
+// data is gathered to the master. Nodes shared between processors are written 
+// in each piece, the copies of the nodes not owned by the processor (not 
+// in [0,lhs.mynNo) of the FSILS node ordering) are marked as duplicate 
+// points in the vtkGhostType array.
+//
+void write_vtu_pieces(Simulation* simulation, const std::vector<dataType>& d, const std::vector<std::string>& outNames, 
+    const std::vector<int>& outS, const std::vector<std::string>& outNamesE, const int nOute, const std::string& fName)
+{
+  auto& com_mod = simulation->com_mod;
+  auto& cm = com_mod.cm;
+  auto& cm_mod = simulation->cm_mod;
+  const auto& lhs = com_mod.lhs;
+
+  const int nsd = com_mod.nsd;
+  const int nMsh = com_mod.nMsh;
+  const int nOut = outNames.size();
+  const auto& meshes = com_mod.msh;
+
+  int nNo = 0;
+  int nEl = 0;
+
+  for (int iM = 0; iM < nMsh; iM++) {
+    nNo = nNo + meshes[iM].nNo;
+    nEl = nEl + meshes[iM].nEl;
+  }
+
+  auto piece_name = [&fName](const int i) -> std::string { 
+    return fName + "_p" + std::to_string(i) + ".vtu"; 
+  };
+
+  VtkVtuData vtk_writer(piece_name(cm.id()), false);
+
+  // Array types, names and number of components of the pieces, used
+  // to write the .pvtu file.
+  //
+  std::vector<std::tuple<std::string,std::string,int>> pointArrays;
+  std::vector<std::tuple<std::string,std::string,int>> cellArrays;
+
+  // Writing the position data and the ghost points
+  //
+  Array<double> tmpV(consts::maxNSD, nNo);
+  Vector<int> ghost(nNo);
+  int nSh = 0;
+
+  for (int iM = 0; iM < nMsh; iM++) {
+    auto& msh = meshes[iM];
+    for (int a = 0; a < msh.nNo; a++) {
+      for (int i = 0; i < nsd; i++) {
+        tmpV(i,a+nSh) = d[iM].x(i+outS[0],a);
+      }
+      ghost(a+nSh) = (lhs.map(msh.gN(a)) >= lhs.mynNo);
+    }
+    nSh = nSh + msh.nNo;
+  }
+
+  vtk_writer.set_points(tmpV);
+  vtk_writer.set_ghost_points(ghost);
+  pointArrays.push_back({"UInt8", "vtkGhostType", 1});
+
+  // Writing the connectivity data using the node numbers of the piece
+  //
+  nSh = 0;
+
+  for (int iM = 0; iM < nMsh; iM++) {
+    auto& msh = meshes[iM];
+    Array<int> tmpI(msh.eNoN, msh.nEl);
+
+    for (int e = 0; e < msh.nEl; e++) {
+      for (int i = 0; i < msh.eNoN; i++) {
+        tmpI(i,e) = msh.lN(msh.IEN(i,e)) + nSh;
+      }
+    }
+
+    vtk_writer.set_connectivity(nsd, tmpI);
+    nSh = nSh + msh.nNo;
+  }
+
+  // Writing all solutions
+  //
+  for (int iOut = 1; iOut < nOut; iOut++) {
+    int s = outS[iOut];
+    int l = outS[iOut+1] - s;
+
+    Array<double> tmpV(l, nNo);
+    int nSh = 0;
+
+    for (int iM = 0; iM < nMsh; iM++) {
+      for (int a = 0; a < meshes[iM].nNo; a++) {
+        for (int i = 0; i < l; i++) {
+          tmpV(i,a+nSh) = d[iM].x(i+s,a);
+        }
+      }
+      nSh = nSh + meshes[iM].nNo;
+    }
+
+    vtk_writer.set_point_data(outNames[iOut], tmpV);
+    pointArrays.push_back({"Float64", outNames[iOut], l});
+  }
+
+  // Write element-based variables
+  //
+  if (!com_mod.savedOnce || nMsh > 1) {
+    Array<int> tmpI(1,nEl);
+
+    if (com_mod.dmnId.size() != 0) {
+      int Ec = 0;
+      for (int iM = 0; iM < nMsh; iM++) {
+        for (int e = 0; e < meshes[iM].nEl; e++) {
+          tmpI(0,Ec) = meshes[iM].eId(e);
+          Ec = Ec + 1;
+        }
+      }
+      vtk_writer.set_element_data("Domain_ID", tmpI);
+      cellArrays.push_back({"Int32", "Domain_ID", 1});
+    }
+
+    if (!com_mod.savedOnce) {
+      tmpI = cm.id();
+      vtk_writer.set_element_data("Proc_ID", tmpI);
+      cellArrays.push_back({"Int32", "Proc_ID", 1});
+    }
+
+    if (nMsh > 1) {
+      int Ec = 0;
+      for (int iM = 0; iM < nMsh; iM++) {
+        for (int e = 0; e < meshes[iM].nEl; e++) {
+          tmpI(0,Ec) = iM;
+          Ec = Ec + 1;
+        }
+      }
+      vtk_writer.set_element_data("Mesh_ID", tmpI);
+      cellArrays.push_back({"Int32", "Mesh_ID", 1});
+    }
+  }
+
+  com_mod.savedOnce = true;
+
+  // Write element Jacobian and von Mises stress if necessary
+  //
+  for (int l = 0; l < nOute; l++) {
+    Array<double> tmpVe(1,nEl);
+    int Ec = 0;
+
+    for (int iM = 0; iM < nMsh; iM++) {
+      for (int e = 0; e < meshes[iM].nEl; e++) {
+        tmpVe(0,Ec) = d[iM].xe(l,e);
+        Ec = Ec + 1;
+      }
+    }
+    vtk_writer.set_element_data(outNamesE[l], tmpVe);
+    cellArrays.push_back({"Float64", outNamesE[l], 1});
+  }
+
+  vtk_writer.write();
+
+  if (cm.slv(cm_mod)) {
+    return;
+  }
+
+  // Write the .pvtu file referencing the pieces by their file name 
+  // relative to the .pvtu file.
+  //
+  auto write_arrays = [](std::ofstream& pvtu, const std::vector<std::tuple<std::string,std::string,int>>& arrays) -> void {
+    for (auto& [type, name, num_comp] : arrays) {
+      pvtu << "      <PDataArray type=\"" << type << "\" Name=\"" << name << "\" NumberOfComponents=\"" << num_comp << "\"/>\n";
+    }
+  };
+
+  std::ofstream pvtu(fName + ".pvtu");
+  if (!pvtu.is_open()) {
+    throw std::runtime_error("Unable to open the file '" + fName + ".pvtu' for writing.");
+  }
+
+  pvtu << "<?xml version=\"1.0\"?>\n";
+  pvtu << "<VTKFile type=\"PUnstructuredGrid\" version=\"0.1\" byte_order=\"LittleEndian\">\n";
+  pvtu << "  <PUnstructuredGrid GhostLevel=\"0\">\n";
+  pvtu << "    <PPointData>\n";
+  write_arrays(pvtu, pointArrays);
+  pvtu << "    </PPointData>\n";
+  pvtu << "    <PCellData>\n";
+  write_arrays(pvtu, cellArrays);
+  pvtu << "    </PCellData>\n";
+  pvtu << "    <PPoints>\n";
+  pvtu << "      <PDataArray type=\"Float32\" NumberOfComponents=\"3\"/>\n";
+  pvtu << "    </PPoints>\n";
+
+  for (int i = 0; i < cm.np(); i++) {
+    auto source = piece_name(i);
+    source = source.substr(source.find_last_of('/') + 1);
+    pvtu << "    <Piece Source=\"" << source << "\"/>\n";
+  }
+
+  pvtu << "  </PUnstructuredGrid>\n";
+  pvtu << "</VTKFile>\n";
+}
+
 //------------
 // write_vtus
 //------------
@@ -1304,6 +1509,26 @@ void write_vtus(Simulation* simulation, const Array<double>& lA, const Array<dou
 
   } // iM for loop 
 
+  // Set the output file name.
+  //
+  std::string fName;
+
+  if (com_mod.cTS > 1000 || lAve) {
+    fName = std::to_string(com_mod.cTS);
+  } else { 
+    std::ostringstream ss;
+    ss << std::setw(3) << std::setfill('0') << com_mod.cTS;
+    fName = ss.str();
+  }
+
+  fName = com_mod.saveName + "_" + fName;
+
+  // Write a piece of the results from each processor.
+  //
+  if (com_mod.savePVTU && !cm.seq()) {
+    write_vtu_pieces(simulation, d, outNames, outS, outNamesE, nOute, fName);
+    return;
+  }
 
   // Integrate data from all processors
   //
@@ -1330,17 +1555,7 @@ void write_vtus(Simulation* simulation, const Array<double>& lA, const Array<dou
 
   // Writing to vtu file (master only)
   //
-  std::string fName;
-
-  if (com_mod.cTS > 1000 || lAve) {
-    fName = std::to_string(com_mod.cTS);
-  } else { 
-    std::ostringstream ss;
-    ss << std::setw(3) << std::setfill('0') << com_mod.cTS;
-    fName = ss.str();
-  }
-
-  fName = com_mod.saveName + "_" + fName + ".vtu";
+  fName = fName + ".vtu";
   auto vtk_writer = VtkData::create_writer(fName);
 
   // Writing the position data
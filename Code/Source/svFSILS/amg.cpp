@@ -0,0 +1,803 @@
+/* Copyright (c) Stanford University, The Regents of the University of California, and others.
+ *
+ * All Rights Reserved.
+ *
+ * See Copyright-SimVascular.txt for additional details.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Smoothed aggregation algebraic multigrid preconditioner.
+//
+// A hierarchy is built for the matrix of the nodes local to a process (see
+// loc_lhs.cpp), one V-cycle per subdomain is combined over the processes 
+// as an additive Schwarz method (see precond::precond_apply).
+//
+// Coarse levels use aggregates of strongly coupled nodes (Vanek, Mandel 
+// and Brezina 1996). All the dof of a node belong to the same aggregate and
+// the tentative prolongator is the piecewise constant per dof, smoothed 
+// with one damped Jacobi step. Block Gauss-Seidel is used as the smoother 
+// and the coarsest level is solved with a dense LU factorization.
+
+#include "amg.h"
+
+#include "fsils_api.hpp"
+#include "loc_lhs.h"
+
+#include <algorithm>
+#include <math.h>
+
+namespace amg {
+
+using namespace loc_lhs;
+
+/// Strength of connection threshold on the finest level, halved on each
+/// coarser level.
+const double strength_threshold = 0.08;
+
+/// Maximum number of levels.
+const int max_levels = 10;
+
+/// Stop coarsening when the number of unknowns is below this value.
+const int min_coarse_size = 400;
+
+/// Stop coarsening when the number of nodes is not reduced by this ratio.
+const double max_coarsening_ratio = 0.85;
+
+/// Maximum number of unknowns of the coarsest level solved with LU, 
+/// Gauss-Seidel sweeps are used for larger coarse levels.
+const int max_coarse_lu = 2000;
+
+/// Number of Gauss-Seidel sweeps on a coarsest level not factorized.
+const int coarse_sweeps = 4;
+
+//------------
+// block_norm
+//------------
+//
+static inline double block_norm(const int d, const double* A)
+{
+  double s = 0.0;
+  for (int i = 0; i < d*d; i++) {
+    s += A[i]*A[i];
+  }
+  return sqrt(s);
+}
+
+//--------
+// spgemm
+//--------
+// C = A*B for block sparse matrices, B has nc columns.
+//
+static void spgemm(const int d, const int n, const int nc, 
+    const std::vector<int>& aRowPtr, const std::vector<int>& aColPtr, const std::vector<double>& aVal, 
+    const std::vector<int>& bRowPtr, const std::vector<int>& bColPtr, const std::vector<double>& bVal, 
+    std::vector<int>& cRowPtr, std::vector<int>& cColPtr, std::vector<double>& cVal)
+{
+  int dd = d*d;
+  std::vector<int> marker(nc, -1);
+
+  cRowPtr.assign(n+1, 0);
+  cColPtr.clear();
+  cVal.clear();
+
+  for (int i = 0; i < n; i++) {
+    int start = cColPtr.size();
+
+    for (int k = aRowPtr[i]; k < aRowPtr[i+1]; k++) {
+      int a = aColPtr[k];
+      for (int m = bRowPtr[a]; m < bRowPtr[a+1]; m++) {
+        int c = bColPtr[m];
+        if (marker[c] < start) {
+          marker[c] = cColPtr.size();
+          cColPtr.push_back(c);
+          cVal.resize(cVal.size()+dd, 0.0);
+        }
+        block_mul_add(d, &aVal[k*dd], &bVal[m*dd], &cVal[marker[c]*dd]);
+      }
+    }
+
+    cRowPtr[i+1] = cColPtr.size();
+  }
+}
+
+//-----------
+// transpose
+//-----------
+// B = A^T for a block sparse matrix A with n rows and nc columns.
+//
+static void transpose(const int d, const int n, const int nc, 
+    const std::vector<int>& aRowPtr, const std::vector<int>& aColPtr, const std::vector<double>& aVal, 
+    std::vector<int>& bRowPtr, std::vector<int>& bColPtr, std::vector<double>& bVal)
+{
+  int dd = d*d;
+  int nnz = aRowPtr[n];
+
+  bRowPtr.assign(nc+1, 0);
+  bColPtr.resize(nnz);
+  bVal.resize(nnz*dd);
+
+  for (int k = 0; k < nnz; k++) {
+    bRowPtr[aColPtr[k]+1] += 1;
+  }
+
+  for (int i = 0; i < nc; i++) {
+    bRowPtr[i+1] += bRowPtr[i];
+  }
+
+  std::vector<int> next(bRowPtr.begin(), bRowPtr.end()-1);
+
+  for (int i = 0; i < n; i++) {
+    for (int k = aRowPtr[i]; k < aRowPtr[i+1]; k++) {
+      int m = next[aColPtr[k]]++;
+      bColPtr[m] = i;
+      for (int r = 0; r < d; r++) {
+        for (int c = 0; c < d; c++) {
+          bVal[m*dd+c*d+r] = aVal[k*dd+r*d+c];
+        }
+      }
+    }
+  }
+}
+
+//--------------
+// set_diag_inv
+//--------------
+//
+static void set_diag_inv(FSILS_amgLevelType& L, const int dof)
+{
+  int dd = dof*dof;
+  std::vector<double> zero(dd, 0.0);
+
+  L.dInv.assign(L.nNo*dd, 0.0);
+
+  for (int a = 0; a < L.nNo; a++) {
+    const double* D = zero.data();
+    for (int k = L.rowPtr[a]; k < L.rowPtr[a+1]; k++) {
+      if (L.colPtr[k] == a) {
+        D = &L.val[k*dd];
+        break;
+      }
+    }
+    block_inverse(dof, D, &L.dInv[a*dd]);
+  }
+
+  L.x.assign(L.nNo*dof, 0.0);
+  L.b.assign(L.nNo*dof, 0.0);
+  L.r.assign(L.nNo*dof, 0.0);
+}
+
+//-----------
+// aggregate
+//-----------
+// Group strongly coupled nodes into aggregates. Returns the number of 
+// aggregates, agg[a] is -1 for nodes without strong couplings.
+//
+static int aggregate(const FSILS_amgLevelType& L, const int dof, const double theta, std::vector<int>& agg)
+{
+  int n = L.nNo;
+  int dd = dof*dof;
+  std::vector<double> dNorm(n, 0.0);
+
+  for (int a = 0; a < n; a++) {
+    for (int k = L.rowPtr[a]; k < L.rowPtr[a+1]; k++) {
+      if (L.colPtr[k] == a) {
+        dNorm[a] = block_norm(dof, &L.val[k*dd]);
+      }
+    }
+  }
+
+  // Strong couplings: |A_ab| >= theta * sqrt(|A_aa| |A_bb|).
+  //
+  std::vector<int> sRowPtr(n+1, 0), sColPtr;
+  std::vector<double> sVal;
+
+  for (int a = 0; a < n; a++) {
+    for (int k = L.rowPtr[a]; k < L.rowPtr[a+1]; k++) {
+      int b = L.colPtr[k];
+      if ((b == a) || (dNorm[a] == 0.0) || (dNorm[b] == 0.0)) {
+        continue;
+      }
+      double s = block_norm(dof, &L.val[k*dd]);
+      if (s >= theta*sqrt(dNorm[a]*dNorm[b])) {
+        sColPtr.push_back(b);
+        sVal.push_back(s);
+      }
+    }
+    sRowPtr[a+1] = sColPtr.size();
+  }
+
+  const int unset = -2;
+  agg.assign(n, unset);
+  int nAgg = 0;
+
+  for (int a = 0; a < n; a++) {
+    if (sRowPtr[a] == sRowPtr[a+1]) {
+      agg[a] = -1;
+    }
+  }
+
+  // Phase 1: a node and all its strong neighbors form an aggregate if 
+  // none of them is aggregated yet.
+  //
+  for (int a = 0; a < n; a++) {
+    if (agg[a] != unset) {
+      continue;
+    }
+    bool free = true;
+    for (int k = sRowPtr[a]; k < sRowPtr[a+1]; k++) {
+      if (agg[sColPtr[k]] >= 0) {
+        free = false;
+        break;
+      }
+    }
+    if (!free) {
+      continue;
+    }
+    agg[a] = nAgg;
+    for (int k = sRowPtr[a]; k < sRowPtr[a+1]; k++) {
+      agg[sColPtr[k]] = nAgg;
+    }
+    nAgg += 1;
+  }
+
+  // Phase 2: remaining nodes join the aggregate of their most strongly
+  // coupled neighbor.
+  //
+  auto agg1 = agg;
+
+  for (int a = 0; a < n; a++) {
+    if (agg1[a] != unset) {
+      continue;
+    }
+    double smax = -1.0;
+    for (int k = sRowPtr[a]; k < sRowPtr[a+1]; k++) {
+      int b = sColPtr[k];
+      if ((agg1[b] >= 0) && (sVal[k] > smax)) {
+        smax = sVal[k];
+        agg[a] = agg1[b];
+      }
+    }
+  }
+
+  // Phase 3: the nodes left form aggregates with their free strong 
+  // neighbors.
+  //
+  for (int a = 0; a < n; a++) {
+    if (agg[a] != unset) {
+      continue;
+    }
+    agg[a] = nAgg;
+    for (int k = sRowPtr[a]; k < sRowPtr[a+1]; k++) {
+      if (agg[sColPtr[k]] == unset) {
+        agg[sColPtr[k]] = nAgg;
+      }
+    }
+    nAgg += 1;
+  }
+
+  return nAgg;
+}
+
+//--------------------
+// spectral_radius
+//--------------------
+// Estimate the spectral radius of D^{-1}*A with a few power iterations.
+//
+static double spectral_radius(const FSILS_amgLevelType& L, const int dof)
+{
+  int n = L.nNo;
+  int dd = dof*dof;
+  std::vector<double> v(n*dof), w(n*dof), t(dof);
+
+  for (int i = 0; i < n*dof; i++) {
+    v[i] = 1.0 + 0.5*sin(double(i));
+  }
+
+  double rho = 0.0;
+
+  for (int iter = 0; iter < 10; iter++) {
+    double vn = 0.0;
+    for (int i = 0; i < n*dof; i++) {
+      vn += v[i]*v[i];
+    }
+    vn = sqrt(vn);
+    if (vn == 0.0) {
+      break;
+    }
+
+    double wn = 0.0;
+    for (int a = 0; a < n; a++) {
+      std::fill(t.begin(), t.end(), 0.0);
+      for (int k = L.rowPtr[a]; k < L.rowPtr[a+1]; k++) {
+        const double* A = &L.val[k*dd];
+        const double* x = &v[L.colPtr[k]*dof];
+        for (int i = 0; i < dof; i++) {
+          for (int j = 0; j < dof; j++) {
+            t[i] += A[i*dof+j] * x[j] / vn;
+          }
+        }
+      }
+      for (int i = 0; i < dof; i++) {
+        double s = 0.0;
+        for (int j = 0; j < dof; j++) {
+          s += L.dInv[a*dd+i*dof+j] * t[j];
+        }
+        w[a*dof+i] = s;
+        wn += s*s;
+      }
+    }
+
+    rho = sqrt(wn);
+    std::swap(v, w);
+  }
+
+  return rho;
+}
+
+//--------------------
+// set_prolongator
+//--------------------
+// P = (I - omega D^{-1} A) P0, P0 being the tentative prolongator of the 
+// aggregates. The dof with a zero diagonal are not interpolated.
+//
+static void set_prolongator(FSILS_amgLevelType& L, const int dof, const std::vector<int>& agg, const int nAgg)
+{
+  int n = L.nNo;
+  int dd = dof*dof;
+
+  std::vector<int> size(nAgg, 0);
+  for (int a = 0; a < n; a++) {
+    if (agg[a] >= 0) {
+      size[agg[a]] += 1;
+    }
+  }
+
+  // Tentative prolongator block of each node: a diagonal matrix.
+  //
+  std::vector<double> p0(n*dof, 0.0);
+  for (int a = 0; a < n; a++) {
+    if (agg[a] < 0) {
+      continue;
+    }
+    double s = 1.0 / sqrt(double(size[agg[a]]));
+    for (int i = 0; i < dof; i++) {
+      if (L.dInv[a*dd+i*dof+i] != 0.0) {
+        p0[a*dof+i] = s;
+      }
+    }
+  }
+
+  double rho = spectral_radius(L, dof);
+  double omega = (rho > 0.0) ? 4.0 / (3.0*rho) : 0.0;
+
+  std::vector<int> marker(nAgg, -1);
+  std::vector<double> C, blk(dd);
+  std::vector<int> cols;
+
+  L.pRowPtr.assign(n+1, 0);
+  L.pColPtr.clear();
+  L.pVal.clear();
+
+  for (int a = 0; a < n; a++) {
+    cols.clear();
+    C.clear();
+
+    // C_g = sum_b A_ab P0_b for the aggregates g of the neighbors b.
+    //
+    for (int k = L.rowPtr[a]; k < L.rowPtr[a+1]; k++) {
+      int b = L.colPtr[k];
+      int g = agg[b];
+      if (g < 0) {
+        continue;
+      }
+      if (marker[g] == -1) {
+        marker[g] = cols.size();
+        cols.push_back(g);
+        C.resize(C.size()+dd, 0.0);
+      }
+      double* c = &C[marker[g]*dd];
+      for (int i = 0; i < dof; i++) {
+        for (int j = 0; j < dof; j++) {
+          c[i*dof+j] += L.val[k*dd+i*dof+j] * p0[b*dof+j];
+        }
+      }
+    }
+
+    if ((agg[a] >= 0) && (marker[agg[a]] == -1)) {
+      marker[agg[a]] = cols.size();
+      cols.push_back(agg[a]);
+      C.resize(C.size()+dd, 0.0);
+    }
+
+    for (size_t m = 0; m < cols.size(); m++) {
+      int g = cols[m];
+      std::fill(blk.begin(), blk.end(), 0.0);
+      block_mul_add(dof, &L.dInv[a*dd], &C[m*dd], blk.data());
+      for (int l = 0; l < dd; l++) {
+        blk[l] = -omega*blk[l];
+      }
+      if (g == agg[a]) {
+        for (int i = 0; i < dof; i++) {
+          blk[i*dof+i] += p0[a*dof+i];
+        }
+      }
+      L.pColPtr.push_back(g);
+      L.pVal.insert(L.pVal.end(), blk.begin(), blk.end());
+      marker[g] = -1;
+    }
+
+    L.pRowPtr[a+1] = L.pColPtr.size();
+  }
+
+  transpose(dof, n, nAgg, L.pRowPtr, L.pColPtr, L.pVal, L.rRowPtr, L.rColPtr, L.rVal);
+}
+
+//----------------
+// set_coarse_matrix
+//----------------
+// Galerkin coarse matrix C = R*A*P.
+//
+static void set_coarse_matrix(const FSILS_amgLevelType& L, FSILS_amgLevelType& C, const int dof)
+{
+  std::vector<int> apRowPtr, apColPtr;
+  std::vector<double> apVal;
+
+  spgemm(dof, L.nNo, C.nNo, L.rowPtr, L.colPtr, L.val, L.pRowPtr, L.pColPtr, L.pVal, apRowPtr, apColPtr, apVal);
+  spgemm(dof, C.nNo, C.nNo, L.rRowPtr, L.rColPtr, L.rVal, apRowPtr, apColPtr, apVal, C.rowPtr, C.colPtr, C.val);
+}
+
+//--------------
+// factor_coarse
+//--------------
+// Dense LU factorization with partial pivoting of the coarsest level. 
+// Unknowns with a zero column (constrained dof) are set to zero.
+//
+static void factor_coarse(FSILS_amgType& amg, const int dof)
+{
+  auto& L = amg.levels.back();
+  int N = L.nNo*dof;
+  int dd = dof*dof;
+
+  if (N > max_coarse_lu) {
+    amg.coarseN = 0;
+    amg.coarseLU.clear();
+    amg.coarsePiv.clear();
+    return;
+  }
+
+  amg.coarseN = N;
+  amg.coarseLU.assign(N*N, 0.0);
+  amg.coarsePiv.resize(N);
+  auto& A = amg.coarseLU;
+
+  for (int a = 0; a < L.nNo; a++) {
+    for (int k = L.rowPtr[a]; k < L.rowPtr[a+1]; k++) {
+      int b = L.colPtr[k];
+      for (int i = 0; i < dof; i++) {
+        for (int j = 0; j < dof; j++) {
+          A[(a*dof+i)*N + b*dof+j] += L.val[k*dd+i*dof+j];
+        }
+      }
+    }
+  }
+
+  double amax = 0.0;
+  for (auto v : A) {
+    amax = std::max(amax, fabs(v));
+  }
+  double tiny = 1.0e-14 * amax;
+
+  for (int k = 0; k < N; k++) {
+    int p = k;
+    for (int i = k+1; i < N; i++) {
+      if (fabs(A[i*N+k]) > fabs(A[p*N+k])) {
+        p = i;
+      }
+    }
+    amg.coarsePiv[k] = p;
+
+    if (p != k) {
+      for (int j = 0; j < N; j++) {
+        std::swap(A[k*N+j], A[p*N+j]);
+      }
+    }
+
+    if (fabs(A[k*N+k]) <= tiny) {
+      for (int j = 0; j < N; j++) {
+        A[k*N+j] = 0.0;
+      }
+      for (int i = k+1; i < N; i++) {
+        A[i*N+k] = 0.0;
+      }
+      A[k*N+k] = 0.0;
+      continue;
+    }
+
+    for (int i = k+1; i < N; i++) {
+      double f = A[i*N+k] / A[k*N+k];
+      A[i*N+k] = f;
+      if (f == 0.0) {
+        continue;
+      }
+      for (int j = k+1; j < N; j++) {
+        A[i*N+j] -= f * A[k*N+j];
+      }
+    }
+  }
+}
+
+//-------------
+// solve_coarse
+//-------------
+//
+static void solve_coarse(const FSILS_amgType& amg, std::vector<double>& x, const std::vector<double>& b)
+{
+  int N = amg.coarseN;
+  const auto& A = amg.coarseLU;
+
+  x = b;
+
+  for (int k = 0; k < N; k++) {
+    std::swap(x[k], x[amg.coarsePiv[k]]);
+  }
+
+  for (int i = 0; i < N; i++) {
+    double s = x[i];
+    for (int j = 0; j < i; j++) {
+      s -= A[i*N+j] * x[j];
+    }
+    x[i] = s;
+  }
+
+  for (int i = N-1; i >= 0; i--) {
+    if (A[i*N+i] == 0.0) {
+      x[i] = 0.0;
+      continue;
+    }
+    double s = x[i];
+    for (int j = i+1; j < N; j++) {
+      s -= A[i*N+j] * x[j];
+    }
+    x[i] = s / A[i*N+i];
+  }
+}
+
+//--------------
+// gauss_seidel
+//--------------
+// One block Gauss-Seidel sweep, forward or backward.
+//
+static void gauss_seidel(FSILS_amgLevelType& L, const int dof, const bool forward)
+{
+  int n = L.nNo;
+  int dd = dof*dof;
+  std::vector<double> s(dof);
+
+  for (int m = 0; m < n; m++) {
+    int a = forward ? m : n-1-m;
+
+    for (int i = 0; i < dof; i++) {
+      s[i] = L.b[a*dof+i];
+    }
+
+    for (int k = L.rowPtr[a]; k < L.rowPtr[a+1]; k++) {
+      int c = L.colPtr[k];
+      if (c == a) {
+        continue;
+      }
+      const double* A = &L.val[k*dd];
+      const double* x = &L.x[c*dof];
+      for (int i = 0; i < dof; i++) {
+        for (int j = 0; j < dof; j++) {
+          s[i] -= A[i*dof+j] * x[j];
+        }
+      }
+    }
+
+    const double* D = &L.dInv[a*dd];
+    for (int i = 0; i < dof; i++) {
+      double v = 0.0;
+      for (int j = 0; j < dof; j++) {
+        v += D[i*dof+j] * s[j];
+      }
+      L.x[a*dof+i] = v;
+    }
+  }
+}
+
+//---------
+// vcycle
+//---------
+// Approximately solve A x = b on level 'l' with x = 0 as initial guess.
+//
+static void vcycle(FSILS_amgType& amg, const int dof, const int l)
+{
+  auto& L = amg.levels[l];
+  int n = L.nNo;
+  int dd = dof*dof;
+
+  std::fill(L.x.begin(), L.x.end(), 0.0);
+
+  if (l == static_cast<int>(amg.levels.size())-1) {
+    if (amg.coarseN != 0) {
+      solve_coarse(amg, L.x, L.b);
+    } else {
+      for (int i = 0; i < coarse_sweeps; i++) {
+        gauss_seidel(L, dof, true);
+        gauss_seidel(L, dof, false);
+      }
+    }
+    return;
+  }
+
+  auto& C = amg.levels[l+1];
+
+  gauss_seidel(L, dof, true);
+
+  // r = b - A x
+  //
+  for (int a = 0; a < n; a++) {
+    for (int i = 0; i < dof; i++) {
+      double s = L.b[a*dof+i];
+      for (int k = L.rowPtr[a]; k < L.rowPtr[a+1]; k++) {
+        const double* A = &L.val[k*dd+i*dof];
+        const double* x = &L.x[L.colPtr[k]*dof];
+        for (int j = 0; j < dof; j++) {
+          s -= A[j] * x[j];
+        }
+      }
+      L.r[a*dof+i] = s;
+    }
+  }
+
+  // b_c = R r
+  //
+  for (int g = 0; g < C.nNo; g++) {
+    for (int i = 0; i < dof; i++) {
+      double s = 0.0;
+      for (int k = L.rRowPtr[g]; k < L.rRowPtr[g+1]; k++) {
+        const double* R = &L.rVal[k*dd+i*dof];
+        const double* r = &L.r[L.rColPtr[k]*dof];
+        for (int j = 0; j < dof; j++) {
+          s += R[j] * r[j];
+        }
+      }
+      C.b[g*dof+i] = s;
+    }
+  }
+
+  vcycle(amg, dof, l+1);
+
+  // x = x + P x_c
+  //
+  for (int a = 0; a < n; a++) {
+    for (int i = 0; i < dof; i++) {
+      double s = 0.0;
+      for (int k = L.pRowPtr[a]; k < L.pRowPtr[a+1]; k++) {
+        const double* P = &L.pVal[k*dd+i*dof];
+        const double* x = &C.x[L.pColPtr[k]*dof];
+        for (int j = 0; j < dof; j++) {
+          s += P[j] * x[j];
+        }
+      }
+      L.x[a*dof+i] += s;
+    }
+  }
+
+  gauss_seidel(L, dof, false);
+}
+
+/// @brief Create or update the multigrid hierarchy for the matrix Val. 
+///
+/// The aggregates and prolongators are created when the sparsity pattern
+/// or dof changed since the last call, otherwise they are reused and only 
+/// the level matrices, smoothers and coarse factorization are recomputed.
+///
+/// Modifies: amg
+//
+void amg_setup(FSILS_lhsType& lhs, FSILS_amgType& amg, const int dof, const Array<double>& Val)
+{
+  #define n_debug_amg_setup
+  #ifdef debug_amg_setup
+  DebugMsg dmsg(__func__,  lhs.commu.task);
+  dmsg.banner();
+  double time = fsi_linear_solver::fsils_cpu_t();
+  #endif
+
+  bool reuse = !loc_lhs_set_pattern(lhs, amg.loc, dof) && amg.foC;
+
+  if (!reuse) {
+    amg.foC = false;
+    amg.levels.clear();
+    amg.levels.resize(1);
+    amg.levels[0].nNo = amg.loc.nNo;
+    amg.levels[0].rowPtr = amg.loc.rowPtr;
+    amg.levels[0].colPtr = amg.loc.colPtr;
+  }
+
+  // The local matrix values are moved to the finest level, they are 
+  // overwritten on the next call.
+  //
+  loc_lhs_set_values(lhs, amg.loc, Val);
+  amg.levels[0].val.swap(amg.loc.val);
+
+  for (int l = 0; ; l++) {
+    set_diag_inv(amg.levels[l], dof);
+
+    if (!reuse) {
+      auto& L = amg.levels[l];
+      if ((l == max_levels-1) || (L.nNo*dof <= min_coarse_size)) {
+        break;
+      }
+
+      std::vector<int> agg;
+      double theta = strength_threshold * pow(0.5, l);
+      int nAgg = aggregate(L, dof, theta, agg);
+
+      if ((nAgg == 0) || (nAgg > max_coarsening_ratio*L.nNo)) {
+        break;
+      }
+
+      set_prolongator(L, dof, agg, nAgg);
+      amg.levels.emplace_back();
+      amg.levels.back().nNo = nAgg;
+
+    } else if (l == static_cast<int>(amg.levels.size())-1) {
+      break;
+    }
+
+    set_coarse_matrix(amg.levels[l], amg.levels[l+1], dof);
+  }
+
+  factor_coarse(amg, dof);
+  amg.foC = true;
+
+  #ifdef debug_amg_setup
+  dmsg << "reuse: " << reuse;
+  dmsg << "levels: " << amg.levels.size();
+  for (auto& L : amg.levels) {
+    dmsg << "  nNo: " << L.nNo << "  nnz: " << L.colPtr.size();
+  }
+  dmsg << "Execution time: " << fsi_linear_solver::fsils_cpu_t() - time;
+  #endif
+}
+
+/// @brief Apply one V-cycle to the local part of R: Z = M^{-1} R.
+///
+/// Modifies: Z, amg work vectors
+//
+void amg_apply(FSILS_lhsType& lhs, FSILS_amgType& amg, const int dof, const Array<double>& R, Array<double>& Z)
+{
+  int nNo = lhs.nNo;
+  auto& L = amg.levels[0];
+
+  std::copy(R.data(), R.data()+dof*nNo, L.b.begin());
+
+  vcycle(amg, dof, 0);
+
+  std::copy(L.x.begin(), L.x.end(), Z.data());
+}
+
+};
@@ -0,0 +1,303 @@
+/* Copyright (c) Stanford University, The Regents of the University of California, and others.
+ *
+ * All Rights Reserved.
+ *
+ * See Copyright-SimVascular.txt for additional details.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Block ILU(0) and block Jacobi preconditioners.
+//
+// Both operate on the dof x dof blocks of the matrix of the nodes local to 
+// a process (see loc_lhs.cpp) and are combined over the processes as an 
+// additive Schwarz method overlapping on the shared nodes (see 
+// precond::precond_apply). 
+//
+// The incomplete factorization keeps the sparsity pattern of the matrix. 
+// The rows of the forward and backward substitutions are grouped by levels, 
+// a row only depends on rows of lower levels, so that the rows of a level
+// are solved concurrently by the OpenMP threads.
+
+#include "bilu.h"
+
+#include "loc_lhs.h"
+
+#include <algorithm>
+#include <math.h>
+
+namespace bilu {
+
+using namespace loc_lhs;
+
+/// Minimum number of rows of a level solved by several threads.
+const int min_level_rows = 64;
+
+//---------------
+// set_schedule
+//---------------
+// Group the rows of the forward (lower) and backward (upper) substitutions
+// by levels. The level of a row is one more than the largest level of the 
+// rows it depends on.
+//
+static void set_schedule(FSILS_biluType& bilu)
+{
+  auto& loc = bilu.loc;
+  int nNo = loc.nNo;
+  std::vector<int> lev(nNo);
+
+  auto sort_rows = [&](std::vector<int>& levPtr, std::vector<int>& levRow) {
+    int nLev = (nNo == 0) ? 0 : *std::max_element(lev.begin(), lev.end()) + 1;
+    levPtr.assign(nLev+1, 0);
+    for (int a = 0; a < nNo; a++) {
+      levPtr[lev[a]+1] += 1;
+    }
+    for (int l = 0; l < nLev; l++) {
+      levPtr[l+1] += levPtr[l];
+    }
+    std::vector<int> next(levPtr.begin(), levPtr.end()-1);
+    levRow.resize(nNo);
+    for (int a = 0; a < nNo; a++) {
+      levRow[next[lev[a]]++] = a;
+    }
+  };
+
+  for (int a = 0; a < nNo; a++) {
+    lev[a] = 0;
+    for (int k = loc.rowPtr[a]; k < loc.diagPtr[a]; k++) {
+      lev[a] = std::max(lev[a], lev[loc.colPtr[k]]+1);
+    }
+  }
+  sort_rows(bilu.lLevPtr, bilu.lLevRow);
+
+  for (int a = nNo-1; a >= 0; a--) {
+    lev[a] = 0;
+    for (int k = loc.diagPtr[a]+1; k < loc.rowPtr[a+1]; k++) {
+      lev[a] = std::max(lev[a], lev[loc.colPtr[k]]+1);
+    }
+  }
+  sort_rows(bilu.uLevPtr, bilu.uLevRow);
+}
+
+//-----------
+// factorize
+//-----------
+// Block ILU(0) factorization in place of the local matrix:
+//
+//   L_ij = A_ij U_jj^{-1},  A_ik = A_ik - L_ij U_jk  for j < i, (i,k) in A
+//
+static void factorize(FSILS_biluType& bilu)
+{
+  auto& loc = bilu.loc;
+  int nNo = loc.nNo;
+  int dof = loc.dof;
+  int dd = dof*dof;
+  auto& val = loc.val;
+
+  std::vector<int> pos(nNo, -1);
+  std::vector<double> Lij(dd);
+
+  for (int a = 0; a < nNo; a++) {
+    for (int k = loc.rowPtr[a]; k < loc.rowPtr[a+1]; k++) {
+      pos[loc.colPtr[k]] = k;
+    }
+
+    for (int k = loc.rowPtr[a]; k < loc.diagPtr[a]; k++) {
+      int b = loc.colPtr[k];
+
+      std::fill(Lij.begin(), Lij.end(), 0.0);
+      block_mul_add(dof, &val[k*dd], &bilu.dInv[b*dd], Lij.data());
+      std::copy(Lij.begin(), Lij.end(), &val[k*dd]);
+
+      for (int i = 0; i < dd; i++) {
+        Lij[i] = -Lij[i];
+      }
+
+      for (int m = loc.diagPtr[b]+1; m < loc.rowPtr[b+1]; m++) {
+        int p = pos[loc.colPtr[m]];
+        if (p != -1) {
+          block_mul_add(dof, Lij.data(), &val[m*dd], &val[p*dd]);
+        }
+      }
+    }
+
+    block_inverse(dof, &val[loc.diagPtr[a]*dd], &bilu.dInv[a*dd]);
+
+    for (int k = loc.rowPtr[a]; k < loc.rowPtr[a+1]; k++) {
+      pos[loc.colPtr[k]] = -1;
+    }
+  }
+}
+
+/// @brief Create or update the block ILU(0) factors (or the inverses of the
+/// diagonal blocks for block Jacobi) of the matrix Val. 
+///
+/// The local matrix pattern and the level schedules are only recreated 
+/// when the sparsity pattern or dof changed since the last call.
+///
+/// Modifies: bilu
+//
+void bilu_setup(FSILS_lhsType& lhs, FSILS_biluType& bilu, const int dof, const Array<double>& Val, const bool jacobi)
+{
+  #define n_debug_bilu_setup
+  #ifdef debug_bilu_setup
+  DebugMsg dmsg(__func__,  lhs.commu.task);
+  dmsg.banner();
+  double time = fsi_linear_solver::fsils_cpu_t();
+  #endif
+
+  auto& loc = bilu.loc;
+  int dd = dof*dof;
+
+  bool created = loc_lhs_set_pattern(lhs, loc, dof);
+
+  for (int a = 0; a < loc.nNo; a++) {
+    if (loc.diagPtr[a] == -1) {
+      throw std::runtime_error("[bilu_setup] The matrix has no diagonal entry for a node.");
+    }
+  }
+
+  if (created) {
+    bilu.lLevPtr.clear();
+    bilu.uLevPtr.clear();
+  }
+
+  if (!jacobi && bilu.lLevPtr.empty()) {
+    set_schedule(bilu);
+  }
+
+  bilu.jacobi = jacobi;
+  bilu.dInv.assign(loc.nNo*dd, 0.0);
+  bilu.y.resize(loc.nNo*dof);
+
+  loc_lhs_set_values(lhs, loc, Val);
+
+  if (jacobi) {
+    for (int a = 0; a < loc.nNo; a++) {
+      block_inverse(dof, &loc.val[loc.diagPtr[a]*dd], &bilu.dInv[a*dd]);
+    }
+  } else {
+    factorize(bilu);
+  }
+
+  #ifdef debug_bilu_setup
+  dmsg << "created: " << created;
+  dmsg << "jacobi: " << jacobi;
+  dmsg << "levels: " << bilu.lLevPtr.size()-1 << " " << bilu.uLevPtr.size()-1;
+  dmsg << "Execution time: " << fsi_linear_solver::fsils_cpu_t() - time;
+  #endif
+}
+
+/// @brief Apply the preconditioner to the local part of R: Z = (LU)^{-1} R,
+/// or Z = D^{-1} R for block Jacobi.
+///
+/// Modifies: Z, bilu.y
+//
+void bilu_apply(FSILS_lhsType& lhs, FSILS_biluType& bilu, const int dof, const Array<double>& R, Array<double>& Z)
+{
+  auto& loc = bilu.loc;
+  int nNo = loc.nNo;
+  int dd = dof*dof;
+  int nt = std::max(1, lhs.nThreads);
+
+  const double* r = R.data();
+  const double* dInv = bilu.dInv.data();
+  const double* val = loc.val.data();
+  double* y = bilu.y.data();
+  double* z = Z.data();
+
+  if (bilu.jacobi) {
+    #pragma omp parallel for schedule(static) num_threads(nt) if(nt > 1)
+    for (int a = 0; a < nNo; a++) {
+      for (int i = 0; i < dof; i++) {
+        double s = 0.0;
+        for (int j = 0; j < dof; j++) {
+          s += dInv[a*dd+i*dof+j] * r[a*dof+j];
+        }
+        z[a*dof+i] = s;
+      }
+    }
+    return;
+  }
+
+  // Forward substitution: y_a = r_a - sum_{b<a} L_ab y_b
+  //
+  int nLev = bilu.lLevPtr.size() - 1;
+
+  for (int l = 0; l < nLev; l++) {
+    int first = bilu.lLevPtr[l];
+    int last = bilu.lLevPtr[l+1];
+
+    #pragma omp parallel for schedule(static) num_threads(nt) if((nt > 1) && (last-first >= min_level_rows))
+    for (int q = first; q < last; q++) {
+      int a = bilu.lLevRow[q];
+      double* ya = &y[a*dof];
+      for (int i = 0; i < dof; i++) {
+        ya[i] = r[a*dof+i];
+      }
+      for (int k = loc.rowPtr[a]; k < loc.diagPtr[a]; k++) {
+        const double* yb = &y[loc.colPtr[k]*dof];
+        const double* Lab = &val[k*dd];
+        for (int i = 0; i < dof; i++) {
+          for (int j = 0; j < dof; j++) {
+            ya[i] -= Lab[i*dof+j] * yb[j];
+          }
+        }
+      }
+    }
+  }
+
+  // Backward substitution: z_a = U_aa^{-1} (y_a - sum_{b>a} U_ab z_b)
+  //
+  nLev = bilu.uLevPtr.size() - 1;
+
+  for (int l = 0; l < nLev; l++) {
+    int first = bilu.uLevPtr[l];
+    int last = bilu.uLevPtr[l+1];
+
+    #pragma omp parallel for schedule(static) num_threads(nt) if((nt > 1) && (last-first >= min_level_rows))
+    for (int q = first; q < last; q++) {
+      int a = bilu.uLevRow[q];
+      double* ya = &y[a*dof];
+      for (int k = loc.diagPtr[a]+1; k < loc.rowPtr[a+1]; k++) {
+        const double* zb = &z[loc.colPtr[k]*dof];
+        const double* Uab = &val[k*dd];
+        for (int i = 0; i < dof; i++) {
+          for (int j = 0; j < dof; j++) {
+            ya[i] -= Uab[i*dof+j] * zb[j];
+          }
+        }
+      }
+      for (int i = 0; i < dof; i++) {
+        double s = 0.0;
+        for (int j = 0; j < dof; j++) {
+          s += dInv[a*dd+i*dof+j] * ya[j];
+        }
+        z[a*dof+i] = s;
+      }
+    }
+  }
+}
+
+};
@@ -36,6 +36,7 @@
 #include "dot.h"
 #include "omp_la.h"
 #include "norm.h"
+#include "precond.h"
 #include "spar_mul.h"
 
 #include <math.h>
@@ -45,10 +46,11 @@ namespace cgrad {
 /// @brief Conjugate-gradient algorithm for scaler, vector and Schur
 /// complement cases.
 ///
-/// Reproduces 'SUBROUTINE CGRAD_SCHUR(lhs, ls, dof, D, G, L, R)'
+/// Reproduces 'SUBROUTINE CGRAD_SCHUR(lhs, ls, dof, D, G, L, R)' with 
+/// D = -G^t, the product with G^t uses the entries of G in place.
 //
-void schur(FSILS_lhsType& lhs, FSILS_subLsType& ls, const int dof, const Array<double>& D, 
-    const Array<double>& G, const Vector<double>& L, Vector<double>& R)
+void schur(FSILS_lhsType& lhs, FSILS_subLsType& ls, const int dof, const FSILS_valBlockType& G, 
+    const FSILS_valBlockType& L, Vector<double>& R)
 {
   #define n_debug_schur
   #ifdef debug_schur
@@ -59,7 +61,7 @@ void schur(FSILS_lhsType& lhs, FSILS_subLsType& ls, const int dof, const Array<d
   int nNo = lhs.nNo;
   int mynNo = lhs.mynNo;
 
-  Vector<double> X(nNo), P(nNo), SP(nNo), DGP(nNo); 
+  Vector<double> X(nNo), P(nNo), SP(nNo), GtGP(nNo); 
   Array<double> GP(dof,nNo), unCondU(dof,nNo);
 
   double time = fsi_linear_solver::fsils_cpu_t();
@@ -108,14 +110,14 @@ void schur(FSILS_lhsType& lhs, FSILS_subLsType& ls, const int dof, const Array<d
       }
     }
 
-    // DGP = K * GP
-    spar_mul::fsils_spar_mul_vs(lhs, lhs.rowPtr, lhs.colPtr, dof, D, GP, DGP);
+    // GtGP = G^t * GP
+    spar_mul::fsils_spar_mul_sv_t(lhs, lhs.rowPtr, lhs.colPtr, dof, G, GP, GtGP);
 
     // SP = L * P
     spar_mul::fsils_spar_mul_ss(lhs, lhs.rowPtr, lhs.colPtr, L, P, SP);
 
-    // SP = SP - DGP
-    omp_la::omp_sum_s(nNo, -1.0, SP, DGP);
+    // SP = SP - D * GP = SP + GtGP
+    omp_la::omp_sum_s(nNo, 1.0, SP, GtGP);
 
     double alpha = errO / dot::fsils_dot_s(mynNo, lhs.commu, P, SP);
 
@@ -245,6 +247,75 @@ void cgrad_v(FSILS_lhsType& lhs, FSILS_subLsType& ls, const int dof, const Array
   #endif
 }
 
+//------------
+// pc_cgrad_v
+//------------
+// Preconditioned conjugate gradient with the preconditioner 'pc', which 
+// must have been set up for K. The additive Schwarz form of the 
+// preconditioner is used so that it is symmetric.
+//
+void pc_cgrad_v(FSILS_lhsType& lhs, FSILS_subLsType& ls, const int dof, const Array<double>& K, 
+    FSILS_pcType& pc, Array<double>& R)
+{
+  int nNo = lhs.nNo;
+  int mynNo = lhs.mynNo;
+
+  Array<double> P(dof,nNo), KP(dof,nNo), X(dof,nNo), Z(dof,nNo);
+
+  ls.callD = fsi_linear_solver::fsils_cpu_t();
+  ls.suc = false;
+  ls.iNorm = norm::fsi_ls_normv(dof, mynNo, lhs.commu, R);
+  double eps = std::max(ls.absTol, ls.relTol*ls.iNorm);
+
+  double errO = ls.iNorm;
+  double err = errO;
+  X = 0.0;
+
+  precond::precond_apply(lhs, pc, dof, R, Z, false);
+  P = Z;
+  double rz = dot::fsils_dot_v(dof, mynNo, lhs.commu, R, Z);
+  int last_i = 0;
+
+  for (int i = 0; i < ls.mItr; i++) {
+    last_i = i;
+
+    if (err < eps) {
+      ls.suc = true;
+      break;
+    }
+
+    errO = err;
+
+    spar_mul::fsils_spar_mul_vv(lhs, lhs.rowPtr, lhs.colPtr, dof, K, P, KP);
+
+    double alpha = rz / dot::fsils_dot_v(dof, mynNo, lhs.commu, P, KP);
+    omp_la::omp_sum_v(dof, nNo, alpha, X, P);
+    omp_la::omp_sum_v(dof, nNo, -alpha, R, KP);
+
+    err = norm::fsi_ls_normv(dof, mynNo, lhs.commu, R);
+
+    precond::precond_apply(lhs, pc, dof, R, Z, false);
+    double rzO = rz;
+    rz = dot::fsils_dot_v(dof, mynNo, lhs.commu, R, Z);
+
+    // P = Z + (rz/rzO) P
+    //
+    omp_la::omp_mul_v(dof, nNo, rz/rzO, P);
+    omp_la::omp_sum_v(dof, nNo, 1.0, P, Z);
+  }
+
+  R = X;
+  ls.itr = last_i;
+  ls.fNorm = err;
+  ls.callD = fsi_linear_solver::fsils_cpu_t() - ls.callD;
+
+  if (errO < std::numeric_limits<double>::epsilon()) {
+    ls.dB = 0.0;
+  } else {
+    ls.dB = 10.0 * log(err/errO);
+  }
+}
+
 //---------
 // cgrad_s
 //---------
@@ -38,7 +38,10 @@ void cgrad_v(FSILS_lhsType& lhs, FSILS_subLsType& ls, const int dof, const Array
 
 void cgrad_s(FSILS_lhsType& lhs, FSILS_subLsType& ls, const Vector<double>& K, Vector<double>& R);
 
-void schur(FSILS_lhsType& lhs, FSILS_subLsType& ls, const int dof, const Array<double>& D,
-    const Array<double>& G, const Vector<double>& L, Vector<double>& R);
+void pc_cgrad_v(FSILS_lhsType& lhs, FSILS_subLsType& ls, const int dof, const Array<double>& K, 
+    FSILS_pcType& pc, Array<double>& R);
+
+void schur(FSILS_lhsType& lhs, FSILS_subLsType& ls, const int dof, const FSILS_valBlockType& G, 
+    const FSILS_valBlockType& L, Vector<double>& R);
 
 };
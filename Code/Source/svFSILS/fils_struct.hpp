@@ -36,6 +36,7 @@
 #include "mpi.h"
 
 #include <map>
+#include <vector>
 
 /// SELECTED_REAL_KIND(P,R) returns the kind value of a real data type with 
 ///
@@ -72,7 +73,8 @@ enum LinearSolverType
   LS_TYPE_CG = 798,
   LS_TYPE_GMRES = 797, 
   LS_TYPE_NS = 796, 
-  LS_TYPE_BICGS = 795
+  LS_TYPE_BICGS = 795,
+  LS_TYPE_PGMRES = 794
 };
 
 class FSILS_commuType 
@@ -113,6 +115,34 @@ class FSILS_cSType
     Vector<int> ptr;
 };
 
+/// @brief Persistent buffers and requests used to exchange 'dof' values per
+/// node of the shared nodes (see fsils_commu_begin/fsils_commu_end).
+///
+/// The values of the shared nodes with neighbor lhs.cS[i] are stored in the
+/// buffers at offset dof*lhs.cSDisp(i). The requests are created once with
+/// MPI_Send_init/MPI_Recv_init and restarted for each exchange.
+class FSILS_commuReqType
+{
+  public:
+    /// Whether an exchange is in progress
+    bool active = false;
+
+    /// Number of values per node
+    int dof = 0;
+
+    /// Send buffer
+    Vector<double> sB;
+
+    /// Receive buffer
+    Vector<double> rB;
+
+    /// Persistent send requests
+    std::vector<MPI_Request> sReq;
+
+    /// Persistent receive requests
+    std::vector<MPI_Request> rReq;
+};
+
 class FSILS_faceType
 {
   public:
@@ -189,6 +219,9 @@ class FSILS_lhsType
     /// Number of communication requests    (USE)
     int nReq = 0;
 
+    /// Number of OpenMP threads used by the sparse matrix-vector products (IN)
+    int nThreads = 1;
+
     /// Column pointer                      (USE)
     Vector<int> colPtr;
 
@@ -198,6 +231,9 @@ class FSILS_lhsType
     /// Diagonal pointer                    (USE)
     Vector<int> diagPtr;
 
+    /// Index of the transposed entry (b,a) of each entry (a,b)    (USE)
+    Vector<int> transPtr;
+
     /// Mapping of nodes                    (USE)
     Vector<int> map;
 
@@ -205,9 +241,36 @@ class FSILS_lhsType
 
     std::vector<FSILS_cSType> cS;
 
+    /// Offsets of the shared nodes of each cS in the communication buffers (USE)
+    Vector<int> cSDisp;
+
+    /// Persistent communication buffers and requests, keyed by the number 
+    /// of values per node. They are created on first use.   (USE)
+    mutable std::map<int,FSILS_commuReqType> commuReq;
+
     std::vector<FSILS_faceType> face;
 };
 
+/// @brief Strided view of a sub-block of the values Val(dof*dof,nnz) of a 
+/// block sparse matrix. 
+///
+/// Value (l,m) of the sub-block of the entry j is val[j*stride + l*ld + m].
+/// It is used to operate on the blocks of the Navier-Stokes matrix 
+/// A = [K G; D L] without copying them out of Val.
+class FSILS_valBlockType
+{
+  public:
+    FSILS_valBlockType(const double* val, const int stride, const int ld) : val(val), stride(stride), ld(ld) { }
+
+    /// The sub-block of Val starting at (row,col) of each dof x dof block
+    FSILS_valBlockType(const Array<double>& Val, const int dof, const int row, const int col) : 
+        val(Val.data() + row*dof + col), stride(Val.nrows()), ld(dof) { }
+
+    const double* val;
+    int stride;
+    int ld;
+};
+
 class FSILS_subLsType 
 {
   public:
@@ -254,6 +317,142 @@ class FSILS_subLsType
 
     /// Calling duration            (OUT)
     double callD;  
+
+    /// Use the pipelined GMRES     (IN)
+    bool pipelined = false;
+};
+
+/// @brief Matrix of the nodes local to a process in block compressed sparse
+/// row format, with the columns of each row sorted.
+///
+/// The entries of row a are [rowPtr[a], rowPtr[a+1]) and each entry is a 
+/// dof x dof block stored row-major, as in Val. The partially assembled values
+/// of the couplings between shared nodes are summed over the processes sharing
+/// them, so that the matrix is the restriction of the global one to the local 
+/// nodes.
+class FSILS_locLhsType
+{
+  public:
+    /// Number of values per node
+    int dof = 0;
+
+    /// Number of nodes
+    int nNo = 0;
+
+    /// Sparsity pattern of the lhs the matrix was created for
+    Array<int> lhsRowPtr;
+    Vector<int> lhsColPtr;
+
+    std::vector<int> rowPtr;
+    std::vector<int> colPtr;
+    std::vector<double> val;
+
+    /// Index of the diagonal entry of each row
+    std::vector<int> diagPtr;
+
+    /// Index in Val of the entries
+    std::vector<int> valPtr;
+
+    /// Entries exchanged with each lhs.cS to sum the values of the couplings
+    /// between shared nodes, -1 if not present
+    std::vector<std::vector<int>> sendPtr;
+    std::vector<std::vector<int>> recvPtr;
+};
+
+/// @brief A level of the algebraic multigrid hierarchy. 
+///
+/// Matrices are stored in the block compressed sparse row format of 
+/// FSILS_locLhsType.
+class FSILS_amgLevelType
+{
+  public:
+    /// Number of nodes (aggregates on coarse levels)
+    int nNo = 0;
+
+    /// Matrix of the level
+    std::vector<int> rowPtr;
+    std::vector<int> colPtr;
+    std::vector<double> val;
+
+    /// Inverse of the diagonal blocks used by the smoother
+    std::vector<double> dInv;
+
+    /// Prolongation from the next coarser level
+    std::vector<int> pRowPtr;
+    std::vector<int> pColPtr;
+    std::vector<double> pVal;
+
+    /// Restriction to the next coarser level (transpose of P)
+    std::vector<int> rRowPtr;
+    std::vector<int> rColPtr;
+    std::vector<double> rVal;
+
+    /// Work vectors for the V-cycle (dof,nNo)
+    std::vector<double> x;
+    std::vector<double> b;
+    std::vector<double> r;
+};
+
+/// @brief Smoothed aggregation algebraic multigrid preconditioner.
+///
+/// The hierarchy is built for the part of the matrix local to a process
+/// and is applied as a restricted additive Schwarz preconditioner. 
+/// Aggregates and prolongators are reused while the sparsity pattern and
+/// dof are unchanged, only the Galerkin coarse matrices are recomputed.
+class FSILS_amgType
+{
+  public:
+    /// Aggregates and prolongators have been created
+    bool foC = false;
+
+    /// Local matrix, its values are moved to the finest level
+    FSILS_locLhsType loc;
+
+    std::vector<FSILS_amgLevelType> levels;
+
+    /// LU factors of the coarsest level matrix, if it is small enough
+    int coarseN = 0;
+    std::vector<double> coarseLU;
+    std::vector<int> coarsePiv;
+};
+
+/// @brief Block ILU(0) or block Jacobi preconditioner of the local matrix.
+///
+/// The ILU(0) factors are stored in place of the local matrix: the strictly
+/// lower blocks of L (unit diagonal) and the upper blocks of U, with the 
+/// inverses of the pivot blocks in dInv. The rows of the triangular solves 
+/// are grouped by levels of rows that do not depend on each other.
+class FSILS_biluType
+{
+  public:
+    /// Block Jacobi, only dInv is computed
+    bool jacobi = false;
+
+    FSILS_locLhsType loc;
+
+    /// Inverse of the pivot (diagonal for block Jacobi) blocks
+    std::vector<double> dInv;
+
+    /// Rows of the forward and backward substitutions grouped by level, 
+    /// the rows of level l are [levPtr[l], levPtr[l+1])
+    std::vector<int> lLevPtr;
+    std::vector<int> lLevRow;
+    std::vector<int> uLevPtr;
+    std::vector<int> uLevRow;
+
+    /// Work vector (dof,nNo)
+    std::vector<double> y;
+};
+
+/// @brief Preconditioners applied within the FSILS Krylov iterations
+/// (see precond::precond_setup and precond::precond_apply).
+class FSILS_pcType
+{
+  public:
+    consts::PreconditionerType type = consts::PreconditionerType::PREC_NONE;
+
+    FSILS_amgType amg;
+    FSILS_biluType bilu;
 };
 
 class FSILS_lsType 
@@ -274,6 +473,10 @@ class FSILS_lsType
     FSILS_subLsType GM;
     FSILS_subLsType CG;
     FSILS_subLsType RI;
+
+    /// Preconditioner applied within the iterations (fsils-amg, fsils-ilu, 
+    /// fsils-blockjacobi)
+    FSILS_pcType pc;
 };
 
 
@@ -47,6 +47,14 @@ void fsils_bc_free(FSILS_lhsType& lhs, int faIn);
 
 void fsils_bc_update(FSILS_lhsType& lhs, int faIn, int nNo, int dof, const Array<double>& Val);
     
+void fsils_commu_begin(const FSILS_lhsType& lhs, const int dof, const double* R);
+
+void fsils_commu_end(const FSILS_lhsType& lhs, const int dof, double* R);
+
+void fsils_commu_free(FSILS_lhsType& lhs);
+
+void fsils_commu_init(FSILS_lhsType& lhs);
+
 void fsils_commus(const FSILS_lhsType& lhs, Vector<double>& R); 
 
 void fsils_commuv(const FSILS_lhsType& lhs, const int dof, Array<double>& R);
@@ -46,6 +46,8 @@
 
 #include "Array3.h"
 
+#include "mpi.h"
+
 #include <math.h>
 
 namespace gmres {
@@ -89,7 +91,7 @@ void bc_pre(fsi_linear_solver::FSILS_lhsType& lhs, fsi_linear_solver::FSILS_subL
 /// Reproduces the Fortran 'GMRES' subroutine.
 //
 void gmres(fsi_linear_solver::FSILS_lhsType& lhs, fsi_linear_solver::FSILS_subLsType& ls, const int dof, 
-    const Array<double>& Val, const Array<double>& R, Array<double>& X)
+    const fsi_linear_solver::FSILS_valBlockType& Val, const Array<double>& R, Array<double>& X)
 {
   #define n_debug_gmres
   #ifdef debug_gmres
@@ -628,6 +630,460 @@ void gmres_v(fsi_linear_solver::FSILS_lhsType& lhs, fsi_linear_solver::FSILS_sub
   #endif
 }
 
-};
+//------------------
+// pgmres_face_dots
+//------------------
+// Compute the local parts of the products v_f^T X for the coupled faces 
+// with 'face.sharedFlag == shared' and store them in 'd' starting at 
+// index 'k'. For shared faces only the nodes owned by this processor are 
+// used so that the parts can be summed over processors.
+//
+// Returns the index following the last stored product.
+//
+static int pgmres_face_dots(const fsi_linear_solver::FSILS_lhsType& lhs, const int dof, const Array<double>& X, 
+    const bool shared, Vector<double>& d, int k)
+{
+  for (int faIn = 0; faIn < lhs.nFaces; faIn++) {
+    auto& face = lhs.face[faIn];
+    if (!face.coupledFlag || (face.sharedFlag != shared)) {
+      continue;
+    }
+    int nsd = std::min(face.dof, dof);
+    double S = 0.0;
+
+    for (int a = 0; a < face.nNo; a++) {
+      int Ac = face.glob(a);
+      if (shared && (Ac >= lhs.mynNo)) {
+        continue;
+      }
+      for (int i = 0; i < nsd; i++) {
+        S = S + face.valM(i,a)*X(i,Ac);
+      }
+    }
+
+    d(k) = S;
+    k += 1;
+  }
+
+  return k;
+}
+
+//-----------------
+// pgmres_face_add
+//-----------------
+// Compute Y = Y + coef_f * v_f * d(k) for the coupled faces with 
+// 'face.sharedFlag == shared' using the products v_f^T X computed by 
+// pgmres_face_dots(). The coefficients are those used by add_bc_mul().
+//
+static void pgmres_face_add(const fsi_linear_solver::FSILS_lhsType& lhs, const fsi_linear_solver::BcopType op_Type, 
+    const int dof, const Vector<double>& d, const bool shared, Array<double>& Y, int k)
+{
+  using namespace fsi_linear_solver;
+
+  for (int faIn = 0; faIn < lhs.nFaces; faIn++) {
+    auto& face = lhs.face[faIn];
+    if (!face.coupledFlag || (face.sharedFlag != shared)) {
+      continue;
+    }
+    int nsd = std::min(face.dof, dof);
+    double coef = face.res;
+    if (op_Type == BcopType::BCOP_TYPE_PRE) {
+      coef = -face.res / (1.0 + face.res*face.nS);
+    }
+    double S = coef * d(k);
+    k += 1;
+
+    for (int a = 0; a < face.nNo; a++) {
+      int Ac = face.glob(a);
+      for (int i = 0; i < nsd; i++) {
+        Y(i,Ac) = Y(i,Ac) + face.valM(i,a)*S;
+      }
+    }
+  }
+}
+
+//-------------
+// pgmres_prec
+//-------------
+// Apply the coupled BC preconditioner to Y. 
+//
+// The products v_f^T Y of all faces are computed before Y is modified and 
+// the products of the shared faces are summed with a single reduction. 
+//
+static void pgmres_prec(fsi_linear_solver::FSILS_lhsType& lhs, const int dof, Array<double>& Y)
+{
+  using namespace fsi_linear_solver;
+
+  Vector<double> dl(lhs.nFaces), dg(lhs.nFaces), du(lhs.nFaces);
+
+  int n = pgmres_face_dots(lhs, dof, Y, true, dl, 0);
+  pgmres_face_dots(lhs, dof, Y, false, du, 0);
+
+  if ((lhs.commu.nTasks > 1) && (n > 0)) {
+    MPI_Allreduce(dl.data(), dg.data(), n, cm_mod::mpreal, MPI_SUM, lhs.commu.comm);
+  } else {
+    dg = dl;
+  }
+
+  pgmres_face_add(lhs, BcopType::BCOP_TYPE_PRE, dof, du, false, Y, 0);
+  pgmres_face_add(lhs, BcopType::BCOP_TYPE_PRE, dof, dg, true, Y, 0);
+}
+
+//-------------
+// pgmres_op
+//-------------
+// Compute Y = A*X for the pipelined solver: the sparse product, the 
+// coupled BC contribution and optionally the coupled BC preconditioner.
+//
+static void pgmres_op(fsi_linear_solver::FSILS_lhsType& lhs, const int dof, const fsi_linear_solver::FSILS_valBlockType& Val,
+    const bool bc_prec, const Array<double>& X, Array<double>& Y)
+{
+  using namespace fsi_linear_solver;
+
+  spar_mul::fsils_spar_mul_vv(lhs, lhs.rowPtr, lhs.colPtr, dof, Val, X, Y);
+
+  add_bc_mul::add_bc_mul(lhs, BcopType::BCOP_TYPE_ADD, dof, X, Y);
+
+  if (bc_prec) {
+    pgmres_prec(lhs, dof, Y);
+  }
+}
+
+//-----------------
+// pgmres_residual
+//-----------------
+// Compute the (preconditioned) residual Y = R - A*X and return its norm.
+//
+static double pgmres_residual(fsi_linear_solver::FSILS_lhsType& lhs, const int dof, 
+    const fsi_linear_solver::FSILS_valBlockType& Val, const bool bc_prec, const Array<double>& R, 
+    const Array<double>& X, Array<double>& Y)
+{
+  using namespace fsi_linear_solver;
+
+  spar_mul::fsils_spar_mul_vv(lhs, lhs.rowPtr, lhs.colPtr, dof, Val, X, Y);
+  add_bc_mul::add_bc_mul(lhs, BcopType::BCOP_TYPE_ADD, dof, X, Y);
+  Y = R - Y;
+
+  if (bc_prec) {
+    pgmres_prec(lhs, dof, Y);
+  }
+
+  return norm::fsi_ls_normv(dof, lhs.mynNo, lhs.commu, Y);
+}
+
+//--------------
+// pgmres_solve
+//--------------
+// Pipelined GMRES (p(1)-GMRES, Ghysels et al. 2013, SIAM J. Sci. Comput.
+// 35(1), https://doi.org/10.1137/12086563X).
+//
+// Along with the orthonormal basis v_j the vectors z_{j+1} = A*v_j are 
+// stored. At step i the classical Gram-Schmidt coefficients <z_{i+1},v_j>
+// and |z_{i+1}|^2 are summed over processors with a single non-blocking
+// reduction which is completed while A*z_{i+1} is computed. Then
+//
+//   v_{i+1} = (z_{i+1} - sum_j h(j,i) v_j) / h(i+1,i)
+//   z_{i+2} = (A*z_{i+1} - sum_j h(j,i) z_{j+1}) / h(i+1,i)
+//
+// so that each iteration performs one product and one reduction, as 
+// gmres(), but the reduction latency is hidden by the product.
+//
+// The products v_f^T z_{i+1} needed for the coupled BC contribution of the 
+// faces shared between processors are summed in the same reduction. If
+// the coupled BC preconditioner is used the products v_f^T (A*z_{i+1}) are 
+// summed with a second non-blocking reduction which is completed while 
+// v_{i+1} is computed.
+//
+// If h(i+1,i)^2 = |z_{i+1}|^2 - sum_j h(j,i)^2 is not positive the basis
+// has lost orthogonality: the cycle is ended, the true residual is computed
+// and the solver restarts from it.
+//
+// Returns false if the initial residual is below the absolute tolerance.
+//
+static bool pgmres_solve(fsi_linear_solver::FSILS_lhsType& lhs, fsi_linear_solver::FSILS_subLsType& ls, 
+    const int dof, const fsi_linear_solver::FSILS_valBlockType& Val, const Array<double>& R, Array<double>& X, 
+    const bool bc_prec)
+{
+  #define n_debug_pgmres_solve
+  #ifdef debug_pgmres_solve
+  DebugMsg dmsg(__func__,  lhs.commu.task);
+  dmsg.banner();
+  #endif
+
+  using namespace fsi_linear_solver;
+
+  int nNo = lhs.nNo;
+  int mynNo = lhs.mynNo;
+  int sD = ls.sD;
+  bool parallel = (lhs.commu.nTasks > 1);
+
+  // Number of coupled faces shared between processors.
+  int nsf = 0;
+  for (int faIn = 0; faIn < lhs.nFaces; faIn++) {
+    if (lhs.face[faIn].coupledFlag && lhs.face[faIn].sharedFlag) {
+      nsf += 1;
+    }
+  }
+
+  Array<double> h(sD+1,sD); 
+  Array3<double> v(dof,nNo,sD+1); 
+  Array3<double> z(dof,nNo,sD+1); 
+  Vector<double> y(sD), c(sD), s(sD), err(sD+1);
+  Vector<double> dl(sD+1+nsf), dg(sD+1+nsf);
+  Vector<double> pl(lhs.nFaces), pg(lhs.nFaces), pu(lhs.nFaces), fu(lhs.nFaces);
+
+  double time = fsi_linear_solver::fsils_cpu_t(); 
+  ls.suc = false;
+  double eps = 0.0;
+  bool restart = false;
+  X = 0.0;
+
+  for (int l = 0; l < ls.mItr; l++) {
+    auto v_0 = v.rslice(0);
+
+    // After a breakdown the residual has already been computed in v_0.
+    //
+    if (l == 0) {
+      v_0 = R;
+      if (bc_prec) {
+        pgmres_prec(lhs, dof, v_0);
+      }
+      err(0) = norm::fsi_ls_normv(dof, mynNo, lhs.commu, v_0);
+    } else if (restart) {
+      err(0) = ls.fNorm;
+    } else {
+      err(0) = pgmres_residual(lhs, dof, Val, bc_prec, R, X, v_0);
+      ls.itr = ls.itr + 1;
+    }
+    restart = false;
+    #ifdef debug_pgmres_solve
+    dmsg << "l: " << l+1 << "  err(1): " << err(0);
+    #endif
+
+    if (l == 0) {
+      eps = err(0);
 
+      if (eps <= ls.absTol) {
+        ls.callD = std::numeric_limits<double>::epsilon();
+        ls.dB = 0.0;
+        return false; 
+      }
+
+      ls.iNorm = eps;
+      ls.fNorm = eps;
+      eps = std::max(ls.absTol, ls.relTol*eps);
+
+    } else if (err(0) < eps) {
+      ls.fNorm = err(0);
+      ls.suc = true;
+      break;
+    }
+
+    ls.dB = ls.fNorm;
+    omp_la::omp_mul_v(dof, nNo, 1.0/err(0), v_0);
 
+    auto z_1 = z.rslice(1);
+    pgmres_op(lhs, dof, Val, bc_prec, v_0, z_1);
+    ls.itr = ls.itr + 1;
+
+    int last_i = -1;
+    bool breakdown = false;
+
+    for (int i = 0; i < sD; i++) {
+      auto z_i = z.rslice(i+1);
+      bool next = (i+1 < sD);
+
+      // Local parts of <z_{i+1},v_j>, |z_{i+1}|^2 and of the shared face 
+      // products v_f^T z_{i+1}.
+      //
+      for (int j = 0; j <= i; j++) {
+        dl(j) = dot::fsils_nc_dot_v(dof, mynNo, z_i, v.rslice(j));
+      }
+      dl(i+1) = dot::fsils_nc_dot_v(dof, mynNo, z_i, z_i);
+      int n = i+2;
+      if (next) {
+        n = pgmres_face_dots(lhs, dof, z_i, true, dl, n);
+      }
+
+      MPI_Request req;
+      if (parallel) {
+        MPI_Iallreduce(dl.data(), dg.data(), n, cm_mod::mpreal, MPI_SUM, lhs.commu.comm, &req);
+      }
+
+      // Compute A*z_{i+1} while the reduction is in progress, the shared 
+      // face contributions are added when it is complete.
+      //
+      if (next) {
+        auto z_n = z.rslice(i+2);
+        spar_mul::fsils_spar_mul_vv(lhs, lhs.rowPtr, lhs.colPtr, dof, Val, z_i, z_n);
+        pgmres_face_dots(lhs, dof, z_i, false, fu, 0);
+        pgmres_face_add(lhs, BcopType::BCOP_TYPE_ADD, dof, fu, false, z_n, 0);
+        ls.itr = ls.itr + 1;
+      }
+
+      if (parallel) {
+        MPI_Wait(&req, MPI_STATUS_IGNORE);
+      } else {
+        dg = dl;
+      }
+
+      MPI_Request preq;
+      bool prec_reduce = false;
+
+      if (next) {
+        auto z_n = z.rslice(i+2);
+        pgmres_face_add(lhs, BcopType::BCOP_TYPE_ADD, dof, dg, true, z_n, i+2);
+
+        if (bc_prec) {
+          pgmres_face_dots(lhs, dof, z_n, false, pu, 0);
+          pgmres_face_dots(lhs, dof, z_n, true, pl, 0);
+          prec_reduce = parallel && (nsf > 0);
+          if (prec_reduce) {
+            MPI_Iallreduce(pl.data(), pg.data(), nsf, cm_mod::mpreal, MPI_SUM, lhs.commu.comm, &preq);
+          } else {
+            pg = pl;
+          }
+        }
+      }
+
+      double hh = dg(i+1);
+      for (int j = 0; j <= i; j++) {
+        h(j,i) = dg(j);
+        hh = hh - h(j,i)*h(j,i);
+      }
+
+      breakdown = (hh <= 0.0);
+      h(i+1,i) = breakdown ? 0.0 : sqrt(hh);
+      last_i = i;
+
+      if (!breakdown) {
+        auto v_n = v.rslice(i+1);
+        v_n = z_i;
+        for (int j = 0; j <= i; j++) {
+          omp_la::omp_sum_v(dof, nNo, -h(j,i), v_n, v.rslice(j));
+        }
+        omp_la::omp_mul_v(dof, nNo, 1.0/h(i+1,i), v_n);
+      }
+
+      if (prec_reduce) {
+        MPI_Wait(&preq, MPI_STATUS_IGNORE);
+      }
+
+      if (next) {
+        auto z_n = z.rslice(i+2);
+
+        if (bc_prec) {
+          pgmres_face_add(lhs, BcopType::BCOP_TYPE_PRE, dof, pu, false, z_n, 0);
+          pgmres_face_add(lhs, BcopType::BCOP_TYPE_PRE, dof, pg, true, z_n, 0);
+        }
+
+        if (!breakdown) {
+          for (int j = 0; j <= i; j++) {
+            omp_la::omp_sum_v(dof, nNo, -h(j,i), z_n, z.rslice(j+1));
+          }
+          omp_la::omp_mul_v(dof, nNo, 1.0/h(i+1,i), z_n);
+        }
+      }
+
+      for (int j = 0; j <= i-1; j++) {
+        double tmp = c(j)*h(j,i) + s(j)*h(j+1,i);
+        h(j+1,i) = -s(j)*h(j,i) + c(j)*h(j+1,i);
+        h(j,i) = tmp;
+      }
+
+      double tmp = sqrt(h(i,i)*h(i,i) + h(i+1,i)*h(i+1,i));
+      c(i) = h(i,i) / tmp;
+      s(i) = h(i+1,i) / tmp;
+      h(i,i) = tmp;
+      h(i+1,i) = 0.0;
+      err(i+1) = -s(i)*err(i);
+      err(i) = c(i)*err(i);
+      #ifdef debug_pgmres_solve
+      dmsg << "i: " << i+1 << "  err(i+1): " << err(i+1) << "  breakdown: " << breakdown;
+      #endif
+
+      if (breakdown) {
+        break;
+      }
+
+      if (fabs(err(i+1)) < eps) {
+        ls.suc = true;
+        break;
+      }
+    } // for int i = 0; i < sD
+
+    for (int i = 0; i <= last_i; i++) {
+      y(i) = err(i);
+    }
+
+    for (int j = last_i; j >= 0; j--) { 
+      for (int k = j+1; k <= last_i; k++) {
+        y(j) = y(j) - h(j,k)*y(k);
+      }
+      y(j) = y(j) / h(j,j);
+    }
+
+    for (int j = 0; j <= last_i; j++) {
+      omp_la::omp_sum_v(dof, nNo, y(j), X, v.rslice(j));
+    }
+
+    ls.fNorm = fabs(err(last_i+1));
+    if (ls.suc) {
+      break;
+    }
+
+    // The residual estimate err(last_i+1) is not valid after a breakdown,
+    // compute the true residual which is also used to restart.
+    //
+    if (breakdown) {
+      ls.fNorm = pgmres_residual(lhs, dof, Val, bc_prec, R, X, v_0);
+      ls.itr = ls.itr + 1;
+      restart = true;
+      if (ls.fNorm < eps) {
+        ls.suc = true;
+        break;
+      }
+    }
+  } // for l = 0; l < ls.mItr
+
+  ls.callD = fsi_linear_solver::fsils_cpu_t() - time + ls.callD;
+  ls.dB  = 10.0 * log(ls.fNorm / ls.dB);
+
+  return true;
+}
+
+/// @brief Solve the system Val * X = R with the pipelined GMRES.
+///
+/// This is a replacement for gmres() used by the NS solver, the coupled BC 
+/// preconditioner is applied as in gmres().
+//
+void pgmres(fsi_linear_solver::FSILS_lhsType& lhs, fsi_linear_solver::FSILS_subLsType& ls, const int dof, 
+    const fsi_linear_solver::FSILS_valBlockType& Val, const Array<double>& R, Array<double>& X)
+{
+  pgmres_solve(lhs, ls, dof, Val, R, X, true);
+}
+
+/// @brief Solve the system Val * X = R with the pipelined GMRES, the 
+/// solution is returned in R.
+///
+/// This is a replacement for gmres_s() and gmres_v(). As in those solvers 
+/// the coupled BC preconditioner is not applied.
+//
+void pgmres_v(fsi_linear_solver::FSILS_lhsType& lhs, fsi_linear_solver::FSILS_subLsType& ls, const int dof,
+    const Array<double>& Val, Array<double>& R)
+{
+  Array<double> X(dof,lhs.nNo);
+
+  ls.itr = 0;
+  ls.callD = 0.0;
+
+  bc_pre(lhs, ls, dof, lhs.mynNo, lhs.nNo);
+
+  fsi_linear_solver::FSILS_valBlockType K(Val.data(), dof*dof, dof);
+
+  if (pgmres_solve(lhs, ls, dof, K, R, X, false)) {
+    R = X;
+  }
+}
+
+};
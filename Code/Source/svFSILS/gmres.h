@@ -33,7 +33,7 @@
 namespace gmres {
 
 void gmres(fsi_linear_solver::FSILS_lhsType& lhs, fsi_linear_solver::FSILS_subLsType& ls, const int dof,
-    const Array<double>& Val, const Array<double>& R, Array<double>& X);
+    const fsi_linear_solver::FSILS_valBlockType& Val, const Array<double>& R, Array<double>& X);
 
 void gmres_s(fsi_linear_solver::FSILS_lhsType& lhs, fsi_linear_solver::FSILS_subLsType& ls, const int dof,
     const Vector<double>& Val, Vector<double>& R);
@@ -41,4 +41,10 @@ void gmres_s(fsi_linear_solver::FSILS_lhsType& lhs, fsi_linear_solver::FSILS_sub
 void gmres_v(fsi_linear_solver::FSILS_lhsType& lhs, fsi_linear_solver::FSILS_subLsType& ls, const int dof,
     const Array<double>& Val, Array<double>& R);
 
+void pgmres(fsi_linear_solver::FSILS_lhsType& lhs, fsi_linear_solver::FSILS_subLsType& ls, const int dof,
+    const fsi_linear_solver::FSILS_valBlockType& Val, const Array<double>& R, Array<double>& X);
+
+void pgmres_v(fsi_linear_solver::FSILS_lhsType& lhs, fsi_linear_solver::FSILS_subLsType& ls, const int dof,
+    const Array<double>& Val, Array<double>& R);
+
 };
@@ -42,133 +42,176 @@
 #include "CmMod.h"
 #include "Array3.h"
 
+#include <string>
+
 #include "fsils_std.h"
 
 namespace fsi_linear_solver {
 
-void fsils_commus(const FSILS_lhsType& lhs, Vector<double>& R)
+/// @brief Set the offsets of the shared nodes of each neighbor in the
+/// communication buffers. Called when the lhs is created.
+///
+/// Modifies: lhs.cSDisp
+//
+void fsils_commu_init(FSILS_lhsType& lhs)
 {
-  if (lhs.commu.nTasks == 1) {
-    return;
-  }
+  fsils_commu_free(lhs);
 
-  int nReq = lhs.nReq;
-  if (lhs.cS.size() == 0) {
-    return;
-  }
+  lhs.cSDisp.resize(lhs.nReq+1);
+  lhs.cSDisp(0) = 0;
 
-  int nmax = std::max_element(lhs.cS.begin(), lhs.cS.end(), 
-    [](const FSILS_cSType& a, const FSILS_cSType& b){return a.n < b.n;})->n; 
-
-  Array<double> sB(nmax,nReq); 
-  Array<double> rB(nmax,nReq); 
-  std::vector<MPI_Request> rReq(nReq); 
-  std::vector<MPI_Request> sReq(nReq);
+  for (int i = 0; i < lhs.nReq; i++) {
+    lhs.cSDisp(i+1) = lhs.cSDisp(i) + lhs.cS[i].n;
+  }
+}
 
-  for (int i = 0; i < nReq; i++) {
-    for (int j = 0; j < lhs.cS[i].n; j++) { 
-      int k = lhs.cS[i].ptr(j);
-      sB(j,i) = R(k);
+/// @brief Free the persistent requests created for the lhs.
+///
+/// Modifies: lhs.commuReq
+//
+void fsils_commu_free(FSILS_lhsType& lhs)
+{
+  for (auto& entry : lhs.commuReq) {
+    auto& req = entry.second;
+    for (auto& r : req.sReq) {
+      MPI_Request_free(&r);
+    }
+    for (auto& r : req.rReq) {
+      MPI_Request_free(&r);
     }
   }
 
-  int mpi_tag = 1;
+  lhs.commuReq.clear();
+}
 
-  for (int i = 0; i < nReq; i++) {
-    auto rec_err = MPI_Irecv(rB.col_data(i), lhs.cS[i].n, mpreal, lhs.cS[i].iP, mpi_tag, lhs.commu.comm, &rReq[i]);
-    auto send_err = MPI_Isend(sB.col_data(i), lhs.cS[i].n, mpreal, lhs.cS[i].iP, mpi_tag, lhs.commu.comm, &sReq[i]);
+/// @brief Return the persistent buffers and requests used to exchange 'dof'
+/// values per node, creating them on first use.
+//
+static FSILS_commuReqType& commu_req(const FSILS_lhsType& lhs, const int dof)
+{
+  auto it = lhs.commuReq.find(dof);
+  if (it != lhs.commuReq.end()) {
+    return it->second;
   }
 
-  // Wait for the MPI receive to complete.
-  //
-  for (int i = 0; i < nReq; i++) {
-    MPI_Status stat;
-    auto err = MPI_Wait(&rReq[i], &stat);
+  if (lhs.cSDisp.size() != lhs.nReq+1) {
+    throw std::runtime_error("[fsils_commu] The communication structures of the lhs have not been initialized.");
   }
 
-  for (int i = 0; i < nReq; i++) {
-    for (int j = 0; j < lhs.cS[i].n; j++) { 
-      int k = lhs.cS[i].ptr(j);
-      R(k) = R(k) + rB(j,i);
-    }
-  }
+  auto& req = lhs.commuReq[dof];
+  int nReq = lhs.nReq;
+  int mpi_tag = 1;
+
+  req.dof = dof;
+  req.sB.resize(dof*lhs.cSDisp(nReq));
+  req.rB.resize(dof*lhs.cSDisp(nReq));
+  req.sReq.resize(nReq);
+  req.rReq.resize(nReq);
 
-  // Wait for the MPI send to complete.
-  //
   for (int i = 0; i < nReq; i++) {
-    MPI_Status stat;
-    auto err = MPI_Wait(&sReq[i], &stat);
+    int n = dof * lhs.cS[i].n;
+    int iP = lhs.cS[i].iP;
+    double* sB = req.sB.data() + dof*lhs.cSDisp(i);
+    double* rB = req.rB.data() + dof*lhs.cSDisp(i);
+    MPI_Recv_init(rB, n, mpreal, iP, mpi_tag, lhs.commu.comm, &req.rReq[i]);
+    MPI_Send_init(sB, n, mpreal, iP, mpi_tag, lhs.commu.comm, &req.sReq[i]);
   }
+
+  return req;
 }
 
-/// @brief This a both way communication with three main part:
+/// @brief Start the exchange of the 'dof' values per node of the shared 
+/// nodes in R (stored as (dof,nNo)): the values are copied to the send
+/// buffer and the persistent sends and receives are started. 
 ///
-/// 1 - rTmp {in master} = R          {from slave}
-/// 2 - R    {in master} = R + rTmp   {both from master}
-/// 3 - rTmp {in master} = R          {from master}
-/// 4 - R    {in slave}  = rTmp       {from master}
+/// R can be modified at the nodes that are not shared until the exchange is
+/// completed by fsils_commu_end().
 //
-void fsils_commuv(const FSILS_lhsType& lhs, int dof, Array<double>& R)
+void fsils_commu_begin(const FSILS_lhsType& lhs, const int dof, const double* R)
 {
-  if (lhs.commu.nTasks == 1) {
+  if ((lhs.commu.nTasks == 1) || (lhs.cS.size() == 0)) {
     return;
   }
 
-  if (lhs.cS.size() == 0) {
-    return;
-  }
+  auto& req = commu_req(lhs, dof);
 
-  int nReq = lhs.nReq;
-  int nmax = std::max_element(lhs.cS.begin(), lhs.cS.end(), 
-      [](const FSILS_cSType& a, const FSILS_cSType& b){return a.n < b.n;})->n; 
-
-  Array3<double> sB(dof,nmax,nReq); 
-  Array3<double> rB(dof,nmax,nReq); 
-  std::vector<MPI_Request> rReq(nReq); 
-  std::vector<MPI_Request> sReq(nReq);
+  if (req.active) {
+    throw std::runtime_error("[fsils_commu_begin] An exchange of " + std::to_string(dof) + 
+        " values per node is already in progress.");
+  }
 
-  int n = 1;
+  double* sB = req.sB.data();
 
-  for (int i = 0; i < nReq; i++) {
+  for (int i = 0; i < lhs.nReq; i++) {
+    int s = dof * lhs.cSDisp(i);
     for (int j = 0; j < lhs.cS[i].n; j++) { 
       int k = lhs.cS[i].ptr(j);
       for (int l = 0; l < dof; l++) { 
-        sB(l,j,i) = R(l,k);
+        sB[s+dof*j+l] = R[dof*k+l];
       }
     }
   }
 
-  int mpi_tag = 1;
+  MPI_Startall(lhs.nReq, req.rReq.data());
+  MPI_Startall(lhs.nReq, req.sReq.data());
+  req.active = true;
+}
 
-  for (int i = 0; i < nReq; i++) {
-    auto rec_err = MPI_Irecv(rB.slice_data(i), lhs.cS[i].n*dof, mpreal, lhs.cS[i].iP, mpi_tag, lhs.commu.comm, &rReq[i]);
-    auto send_err = MPI_Isend(sB.slice_data(i), lhs.cS[i].n*dof, mpreal, lhs.cS[i].iP, mpi_tag, lhs.commu.comm, &sReq[i]);
+/// @brief Complete an exchange started by fsils_commu_begin(), adding the 
+/// received values to the shared nodes of R.
+//
+void fsils_commu_end(const FSILS_lhsType& lhs, const int dof, double* R)
+{
+  if ((lhs.commu.nTasks == 1) || (lhs.cS.size() == 0)) {
+    return;
+  }
+
+  auto& req = commu_req(lhs, dof);
+
+  if (!req.active) {
+    return;
   }
 
   // Wait for the MPI receive to complete.
   //
-  for (int i = 0; i < nReq; i++) {
-    MPI_Status stat;
-    auto err = MPI_Wait(&rReq[i], &stat);
-  }
+  MPI_Waitall(lhs.nReq, req.rReq.data(), MPI_STATUSES_IGNORE);
 
-  for (int i = 0; i < nReq; i++) {
+  const double* rB = req.rB.data();
+
+  for (int i = 0; i < lhs.nReq; i++) {
+    int s = dof * lhs.cSDisp(i);
     for (int j = 0; j < lhs.cS[i].n; j++) { 
       int k = lhs.cS[i].ptr(j);
       for (int l = 0; l < dof; l++) { 
-        R(l,k) = R(l,k) + rB(l,j,i);
+        R[dof*k+l] = R[dof*k+l] + rB[s+dof*j+l];
       }
     }
   }
 
   // Wait for the MPI send to complete.
   //
-  for (int i = 0; i < nReq; i++) {
-    MPI_Status stat;
-    auto err = MPI_Wait(&sReq[i], &stat);
-  }
+  MPI_Waitall(lhs.nReq, req.sReq.data(), MPI_STATUSES_IGNORE);
+
+  req.active = false;
 }
 
-};
+void fsils_commus(const FSILS_lhsType& lhs, Vector<double>& R)
+{
+  fsils_commu_begin(lhs, 1, R.data());
+  fsils_commu_end(lhs, 1, R.data());
+}
 
+/// @brief This a both way communication with three main part:
+///
+/// 1 - rTmp {in master} = R          {from slave}
+/// 2 - R    {in master} = R + rTmp   {both from master}
+/// 3 - rTmp {in master} = R          {from master}
+/// 4 - R    {in slave}  = rTmp       {from master}
+//
+void fsils_commuv(const FSILS_lhsType& lhs, int dof, Array<double>& R)
+{
+  fsils_commu_begin(lhs, dof, R.data());
+  fsils_commu_end(lhs, dof, R.data());
+}
 
+};
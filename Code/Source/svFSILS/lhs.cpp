@@ -33,11 +33,173 @@
 #include "lhs.h"
 #include "CmMod.h"
 #include "DebugMsg.h"
+#include "fsils_api.hpp"
 
 #include "mpi.h"
 
+#include <algorithm>
+#include <array>
+#include <utility>
+#include <vector>
+
 namespace fsi_linear_solver {
 
+/// @brief Set lhs.transPtr, the index of the transposed entry of each entry,
+/// -1 if the transposed entry is not in the sparsity pattern.
+//
+static void set_trans_ptr(FSILS_lhsType& lhs)
+{
+  lhs.transPtr.resize(lhs.nnz);
+
+  for (int Ac = 0; Ac < lhs.nNo; Ac++) {
+    for (int i = lhs.rowPtr(0,Ac); i <= lhs.rowPtr(1,Ac); i++) {
+      int a = lhs.colPtr(i);
+      lhs.transPtr(i) = -1;
+      for (int j = lhs.rowPtr(0,a); j <= lhs.rowPtr(1,a); j++) {
+        if (lhs.colPtr(j) == Ac) {
+          lhs.transPtr(i) = j;
+          break;
+        }
+      }
+    }
+  }
+}
+
+/// @brief Return the local node of global node 'Ac' using the sorted global 
+/// to local node map 'gtl'.
+//
+static int local_node(const std::vector<std::pair<int,int>>& gtl, const int Ac)
+{
+  auto it = std::lower_bound(gtl.begin(), gtl.end(), std::make_pair(Ac, -1));
+
+  if ((it == gtl.end()) || (it->first != Ac)) {
+    throw std::runtime_error("FSILS: Global node " + std::to_string(Ac) + " is not on this processor.");
+  }
+
+  return it->second;
+}
+
+/// @brief Find the nodes shared with other processors.
+///
+/// The global node IDs are split into blocks, one per processor, forming a 
+/// distributed directory. Each processor registers its nodes with the owner 
+/// of their block, which returns the other processors registering the same 
+/// node. Memory and communication only depend on the local number of nodes.
+///
+/// Returns (local node, processor, position of the node in the gNodes of
+/// that processor) for each node and each other processor sharing it.
+//
+static std::vector<std::array<int,3>> find_shared_nodes(const FSILS_commuType& commu, const int gnNo, const int nNo, 
+    const Vector<int>& gNodes, const std::vector<std::pair<int,int>>& gtl)
+{
+  int nTasks = commu.nTasks;
+  auto comm = commu.comm;
+  int blkSize = (gnNo + nTasks - 1) / nTasks;
+
+  std::vector<int> sCount(nTasks, 0);
+  std::vector<int> rCount(nTasks);
+  std::vector<int> sDisp(nTasks);
+  std::vector<int> rDisp(nTasks);
+
+  auto exchange = [&](std::vector<int>& sBuf, std::vector<int>& rBuf) -> void {
+    MPI_Alltoall(sCount.data(), 1, cm_mod::mpint, rCount.data(), 1, cm_mod::mpint, comm);
+    sDisp[0] = 0;
+    rDisp[0] = 0;
+    for (int i = 1; i < nTasks; i++) {
+      sDisp[i] = sDisp[i-1] + sCount[i-1];
+      rDisp[i] = rDisp[i-1] + rCount[i-1];
+    }
+    rBuf.resize(rDisp[nTasks-1] + rCount[nTasks-1]);
+    MPI_Alltoallv(sBuf.data(), sCount.data(), sDisp.data(), cm_mod::mpint, rBuf.data(), rCount.data(), 
+        rDisp.data(), cm_mod::mpint, comm);
+  };
+
+  // Register (global node, position) with the directory.
+  //
+  for (int a = 0; a < nNo; a++) {
+    sCount[gNodes(a) / blkSize] += 2;
+  }
+
+  std::vector<int> sBuf(2*nNo);
+  std::vector<int> rBuf;
+  std::vector<int> offset(nTasks, 0);
+  for (int i = 1; i < nTasks; i++) {
+    offset[i] = offset[i-1] + sCount[i-1];
+  }
+
+  for (int a = 0; a < nNo; a++) {
+    int iP = gNodes(a) / blkSize;
+    sBuf[offset[iP]] = gNodes(a);
+    sBuf[offset[iP]+1] = a;
+    offset[iP] += 2;
+  }
+
+  exchange(sBuf, rBuf);
+
+  // Directory entries (global node, processor, position) sorted by node.
+  //
+  std::vector<std::array<int,3>> dir;
+  dir.reserve(rBuf.size() / 2);
+  for (int iP = 0; iP < nTasks; iP++) {
+    for (int i = rDisp[iP]; i < rDisp[iP] + rCount[iP]; i += 2) {
+      dir.push_back({rBuf[i], iP, rBuf[i+1]});
+    }
+  }
+  std::sort(dir.begin(), dir.end());
+
+  // Send each processor sharing a node the other processors sharing it.
+  //
+  int nDir = dir.size();
+  std::vector<std::pair<int,int>> groups;
+  for (int s = 0; s < nDir; ) {
+    int e = s + 1;
+    while ((e < nDir) && (dir[e][0] == dir[s][0])) {
+      e = e + 1;
+    }
+    if (e - s > 1) {
+      groups.push_back(std::make_pair(s, e));
+    }
+    s = e;
+  }
+
+  std::fill(sCount.begin(), sCount.end(), 0);
+  for (auto& [s, e] : groups) {
+    for (int m = s; m < e; m++) {
+      sCount[dir[m][1]] += 3 * (e - s - 1);
+    }
+  }
+
+  offset[0] = 0;
+  for (int i = 1; i < nTasks; i++) {
+    offset[i] = offset[i-1] + sCount[i-1];
+  }
+  sBuf.resize(offset[nTasks-1] + sCount[nTasks-1]);
+
+  for (auto& [s, e] : groups) {
+    for (int m = s; m < e; m++) {
+      int iP = dir[m][1];
+      for (int o = s; o < e; o++) {
+        if (o != m) {
+          sBuf[offset[iP]] = dir[o][0];
+          sBuf[offset[iP]+1] = dir[o][1];
+          sBuf[offset[iP]+2] = dir[o][2];
+          offset[iP] += 3;
+        }
+      }
+    }
+  }
+
+  exchange(sBuf, rBuf);
+
+  int nShared = rBuf.size() / 3;
+  std::vector<std::array<int,3>> shared(nShared);
+  for (int i = 0; i < nShared; i++) {
+    shared[i] = {local_node(gtl, rBuf[3*i]), rBuf[3*i+1], rBuf[3*i+2]};
+  }
+
+  return shared;
+}
+
 /// @brief Modifies:
 ///
 ///  lhs.foC 
@@ -51,6 +213,7 @@ namespace fsi_linear_solver {
 ///  lhs.colPtr
 ///  lhs.rowPtr
 ///  lhs.diagPtr
+///  lhs.transPtr
 ///  lhs.map
 ///  lhs.face
 //
@@ -115,97 +278,71 @@ void fsils_lhs_create(FSILS_lhsType& lhs, FSILS_commuType& commu, int gnNo, int
       lhs.map(Ac) = Ac;
     }
 
+    set_trans_ptr(lhs);
     lhs.mynNo = nNo;
     return; 
   }
 
-  // Get the number of nodes for this process and the max number of 
-  // nodes for all processes.
+  // Sorted global to local node map of this process.
   //
-  // Combines values from all processes and distributes the result back to all processes.
-  //
-  int maxnNo;
-  MPI_Allreduce(&nNo, &maxnNo, 1, cm_mod::mpint, MPI_MAX, comm);
+  std::vector<std::pair<int,int>> gtl(nNo);
+  for (int a = 0; a < nNo; a++) {
+    gtl[a] = std::make_pair(gNodes(a), a);
+  }
+  std::sort(gtl.begin(), gtl.end());
 
+  // Find the processes sharing the nodes of this process.
+  //
+  auto shared = find_shared_nodes(commu, gnNo, nNo, gNodes, gtl);
   #ifdef debug_fsils_lhs_create
-  dmsg << "nNo: " << nNo;
-  dmsg << "maxnNo: " << maxnNo;
+  dmsg << "shared.size(): " << shared.size();
   #endif
 
-  // Initialize some data structures.
+  // The highest ID of the other processes sharing a node and the 
+  // position of the node in the gNodes of that process.
   //
-  Vector<int> part(maxnNo); 
-  part = -1;
-
-  for (int i = 0; i < nNo; i++) {
-    part(i) = gNodes(i);
-  }
-
-  Vector<int> sCount(nTasks); 
-  Vector<int> disp(nTasks); 
-
-  for (int i = 0; i < nTasks; i++) {
-     disp(i) = i*maxnNo;
-     sCount(i) = maxnNo;
-  }
-
-  Array<int> aNodes(maxnNo,nTasks); 
-  Vector<int> ltg(nNo);
-
-  // Gather data from all processes and deliver it to all. Each process may contribute a different amount of data.
-  MPI_Allgatherv(part.data(), maxnNo, cm_mod::mpint, aNodes.data(), sCount.data(), disp.data(), cm_mod::mpint, comm);
-
-  Vector<int> gtlPtr(gnNo); 
-  gtlPtr = -1;
-
-  for (int a = 0; a < nNo; a++) {
-     int Ac = gNodes(a);
-     gtlPtr(Ac) = a;
+  Vector<int> maxP(nNo);
+  Vector<int> maxPos(nNo);
+  maxP = -1;
+
+  for (auto& node : shared) {
+    int a = node[0];
+    if (node[1] > maxP(a)) {
+      maxP(a) = node[1];
+      maxPos(a) = node[2];
+    }
   }
 
   // Including the nodes shared by processors with higher ID at the end,
   // and including the nodes shared by lower processors IDs at the front.
   // shnNo is counter for lower ID and mynNo is counter for higher ID
   //
-  lhs.mynNo = nNo;
-  lhs.shnNo = 0;
-  #ifdef debug_fsils_lhs_create
-  dmsg << "lhs.mynNo: " << lhs.mynNo;
-  dmsg << "tF: " << tF;
-  #endif
-
-  for (int i = nTasks-1; i >= 0; i--) { 
-    // Will include local nodes later
-    if (i == tF) {
-      continue; 
+  // Shared nodes are visited processor by processor from the highest ID 
+  // down, in the node order of that processor, so a node is placed by 
+  // the highest processor sharing it.
+  //
+  std::vector<std::array<int,3>> order;
+  for (int a = 0; a < nNo; a++) {
+    if (maxP(a) != -1) {
+      order.push_back({-maxP(a), maxPos(a), a});
     }
+  }
+  std::sort(order.begin(), order.end());
 
-    for (int a = 0; a < maxnNo; a++) { 
-      // Global node number in processor i at location a
-      int Ac = aNodes(a,i);
-      // Exit if this is the last node
-      if (Ac == -1) {
-        break; 
-      }
+  Vector<int> ltg(nNo);
+  lhs.mynNo = nNo;
+  lhs.shnNo = 0;
 
-      // Corresponding local node in current processor.
-      int ai = gtlPtr(Ac);
-      if (ai != -1) {
-        // If this node has not been included already
-        if (aNodes(ai,tF) != -1) {
-          // If the processor ID is lower, it is appended to the beginning
-          if (i < tF) {
-            ltg(lhs.shnNo) = Ac;
-            lhs.shnNo = lhs.shnNo + 1;
-          // If the processor ID is higher, it is appended to the end
-          } else {
-            ltg(lhs.mynNo-1) = Ac;
-            lhs.mynNo = lhs.mynNo - 1;
-          }
-          aNodes(ai,tF) = -1;
-        }
-      }
+  for (auto& node : order) {
+    int a = node[2];
+    if (-node[0] < tF) {
+      lhs.map(a) = lhs.shnNo;
+      lhs.shnNo = lhs.shnNo + 1;
+    } else {
+      lhs.mynNo = lhs.mynNo - 1;
+      lhs.map(a) = lhs.mynNo;
     }
+    ltg(lhs.map(a)) = gNodes(a);
   }
 
   #ifdef debug_fsils_lhs_create
@@ -215,33 +352,18 @@ void fsils_lhs_create(FSILS_lhsType& lhs, FSILS_commuType& commu, int gnNo, int
 
   // Now including the local nodes that are left behind
   //
-  int j = lhs.shnNo + 1;
+  int j = lhs.shnNo;
 
   for (int a = 0; a < nNo; a++) {
-    int Ac = aNodes(a,tF);
-    //  If this node has not been included already
-    if (Ac != -1) {
-      ltg(j-1) = Ac;
+    if (maxP(a) == -1) {
+      lhs.map(a) = j;
+      ltg(j) = gNodes(a);
       j = j + 1;
     }
   }
 
-  if (j != lhs.mynNo+1) {
+  if (j != lhs.mynNo) {
     throw std::runtime_error("FSILS: Unexpected behavior: j=" + std::to_string(j) + " lhs.mynNo: " + std::to_string(lhs.mynNo) + ".");
-    MPI_Finalize();
-  }
-
-  // Having the new ltg pointer, map is constructed
-  //
-  gtlPtr = -1;
-  for (int a = 0; a < nNo; a++) {
-     int Ac = ltg(a);
-     gtlPtr(Ac) = a;
-  }
-
-  for (int a = 0; a < nNo; a++) {
-     int Ac = gNodes(a);
-     lhs.map(a) = gtlPtr(Ac);
   }
 
   // Based on the new ordering of the nodes, rowPtr and colPtr are constructed
@@ -267,37 +389,21 @@ void fsils_lhs_create(FSILS_lhsType& lhs, FSILS_commuType& commu, int gnNo, int
     }
   }
 
-  // Constructing the communication data structure based on the ltg
+  set_trans_ptr(lhs);
+
+  // Constructing the communication data structure: the shared nodes 
+  // grouped by processor in ascending ID order.
   //
-  for (int i = 0; i < nNo; i++) {
-    part(i) = ltg(i);
+  int nComNodes = shared.size();
+  std::vector<std::pair<int,int>> comNodes(nComNodes);
+  for (int i = 0; i < nComNodes; i++) {
+    comNodes[i] = std::make_pair(shared[i][1], lhs.map(shared[i][0]));
   }
+  std::sort(comNodes.begin(), comNodes.end());
 
-  MPI_Allgatherv(part.data(), maxnNo, cm_mod::mpint, aNodes.data(), sCount.data(), disp.data(), cm_mod::mpint, comm);
-
-  // This variable keeps track of number of shared nodes
-  disp = 0;
   lhs.nReq = 0;
-
-  for (int i = 0; i < nTasks; i++) {
-    if (i == tF) {
-      continue; 
-    }
-    for (int a = 0; a <  maxnNo; a++) {
-      // Global node number in processor i at location a
-      int Ac = aNodes(a,i);
-      // Exit if this is the last node
-      if (Ac == -1) {
-        break;
-      }
-      // Corresponding local node in current processor
-      int ai = gtlPtr(Ac);
-      if (ai != -1) {
-        disp(i) = disp(i) + 1;
-      }
-    }
-
-    if (disp(i) != 0) {
+  for (int i = 0; i < nComNodes; i++) {
+    if ((i == 0) || (comNodes[i].first != comNodes[i-1].first)) {
       lhs.nReq = lhs.nReq + 1;
     }
   }
@@ -315,63 +421,80 @@ void fsils_lhs_create(FSILS_lhsType& lhs, FSILS_commuType& commu, int gnNo, int
   #ifdef debug_fsils_lhs_create
   dmsg << "Setup the handles ...";
   #endif
-  j = 0;
-  for (int i = 0; i < nTasks; i++) {
-    int a = disp(i);
-    if (a != 0) {
-      lhs.cS[j].iP = i;
-      lhs.cS[j].n = a;
-      lhs.cS[j].ptr.resize(a);
+  j = -1;
+  for (int i = 0; i < nComNodes; i++) {
+    if ((i == 0) || (comNodes[i].first != comNodes[i-1].first)) {
       j = j + 1;
+      lhs.cS[j].iP = comNodes[i].first;
+      lhs.cS[j].n = 0;
     }
+    lhs.cS[j].n = lhs.cS[j].n + 1;
   }
 
   // Order of nodes in ptr is based on the node order in processor
-  // with higher ID. ptr is calculated for tF+1:nTasks and will be
-  // sent over.
+  // with higher ID. The processor with higher ID sends its order as
+  // global node IDs.
   //
   #ifdef debug_fsils_lhs_create
   dmsg << "Order of nodes ...";
   #endif
-  MPI_Status status;
+  std::vector<MPI_Request> requests(lhs.nReq);
+  Vector<int> sendNodes(comNodes.size());
+  int k = 0;
 
   for (int i = 0; i < lhs.nReq; i++) {
     int iP = lhs.cS[i].iP;
+    int n = lhs.cS[i].n;
+    lhs.cS[i].ptr.resize(n);
 
     if (iP < tF) {
-      MPI_Recv(lhs.cS[i].ptr.data(), lhs.cS[i].n, cm_mod::mpint, iP, 1,  comm, &status);
-
-      for (int j = 0; j < lhs.cS[i].n; j++) { 
-        lhs.cS[i].ptr[j] = gtlPtr(lhs.cS[i].ptr[j]);
+      for (int j = 0; j < n; j++) {
+        lhs.cS[i].ptr[j] = comNodes[k+j].second;
+        sendNodes(k+j) = ltg(comNodes[k+j].second);
       }
+      MPI_Isend(&sendNodes(k), n, cm_mod::mpint, iP, 1, comm, &requests[i]);
     } else {
-      // This is a counter for the shared nodes
-      j = 0;
-      for (int a = 0; a < maxnNo; a++) {
-        // Global node number in processor i at location a
-        int Ac = aNodes(a,iP);
-        // Exit if this is the last node
-        if (Ac == -1) {
-          break; 
-        }
-        // Corresponding local node in current processor
-        int ai = gtlPtr(Ac);
-        if (ai != -1) {
-          // Just for now global node ID is used. Later on this will be changed
-          // to make sure nodes corresponds to each other on both processors
-          // and then will be transformed to local node IDs
-          lhs.cS[i].ptr[j] = Ac;
-          j = j + 1;
-        }
-      }
+      MPI_Irecv(lhs.cS[i].ptr.data(), n, cm_mod::mpint, iP, 1, comm, &requests[i]);
+    }
+
+    k = k + n;
+  }
 
-      MPI_Send(lhs.cS[i].ptr.data(), lhs.cS[i].n, cm_mod::mpint, iP, 1, comm);
+  MPI_Waitall(lhs.nReq, requests.data(), MPI_STATUSES_IGNORE);
 
+  for (int i = 0; i < lhs.nReq; i++) {
+    if (lhs.cS[i].iP > tF) {
       for (int j = 0; j < lhs.cS[i].n; j++) {
-        lhs.cS[i].ptr[j] = gtlPtr(lhs.cS[i].ptr[j]);
+        lhs.cS[i].ptr[j] = lhs.map(local_node(gtl, lhs.cS[i].ptr[j]));
       }
     }
   }
+
+  // Set up the persistent communication of the shared nodes.
+  //
+  fsils_commu_init(lhs);
+}
+
+/// @brief Set up lhs from the node ordering, sparsity pattern and 
+/// communication structure computed by an earlier fsils_lhs_create() call 
+/// with the same arguments, read from the svFSI partition cache. 
+///
+/// The caller sets lhs.mynNo, lhs.shnNo, lhs.map, lhs.rowPtr, lhs.colPtr,
+/// lhs.diagPtr, lhs.transPtr, lhs.nReq and lhs.cS.
+//
+void fsils_lhs_restore(FSILS_lhsType& lhs, FSILS_commuType& commu, int gnNo, int nNo, int nnz, int nFaces)
+{
+  lhs.foC = true; 
+  lhs.gnNo = gnNo;
+  lhs.nNo = nNo;
+  lhs.nnz = nnz;
+  lhs.commu = commu;
+  lhs.nFaces = nFaces;
+  lhs.face.resize(nFaces);
+
+  if (commu.nTasks > 1) {
+    fsils_commu_init(lhs);
+  }
 }
 
 //----------------
@@ -390,6 +513,8 @@ void fsils_lhs_free(FSILS_lhsType& lhs)
     //IF (ALLOCATED(lhs.cS(i).ptr)) DEALLOCATE(lhs.cS(i).ptr)
   }
 
+  fsils_commu_free(lhs);
+
   lhs.foC = false;
   lhs.gnNo   = 0;
   lhs.nNo    = 0;
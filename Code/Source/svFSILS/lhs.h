@@ -43,6 +43,8 @@ void fsils_lhs_create(FSILS_lhsType& lhs, FSILS_commuType& commu, int gnNo, int
 
 void fsils_lhs_free(FSILS_lhsType& lhs);
 
+void fsils_lhs_restore(FSILS_lhsType& lhs, FSILS_commuType& commu, int gnNo, int nNo, int nnz, int nFaces);
+
 };
 
 #endif
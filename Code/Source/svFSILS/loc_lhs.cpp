@@ -0,0 +1,312 @@
+/* Copyright (c) Stanford University, The Regents of the University of California, and others.
+ *
+ * All Rights Reserved.
+ *
+ * See Copyright-SimVascular.txt for additional details.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Matrix of the nodes local to a process.
+//
+// The matrix rows of the nodes shared between processes are only partially
+// assembled on each process. The values of the couplings between shared 
+// nodes are summed here over the processes sharing them so that the local 
+// matrix is the restriction of the global matrix to the local nodes, as 
+// used by the additive Schwarz preconditioners.
+
+#include "loc_lhs.h"
+
+#include "fsils_api.hpp"
+
+#include "mpi.h"
+
+#include <algorithm>
+#include <math.h>
+
+namespace loc_lhs {
+
+/// @brief Invert a diagonal block. Components with a zero diagonal 
+/// (Dirichlet dof after scaling) are excluded, their rows and columns of 
+/// the inverse are set to zero.
+//
+void block_inverse(const int d, const double* A, double* Ainv)
+{
+  std::vector<int> id;
+  for (int i = 0; i < d; i++) {
+    if (A[i*d+i] != 0.0) {
+      id.push_back(i);
+    }
+  }
+
+  int m = id.size();
+  std::vector<double> M(m*m), I(m*m, 0.0);
+
+  for (int i = 0; i < m; i++) {
+    for (int j = 0; j < m; j++) {
+      M[i*m+j] = A[id[i]*d+id[j]];
+    }
+    I[i*m+i] = 1.0;
+  }
+
+  // Gauss-Jordan elimination with partial pivoting.
+  //
+  for (int k = 0; k < m; k++) {
+    int p = k;
+    for (int i = k+1; i < m; i++) {
+      if (fabs(M[i*m+k]) > fabs(M[p*m+k])) {
+        p = i;
+      }
+    }
+
+    if (M[p*m+k] == 0.0) {
+      for (int j = 0; j < m; j++) {
+        I[k*m+j] = 0.0;
+      }
+      continue;
+    }
+
+    if (p != k) {
+      for (int j = 0; j < m; j++) {
+        std::swap(M[k*m+j], M[p*m+j]);
+        std::swap(I[k*m+j], I[p*m+j]);
+      }
+    }
+
+    double s = 1.0 / M[k*m+k];
+    for (int j = 0; j < m; j++) {
+      M[k*m+j] *= s;
+      I[k*m+j] *= s;
+    }
+
+    for (int i = 0; i < m; i++) {
+      double f = M[i*m+k];
+      if ((i == k) || (f == 0.0)) {
+        continue;
+      }
+      for (int j = 0; j < m; j++) {
+        M[i*m+j] -= f * M[k*m+j];
+        I[i*m+j] -= f * I[k*m+j];
+      }
+    }
+  }
+
+  std::fill(Ainv, Ainv+d*d, 0.0);
+
+  for (int i = 0; i < m; i++) {
+    for (int j = 0; j < m; j++) {
+      Ainv[id[i]*d+id[j]] = I[i*m+j];
+    }
+  }
+}
+
+/// @brief Set the pattern of the local matrix from the lhs, with the 
+/// columns of each row sorted, and the lists of entries exchanged with the
+/// processes sharing nodes.
+///
+/// Nothing is done if the pattern was already set for the current lhs
+/// sparsity pattern and dof.
+///
+/// Returns true if the pattern has been (re)created.
+///
+/// Modifies: loc
+//
+bool loc_lhs_set_pattern(FSILS_lhsType& lhs, FSILS_locLhsType& loc, const int dof)
+{
+  int nNo = lhs.nNo;
+
+  bool same = (loc.dof == dof) && (loc.nNo == nNo) && (loc.lhsColPtr.size() == lhs.nnz) && 
+      (loc.lhsRowPtr.ncols() == nNo);
+
+  if (same) {
+    same = std::equal(loc.lhsColPtr.data(), loc.lhsColPtr.data()+lhs.nnz, lhs.colPtr.data()) &&
+        std::equal(loc.lhsRowPtr.data(), loc.lhsRowPtr.data()+2*nNo, lhs.rowPtr.data());
+  }
+
+  if (same) {
+    return false;
+  }
+
+  loc.nNo = nNo;
+  loc.rowPtr.assign(nNo+1, 0);
+  loc.colPtr.resize(lhs.nnz);
+  loc.diagPtr.assign(nNo, -1);
+  loc.valPtr.resize(lhs.nnz);
+
+  std::vector<std::pair<int,int>> row;
+
+  for (int a = 0; a < nNo; a++) {
+    row.clear();
+    for (int i = lhs.rowPtr(0,a); i <= lhs.rowPtr(1,a); i++) {
+      row.push_back({lhs.colPtr(i), i});
+    }
+    std::sort(row.begin(), row.end());
+
+    int k = loc.rowPtr[a];
+    for (auto& entry : row) {
+      if (entry.first == a) {
+        loc.diagPtr[a] = k;
+      }
+      loc.colPtr[k] = entry.first;
+      loc.valPtr[k] = entry.second;
+      k += 1;
+    }
+    loc.rowPtr[a+1] = k;
+  }
+
+  loc.dof = dof;
+  loc.lhsRowPtr = lhs.rowPtr;
+  loc.lhsColPtr = lhs.colPtr;
+  loc.sendPtr.clear();
+  loc.recvPtr.clear();
+
+  if ((lhs.commu.nTasks == 1) || (lhs.nReq == 0)) {
+    return true;
+  }
+
+  // The couplings between two nodes shared with a process are identified 
+  // by the positions of the nodes in lhs.cS[i].ptr, which are in the same 
+  // order on both processes.
+  //
+  int nReq = lhs.nReq;
+  int mpi_tag = 2;
+  std::vector<int> pos(nNo, -1);
+  std::vector<std::vector<int>> sPairs(nReq), rPairs(nReq);
+  std::vector<int> sCount(nReq), rCount(nReq);
+  loc.sendPtr.resize(nReq);
+  loc.recvPtr.resize(nReq);
+
+  for (int i = 0; i < nReq; i++) {
+    auto& cS = lhs.cS[i];
+    for (int j = 0; j < cS.n; j++) {
+      pos[cS.ptr(j)] = j;
+    }
+
+    for (int j = 0; j < cS.n; j++) {
+      int a = cS.ptr(j);
+      for (int k = loc.rowPtr[a]; k < loc.rowPtr[a+1]; k++) {
+        int b = loc.colPtr[k];
+        if (pos[b] != -1) {
+          loc.sendPtr[i].push_back(k);
+          sPairs[i].push_back(j);
+          sPairs[i].push_back(pos[b]);
+        }
+      }
+    }
+
+    for (int j = 0; j < cS.n; j++) {
+      pos[cS.ptr(j)] = -1;
+    }
+    sCount[i] = loc.sendPtr[i].size();
+  }
+
+  std::vector<MPI_Request> req(2*nReq);
+
+  for (int i = 0; i < nReq; i++) {
+    MPI_Irecv(&rCount[i], 1, cm_mod::mpint, lhs.cS[i].iP, mpi_tag, lhs.commu.comm, &req[i]);
+    MPI_Isend(&sCount[i], 1, cm_mod::mpint, lhs.cS[i].iP, mpi_tag, lhs.commu.comm, &req[nReq+i]);
+  }
+  MPI_Waitall(2*nReq, req.data(), MPI_STATUSES_IGNORE);
+
+  for (int i = 0; i < nReq; i++) {
+    rPairs[i].resize(2*rCount[i]);
+    MPI_Irecv(rPairs[i].data(), 2*rCount[i], cm_mod::mpint, lhs.cS[i].iP, mpi_tag, lhs.commu.comm, &req[i]);
+    MPI_Isend(sPairs[i].data(), 2*sCount[i], cm_mod::mpint, lhs.cS[i].iP, mpi_tag, lhs.commu.comm, &req[nReq+i]);
+  }
+  MPI_Waitall(2*nReq, req.data(), MPI_STATUSES_IGNORE);
+
+  for (int i = 0; i < nReq; i++) {
+    auto& cS = lhs.cS[i];
+    loc.recvPtr[i].resize(rCount[i]);
+
+    for (int m = 0; m < rCount[i]; m++) {
+      int a = cS.ptr(rPairs[i][2*m]);
+      int b = cS.ptr(rPairs[i][2*m+1]);
+      auto first = loc.colPtr.begin() + loc.rowPtr[a];
+      auto last = loc.colPtr.begin() + loc.rowPtr[a+1];
+      auto it = std::lower_bound(first, last, b);
+      loc.recvPtr[i][m] = ((it != last) && (*it == b)) ? (it - loc.colPtr.begin()) : -1;
+    }
+  }
+
+  return true;
+}
+
+/// @brief Copy Val to the local matrix and add the values of the couplings
+/// between shared nodes computed by other processes. The pattern must have 
+/// been set with loc_lhs_set_pattern().
+///
+/// Modifies: loc.val
+//
+void loc_lhs_set_values(FSILS_lhsType& lhs, FSILS_locLhsType& loc, const Array<double>& Val)
+{
+  int dof = loc.dof;
+  int dd = dof*dof;
+  int nnz = loc.colPtr.size();
+
+  loc.val.resize(nnz*dd);
+
+  for (int k = 0; k < nnz; k++) {
+    const double* v = &Val(0,loc.valPtr[k]);
+    std::copy(v, v+dd, &loc.val[k*dd]);
+  }
+
+  int nReq = loc.sendPtr.size();
+  if (nReq == 0) {
+    return;
+  }
+
+  int mpi_tag = 2;
+  std::vector<std::vector<double>> sB(nReq), rB(nReq);
+  std::vector<MPI_Request> req(2*nReq);
+
+  for (int i = 0; i < nReq; i++) {
+    sB[i].resize(loc.sendPtr[i].size()*dd);
+    rB[i].resize(loc.recvPtr[i].size()*dd);
+    for (size_t m = 0; m < loc.sendPtr[i].size(); m++) {
+      int k = loc.sendPtr[i][m];
+      std::copy(&loc.val[k*dd], &loc.val[k*dd]+dd, &sB[i][m*dd]);
+    }
+  }
+
+  for (int i = 0; i < nReq; i++) {
+    MPI_Irecv(rB[i].data(), rB[i].size(), cm_mod::mpreal, lhs.cS[i].iP, mpi_tag, lhs.commu.comm, &req[i]);
+    MPI_Isend(sB[i].data(), sB[i].size(), cm_mod::mpreal, lhs.cS[i].iP, mpi_tag, lhs.commu.comm, &req[nReq+i]);
+  }
+  MPI_Waitall(2*nReq, req.data(), MPI_STATUSES_IGNORE);
+
+  for (int i = 0; i < nReq; i++) {
+    for (size_t m = 0; m < loc.recvPtr[i].size(); m++) {
+      int k = loc.recvPtr[i][m];
+      if (k == -1) {
+        continue;
+      }
+      for (int l = 0; l < dd; l++) {
+        loc.val[k*dd+l] += rB[i][m*dd+l];
+      }
+    }
+  }
+}
+
+};
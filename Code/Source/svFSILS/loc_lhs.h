@@ -0,0 +1,65 @@
+/* Copyright (c) Stanford University, The Regents of the University of California, and others.
+ *
+ * All Rights Reserved.
+ *
+ * See Copyright-SimVascular.txt for additional details.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "fils_struct.hpp"
+
+#ifndef FSI_LINEAR_SOLVER_LOC_LHS_H 
+#define FSI_LINEAR_SOLVER_LOC_LHS_H 
+
+namespace loc_lhs {
+
+using namespace fsi_linear_solver;
+
+/// @brief C = C + A*B for dof x dof blocks stored row-major.
+//
+inline void block_mul_add(const int d, const double* A, const double* B, double* C)
+{
+  for (int i = 0; i < d; i++) {
+    for (int k = 0; k < d; k++) {
+      double a = A[i*d+k];
+      if (a == 0.0) {
+        continue;
+      }
+      for (int j = 0; j < d; j++) {
+        C[i*d+j] += a * B[k*d+j];
+      }
+    }
+  }
+}
+
+void block_inverse(const int d, const double* A, double* Ainv);
+
+bool loc_lhs_set_pattern(FSILS_lhsType& lhs, FSILS_locLhsType& loc, const int dof);
+
+void loc_lhs_set_values(FSILS_lhsType& lhs, FSILS_locLhsType& loc, const Array<double>& Val);
+
+};
+
+#endif
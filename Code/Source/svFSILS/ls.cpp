@@ -60,6 +60,7 @@ void fsils_ls_create(FSILS_lsType& ls, LinearSolverType LS_type, double relTol,
     break;
 
     case LinearSolverType::LS_TYPE_GMRES:
+    case LinearSolverType::LS_TYPE_PGMRES:
       ls.RI.relTol = 0.1;
       ls.RI.mItr   = 4;
       ls.RI.sD     = 250;
@@ -84,77 +84,26 @@ void bc_pre(fsi_linear_solver::FSILS_lhsType& lhs, const int nsd, const int dof,
   }
 }
 
-/// @brief Store sections of the 'Val' into separate arrays: 'Gt', 'mK', etc.
+/// @brief Store the pressure coupling sections of 'Val' into separate 
+/// arrays: 'mG' and 'mL'.
+///
+/// They are used in each iteration of the Schur complement solver and are
+/// packed so that these products read contiguous values, the other blocks 
+/// are used in place in Val.
 ///
 /// Modifies: no globals
 //
-void depart(fsi_linear_solver::FSILS_lhsType& lhs, const int nsd, const int dof, const int nNo, const int nnz, 
-    const Array<double>& Val, Array<double>& Gt, Array<double>& mK, Array<double>& mG, Array<double>& mD, Vector<double>& mL)
+void depart(const int nsd, const int dof, const int nnz, const Array<double>& Val, Array<double>& mG, Vector<double>& mL)
 {
-  Vector<double> tmp((nsd+1)*(nsd+1));
-
-  if (nsd == 2) {
-    for (int i = 0; i < nnz; i++) {
-      auto tmp = Val.col(i);
-
-      mK(0,i) = tmp(0);
-      mK(1,i) = tmp(1);
-      mK(2,i) = tmp(3);
-      mK(3,i) = tmp(4);
-
-      mG(0,i) = tmp(2);
-      mG(1,i) = tmp(5);
+  const double* val = Val.data();
+  const int dd = dof*dof;
 
-      mD(0,i) = tmp(6);
-      mD(1,i) = tmp(7);
-
-      mL(i) = tmp(8);
-    }
-
-  } else if (nsd == 3) {
-
-    for (int i = 0; i < nnz; i++) {
-      auto tmp = Val.col(i);
-
-      mK(0,i) = tmp(0);
-      mK(1,i) = tmp(1);
-      mK(2,i) = tmp(2);
-      mK(3,i) = tmp(4);
-      mK(4,i) = tmp(5);
-      mK(5,i) = tmp(6);
-      mK(6,i) = tmp(8);
-      mK(7,i) = tmp(9);
-      mK(8,i) = tmp(10);
-
-      mG(0,i) = tmp(3);
-      mG(1,i) = tmp(7);
-      mG(2,i) = tmp(11);
-
-      mD(0,i) = tmp(12);
-      mD(1,i) = tmp(13);
-      mD(2,i) = tmp(14);
-
-      mL(i)   = tmp(15);
-    }
-
-  } else {
-    //PRINT *, "FSILS: Not defined nsd for DEPART", nsd
-    //STOP "FSILS: FATAL ERROR"
-  }
-
-  for (int i = 0; i < nNo; i++) {
-    for (int j = lhs.rowPtr(0,i); j <= lhs.rowPtr(1,i); j++) {
-      int k = lhs.colPtr(j);
-
-      for (int l = lhs.rowPtr(0,k); l <= lhs.rowPtr(1,k); l++) {
-        if (lhs.colPtr(l) == i) {
-          for (int m = 0; m < Gt.nrows(); m++) {
-            Gt(m,l) = -mG(m,j);
-          }
-          break;
-        }
-      }
+  for (int i = 0; i < nnz; i++) {
+    const double* blk = val + dd*i;
+    for (int l = 0; l < nsd; l++) {
+      mG(l,i) = blk[l*dof + nsd];
     }
+    mL(i) = blk[nsd*dof + nsd];
   }
 }
 
@@ -236,14 +185,14 @@ void ns_solver(fsi_linear_solver::FSILS_lhsType& lhs, fsi_linear_solver::FSILS_l
   dmsg << "ls.RI.fNorm: " << ls.RI.fNorm;
   #endif
 
-  Array<double> Gt(nsd,nnz), mK(nsd*nsd,nnz), mG(nsd,nnz), mD(nsd,nnz);
+  // The blocks of A = [mK mG; mD mL]: mK and mD are used in place in 'Val',
+  // mG and mL are packed. G^t is applied with the transposed entries of mG.
+  //
+  FSILS_valBlockType mK(Val, dof, 0, 0), mD(Val, dof, nsd, 0);
+  Array<double> mG(nsd,nnz);
   Vector<double> mL(nnz); 
 
-  // Store sections of the 'Val' array into separate arrays: 'Gt', 'mK', etc.
-  //
-  // Modfies: Gt, mK, mG, mD, and mL.
-  //
-  depart(lhs, nsd, dof, nNo, nnz, Val, Gt, mK, mG, mD, mL);
+  depart(nsd, dof, nnz, Val, mG, mL);
 
   // Computes lhs.face[].nS for each face.
   //
@@ -284,7 +233,11 @@ void ns_solver(fsi_linear_solver::FSILS_lhsType& lhs, fsi_linear_solver::FSILS_l
     // Solve for U = inv(mK) * Rm
     //
     auto U_slice = U.slice(i);
-    gmres::gmres(lhs, ls.GM, nsd, mK, Rm, U_slice);
+    if (ls.GM.pipelined) {
+      gmres::pgmres(lhs, ls.GM, nsd, mK, Rm, U_slice);
+    } else {
+      gmres::gmres(lhs, ls.GM, nsd, mK, Rm, U_slice);
+    }
     U.set_slice(i, U_slice);
 
     // P = D*U
@@ -300,7 +253,7 @@ void ns_solver(fsi_linear_solver::FSILS_lhsType& lhs, fsi_linear_solver::FSILS_l
     // P = [L + G^t*G]^-1*P
     //
     P_col = P.rcol(i);
-    cgrad::schur(lhs, ls.CG, nsd, Gt, mG, mL, P_col);
+    cgrad::schur(lhs, ls.CG, nsd, FSILS_valBlockType(mG.data(), nsd, 1), FSILS_valBlockType(mL.data(), 1, 1), P_col);
     //P.set_col(i, P_col);
 
     // MU1 = G*P
@@ -322,7 +275,11 @@ void ns_solver(fsi_linear_solver::FSILS_lhsType& lhs, fsi_linear_solver::FSILS_l
     //
     lhs.debug_active = true;
     auto U_i = U.rslice(i);
-    gmres::gmres(lhs, ls.GM, nsd, mK, MU.slice(iBB), U_i);
+    if (ls.GM.pipelined) {
+      gmres::pgmres(lhs, ls.GM, nsd, mK, MU.slice(iBB), U_i);
+    } else {
+      gmres::gmres(lhs, ls.GM, nsd, mK, MU.slice(iBB), U_i);
+    }
     //U.set_slice(i, U_i);
 
     // MU2 = K*U
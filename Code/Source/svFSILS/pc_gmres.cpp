@@ -37,6 +37,7 @@
 #include "dot.h"
 #include "norm.h"
 #include "omp_la.h"
+#include "precond.h"
 #include "spar_mul.h"
 
 #include "Array3.h"
@@ -45,13 +46,145 @@
 
 namespace pc_gmres {
 
-/// \todo [NOTE] Not implemented.
+/// @brief Right preconditioned GMRES: solve Val * M^{-1} * Y = R and return 
+/// X = M^{-1} * Y in R. M^{-1} is the preconditioner 'pc' which must have
+/// been set up for Val (see precond::precond_setup).
+///
+/// The orthogonalization is the same as in gmres::gmres_v().
 //
 void pc_gmres(fsi_linear_solver::FSILS_lhsType& lhs, fsi_linear_solver::FSILS_subLsType& ls, const int dof, 
-    const Array<double>& Val, const Array<double>& R)
+    const Array<double>& Val, fsi_linear_solver::FSILS_pcType& pc, Array<double>& R)
 {
   using namespace fsi_linear_solver;
 
+  #define n_debug_pc_gmres
+  #ifdef debug_pc_gmres
+  DebugMsg dmsg(__func__,  lhs.commu.task);
+  dmsg.banner();
+  #endif
+
+  int nNo = lhs.nNo;
+  int mynNo = lhs.mynNo;
+
+  Array<double> h(ls.sD+1,ls.sD), X(dof,nNo), Z(dof,nNo), Y(dof,nNo);
+  Array3<double> u(dof,nNo,ls.sD+1);
+  Vector<double> y(ls.sD), c(ls.sD), s(ls.sD), err(ls.sD+1);
+
+  ls.callD = fsi_linear_solver::fsils_cpu_t();
+  ls.suc = false;
+  double eps = norm::fsi_ls_normv(dof, mynNo, lhs.commu, R);
+  ls.iNorm = eps;
+  ls.fNorm = eps;
+  eps = std::max(ls.absTol, ls.relTol*eps);
+  ls.itr = 0;
+  int last_i = 0;
+  X = 0.0;
+
+  if (ls.iNorm <= ls.absTol) {
+    ls.callD = std::numeric_limits<double>::epsilon();
+    ls.dB = 0.0;
+    return; 
+  }
+
+  for (int l = 0; l < ls.mItr; l++) {
+    ls.dB = ls.fNorm;
+    ls.itr = ls.itr + 1;
+    auto u_slice = u.rslice(0);
+    spar_mul::fsils_spar_mul_vv(lhs, lhs.rowPtr, lhs.colPtr, dof, Val, X, u_slice);
+
+    add_bc_mul::add_bc_mul(lhs, BcopType::BCOP_TYPE_ADD, dof, X, u_slice);
+
+    u_slice = R - u_slice;
+
+    err[0] = norm::fsi_ls_normv(dof, mynNo, lhs.commu, u_slice);
+    u_slice = u.rslice(0) / err[0];
+    #ifdef debug_pc_gmres
+    dmsg << "err(1): " << err[0];
+    #endif
+
+    for (int i = 0; i < ls.sD; i++) {
+      ls.itr = ls.itr + 1;
+      last_i = i;
+      auto u_slice = u.rslice(i);
+      auto u_slice_1 = u.rslice(i+1);
+
+      // u(i+1) = Val * M^{-1} u(i)
+      //
+      precond::precond_apply(lhs, pc, dof, u_slice, Z, true);
+
+      spar_mul::fsils_spar_mul_vv(lhs, lhs.rowPtr, lhs.colPtr, dof, Val, Z, u_slice_1);
+
+      add_bc_mul::add_bc_mul(lhs, BcopType::BCOP_TYPE_ADD, dof, Z, u_slice_1);
+
+      for (int j = 0; j <= i+1; j++) {
+        h(j,i) = dot::fsils_nc_dot_v(dof, mynNo, u.rslice(j), u.rslice(i+1));
+      }
+
+      auto h_col = h.col(i);
+      bcast::fsils_bcast_v(i+2, h_col, lhs.commu);
+      h.set_col(i, h_col);
+
+      for (int j = 0; j <= i; j++) {
+        omp_la::omp_sum_v(dof, nNo, -h(j,i), u_slice_1, u.rslice(j));
+        h(i+1,i) = h(i+1,i) - h(j,i)*h(j,i);
+      }
+      h(i+1,i) = sqrt(fabs(h(i+1,i)));
+
+      omp_la::omp_mul_v(dof, nNo, 1.0/h(i+1,i), u_slice_1);
+
+      for (int j = 0; j <= i-1; j++) {
+        double tmp = c(j)*h(j,i) + s(j)*h(j+1,i);
+        h(j+1,i) = -s(j)*h(j,i) + c(j)*h(j+1,i);
+        h(j,i) = tmp;
+      }
+
+      double tmp = sqrt(h(i,i)*h(i,i) + h(i+1,i)*h(i+1,i));
+      c(i) = h(i,i) / tmp;
+      s(i) = h(i+1,i) / tmp;
+      h(i,i) = tmp;
+      h(i+1,i) = 0.0;
+      err(i+1) = -s(i)*err(i);
+      err(i) = c(i)*err(i);
+      #ifdef debug_pc_gmres
+      dmsg << "err(i+1): " << err(i+1);
+      #endif
+
+      if (fabs(err(i+1)) < eps) {
+        ls.suc = true;
+        break;
+      }
+    } // for int i = 0; i < ls.sD
+
+    for (int i = 0; i <= last_i; i++) {
+      y(i) = err(i);
+    }
+
+    for (int j = last_i; j >= 0; j--) { 
+      for (int k = j+1; k <= last_i; k++) {
+        y(j) = y(j) - h(j,k)*y(k);
+      }
+      y(j) = y(j) / h(j,j);
+    }
+
+    // X = X + M^{-1} * sum_j y(j) u(j)
+    //
+    Y = 0.0;
+    for (int j = 0; j <= last_i; j++) {
+      omp_la::omp_sum_v(dof, nNo, y(j), Y, u.rslice(j));
+    }
+
+    precond::precond_apply(lhs, pc, dof, Y, Z, true);
+    omp_la::omp_sum_v(dof, nNo, 1.0, X, Z);
+
+    ls.fNorm = fabs(err(last_i+1));
+    if (ls.suc) {
+      break;
+    }
+  }
+
+  R = X;
+  ls.callD = fsi_linear_solver::fsils_cpu_t() - ls.callD;
+  ls.dB  = 10.0 * log(ls.fNorm / ls.dB);
 }
 
 };
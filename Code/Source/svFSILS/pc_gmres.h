@@ -32,5 +32,7 @@
 
 namespace pc_gmres {
 
+void pc_gmres(fsi_linear_solver::FSILS_lhsType& lhs, fsi_linear_solver::FSILS_subLsType& ls, const int dof,
+    const Array<double>& Val, fsi_linear_solver::FSILS_pcType& pc, Array<double>& R);
 
 };
@@ -34,6 +34,8 @@
 #include "precond.h"
 
 #include "fsils_api.hpp"
+#include "amg.h"
+#include "bilu.h"
 
 #include <math.h>
 
@@ -623,4 +625,72 @@ void pre_mul(const Array<int>& rowPtr, const int nNo, const int nnz, const int d
   }
 }
 
+/// @brief Set up the preconditioner 'prec' applied within the Krylov 
+/// iterations for the (scaled) matrix Val. It is called once per assembly.
+///
+/// Modifies: pc
+//
+void precond_setup(fsi_linear_solver::FSILS_lhsType& lhs, fsi_linear_solver::FSILS_pcType& pc, 
+    const consts::PreconditionerType prec, const int dof, const Array<double>& Val)
+{
+  using namespace consts;
+
+  pc.type = prec;
+
+  switch (prec) {
+    case PreconditionerType::PREC_FSILS_AMG:
+      amg::amg_setup(lhs, pc.amg, dof, Val);
+    break;
+
+    case PreconditionerType::PREC_FSILS_BILU:
+      bilu::bilu_setup(lhs, pc.bilu, dof, Val, false);
+    break;
+
+    case PreconditionerType::PREC_FSILS_BLOCK_JACOBI:
+      bilu::bilu_setup(lhs, pc.bilu, dof, Val, true);
+    break;
+
+    default:
+      throw std::runtime_error("[precond_setup] The preconditioner '" + 
+          preconditioner_type_to_name.at(prec) + "' is not applied within the iterations.");
+    break;
+  }
+}
+
+/// @brief Apply the preconditioner: Z = M^{-1} R.
+///
+/// The preconditioner is applied to the local part of R on each process. 
+/// If 'restricted' the result is only kept at the nodes owned by the process
+/// (restricted additive Schwarz), otherwise the results of the processes 
+/// sharing a node are summed (additive Schwarz, symmetric). Block Jacobi 
+/// needs no communication, the diagonal blocks are the global ones.
+///
+/// Modifies: Z, pc work vectors
+//
+void precond_apply(fsi_linear_solver::FSILS_lhsType& lhs, fsi_linear_solver::FSILS_pcType& pc, 
+    const int dof, const Array<double>& R, Array<double>& Z, const bool restricted)
+{
+  using namespace consts;
+
+  if (pc.type == PreconditionerType::PREC_FSILS_AMG) {
+    amg::amg_apply(lhs, pc.amg, dof, R, Z);
+  } else {
+    bilu::bilu_apply(lhs, pc.bilu, dof, R, Z);
+  }
+
+  if ((lhs.commu.nTasks == 1) || (lhs.nReq == 0) || (pc.type == PreconditionerType::PREC_FSILS_BLOCK_JACOBI)) {
+    return;
+  }
+
+  if (restricted) {
+    for (int a = lhs.mynNo; a < lhs.nNo; a++) {
+      for (int i = 0; i < dof; i++) {
+        Z(i,a) = 0.0;
+      }
+    }
+  }
+
+  fsi_linear_solver::fsils_commuv(lhs, dof, Z);
+}
+
 };
@@ -40,6 +40,12 @@ void precond_diag(fsi_linear_solver::FSILS_lhsType& lhs, const Array<int>& rowPt
 void precond_rcs(fsi_linear_solver::FSILS_lhsType& lhs, const Array<int>& rowPtr, const Vector<int>& colPtr,
     const Vector<int>& diagPtr, const int dof, Array<double>& Val, Array<double>& R, Array<double>& W1, Array<double>& W2);
 
+void precond_apply(fsi_linear_solver::FSILS_lhsType& lhs, fsi_linear_solver::FSILS_pcType& pc, 
+    const int dof, const Array<double>& R, Array<double>& Z, const bool restricted);
+
+void precond_setup(fsi_linear_solver::FSILS_lhsType& lhs, fsi_linear_solver::FSILS_pcType& pc, 
+    const consts::PreconditionerType prec, const int dof, const Array<double>& Val);
+
 void pre_mul(const Array<int>& rowPtr, const int nNo, const int nnz, const int dof, Array<double>& Val, const Array<double>& W);
 
 };
@@ -34,6 +34,7 @@
 #include "cgrad.h"
 #include "gmres.h"
 #include "ns_solver.h"
+#include "pc_gmres.h"
 #include "precond.h"
 
 namespace fsi_linear_solver {
@@ -124,7 +125,10 @@ void fsils_solve(FSILS_lhsType& lhs, FSILS_lsType& ls, const int dof, Array<doub
   // Modifies Val and R.
   //
 
-  if (prec == PreconditionerType::PREC_FSILS) {
+  bool use_pc = (prec == PreconditionerType::PREC_FSILS_AMG) || (prec == PreconditionerType::PREC_FSILS_BILU) ||
+      (prec == PreconditionerType::PREC_FSILS_BLOCK_JACOBI);
+
+  if ((prec == PreconditionerType::PREC_FSILS) || use_pc) {
     precond::precond_diag(lhs, lhs.rowPtr, lhs.colPtr, lhs.diagPtr, dof, Val, R, Wc);
   } else if (prec == PreconditionerType::PREC_RCS) {
     precond::precond_rcs(lhs, lhs.rowPtr, lhs.colPtr, lhs.diagPtr, dof, Val, R, Wr, Wc);
@@ -132,6 +136,17 @@ void fsils_solve(FSILS_lhsType& lhs, FSILS_lsType& ls, const int dof, Array<doub
     //PRINT *, "This linear solver and preconditioner combination is not supported."
   }
 
+  // Set up the multigrid or block ILU/Jacobi preconditioner for the scaled 
+  // matrix, it is applied within the GMRES and CG iterations.
+  //
+  if (use_pc) {
+    if ((ls.LS_type != LinearSolverType::LS_TYPE_GMRES) && (ls.LS_type != LinearSolverType::LS_TYPE_CG)) {
+      throw std::runtime_error("[fsils_solve] The '" + preconditioner_type_to_name.at(prec) + 
+          "' preconditioner can only be used with the GMRES and CG linear solvers.");
+    }
+    precond::precond_setup(lhs, ls.pc, prec, dof, Val);
+  }
+
   // Solve for 'R'.
   //
   switch (ls.LS_type) {
@@ -140,7 +155,9 @@ void fsils_solve(FSILS_lhsType& lhs, FSILS_lsType& ls, const int dof, Array<doub
     break;
 
     case LinearSolverType::LS_TYPE_GMRES:
-      if (dof == 1) {
+      if (use_pc) {
+        pc_gmres::pc_gmres(lhs, ls.RI, dof, Val, ls.pc, R);
+      } else if (dof == 1) {
         auto Valv = Val.row(0);
         auto Rv = R.row(0);
         gmres::gmres_s(lhs, ls.RI, dof, Valv, Rv);
@@ -151,8 +168,14 @@ void fsils_solve(FSILS_lhsType& lhs, FSILS_lsType& ls, const int dof, Array<doub
       }
     break;
 
+    case LinearSolverType::LS_TYPE_PGMRES:
+      gmres::pgmres_v(lhs, ls.RI, dof, Val, R);
+    break;
+
     case LinearSolverType::LS_TYPE_CG:
-      if (dof == 1) {
+      if (use_pc) {
+        cgrad::pc_cgrad_v(lhs, ls.RI, dof, Val, ls.pc, R);
+      } else if (dof == 1) {
         auto Valv = Val.row(0);
         auto Rv = R.row(0);
         cgrad::cgrad_s(lhs, ls.RI, Valv, Rv);
@@ -27,35 +27,209 @@
  * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
  * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
-
 //--------------------------------------------------------------------
 // Product of a sparse matrix and a vector. The matrix might be
 // vector in neither, one or both dimensions.
 //--------------------------------------------------------------------
 //
 // Reproduces code in SPARMUL.f.
+//
+// The matrix is stored in block form, a dof x dof block (row major) for 
+// each non-zero, so the row loops are run over raw arrays. Rows are 
+// independent and are split among lhs.nThreads OpenMP threads. The kernels 
+// are specialized for dof = 1,2,3,4 so that the block products are fully 
+// unrolled and vectorized by the compiler.
+//
+// The matrix values are accessed through FSILS_valBlockType views so that
+// the sub-blocks of a block matrix (e.g. the velocity and pressure blocks
+// of the Navier-Stokes matrix) are used in place.
+//
+// When running in parallel the rows of the nodes shared with other 
+// processors, [0,shnNo) and [mynNo,nNo), are computed first. Their exchange
+// is then started and the interior rows [shnNo,mynNo) are computed while 
+// the messages are in flight.
 
 #include "spar_mul.h"
 
 #include "fsils_api.hpp"
 
+#include <algorithm>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 namespace spar_mul {
 
+/// @brief Number of threads used for the row loops.
+//
+static int num_threads(const FSILS_lhsType& lhs)
+{
+  #ifdef _OPENMP
+  return std::max(1, lhs.nThreads);
+  #else
+  return 1;
+  #endif
+}
+
+/// @brief KU(:,i) = sum_j K(:,j) * U(colPtr(j)) for rows [i0,i1). 
+///
+/// DOF is the number of values per node, or 0 to use 'dof'.
+//
+template <int DOF>
+static void spar_mul_sv_rows(const int i0, const int i1, const int nt, const int dof, const int* rowPtr, 
+    const int* colPtr, const FSILS_valBlockType& K, const double* U, double* KU)
+{
+  const int d = (DOF > 0) ? DOF : dof;
+  const int ks = K.stride;
+  const int kl = K.ld;
+
+  #pragma omp parallel for schedule(static) num_threads(nt) if(nt > 1)
+  for (int i = i0; i < i1; i++) {
+    // Accumulate in registers when the dof is known at compile time.
+    double acc[(DOF > 0) ? DOF : 1];
+    double* ku = (DOF > 0) ? acc : KU + d*i;
+    for (int l = 0; l < d; l++) {
+      ku[l] = 0.0;
+    }
+    for (int j = rowPtr[2*i]; j <= rowPtr[2*i+1]; j++) {
+      const double u = U[colPtr[j]];
+      const double* k = K.val + ks*j;
+      #pragma omp simd
+      for (int l = 0; l < d; l++) {
+        ku[l] += k[kl*l] * u;
+      }
+    }
+    if (DOF > 0) {
+      for (int l = 0; l < d; l++) {
+        KU[d*i+l] = ku[l];
+      }
+    }
+  }
+}
+
+/// @brief KU(i) = sum_j K(:,j) . U(:,colPtr(j)) for rows [i0,i1).
+///
+/// If 'transPtr' is given the transposed entries K(:,transPtr(j)) are used,
+/// this is the product with the transpose of a matrix stored as for 
+/// spar_mul_sv_rows().
+///
+/// DOF is the number of values per node, or 0 to use 'dof'.
+//
+template <int DOF>
+static void spar_mul_vs_rows(const int i0, const int i1, const int nt, const int dof, const int* rowPtr, 
+    const int* colPtr, const int* transPtr, const FSILS_valBlockType& K, const double* U, double* KU)
+{
+  const int d = (DOF > 0) ? DOF : dof;
+  const int ks = K.stride;
+  const int kl = (transPtr == nullptr) ? 1 : K.ld;
+
+  #pragma omp parallel for schedule(static) num_threads(nt) if(nt > 1)
+  for (int i = i0; i < i1; i++) {
+    double ku = 0.0;
+    for (int j = rowPtr[2*i]; j <= rowPtr[2*i+1]; j++) {
+      int jk = j;
+      if (transPtr != nullptr) {
+        jk = transPtr[j];
+        if (jk == -1) {
+          continue;
+        }
+      }
+      const double* u = U + d*colPtr[j];
+      const double* k = K.val + ks*jk;
+      for (int l = 0; l < d; l++) {
+        ku += k[kl*l] * u[l];
+      }
+    }
+    KU[i] = ku;
+  }
+}
+
+/// @brief KU(:,i) = sum_j K(:,:,j) * U(:,colPtr(j)) for dof x dof blocks
+/// and rows [i0,i1).
+///
+/// DOF is the number of values per node, or 0 to use 'dof'.
+//
+template <int DOF>
+static void spar_mul_vv_rows(const int i0, const int i1, const int nt, const int dof, const int* rowPtr, 
+    const int* colPtr, const FSILS_valBlockType& K, const double* U, double* KU)
+{
+  const int d = (DOF > 0) ? DOF : dof;
+  const int ks = K.stride;
+  const int kl = K.ld;
+
+  #pragma omp parallel for schedule(static) num_threads(nt) if(nt > 1)
+  for (int i = i0; i < i1; i++) {
+    // Accumulate in registers when the dof is known at compile time.
+    double acc[(DOF > 0) ? DOF : 1];
+    double* ku = (DOF > 0) ? acc : KU + d*i;
+    for (int l = 0; l < d; l++) {
+      ku[l] = 0.0;
+    }
+    for (int j = rowPtr[2*i]; j <= rowPtr[2*i+1]; j++) {
+      const double* u = U + d*colPtr[j];
+      const double* k = K.val + ks*j;
+      for (int l = 0; l < d; l++) {
+        double sum = ku[l];
+        for (int m = 0; m < d; m++) {
+          sum += k[kl*l+m] * u[m];
+        }
+        ku[l] = sum;
+      }
+    }
+    if (DOF > 0) {
+      for (int l = 0; l < d; l++) {
+        KU[d*i+l] = ku[l];
+      }
+    }
+  }
+}
+
+/// @brief Compute the rows of a product with 'rows(i0,i1)' and sum the 
+/// values of the shared nodes of KU (stored as (dof,nNo)) over processors.
+//
+template <typename RowsFunc>
+static void spar_mul_commu(const FSILS_lhsType& lhs, const int dof, RowsFunc rows, double* KU)
+{
+  int nNo = lhs.nNo;
+
+  if ((lhs.commu.nTasks == 1) || (lhs.cS.size() == 0)) {
+    rows(0, nNo);
+    return;
+  }
+
+  rows(0, lhs.shnNo);
+  rows(lhs.mynNo, nNo);
+
+  fsils_commu_begin(lhs, dof, KU);
+
+  rows(lhs.shnNo, lhs.mynNo);
+
+  fsils_commu_end(lhs, dof, KU);
+}
+
 /// @brief Reproduces 'SUBROUTINE FSILS_SPARMULSS(lhs, rowPtr, colPtr, K, U, KU)'
 //
 void fsils_spar_mul_ss(FSILS_lhsType& lhs, const Array<int>& rowPtr, const Vector<int>& colPtr, 
     const Vector<double>& K, const Vector<double>& U, Vector<double>& KU)
 {
-  int nNo = lhs.nNo;
-  KU = 0.0;
+  fsils_spar_mul_ss(lhs, rowPtr, colPtr, FSILS_valBlockType(K.data(), 1, 1), U, KU);
+}
 
-  for (int i = 0; i < nNo; i++) {
-    for (int j = rowPtr(0,i); j <= rowPtr(1,i); j++) {
-      KU(i) = KU(i) + K(j) * U(colPtr(j));
-    } 
-  }
+/// @brief KU = K * U for a scalar sub-block K of a block matrix.
+//
+void fsils_spar_mul_ss(FSILS_lhsType& lhs, const Array<int>& rowPtr, const Vector<int>& colPtr, 
+    const FSILS_valBlockType& K, const Vector<double>& U, Vector<double>& KU)
+{
+  int nt = num_threads(lhs);
+  auto rp = rowPtr.data();
+  auto cp = colPtr.data();
+
+  auto rows = [&](const int i0, const int i1) {
+    spar_mul_vv_rows<1>(i0, i1, nt, 1, rp, cp, K, U.data(), KU.data());
+  };
 
-  fsils_commus(lhs, KU);
+  spar_mul_commu(lhs, 1, rows, KU.data());
 }
 
 /// @brief Reproduces 'SUBROUTINE FSILS_SPARMULSV(lhs, rowPtr, colPtr, dof, K, U, KU)'. 
@@ -63,65 +237,53 @@ void fsils_spar_mul_ss(FSILS_lhsType& lhs, const Array<int>& rowPtr, const Vecto
 void fsils_spar_mul_sv(FSILS_lhsType& lhs, const Array<int>& rowPtr, const Vector<int>& colPtr, 
     const int dof, const Array<double>& K, const Vector<double>& U, Array<double>& KU)
 {
-  int nNo = lhs.nNo;
-  KU = 0.0;
-
-  switch (dof) {
+  fsils_spar_mul_sv(lhs, rowPtr, colPtr, dof, FSILS_valBlockType(K.data(), dof, 1), U, KU);
+}
 
-    case 1:
-      for (int i = 0; i < nNo; i++) {
-        for (int j = rowPtr(0,i); j <= rowPtr(1,i); j++) {
-          KU(0,i) = KU(0,i) + K(0,j)*U(colPtr(j));
-        }
-      }
-    break; 
-
-    case 2: {
-      for (int i = 0; i < nNo; i++) {
-        for (int j = rowPtr(0,i); j <= rowPtr(1,i); j++) {
-          int col = colPtr(j);
-          KU(0,i) = KU(0,i) + K(0,j)*U(col);
-          KU(1,i) = KU(1,i) + K(1,j)*U(col);
-        }
-      }
+/// @brief KU = K * U for a dof x 1 sub-block K of a block matrix.
+//
+void fsils_spar_mul_sv(FSILS_lhsType& lhs, const Array<int>& rowPtr, const Vector<int>& colPtr, 
+    const int dof, const FSILS_valBlockType& K, const Vector<double>& U, Array<double>& KU)
+{
+  int nt = num_threads(lhs);
+  auto rp = rowPtr.data();
+  auto cp = colPtr.data();
+
+  auto rows = [&](const int i0, const int i1) {
+    switch (dof) {
+      case 1: spar_mul_sv_rows<1>(i0, i1, nt, dof, rp, cp, K, U.data(), KU.data()); break; 
+      case 2: spar_mul_sv_rows<2>(i0, i1, nt, dof, rp, cp, K, U.data(), KU.data()); break; 
+      case 3: spar_mul_sv_rows<3>(i0, i1, nt, dof, rp, cp, K, U.data(), KU.data()); break; 
+      case 4: spar_mul_sv_rows<4>(i0, i1, nt, dof, rp, cp, K, U.data(), KU.data()); break; 
+      default: spar_mul_sv_rows<0>(i0, i1, nt, dof, rp, cp, K, U.data(), KU.data()); break; 
+    } 
+  };
 
-    } break; 
+  spar_mul_commu(lhs, dof, rows, KU.data());
+}
 
-    case 3: {
-      for (int i = 0; i < nNo; i++) {
-        for (int j = rowPtr(0,i); j <= rowPtr(1,i); j++) {
-          int col = colPtr(j);
-          KU(0,i) += K(0,j) * U(col);
-          KU(1,i) += K(1,j) * U(col);
-          KU(2,i) += K(2,j) * U(col);
-        }
-      }
-    } break; 
-
-    case 4:
-      for (int i = 0; i < nNo; i++) {
-        for (int j = rowPtr(0,i); j <= rowPtr(1,i); j++) {
-          int col = colPtr(j);
-          KU(0,i) = KU(0,i) + K(0,j)*U(col);
-          KU(1,i) = KU(1,i) + K(1,j)*U(col);
-          KU(2,i) = KU(2,i) + K(2,j)*U(col);
-          KU(3,i) = KU(3,i) + K(3,j)*U(col);
-        }
-      }
-    break; 
-
-    default: 
-      for (int i = 0; i < nNo; i++) {
-        for (int j = rowPtr(0,i); j <= rowPtr(1,i); j++) {
-          int col = colPtr(j);
-          for (int m = 0; m < KU.nrows(); m++) {
-            KU(m,i) = KU(m,i) + K(m,j) * U(col);
-          }
-        }
-      }
-  } 
+/// @brief KU = K^T * U for a dof x 1 sub-block K of a block matrix, using 
+/// the transposed entries lhs.transPtr so that K^T needs not be formed.
+//
+void fsils_spar_mul_sv_t(FSILS_lhsType& lhs, const Array<int>& rowPtr, const Vector<int>& colPtr, 
+    const int dof, const FSILS_valBlockType& K, const Array<double>& U, Vector<double>& KU)
+{
+  int nt = num_threads(lhs);
+  auto rp = rowPtr.data();
+  auto cp = colPtr.data();
+  auto tp = lhs.transPtr.data();
+
+  auto rows = [&](const int i0, const int i1) {
+    switch (dof) {
+      case 1: spar_mul_vs_rows<1>(i0, i1, nt, dof, rp, cp, tp, K, U.data(), KU.data()); break; 
+      case 2: spar_mul_vs_rows<2>(i0, i1, nt, dof, rp, cp, tp, K, U.data(), KU.data()); break; 
+      case 3: spar_mul_vs_rows<3>(i0, i1, nt, dof, rp, cp, tp, K, U.data(), KU.data()); break; 
+      case 4: spar_mul_vs_rows<4>(i0, i1, nt, dof, rp, cp, tp, K, U.data(), KU.data()); break; 
+      default: spar_mul_vs_rows<0>(i0, i1, nt, dof, rp, cp, tp, K, U.data(), KU.data()); break; 
+    } 
+  };
 
-  fsils_commuv(lhs, dof, KU);
+  spar_mul_commu(lhs, 1, rows, KU.data());
 }
 
 /// @brief Reproduces 'SUBROUTINE FSILS_SPARMULVS(lhs, rowPtr, colPtr, dof, K, U, KU)'.
@@ -129,61 +291,29 @@ void fsils_spar_mul_sv(FSILS_lhsType& lhs, const Array<int>& rowPtr, const Vecto
 void fsils_spar_mul_vs(FSILS_lhsType& lhs, const Array<int>& rowPtr, const Vector<int>& colPtr, 
     const int dof, const Array<double>& K, const Array<double>& U, Vector<double>& KU)
 {
-  int nNo = lhs.nNo;
-  KU = 0.0;
-
-  switch (dof) {
-
-    case 1:
-      for (int i = 0; i < nNo; i++) {
-        for (int j = rowPtr(0,i); j <= rowPtr(1,i); j++) {
-          KU(i) = KU(i) + K(0,j) * U(0,colPtr(j));
-        }
-      }
-    break; 
-
-    case 2:
-      for (int i = 0; i < nNo; i++) {
-        for (int j = rowPtr(0,i); j <= rowPtr(1,i); j++) {
-          int col = colPtr(j);
-          KU(i) = KU(i) + K(0,j)*U(0,col) + K(1,j)*U(1,col);
-        }
-      }
-    break; 
-
-    case 3:
-      for (int i = 0; i < nNo; i++) {
-        for (int j = rowPtr(0,i); j <= rowPtr(1,i); j++) {
-          int col = colPtr(j);
-          KU(i) = KU(i) + K(0,j)*U(0,col) + K(1,j)*U(1,col) + K(2,j)*U(2,col);
-        }
-      }
-    break; 
+  fsils_spar_mul_vs(lhs, rowPtr, colPtr, dof, FSILS_valBlockType(K.data(), dof, 1), U, KU);
+}
 
-    case 4:
-      for (int i = 0; i < nNo; i++) {
-        for (int j = rowPtr(0,i); j <= rowPtr(1,i); j++) {
-          int col = colPtr(j);
-          KU(i) = KU(i) + K(0,j)*U(0,col) + K(1,j)*U(1,col) + K(2,j)*U(2,col) + K(3,j)*U(3,col);
-        }
-      }
-    break; 
-
-    default: 
-      for (int i = 0; i < nNo; i++) {
-        for (int j = rowPtr(0,i); j <= rowPtr(1,i); j++) {
-          int col = colPtr(j);
-          double sum = 0.0;
-          for (int m = 0; m < K.nrows(); m++) {
-            sum += K(m,j) * U(m,col);
-          }
-          KU(i) = KU(i) + sum; 
-          //KU(i) = KU(i) + SUM(K(:,j)*U(:,colPtr(j)))
-        }
-     }
-  } 
+/// @brief KU = K * U for a 1 x dof sub-block K of a block matrix.
+//
+void fsils_spar_mul_vs(FSILS_lhsType& lhs, const Array<int>& rowPtr, const Vector<int>& colPtr, 
+    const int dof, const FSILS_valBlockType& K, const Array<double>& U, Vector<double>& KU)
+{
+  int nt = num_threads(lhs);
+  auto rp = rowPtr.data();
+  auto cp = colPtr.data();
+
+  auto rows = [&](const int i0, const int i1) {
+    switch (dof) {
+      case 1: spar_mul_vs_rows<1>(i0, i1, nt, dof, rp, cp, nullptr, K, U.data(), KU.data()); break; 
+      case 2: spar_mul_vs_rows<2>(i0, i1, nt, dof, rp, cp, nullptr, K, U.data(), KU.data()); break; 
+      case 3: spar_mul_vs_rows<3>(i0, i1, nt, dof, rp, cp, nullptr, K, U.data(), KU.data()); break; 
+      case 4: spar_mul_vs_rows<4>(i0, i1, nt, dof, rp, cp, nullptr, K, U.data(), KU.data()); break; 
+      default: spar_mul_vs_rows<0>(i0, i1, nt, dof, rp, cp, nullptr, K, U.data(), KU.data()); break; 
+    } 
+  };
 
-  fsils_commus(lhs, KU);
+  spar_mul_commu(lhs, 1, rows, KU.data());
 }
 
 /// @brief Reproduces 'SUBROUTINE FSILS_SPARMULVV(lhs, rowPtr, colPtr, dof, K, U, KU)'. 
@@ -191,72 +321,29 @@ void fsils_spar_mul_vs(FSILS_lhsType& lhs, const Array<int>& rowPtr, const Vecto
 void fsils_spar_mul_vv(FSILS_lhsType& lhs, const Array<int>& rowPtr, const Vector<int>& colPtr, 
     const int dof, const Array<double>& K, const Array<double>& U, Array<double>& KU)
 {
-  int nNo = lhs.nNo;
-  KU = 0.0;
-
-  switch (dof) {
+  fsils_spar_mul_vv(lhs, rowPtr, colPtr, dof, FSILS_valBlockType(K.data(), dof*dof, dof), U, KU);
+}
 
-    case 1:
-      for (int i = 0; i < nNo; i++) {
-        for (int j = rowPtr(0,i); j <= rowPtr(1,i); j++) {
-          KU(0,i) = KU(0,i) + K(0,j)*U(0,colPtr(j));
-        }
-      }
-    break;
-
-    case 2:
-      for (int i = 0; i < nNo; i++) {
-        for (int j = rowPtr(0,i); j <= rowPtr(1,i); j++) {
-          int col = colPtr(j);
-          KU(0,i) = KU(0,i) + K(0,j)*U(0,col) + K(1,j)*U(1,col);
-          KU(1,i) = KU(1,i) + K(2,j)*U(0,col) + K(3,j)*U(1,col);
-        }
-      }
-    break;
-
-    case 3:
-      for (int i = 0; i < nNo; i++) {
-        for (int j = rowPtr(0,i); j <= rowPtr(1,i); j++) {
-          int col = colPtr(j);
-          KU(0,i) = KU(0,i) + K(0,j)*U(0,col) + K(1,j)*U(1,col) + K(2,j)*U(2,col);
-          KU(1,i) = KU(1,i) + K(3,j)*U(0,col) + K(4,j)*U(1,col) + K(5,j)*U(2,col);
-          KU(2,i) = KU(2,i) + K(6,j)*U(0,col) + K(7,j)*U(1,col) + K(8,j)*U(2,col);
-        }
-      }
-    break;
-
-    case 4:
-      for (int i = 0; i < nNo; i++) {
-        for (int j = rowPtr(0,i); j <= rowPtr(1,i); j++) {
-          int col = colPtr(j);
-          KU(0,i) = KU(0,i) + K(0 ,j)*U(0,col) + K(1 ,j)*U(1,col) + K(2 ,j)*U(2,col) + K(3 ,j)*U(3,col);
-          KU(1,i) = KU(1,i) + K(4 ,j)*U(0,col) + K(5 ,j)*U(1,col) + K(6 ,j)*U(2,col) + K(7 ,j)*U(3,col);
-          KU(2,i) = KU(2,i) + K(8 ,j)*U(0,col) + K(9,j)*U(1,col) + K(10,j)*U(2,col) + K(11,j)*U(3,col);
-          KU(3,i) = KU(3,i) + K(12,j)*U(0,col) + K(13,j)*U(1,col) + K(14,j)*U(2,col) + K(15,j)*U(3,col);
-        }
-      }
-    break;
-
-    default: 
-      for (int i = 0; i < nNo; i++) {
-        for (int j = rowPtr(0,i); j <= rowPtr(1,i); j++) {
-          int col = colPtr(j);
-          for (int l = 0; l < dof; l++) {
-            int e = l*dof;
-            int s = e - dof + 1;;
-            double sum = 0.0;
-            for (int k = 0; k < dof; k++) {
-              sum += K(k+s,j) * U(k,col);
-            }
-            KU(l,i) = KU(l,i) + sum;
-          }
-        }
-     }
-  } 
+/// @brief KU = K * U for a dof x dof sub-block K of a block matrix.
+//
+void fsils_spar_mul_vv(FSILS_lhsType& lhs, const Array<int>& rowPtr, const Vector<int>& colPtr, 
+    const int dof, const FSILS_valBlockType& K, const Array<double>& U, Array<double>& KU)
+{
+  int nt = num_threads(lhs);
+  auto rp = rowPtr.data();
+  auto cp = colPtr.data();
+
+  auto rows = [&](const int i0, const int i1) {
+    switch (dof) {
+      case 1: spar_mul_vv_rows<1>(i0, i1, nt, dof, rp, cp, K, U.data(), KU.data()); break;
+      case 2: spar_mul_vv_rows<2>(i0, i1, nt, dof, rp, cp, K, U.data(), KU.data()); break;
+      case 3: spar_mul_vv_rows<3>(i0, i1, nt, dof, rp, cp, K, U.data(), KU.data()); break;
+      case 4: spar_mul_vv_rows<4>(i0, i1, nt, dof, rp, cp, K, U.data(), KU.data()); break;
+      default: spar_mul_vv_rows<0>(i0, i1, nt, dof, rp, cp, K, U.data(), KU.data()); break;
+    } 
+  };
 
-  fsils_commuv(lhs, dof, KU);
+  spar_mul_commu(lhs, dof, rows, KU.data());
 }
 
 };
-
-
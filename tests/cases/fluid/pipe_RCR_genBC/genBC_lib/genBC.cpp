@@ -0,0 +1,162 @@
+/* Copyright (c) Stanford University, The Regents of the University of California, and others.
+ *
+ * All Rights Reserved.
+ *
+ * See Copyright-SimVascular.txt for additional details.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// The RCR boundary condition of genBC/src/USER.f built as a shared library 
+// that svFSIplus calls through GenBCInterface instead of running genBC.exe.
+//
+// The 0D unknowns are kept in memory between calls instead of the 
+// InitialData file; AllData is written as genBC does.
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+// Model size (INITIALIZE in USER.f).
+const int nDirichletSrfs = 0;
+const int nNeumannSrfs = 1;
+const int nUnknowns = 1;
+const int nTimeStep = 1000;
+const int nXprint = 3;
+
+// Unknowns and time at the end of the last converged time step.
+double t_last = 0.0;
+std::vector<double> X_last(nUnknowns, 0.0);
+
+//-------
+// findf
+//-------
+// Right-hand side of the 0D model (FINDF in USER.f).
+//
+void findf(const double t, const std::vector<double>& x, std::vector<double>& f, const std::vector<double>& Q, 
+    const std::vector<double>& P, std::vector<double>& offset, std::vector<double>& Xprint)
+{
+  const double Rp = 121.0;
+  const double C = 1.5e-4;
+  const double Rd = 1212.0;
+
+  f[0] = (1.0/C) * (Q[0] - x[0]/Rd);
+  offset[0] = Q[0]*Rp;
+
+  Xprint[0] = t;
+  Xprint[1] = Q[0];
+  Xprint[2] = offset[0];
+}
+
+}
+
+//-------------
+// genbc_integ
+//-------------
+// Integrate the 0D model over the 3D time step dt for the 3D pressures P and 
+// flow rates Q interpolated linearly in time (GenBC.f). See GenBCInterface.h 
+// for the arguments.
+//
+extern "C" void genbc_integ(const char* flag, const double dt, const int nDir, const int nNeu, 
+    const double* P, const double* Q, double* y, int* istat)
+{
+  if ((nDir != nDirichletSrfs) || (nNeu != nNeumannSrfs)) {
+    fprintf(stderr, "[genbc_integ] The number of Dirichlet and Neumann surfaces (%d,%d) does not match the "
+        "genBC model (%d,%d).\n", nDir, nNeu, nDirichletSrfs, nNeumannSrfs);
+    *istat = 1;
+    return;
+  }
+
+  int nt = (flag[0] == 'I') ? 0 : nTimeStep;
+  double h = dt / nTimeStep;
+  double t = t_last;
+  auto Xo = X_last;
+  std::vector<double> X(nUnknowns), offset(nUnknowns, 0.0), Xprint(nXprint, 0.0);
+  std::vector<std::vector<double>> f(4, std::vector<double>(nUnknowns));
+  std::vector<std::vector<double>> Qs(4, std::vector<double>(nNeumannSrfs));
+  std::vector<std::vector<double>> Ps(4, std::vector<double>(nDirichletSrfs));
+
+  // Runge-Kutta 3/8 rule.
+  for (int n = 0; n < nt; n++) {
+    for (int i = 0; i < 4; i++) {
+      double s = (n + i/3.0) / nTimeStep;
+      for (int j = 0; j < nNeumannSrfs; j++) {
+        Qs[i][j] = Q[2*j] + (Q[2*j+1] - Q[2*j])*s;
+      }
+      for (int j = 0; j < nDirichletSrfs; j++) {
+        Ps[i][j] = P[2*j] + (P[2*j+1] - P[2*j])*s;
+      }
+    }
+
+    findf(t, Xo, f[0], Qs[0], Ps[0], offset, Xprint);
+    for (int k = 0; k < nUnknowns; k++) {
+      X[k] = Xo[k] + h*f[0][k]/3.0;
+    }
+
+    findf(t + h/3.0, X, f[1], Qs[1], Ps[1], offset, Xprint);
+    for (int k = 0; k < nUnknowns; k++) {
+      X[k] = Xo[k] - h*f[0][k]/3.0 + h*f[1][k];
+    }
+
+    findf(t + h*2.0/3.0, X, f[2], Qs[2], Ps[2], offset, Xprint);
+    for (int k = 0; k < nUnknowns; k++) {
+      X[k] = Xo[k] + h*f[0][k] - h*f[1][k] + h*f[2][k];
+    }
+
+    findf(t + h, X, f[3], Qs[3], Ps[3], offset, Xprint);
+    for (int k = 0; k < nUnknowns; k++) {
+      Xo[k] = Xo[k] + h*(f[0][k] + 3.0*f[1][k] + 3.0*f[2][k] + f[3][k])/8.0;
+    }
+    t = t + h;
+  }
+
+  // Pressure of the single Neumann surface (srfToXPtr = 1).
+  if (std::isnan(Xo[0])) {
+    fprintf(stderr, "[genbc_integ] A NaN has been computed.\n");
+    *istat = 2;
+    return;
+  }
+  y[0] = Xo[0] + offset[0];
+
+  if (flag[0] == 'L') {
+    t_last = t;
+    X_last = Xo;
+
+    FILE* fp = fopen("AllData", "a");
+    if (fp != nullptr) {
+      for (int k = 0; k < nUnknowns; k++) {
+        fprintf(fp, "%14.6E", Xo[k]);
+      }
+      for (int k = 0; k < nXprint; k++) {
+        fprintf(fp, "%14.6E", Xprint[k]);
+      }
+      fprintf(fp, "\n");
+      fclose(fp);
+    }
+  }
+
+  *istat = 0;
+}
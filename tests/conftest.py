@@ -120,6 +120,7 @@ def run_with_reference(
     t_max=1,
     name_ref=None,
     name_inp="svFSI.xml",
+    rtol=None,
 ):
     """
     Run a test case and compare it to a stored reference solution
@@ -130,6 +131,7 @@ def run_with_reference(
         t_max: time step to compare
         name_inp: name of svFSIplus input file (.xml)
         name_ref: name of refence file (.vtu)
+        rtol: relative tolerance used for all fields instead of RTOL
     """
     # default reference name
     if not name_ref:
@@ -169,15 +171,18 @@ def run_with_reference(
                 b = b[:, :2]
 
         # pick tolerance for current field
-        if f not in RTOL:
+        if rtol is not None:
+            f_rtol = rtol
+        elif f not in RTOL:
             raise ValueError("No tolerance defined for field " + f)
-        rtol = RTOL[f]
+        else:
+            f_rtol = RTOL[f]
 
         # relative difference (as computed in np.isclose)
         # note that we consider rtol as absolute zero (and as relative tolerance)
         a_fl = a.flatten()
         b_fl = b.flatten()
-        rel_diff = np.abs(a_fl - b_fl) - rtol - rtol * np.abs(b_fl)
+        rel_diff = np.abs(a_fl - b_fl) - f_rtol - f_rtol * np.abs(b_fl)
 
         # throw error if not all results are within relative tolerance
         close = rel_diff <= 0.0
@@ -196,7 +201,7 @@ def run_with_reference(
 
             # throw error message for pytest
             msg += "Test failed in field " + f + "."
-            msg += " Results differ by more than rtol=" + str(rtol)
+            msg += " Results differ by more than rtol=" + str(f_rtol)
             msg += " in {:.1%}".format(wrong)
             msg += " of results."
             msg += " Max. rel. difference is"
@@ -1,9 +1,10 @@
 import os
 import pytest
 
+import numpy as np
 import pandas as pd
 
-from .conftest import run_with_reference, RTOL
+from .conftest import run_with_reference, run_by_name, RTOL
 
 # Common folder for all tests in this file
 base_folder = "cep"
@@ -22,6 +23,59 @@ def test_spiral_BO_2d(n_proc):
     run_with_reference(base_folder, test_folder, fields, n_proc)
 
 
+# Rush-Larsen integration is compared to the reference computed with RK4,
+# the second-order scheme with a tighter tolerance
+@pytest.mark.parametrize("ode_solver, rtol", [("rl", 1.0e-2), ("rl2", 1.0e-3)])
+@pytest.mark.parametrize("test_folder", ["cable_TTP_1d", "spiral_BO_2d"])
+def test_rush_larsen(test_folder, ode_solver, rtol, n_proc):
+    name_inp = "svFSI_" + ode_solver + ".xml"
+    run_with_reference(
+        base_folder, test_folder, fields, n_proc, name_inp=name_inp, rtol=rtol
+    )
+
+
+# A time step of 1 ms is stable with Rush-Larsen integration only
+@pytest.mark.parametrize("ode_solver", ["FE", "RK", "RL", "RL2"])
+def test_spiral_BO_2d_large_dt(ode_solver, n_proc):
+    folder = os.path.join("cases", base_folder, "spiral_BO_2d")
+    t_max = 10
+
+    # input file with the ODE solver to test
+    with open(os.path.join(folder, "svFSI_large_dt.xml")) as f:
+        xml = f.read()
+    name_inp = "svFSI_large_dt_" + ode_solver + ".xml"
+    with open(os.path.join(folder, name_inp), "w") as f:
+        f.write(
+            xml.replace(
+                "<ODE_solver> RL </ODE_solver>",
+                "<ODE_solver> " + ode_solver + " </ODE_solver>",
+            )
+        )
+
+    try:
+        res = run_by_name(folder, name_inp, t_max, n_proc)
+        ap = res.point_data["Action_potential"]
+    except RuntimeError:
+        # no output, the simulation stopped
+        ap = None
+    finally:
+        os.remove(os.path.join(folder, name_inp))
+
+    # the action potential of the model lies in [-84, 49] mV
+    stable = (
+        ap is not None
+        and np.all(np.isfinite(ap))
+        and np.all(ap > -90.0)
+        and np.all(ap < 60.0)
+    )
+    assert stable == ode_solver.startswith("RL"), (
+        "Action potential with ODE solver "
+        + ode_solver
+        + (" left" if ode_solver.startswith("RL") else " stayed within")
+        + " the physiological range for a time step of 1 ms"
+    )
+
+
 def test_square_AP_2d(n_proc):
     test_folder = "square_AP_2d"
     run_with_reference(base_folder, test_folder, fields, n_proc)
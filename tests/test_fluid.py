@@ -1,6 +1,10 @@
-from .conftest import run_with_reference
+from .conftest import run_with_reference, run_by_name, cpp_exec
+import glob
 import os
+import pytest
+import shutil
 import subprocess
+import numpy as np
 
 # Common folder for all tests in this file
 base_folder = "fluid"
@@ -14,6 +18,49 @@ def test_pipe_RCR_3d(n_proc):
     t_max = 2
     run_with_reference(base_folder, test_folder, fields, n_proc, t_max)
 
+def test_pipe_RCR_3d_partition_cache(n_proc):
+    if n_proc == 1:
+        pytest.skip("The partition cache is not used for a single processor")
+
+    folder = os.path.join("cases", base_folder, "pipe_RCR_3d")
+    t_max = 2
+    cache = os.path.join(folder, "partitions")
+    if os.path.exists(cache):
+        shutil.rmtree(cache)
+
+    # input file saving the partition cache
+    with open(os.path.join(folder, "svFSI.xml")) as f:
+        xml = f.read()
+    name_inp = "svFSI_partition_cache.xml"
+    with open(os.path.join(folder, name_inp), "w") as f:
+        f.write(
+            xml.replace(
+                "</GeneralSimulationParameters>",
+                "  <Partition_cache_folder> partitions </Partition_cache_folder>\n\n"
+                + "</GeneralSimulationParameters>",
+            )
+        )
+
+    try:
+        # the first run partitions the mesh and saves the cache files
+        res_1 = run_by_name(folder, name_inp, t_max, n_proc)
+        files = sorted(glob.glob(os.path.join(cache, "*", "*.bin")))
+        assert len(files) == 2 * n_proc
+        mtimes = [os.path.getmtime(f) for f in files]
+
+        # the second run reads the cache files without writing them again
+        res_2 = run_by_name(folder, name_inp, t_max, n_proc)
+        assert sorted(glob.glob(os.path.join(cache, "*", "*.bin"))) == files
+        assert [os.path.getmtime(f) for f in files] == mtimes
+    finally:
+        os.remove(os.path.join(folder, name_inp))
+        shutil.rmtree(cache, ignore_errors=True)
+
+    # both runs give identical results
+    for f in fields:
+        assert np.array_equal(res_1.point_data[f], res_2.point_data[f]), f
+
+
 def test_pipe_RCR_3d_petsc(n_proc):
     test_folder = "pipe_RCR_3d_petsc"
     t_max = 2
@@ -28,6 +75,37 @@ def test_pipe_RCR_3d_trilinos_bj(n_proc):
     test_folder = "pipe_RCR_3d_bj_trilinos"
     t_max = 2
     run_with_reference(base_folder, test_folder, fields, n_proc, t_max)
+
+def test_pipe_RCR_3d_pgmres(n_proc):
+    test_folder = "pipe_RCR_3d_pgmres"
+    t_max = 2
+    run_with_reference(base_folder, test_folder, fields, n_proc, t_max)
+
+@pytest.mark.parametrize("prec", ["fsils-amg", "fsils-ilu", "fsils-blockjacobi"])
+def test_pipe_RCR_3d_fsils_prec(prec, n_proc):
+    test_folder = "pipe_RCR_3d_fsils_prec"
+    t_max = 2
+    name_inp = "svFSI_" + prec + ".xml"
+    run_with_reference(base_folder, test_folder, fields, n_proc, t_max, name_inp=name_inp)
+
+@pytest.mark.parametrize("ls_type", ["NS", "BICGS", "pipelined-gmres"])
+@pytest.mark.parametrize("prec", ["fsils-amg", "fsils-ilu", "fsils-blockjacobi"])
+def test_pipe_RCR_3d_fsils_prec_unsupported_solver(prec, ls_type):
+    folder = os.path.join("cases", base_folder, "pipe_RCR_3d_fsils_prec")
+
+    # Use the preconditioner with a linear solver that does not support it
+    with open(os.path.join(folder, "svFSI_" + prec + ".xml")) as f:
+        xml = f.read()
+    name_inp = "svFSI_unsupported.xml"
+    with open(os.path.join(folder, name_inp), "w") as f:
+        f.write(xml.replace('<LS type="GMRES" >', '<LS type="' + ls_type + '" >'))
+
+    res = subprocess.run(["mpirun", "-np", "1", cpp_exec, name_inp], cwd=folder, capture_output=True, text=True)
+    os.remove(os.path.join(folder, name_inp))
+
+    assert res.returncode != 0
+    assert "can only be used with the GMRES and CG linear solvers" in res.stdout + res.stderr
+
 def test_pipe_RCR_genBC(n_proc):
     test_folder = "pipe_RCR_genBC"
     t_max = 2
@@ -48,6 +126,32 @@ def test_pipe_RCR_genBC(n_proc):
 
     run_with_reference(base_folder, test_folder, fields, n_proc, t_max)
 
+def test_pipe_RCR_genBC_lib(n_proc):
+    test_folder = "pipe_RCR_genBC"
+    t_max = 2
+
+    # Remove old genBC output
+    os.chdir(os.path.join("cases", base_folder, test_folder))
+    for name in ["AllData", "GenBC.int"]:
+        if os.path.isfile(name):
+            os.remove(name)
+
+    # Compile genBC as a shared library
+    subprocess.run(["cmake", "-S", "genBC_lib", "-B", "genBC_lib/build"], check=True)
+    subprocess.run(["cmake", "--build", "genBC_lib/build"], check=True)
+
+    # Change back to original directory
+    os.chdir("../../..")
+
+    run_with_reference(
+        base_folder, test_folder, fields, n_proc, t_max, name_inp="svFSI_genBC_lib.xml"
+    )
+
+    # genBC was called in-process, without the communication file
+    folder = os.path.join("cases", base_folder, test_folder)
+    assert not os.path.isfile(os.path.join(folder, "GenBC.int"))
+    assert os.path.isfile(os.path.join(folder, "AllData"))
+
 def test_pipe_RCR_sv0D(n_proc):
     test_folder = "pipe_RCR_sv0D"
     t_max = 2
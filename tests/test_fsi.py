@@ -1,4 +1,7 @@
-from .conftest import run_with_reference
+from .conftest import run_with_reference, run_by_name, RTOL
+import numpy as np
+import os
+import shutil
 
 # Common folder for all tests in this file
 base_folder = "fsi"
@@ -25,4 +28,42 @@ def test_pipe_3d_trilinos_bj(n_proc):
 def test_pipe_3d_trilinos_ml(n_proc):
     test_folder = "pipe_3d_ml_trilinos"
     t_max = 5
-    run_with_reference(base_folder, test_folder, fields, n_proc, t_max)
\ No newline at end of file
+    run_with_reference(base_folder, test_folder, fields, n_proc, t_max)
+
+def test_pipe_3d_remesh_restart(n_proc):
+    test_folder = "pipe_3d_remesh"
+    t_max = 4
+    folder = os.path.join("cases", base_folder, test_folder)
+    with open(os.path.join(folder, "svFSI.xml")) as f:
+        xml = f.read()
+
+    # Run with remeshing at time step 3, the restart file of time step 1 is
+    # written before remeshing with the record length of the original mesh
+    run_by_name(folder, "svFSI.xml", t_max, n_proc)
+    st_file = os.path.join(folder, str(n_proc) + "-procs", "stFile_1.bin")
+    assert os.path.exists(st_file)
+    shutil.copy(st_file, os.path.join(folder, "stFile_remesh.bin"))
+
+    # Uninterrupted run on the original mesh
+    xml = xml.replace("<Simulation_requires_remeshing> true", "<Simulation_requires_remeshing> false")
+    with open(os.path.join(folder, "svFSI_ref.xml"), "w") as f:
+        f.write(xml)
+    ref = run_by_name(folder, "svFSI_ref.xml", t_max, n_proc)
+
+    # Run on the original mesh restarted from the restart file of time step 1
+    xml = xml.replace("<Continue_previous_simulation> 0 </Continue_previous_simulation>",
+        "<Continue_previous_simulation> 0 </Continue_previous_simulation>\n" +
+        "  <Simulation_initialization_file_path> stFile_remesh.bin </Simulation_initialization_file_path>")
+    with open(os.path.join(folder, "svFSI_restart.xml"), "w") as f:
+        f.write(xml)
+    res = run_by_name(folder, "svFSI_restart.xml", t_max, n_proc)
+
+    for name in ["svFSI_ref.xml", "svFSI_restart.xml", "stFile_remesh.bin"]:
+        os.remove(os.path.join(folder, name))
+
+    for f in fields:
+        a = res.point_data[f].flatten()
+        b = ref.point_data[f].flatten()
+        assert np.allclose(a, b, rtol=RTOL[f], atol=RTOL[f]), (
+            "Restarted results in field " + f + " differ from the uninterrupted run"
+        )
@@ -84,3 +84,11 @@ TEST(UnitTestIso_2, MR) {
       
 }
 
+
+TEST(UnitTestCep, RushLarsenAliases) {
+    // The ODE_solver names are lower-cased by the parser before the lookup.
+    EXPECT_EQ(cep_time_int_to_type.at("rl"), TimeIntegratioType::RL);
+    EXPECT_EQ(cep_time_int_to_type.at("rush-larsen"), TimeIntegratioType::RL);
+    EXPECT_EQ(cep_time_int_to_type.at("rl2"), TimeIntegratioType::RL2);
+    EXPECT_EQ(cep_time_int_to_type.at("grl2"), TimeIntegratioType::RL2);
+}
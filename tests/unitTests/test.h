@@ -35,6 +35,7 @@
 #include "mat_fun_carray.h"
 #include "mat_models.h"
 #include "mat_models_carray.h"
+#include "CepMod.h"
 
 class MockCepMod : public CepMod {
 public: